@@ -0,0 +1,676 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ctsxml_merge.h"
+
+#include "xml_test_environment.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+namespace Conformance
+{
+    namespace
+    {
+        bool IsXmlWhitespace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        bool IsAllWhitespace(const std::string& text)
+        {
+            for (char c : text) {
+                if (!IsXmlWhitespace(c)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void AppendUtf8(std::string& out, unsigned long codePoint)
+        {
+            if (codePoint < 0x80) {
+                out += (char)codePoint;
+            }
+            else if (codePoint < 0x800) {
+                out += (char)(0xC0 | (codePoint >> 6));
+                out += (char)(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000) {
+                out += (char)(0xE0 | (codePoint >> 12));
+                out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+                out += (char)(0x80 | (codePoint & 0x3F));
+            }
+            else {
+                out += (char)(0xF0 | (codePoint >> 18));
+                out += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+                out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+                out += (char)(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        /// Recursive descent over the subset of XML the reporters write: no DTDs, and only the predefined and numeric
+        /// character references.
+        class XmlParser
+        {
+        public:
+            explicit XmlParser(const std::string& document) : m_document(document)
+            {
+            }
+
+            bool ParseDocument(XmlElement& root, std::string& error)
+            {
+                SkipMisc();
+                if (!ParseElement(root)) {
+                    error = m_error;
+                    return false;
+                }
+                SkipMisc();
+                if (m_pos != m_document.size()) {
+                    error = Fail("content after the root element");
+                    return false;
+                }
+                return true;
+            }
+
+        private:
+            bool StartsWith(const char* token) const
+            {
+                return m_document.compare(m_pos, std::strlen(token), token) == 0;
+            }
+
+            bool SkipPast(const char* token)
+            {
+                const size_t end = m_document.find(token, m_pos);
+                if (end == std::string::npos) {
+                    m_pos = m_document.size();
+                    return false;
+                }
+                m_pos = end + std::strlen(token);
+                return true;
+            }
+
+            void SkipWhitespace()
+            {
+                while (m_pos < m_document.size() && IsXmlWhitespace(m_document[m_pos])) {
+                    m_pos++;
+                }
+            }
+
+            /// Skip whitespace, comments, processing instructions and document type declarations outside the root element.
+            void SkipMisc()
+            {
+                for (;;) {
+                    SkipWhitespace();
+                    if (StartsWith("<?")) {
+                        SkipPast("?>");
+                    }
+                    else if (StartsWith("<!--")) {
+                        SkipPast("-->");
+                    }
+                    else if (StartsWith("<!DOCTYPE")) {
+                        SkipPast(">");
+                    }
+                    else {
+                        return;
+                    }
+                }
+            }
+
+            std::string Fail(const std::string& message)
+            {
+                if (m_error.empty()) {
+                    m_error = message + " at offset " + std::to_string(m_pos);
+                }
+                return m_error;
+            }
+
+            bool ParseName(std::string& name)
+            {
+                const size_t start = m_pos;
+                while (m_pos < m_document.size() && !IsXmlWhitespace(m_document[m_pos]) &&
+                       std::strchr("<>/=\"'", m_document[m_pos]) == nullptr) {
+                    m_pos++;
+                }
+                if (m_pos == start) {
+                    Fail("expected a name");
+                    return false;
+                }
+                name = m_document.substr(start, m_pos - start);
+                return true;
+            }
+
+            /// Append the character data up to @p end to @p out, replacing character references.
+            bool AppendUnescaped(size_t end, std::string& out)
+            {
+                while (m_pos < end) {
+                    const size_t ampersand = m_document.find('&', m_pos);
+                    if (ampersand == std::string::npos || ampersand >= end) {
+                        out.append(m_document, m_pos, end - m_pos);
+                        m_pos = end;
+                        return true;
+                    }
+                    out.append(m_document, m_pos, ampersand - m_pos);
+                    m_pos = ampersand;
+                    const size_t semicolon = m_document.find(';', ampersand);
+                    if (semicolon == std::string::npos || semicolon >= end) {
+                        Fail("unterminated character reference");
+                        return false;
+                    }
+                    const std::string reference = m_document.substr(ampersand + 1, semicolon - ampersand - 1);
+                    if (reference == "lt") {
+                        out += '<';
+                    }
+                    else if (reference == "gt") {
+                        out += '>';
+                    }
+                    else if (reference == "amp") {
+                        out += '&';
+                    }
+                    else if (reference == "quot") {
+                        out += '"';
+                    }
+                    else if (reference == "apos") {
+                        out += '\'';
+                    }
+                    else if (reference.size() > 1 && reference[0] == '#') {
+                        const bool hex = reference[1] == 'x';
+                        const char* digits = reference.c_str() + (hex ? 2 : 1);
+                        char* digitsEnd = nullptr;
+                        const unsigned long codePoint = std::strtoul(digits, &digitsEnd, hex ? 16 : 10);
+                        if (digitsEnd == digits || *digitsEnd != '\0' || codePoint > 0x10FFFF) {
+                            Fail("invalid character reference");
+                            return false;
+                        }
+                        AppendUtf8(out, codePoint);
+                    }
+                    else {
+                        Fail("unknown entity &" + reference + ";");
+                        return false;
+                    }
+                    m_pos = semicolon + 1;
+                }
+                return true;
+            }
+
+            bool ParseAttributes(XmlElement& element, bool& selfClosing)
+            {
+                for (;;) {
+                    SkipWhitespace();
+                    if (StartsWith("/>")) {
+                        m_pos += 2;
+                        selfClosing = true;
+                        return true;
+                    }
+                    if (StartsWith(">")) {
+                        m_pos++;
+                        selfClosing = false;
+                        return true;
+                    }
+                    std::string name;
+                    if (!ParseName(name)) {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (!StartsWith("=")) {
+                        Fail("expected '=' after attribute " + name);
+                        return false;
+                    }
+                    m_pos++;
+                    SkipWhitespace();
+                    if (m_pos >= m_document.size() || (m_document[m_pos] != '"' && m_document[m_pos] != '\'')) {
+                        Fail("expected a quoted value for attribute " + name);
+                        return false;
+                    }
+                    const char quote = m_document[m_pos++];
+                    const size_t end = m_document.find(quote, m_pos);
+                    if (end == std::string::npos) {
+                        Fail("unterminated value of attribute " + name);
+                        return false;
+                    }
+                    std::string value;
+                    if (!AppendUnescaped(end, value)) {
+                        return false;
+                    }
+                    m_pos = end + 1;
+                    element.attributes.emplace_back(name, value);
+                }
+            }
+
+            bool ParseElement(XmlElement& element)
+            {
+                if (!StartsWith("<")) {
+                    Fail("expected an element");
+                    return false;
+                }
+                m_pos++;
+                bool selfClosing = false;
+                if (!ParseName(element.name) || !ParseAttributes(element, selfClosing)) {
+                    return false;
+                }
+                if (selfClosing) {
+                    return true;
+                }
+
+                for (;;) {
+                    if (m_pos >= m_document.size()) {
+                        Fail("missing end tag of " + element.name);
+                        return false;
+                    }
+                    if (StartsWith("</")) {
+                        m_pos += 2;
+                        std::string name;
+                        if (!ParseName(name)) {
+                            return false;
+                        }
+                        if (name != element.name) {
+                            Fail("end tag of " + name + " does not match " + element.name);
+                            return false;
+                        }
+                        SkipWhitespace();
+                        if (!StartsWith(">")) {
+                            Fail("expected '>'");
+                            return false;
+                        }
+                        m_pos++;
+                        break;
+                    }
+                    if (StartsWith("<!--")) {
+                        if (!SkipPast("-->")) {
+                            Fail("unterminated comment");
+                            return false;
+                        }
+                    }
+                    else if (StartsWith("<![CDATA[")) {
+                        m_pos += std::strlen("<![CDATA[");
+                        const size_t end = m_document.find("]]>", m_pos);
+                        if (end == std::string::npos) {
+                            Fail("unterminated CDATA section");
+                            return false;
+                        }
+                        element.text.append(m_document, m_pos, end - m_pos);
+                        m_pos = end + 3;
+                    }
+                    else if (StartsWith("<?")) {
+                        SkipPast("?>");
+                    }
+                    else if (StartsWith("<")) {
+                        element.children.emplace_back();
+                        if (!ParseElement(element.children.back())) {
+                            return false;
+                        }
+                    }
+                    else {
+                        const size_t end = m_document.find('<', m_pos);
+                        if (!AppendUnescaped(end == std::string::npos ? m_document.size() : end, element.text)) {
+                            return false;
+                        }
+                    }
+                }
+
+                // Whitespace between child elements is only indentation.
+                if (!element.children.empty() && IsAllWhitespace(element.text)) {
+                    element.text.clear();
+                }
+                return true;
+            }
+
+            const std::string& m_document;
+            size_t m_pos{0};
+            std::string m_error;
+        };
+
+        void AppendEscaped(std::string& out, const std::string& text)
+        {
+            for (char c : text) {
+                switch (c) {
+                case '<':
+                    out += "&lt;";
+                    break;
+                case '>':
+                    out += "&gt;";
+                    break;
+                case '&':
+                    out += "&amp;";
+                    break;
+                case '"':
+                    out += "&quot;";
+                    break;
+                default:
+                    out += c;
+                    break;
+                }
+            }
+        }
+
+        void AppendElement(std::string& out, const XmlElement& element, size_t depth)
+        {
+            const std::string indent(depth * 2, ' ');
+            out += indent + "<" + element.name;
+            for (const auto& attribute : element.attributes) {
+                out += " " + attribute.first + "=\"";
+                AppendEscaped(out, attribute.second);
+                out += "\"";
+            }
+            if (element.text.empty() && element.children.empty()) {
+                out += "/>\n";
+                return;
+            }
+            out += ">";
+            if (element.children.empty()) {
+                AppendEscaped(out, element.text);
+                out += "</" + element.name + ">\n";
+                return;
+            }
+            out += "\n";
+            if (!element.text.empty()) {
+                AppendEscaped(out, element.text);
+                out += "\n";
+            }
+            for (const XmlElement& child : element.children) {
+                AppendElement(out, child, depth + 1);
+            }
+            out += indent + "</" + element.name + ">\n";
+        }
+
+        uint64_t GetCount(const XmlElement& element, const char* attributeName)
+        {
+            const std::string* value = element.FindAttribute(attributeName);
+            return value == nullptr ? 0 : std::strtoull(value->c_str(), nullptr, 10);
+        }
+
+        /// Add the children of @p from to @p into, except those with the same name and @p key attribute as one already there.
+        void AddMissingChildren(XmlElement& into, const XmlElement& from, const char* key)
+        {
+            for (const XmlElement& child : from.children) {
+                const std::string* childKey = child.FindAttribute(key);
+                bool found = false;
+                for (const XmlElement& existing : into.children) {
+                    const std::string* existingKey = existing.FindAttribute(key);
+                    if (existing.name == child.name && (existingKey == nullptr) == (childKey == nullptr) &&
+                        (childKey == nullptr || *existingKey == *childKey)) {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) {
+                    into.children.push_back(child);
+                }
+            }
+        }
+
+        /// Assertion totals of a testsuite, as attributes of the testsuite or of cts:totals.
+        struct SuiteCounts
+        {
+            uint64_t errors{0};
+            uint64_t failures{0};
+            uint64_t skipped{0};
+            uint64_t tests{0};
+
+            void Add(const XmlElement& suite)
+            {
+                const XmlElement* counts = &suite;
+                if (suite.FindAttribute("tests") == nullptr) {
+                    counts = suite.FindChild(CTS_XML_NS_PREFIX_QUALIFIER "totals");
+                }
+                if (counts != nullptr) {
+                    errors += GetCount(*counts, "errors");
+                    failures += GetCount(*counts, "failures");
+                    skipped += GetCount(*counts, "skipped");
+                    tests += GetCount(*counts, "tests");
+                    return;
+                }
+
+                // A ctsxml-streaming report of a process that stopped before the end of its run has neither: count the
+                // assertions written with its test cases, which are all the failures it saw.
+                for (const XmlElement& testCase : suite.children) {
+                    if (testCase.name != "testcase") {
+                        continue;
+                    }
+                    for (const XmlElement& assertion : testCase.children) {
+                        if (assertion.name == "error") {
+                            errors++;
+                        }
+                        else if (assertion.name == "failure") {
+                            failures++;
+                        }
+                        else if (assertion.name == "skipped") {
+                            skipped++;
+                        }
+                        else {
+                            continue;
+                        }
+                        tests++;
+                    }
+                }
+            }
+        };
+
+        std::function<bool(const XmlElement&)> HasName(const std::string& name)
+        {
+            return [&name](const XmlElement& element) { return element.name == name; };
+        }
+
+        std::string FormatSeconds(double seconds)
+        {
+            char formatted[32];
+            snprintf(formatted, sizeof(formatted), "%.3f", seconds);
+            return formatted;
+        }
+
+        void AppendLine(std::string& text, const std::string& line)
+        {
+            if (line.empty()) {
+                return;
+            }
+            if (!text.empty()) {
+                text += "\n";
+            }
+            text += line;
+        }
+    }  // namespace
+
+    const std::string* XmlElement::FindAttribute(const std::string& attributeName) const
+    {
+        for (const auto& attribute : attributes) {
+            if (attribute.first == attributeName) {
+                return &attribute.second;
+            }
+        }
+        return nullptr;
+    }
+
+    void XmlElement::SetAttribute(const std::string& attributeName, const std::string& value)
+    {
+        for (auto& attribute : attributes) {
+            if (attribute.first == attributeName) {
+                attribute.second = value;
+                return;
+            }
+        }
+        attributes.emplace_back(attributeName, value);
+    }
+
+    const XmlElement* XmlElement::FindChild(const std::string& childName) const
+    {
+        for (const XmlElement& child : children) {
+            if (child.name == childName) {
+                return &child;
+            }
+        }
+        return nullptr;
+    }
+
+    XmlElement* XmlElement::FindChild(const std::string& childName)
+    {
+        return const_cast<XmlElement*>(static_cast<const XmlElement*>(this)->FindChild(childName));
+    }
+
+    bool ParseXml(const std::string& document, XmlElement& root, std::string& error)
+    {
+        root = XmlElement{};
+        return XmlParser(document).ParseDocument(root, error);
+    }
+
+    std::string WriteXml(const XmlElement& root)
+    {
+        std::string out = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        AppendElement(out, root, 0);
+        return out;
+    }
+
+    XmlElement MergeReportDocuments(const std::vector<XmlElement>& reports, double seconds, MergedReportTotals& totals)
+    {
+        const std::string totalsName = CTS_XML_NS_PREFIX_QUALIFIER "totals";
+        const std::string summaryName = CTS_XML_NS_PREFIX_QUALIFIER "ctsConformanceReport";
+        const std::string resultsName = CTS_XML_NS_PREFIX_QUALIFIER "results";
+        const std::string swapchainFormatsName = CTS_XML_NS_PREFIX_QUALIFIER "swapchainFormats";
+        const std::string environmentName = CTS_XML_NS_PREFIX_QUALIFIER "ctsTestEnvironment";
+        const std::string activeName = CTS_XML_NS_PREFIX_QUALIFIER "activeAPILayersAndExtensions";
+
+        totals = MergedReportTotals{};
+        const XmlElement* firstSuite = nullptr;
+        SuiteCounts counts;
+        // Children of the merged testsuite before the test cases, by first appearance.
+        std::vector<XmlElement> header;
+        XmlElement summary;
+        XmlElement swapchainFormats;
+        std::vector<XmlElement> testCases;
+        std::string systemOut;
+        std::string systemErr;
+
+        for (const XmlElement& report : reports) {
+            for (const XmlElement& suite : report.children) {
+                if (suite.name != "testsuite") {
+                    continue;
+                }
+                if (firstSuite == nullptr) {
+                    firstSuite = &suite;
+                }
+                counts.Add(suite);
+
+                for (const XmlElement& child : suite.children) {
+                    if (child.name == "testcase") {
+                        testCases.push_back(child);
+                    }
+                    else if (child.name == "system-out") {
+                        AppendLine(systemOut, child.text);
+                    }
+                    else if (child.name == "system-err") {
+                        AppendLine(systemErr, child.text);
+                    }
+                    else if (child.name == totalsName) {
+                        // Read by SuiteCounts: the merged totals are attributes of the testsuite.
+                    }
+                    else if (child.name == summaryName) {
+                        summary.name = child.name;
+                        for (const XmlElement& entry : child.children) {
+                            if (entry.name == resultsName) {
+                                // Summed here, then written to the first results element.
+                                totals.testSuccessCount += GetCount(entry, "testSuccessCount");
+                                totals.testFailureCount += GetCount(entry, "testFailureCount");
+                            }
+                            if (entry.name == swapchainFormatsName) {
+                                swapchainFormats.name = entry.name;
+                                AddMissingChildren(swapchainFormats, entry, "name");
+                            }
+                            else if (summary.FindChild(entry.name) == nullptr) {
+                                // Each measurement comes from the one process that ran its test.
+                                summary.children.push_back(entry);
+                            }
+                        }
+                    }
+                    else if (child.name == activeName) {
+                        auto it = std::find_if(header.begin(), header.end(), HasName(activeName));
+                        if (it == header.end()) {
+                            header.push_back(child);
+                        }
+                        else {
+                            // Tests enable extensions of their own, so each process may have activated different ones.
+                            for (const XmlElement& list : child.children) {
+                                XmlElement* mergedList = it->FindChild(list.name);
+                                if (mergedList == nullptr) {
+                                    it->children.push_back(list);
+                                }
+                                else {
+                                    AddMissingChildren(*mergedList, list, "name");
+                                }
+                            }
+                        }
+                    }
+                    else if (std::none_of(header.begin(), header.end(), HasName(child.name))) {
+                        header.push_back(child);
+                    }
+                }
+            }
+        }
+
+        XmlElement root;
+        root.name = "testsuites";
+        if (!reports.empty()) {
+            root.attributes = reports.front().attributes;
+        }
+        else {
+            root.SetAttribute("xmlns:" CTS_XML_NS_PREFIX, "https://github.com/KhronosGroup/OpenXR-CTS");
+        }
+
+        XmlElement suite;
+        suite.name = "testsuite";
+        const std::string* name = firstSuite != nullptr ? firstSuite->FindAttribute("name") : nullptr;
+        suite.SetAttribute("name", name != nullptr ? *name : "");
+        suite.SetAttribute("errors", std::to_string(counts.errors));
+        suite.SetAttribute("failures", std::to_string(counts.failures));
+        suite.SetAttribute("skipped", std::to_string(counts.skipped));
+        suite.SetAttribute("tests", std::to_string(counts.tests));
+        suite.SetAttribute("hostname", "tbd");  // !TBD
+        suite.SetAttribute("time", FormatSeconds(seconds));
+        const std::string* timestamp = firstSuite != nullptr ? firstSuite->FindAttribute("timestamp") : nullptr;
+        if (timestamp != nullptr) {
+            suite.SetAttribute("timestamp", *timestamp);
+        }
+
+        for (XmlElement& child : header) {
+            if (child.name == environmentName) {
+                // Together, the processes ran both the exclusive session tests and the others.
+                XmlElement* testOptions = child.FindChild(CTS_XML_NS_PREFIX_QUALIFIER "testOptions");
+                XmlElement* exclusive =
+                    testOptions == nullptr ? nullptr : testOptions->FindChild(CTS_XML_NS_PREFIX_QUALIFIER "exclusiveSessionTests");
+                if (exclusive != nullptr) {
+                    exclusive->SetAttribute("value", "include");
+                }
+            }
+            suite.children.push_back(std::move(child));
+        }
+        // The conformance report summary follows the test environment, as written by the ctsxml reporter.
+        if (!summary.name.empty()) {
+            XmlElement* results = summary.FindChild(resultsName);
+            if (results != nullptr) {
+                results->SetAttribute("testSuccessCount", std::to_string(totals.testSuccessCount));
+                results->SetAttribute("testFailureCount", std::to_string(totals.testFailureCount));
+            }
+            if (!swapchainFormats.name.empty()) {
+                summary.children.push_back(std::move(swapchainFormats));
+            }
+            suite.children.push_back(std::move(summary));
+        }
+
+        for (XmlElement& testCase : testCases) {
+            suite.children.push_back(std::move(testCase));
+        }
+        XmlElement out;
+        out.name = "system-out";
+        out.text = systemOut;
+        suite.children.push_back(out);
+        XmlElement err;
+        err.name = "system-err";
+        err.text = systemErr;
+        suite.children.push_back(err);
+
+        root.children.push_back(std::move(suite));
+        return root;
+    }
+}  // namespace Conformance
@@ -0,0 +1,56 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Conformance
+{
+    /// An element of a parsed ctsxml report.
+    /// Comments and processing instructions are dropped, and whitespace-only text between child elements is ignored.
+    struct XmlElement
+    {
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> attributes;
+        /// Character data directly inside the element, unescaped.
+        std::string text;
+        std::vector<XmlElement> children;
+
+        /// Returns nullptr if the element has no attribute called @p attributeName.
+        const std::string* FindAttribute(const std::string& attributeName) const;
+        void SetAttribute(const std::string& attributeName, const std::string& value);
+
+        /// Returns the first child element called @p childName, or nullptr if there is none.
+        const XmlElement* FindChild(const std::string& childName) const;
+        XmlElement* FindChild(const std::string& childName);
+    };
+
+    /// Parse the elements, attributes and text of an XML document, as written by the ctsxml and ctsxml-streaming reporters.
+    /// Returns false and sets @p error if the document is not well-formed.
+    bool ParseXml(const std::string& document, XmlElement& root, std::string& error);
+
+    /// Write @p root as an XML document.
+    std::string WriteXml(const XmlElement& root);
+
+    /// Results of merging ctsxml reports.
+    struct MergedReportTotals
+    {
+        uint64_t testSuccessCount{0};
+        uint64_t testFailureCount{0};
+    };
+
+    /// Merge the parsed reports of the processes of one run into a single report with one testsuite element,
+    /// in the layout of the ctsxml reporter.
+    ///
+    /// The test cases of all reports are listed in report order. The assertion totals and the conformance report results
+    /// are summed, reading the totals of ctsxml-streaming reports from their cts:totals element. Each other element of the
+    /// conformance report summary and of the test environment is taken from the first report that has it, and the lists of
+    /// active layers, active extensions and swapchain formats are combined.
+    /// @p seconds is the time attribute of the merged testsuite.
+    XmlElement MergeReportDocuments(const std::vector<XmlElement>& reports, double seconds, MergedReportTotals& totals);
+}  // namespace Conformance
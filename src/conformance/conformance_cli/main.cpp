@@ -4,9 +4,12 @@
 
 #include <iostream>
 #include <algorithm>
+#include <string>
 #include <xr_dependencies.h>
 #include <conformance_test.h>
 
+#include "sharded_run.h"
+
 #if defined(_WIN32)
 #ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
 #define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
@@ -57,6 +60,17 @@ int main(int argc, const char** argv)
 {
     SetupConsole();
 
+    Conformance::ShardedRunSettings shardedRunSettings;
+    std::string shardedRunError;
+    if (!Conformance::ParseShardedRunSettings(argc, argv, shardedRunSettings, shardedRunError)) {
+        std::cerr << shardedRunError << std::endl;
+        return 2;  // Tests failed to run.
+    }
+    if (shardedRunSettings.shardCount > 0) {
+        // The workers load the runtime: this process only starts them and merges their reports.
+        return Conformance::RunSharded(argv[0], shardedRunSettings);
+    }
+
     ConformanceLaunchSettings launchSettings;
     launchSettings.argc = argc;
     launchSettings.argv = argv;
@@ -0,0 +1,488 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sharded_run.h"
+
+#include "ctsxml_merge.h"
+#include "test_durations.h"
+
+#include <xr_dependencies.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+// xr_dependencies.h includes windows.h
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#define CONFORMANCE_CLI_POSIX_SPAWN
+#endif
+
+namespace Conformance
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        using Seconds = std::chrono::duration<double>;
+
+        constexpr int ExitCodeTestsFailed = 1;
+        constexpr int ExitCodeFailedToRun = 2;
+
+        /// Matches the option name, returning its value from the following argument or from "--name=value".
+        /// A missing value is only an error if @p error is given: otherwise it is left for Catch2 to report.
+        bool MatchOption(int argc, const char* const* argv, int& i, const char* shortName, const char* longName, std::string& value,
+                         std::string* error)
+        {
+            const std::string arg = argv[i];
+            const std::string longPrefix = std::string(longName) + "=";
+            if (arg.compare(0, longPrefix.size(), longPrefix) == 0) {
+                value = arg.substr(longPrefix.size());
+                return true;
+            }
+            if (arg != longName && (shortName == nullptr || arg != shortName)) {
+                return false;
+            }
+            if (i + 1 >= argc) {
+                if (error == nullptr) {
+                    return false;
+                }
+                *error = arg + " requires a value";
+                return true;
+            }
+            value = argv[++i];
+            return true;
+        }
+
+        /// A child conformance_cli process.
+        class WorkerProcess
+        {
+        public:
+            WorkerProcess() = default;
+            WorkerProcess(const WorkerProcess&) = delete;
+            WorkerProcess& operator=(const WorkerProcess&) = delete;
+            ~WorkerProcess()
+            {
+#if defined(_WIN32)
+                if (m_process != nullptr) {
+                    CloseHandle(m_process);
+                }
+#endif
+            }
+
+            /// Start the process. Its console output goes to @p logPath, or to the console of this process if empty.
+            bool Start(const std::string& executable, const std::vector<std::string>& args, const std::string& logPath)
+            {
+                m_start = Clock::now();
+#if defined(_WIN32)
+                std::string commandLine = Quote(executable);
+                for (const std::string& arg : args) {
+                    commandLine += " " + Quote(arg);
+                }
+
+                STARTUPINFOA startupInfo{};
+                startupInfo.cb = sizeof(startupInfo);
+                HANDLE logFile = INVALID_HANDLE_VALUE;
+                if (!logPath.empty()) {
+                    SECURITY_ATTRIBUTES inheritable{sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+                    logFile = CreateFileA(logPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &inheritable, CREATE_ALWAYS,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+                    if (logFile == INVALID_HANDLE_VALUE) {
+                        return false;
+                    }
+                    startupInfo.dwFlags = STARTF_USESTDHANDLES;
+                    startupInfo.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+                    startupInfo.hStdOutput = logFile;
+                    startupInfo.hStdError = logFile;
+                }
+                PROCESS_INFORMATION processInfo{};
+                const BOOL created = CreateProcessA(executable.c_str(), &commandLine[0], nullptr, nullptr, TRUE, 0, nullptr, nullptr,
+                                                    &startupInfo, &processInfo);
+                if (logFile != INVALID_HANDLE_VALUE) {
+                    CloseHandle(logFile);
+                }
+                if (!created) {
+                    return false;
+                }
+                CloseHandle(processInfo.hThread);
+                m_process = processInfo.hProcess;
+                return true;
+#elif defined(CONFORMANCE_CLI_POSIX_SPAWN)
+                std::vector<char*> argv;
+                argv.push_back(const_cast<char*>(executable.c_str()));
+                for (const std::string& arg : args) {
+                    argv.push_back(const_cast<char*>(arg.c_str()));
+                }
+                argv.push_back(nullptr);
+
+                posix_spawn_file_actions_t fileActions;
+                posix_spawn_file_actions_init(&fileActions);
+                if (!logPath.empty()) {
+                    posix_spawn_file_actions_addopen(&fileActions, STDOUT_FILENO, logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                    posix_spawn_file_actions_adddup2(&fileActions, STDOUT_FILENO, STDERR_FILENO);
+                }
+                const int spawnResult = posix_spawnp(&m_pid, executable.c_str(), &fileActions, nullptr, argv.data(), environ);
+                posix_spawn_file_actions_destroy(&fileActions);
+                return spawnResult == 0;
+#else
+                (void)executable;
+                (void)args;
+                (void)logPath;
+                return false;
+#endif
+            }
+
+            /// Returns true once the process has exited, setting @p exitCode.
+            bool TryGetExitCode(int& exitCode)
+            {
+#if defined(_WIN32)
+                if (WaitForSingleObject(m_process, 0) != WAIT_OBJECT_0) {
+                    return false;
+                }
+                DWORD processExitCode = ExitCodeFailedToRun;
+                GetExitCodeProcess(m_process, &processExitCode);
+                exitCode = (int)processExitCode;
+#elif defined(CONFORMANCE_CLI_POSIX_SPAWN)
+                int status = 0;
+                if (waitpid(m_pid, &status, WNOHANG) != m_pid) {
+                    return false;
+                }
+                // A crashed worker counts as having failed to run.
+                exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : ExitCodeFailedToRun;
+#else
+                exitCode = ExitCodeFailedToRun;
+#endif
+                m_duration = Clock::now() - m_start;
+                return true;
+            }
+
+            Seconds GetDuration() const
+            {
+                return m_duration;
+            }
+
+        private:
+#if defined(_WIN32)
+            /// Quote an argument so that CommandLineToArgvW in the child recovers it unchanged.
+            static std::string Quote(const std::string& arg)
+            {
+                if (!arg.empty() && arg.find_first_of(" \t\"") == std::string::npos) {
+                    return arg;
+                }
+                std::string quoted = "\"";
+                size_t backslashes = 0;
+                for (char c : arg) {
+                    if (c == '\\') {
+                        backslashes++;
+                        continue;
+                    }
+                    // Backslashes are only special before a quote.
+                    quoted.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+                    backslashes = 0;
+                    quoted += c;
+                }
+                quoted.append(backslashes * 2, '\\');
+                quoted += '"';
+                return quoted;
+            }
+
+            HANDLE m_process{nullptr};
+#elif defined(CONFORMANCE_CLI_POSIX_SPAWN)
+            pid_t m_pid{0};
+#endif
+            Clock::time_point m_start;
+            Seconds m_duration{};
+        };
+
+        std::string GetExecutablePath(const char* argv0)
+        {
+#if defined(_WIN32)
+            char path[MAX_PATH];
+            const DWORD length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+            if (length > 0 && length < MAX_PATH) {
+                return std::string(path, length);
+            }
+#endif
+            return argv0;
+        }
+
+        struct WorkerResult
+        {
+            std::string name;
+            std::string reportPath;
+            std::string logPath;
+            std::string durationsPath;
+            int exitCode{ExitCodeFailedToRun};
+            Seconds duration{};
+        };
+
+        /// Start one process per worker and wait for all of them, recording when each one exits.
+        void RunWorkers(const std::string& executable, const std::vector<std::vector<std::string>>& workerArgs,
+                        std::vector<WorkerResult>& results)
+        {
+            std::vector<std::unique_ptr<WorkerProcess>> processes;
+            size_t running = 0;
+            for (size_t i = 0; i < results.size(); ++i) {
+                processes.emplace_back(new WorkerProcess());
+                if (processes.back()->Start(executable, workerArgs[i], results[i].logPath)) {
+                    running++;
+                }
+                else {
+                    std::cerr << "Failed to start " << results[i].name << std::endl;
+                    processes.back().reset();
+                }
+            }
+
+            while (running > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                for (size_t i = 0; i < processes.size(); ++i) {
+                    if (processes[i] != nullptr && processes[i]->TryGetExitCode(results[i].exitCode)) {
+                        results[i].duration = processes[i]->GetDuration();
+                        processes[i].reset();
+                        running--;
+                    }
+                }
+            }
+        }
+
+        bool ReadFile(const std::string& path, std::string& contents)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                return false;
+            }
+            std::ostringstream stream;
+            stream << file.rdbuf();
+            contents = stream.str();
+            return true;
+        }
+
+        /// Merge the ctsxml reports of each process into a single report with one testsuite element.
+        /// A process whose report cannot be parsed is marked as having failed to run.
+        bool MergeReports(std::vector<WorkerResult>& results, const std::string& mergedPath, Seconds wallClock,
+                          MergedReportTotals& totals)
+        {
+            std::vector<XmlElement> reports;
+            bool allRead = true;
+            for (WorkerResult& result : results) {
+                std::string report;
+                std::string error;
+                XmlElement root;
+                if (!ReadFile(result.reportPath, report)) {
+                    error = "the file could not be read";
+                }
+                else if (ParseXml(report, root, error) && (root.name != "testsuites" || root.FindChild("testsuite") == nullptr)) {
+                    error = "it is not a ctsxml report";
+                }
+                if (!error.empty()) {
+                    std::cerr << result.name << " did not write a complete report to " << result.reportPath << ": " << error
+                              << std::endl;
+                    result.exitCode = ExitCodeFailedToRun;
+                    allRead = false;
+                    continue;
+                }
+                reports.push_back(std::move(root));
+            }
+
+            std::ofstream merged(mergedPath, std::ios::binary);
+            merged << WriteXml(MergeReportDocuments(reports, wallClock.count(), totals));
+            if (!merged) {
+                std::cerr << "Failed to write " << mergedPath << std::endl;
+                return false;
+            }
+            return allRead;
+        }
+
+        /// Overlay the durations recorded by each process onto the test durations file.
+        bool MergeTestDurations(const std::vector<WorkerResult>& results, const std::string& durationsPath)
+        {
+            bool succeeded = true;
+            for (const WorkerResult& result : results) {
+                TestDurationDatabase durations;
+                if (!durations.Load(result.durationsPath)) {
+                    std::cerr << "Failed to read " << result.durationsPath << std::endl;
+                    succeeded = false;
+                    continue;
+                }
+                if (!durations.empty() && !durations.MergeInto(durationsPath)) {
+                    std::cerr << "Failed to write " << durationsPath << std::endl;
+                    succeeded = false;
+                    continue;
+                }
+                std::remove(result.durationsPath.c_str());
+            }
+            return succeeded;
+        }
+    }  // namespace
+
+    bool ParseShardedRunSettings(int argc, const char* const* argv, ShardedRunSettings& settings, std::string& error)
+    {
+        settings = ShardedRunSettings{};
+        std::string reporter;
+        for (int i = 1; i < argc && error.empty(); ++i) {
+            std::string value;
+            if (MatchOption(argc, argv, i, nullptr, "--shards", value, &error)) {
+                settings.shardCount = (uint32_t)std::strtoul(value.c_str(), nullptr, 10);
+                if (settings.shardCount == 0 && error.empty()) {
+                    error = "--shards requires a positive number of worker processes";
+                }
+            }
+            else if (MatchOption(argc, argv, i, "-r", "--reporter", value, nullptr)) {
+                reporter = value;
+            }
+            else if (MatchOption(argc, argv, i, "-o", "--out", value, nullptr)) {
+                settings.reportPath = value;
+            }
+            else {
+                settings.args.push_back(argv[i]);
+            }
+        }
+        if (!error.empty() || settings.shardCount == 0) {
+            return error.empty();
+        }
+
+        // Accept the forms used in the documentation: "-r ctsxml -o file" and "--reporter ctsxml::out=file",
+        // with either of the CTS reporters.
+        const std::string outKey = "::out=";
+        settings.reporterName = reporter.substr(0, reporter.find("::"));
+        if (settings.reporterName != "ctsxml" && settings.reporterName != "ctsxml-streaming") {
+            error = "--shards requires --reporter ctsxml::out=<file> or --reporter ctsxml-streaming::out=<file>";
+            return false;
+        }
+        const size_t outPos = reporter.find(outKey);
+        if (outPos != std::string::npos) {
+            const size_t pathStart = outPos + outKey.size();
+            const size_t pathEnd = reporter.find("::", pathStart);
+            settings.reportPath = reporter.substr(pathStart, pathEnd == std::string::npos ? std::string::npos : pathEnd - pathStart);
+        }
+        if (settings.reportPath.empty()) {
+            error = "--shards requires a report file: pass --reporter ctsxml::out=<file>";
+            return false;
+        }
+        for (const std::string& arg : settings.args) {
+            if (arg.compare(0, 7, "--shard") == 0 || arg.compare(0, 23, "--exclusiveSessionTests") == 0 ||
+                arg.compare(0, 21, "--testDurationsOutput") == 0) {
+                error = arg + " cannot be combined with --shards";
+                return false;
+            }
+        }
+        // --testDurations stays in the arguments: every worker reads it to assign the same tests to the same shards.
+        const std::string durationsPrefix = "--testDurations=";
+        for (size_t i = 0; i < settings.args.size(); ++i) {
+            const std::string& arg = settings.args[i];
+            if (arg == "--testDurations" && i + 1 < settings.args.size()) {
+                settings.testDurationsPath = settings.args[i + 1];
+            }
+            else if (arg.compare(0, durationsPrefix.size(), durationsPrefix) == 0) {
+                settings.testDurationsPath = arg.substr(durationsPrefix.size());
+            }
+        }
+        return true;
+    }
+
+    int RunSharded(const char* argv0, const ShardedRunSettings& settings)
+    {
+        const std::string executable = GetExecutablePath(argv0);
+        const Clock::time_point start = Clock::now();
+
+        // Parallel pass: Catch2 shards what remains after the library drops the exclusive session tests.
+        std::vector<WorkerResult> results(settings.shardCount);
+        std::vector<std::vector<std::string>> workerArgs(settings.shardCount);
+        for (uint32_t i = 0; i < settings.shardCount; ++i) {
+            WorkerResult& result = results[i];
+            result.name = "Worker " + std::to_string(i);
+            result.reportPath = settings.reportPath + ".worker" + std::to_string(i) + ".xml";
+            result.logPath = settings.reportPath + ".worker" + std::to_string(i) + ".log";
+
+            workerArgs[i] = settings.args;
+            const std::string shardArgs[] = {"--exclusiveSessionTests",
+                                              "exclude",
+                                              "--shard-count",
+                                              std::to_string(settings.shardCount),
+                                              "--shard-index",
+                                              std::to_string(i),
+                                              "--allow-running-no-tests",
+                                              "--reporter",
+                                              settings.reporterName + "::out=" + result.reportPath};
+            workerArgs[i].insert(workerArgs[i].end(), std::begin(shardArgs), std::end(shardArgs));
+            if (!settings.testDurationsPath.empty()) {
+                result.durationsPath = settings.reportPath + ".worker" + std::to_string(i) + ".durations";
+                workerArgs[i].push_back("--testDurationsOutput");
+                workerArgs[i].push_back(result.durationsPath);
+            }
+        }
+        std::cout << "Running tests in " << settings.shardCount << " worker processes, logging to " << settings.reportPath
+                  << ".worker<N>.log" << std::endl;
+        RunWorkers(executable, workerArgs, results);
+
+        // Exclusive pass: one process with the console, since these tests may be interactive.
+        std::vector<WorkerResult> exclusiveResult(1);
+        exclusiveResult[0].name = "Exclusive session tests";
+        exclusiveResult[0].reportPath = settings.reportPath + ".exclusive.xml";
+        std::vector<std::vector<std::string>> exclusiveArgs(1, settings.args);
+        const std::string onlyArgs[] = {"--exclusiveSessionTests", "only", "--allow-running-no-tests", "--reporter",
+                                        settings.reporterName + "::out=" + exclusiveResult[0].reportPath};
+        exclusiveArgs[0].insert(exclusiveArgs[0].end(), std::begin(onlyArgs), std::end(onlyArgs));
+        if (!settings.testDurationsPath.empty()) {
+            exclusiveResult[0].durationsPath = settings.reportPath + ".exclusive.durations";
+            exclusiveArgs[0].push_back("--testDurationsOutput");
+            exclusiveArgs[0].push_back(exclusiveResult[0].durationsPath);
+        }
+        std::cout << "Running exclusive session tests" << std::endl;
+        RunWorkers(executable, exclusiveArgs, exclusiveResult);
+        results.push_back(exclusiveResult[0]);
+
+        const Seconds wallClock = Clock::now() - start;
+
+        MergedReportTotals totals;
+        const bool merged = MergeReports(results, settings.reportPath, wallClock, totals);
+        if (!settings.testDurationsPath.empty()) {
+            // Durations only inform later runs, so failing to record them does not fail this one.
+            (void)MergeTestDurations(results, settings.testDurationsPath);
+        }
+
+        Seconds processTime{};
+        int exitCode = merged ? 0 : ExitCodeFailedToRun;
+        std::ostringstream summary;
+        summary.precision(1);
+        summary << std::fixed;
+        for (const WorkerResult& result : results) {
+            summary << "   " << result.name << ": " << result.duration.count() << " s, exit code " << result.exitCode << "\n";
+            processTime += result.duration;
+            if (result.exitCode == ExitCodeTestsFailed) {
+                exitCode = exitCode == 0 ? ExitCodeTestsFailed : exitCode;
+            }
+            else if (result.exitCode != 0) {
+                exitCode = ExitCodeFailedToRun;
+            }
+        }
+        summary << "Total process time: " << processTime.count() << " s\n";
+        summary << "Wall clock time: " << wallClock.count() << " s\n";
+        // No serial run is measured: the sum of the process times stands in for one. It overestimates the serial time by
+        // the startup of the extra processes, and underestimates it when workers slow each other down.
+        summary.precision(2);
+        summary << "Estimated speedup (total process time / wall clock time): "
+                << (wallClock.count() > 0 ? processTime.count() / wallClock.count() : 1.0) << "x\n";
+
+        std::cout << "*********************************************\n"
+                     "Conformance Report (sharded run)\n"
+                     "*********************************************\n"
+                  << summary.str() << "Test Success Count: " << totals.testSuccessCount << "\n"
+                  << "Test Failure Count: " << totals.testFailureCount << "\n"
+                  << "Merged report: " << settings.reportPath << std::endl;
+        return exitCode;
+    }
+}  // namespace Conformance
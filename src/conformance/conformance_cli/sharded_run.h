@@ -0,0 +1,42 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    /// Settings for running the test suite across several conformance_cli worker processes.
+    struct ShardedRunSettings
+    {
+        /// Number of worker processes sharing the tests that do not need exclusive use of a session.
+        /// 0 if --shards was not passed.
+        uint32_t shardCount{0};
+
+        /// The reporter each process writes its report with: ctsxml or ctsxml-streaming.
+        std::string reporterName;
+
+        /// Path of the merged ctsxml report. Worker reports and logs are written next to it.
+        std::string reportPath;
+
+        /// The remaining command line arguments, without --shards and the reporter output options.
+        std::vector<std::string> args;
+
+        /// The --testDurations file, if any. Each worker records its durations separately and they are merged into this file.
+        std::string testDurationsPath;
+    };
+
+    /// Extract --shards and the ctsxml output path from the command line.
+    /// Returns false and sets @p error if the command line cannot be used for a sharded run.
+    bool ParseShardedRunSettings(int argc, const char* const* argv, ShardedRunSettings& settings, std::string& error);
+
+    /// Run the tests that do not need exclusive use of a session in settings.shardCount worker processes,
+    /// then the exclusive session tests in one more process by themselves.
+    /// Merges the ctsxml reports of all processes into settings.reportPath and prints an estimate of the wall clock speedup.
+    /// Returns a conformance_cli exit code: 0 if all tests passed, 1 if some failed, 2 if a process failed to run.
+    int RunSharded(const char* argv0, const ShardedRunSettings& settings);
+}  // namespace Conformance
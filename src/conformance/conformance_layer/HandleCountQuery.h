@@ -0,0 +1,16 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+/// Not an OpenXR function: the conformance layer returns it from xrGetInstanceProcAddr so that the conformance tests
+/// can watch the handles an instance has open, e.g. to detect leaks over a long run.
+/// Without the layer, xrGetInstanceProcAddr fails for this name.
+#define XRC_GET_CONFORMANCE_LAYER_HANDLE_COUNT_FUNCTION_NAME "xrcGetConformanceLayerHandleCount"
+
+/// Counts the open handles of @p objectType belonging to @p instance, including @p instance itself.
+typedef XrResult(XRAPI_PTR* PFN_xrcGetConformanceLayerHandleCount)(XrInstance instance, XrObjectType objectType,
+                                                                   uint32_t* handleCount);
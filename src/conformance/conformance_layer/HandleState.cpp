@@ -100,3 +100,28 @@ HandleState* GetHandleState(HandleStateKey key)
     }
     return it->second.get();
 }
+
+namespace
+{
+    uint32_t CountHandleStatesInternal(const HandleState& handleState, XrObjectType type)
+    {
+        uint32_t count = handleState.type == type ? 1 : 0;
+        std::unique_lock<std::recursive_mutex> lock(handleState.childrenMutex);
+        for (const HandleState* child : handleState.children) {
+            count += CountHandleStatesInternal(*child, type);
+        }
+        return count;
+    }
+}  // namespace
+
+uint32_t CountHandleStates(HandleStateKey root, XrObjectType type)
+{
+    // Holding the map lock keeps handles from being unregistered during the walk.
+    std::unique_lock<std::mutex> lock(g_handleStatesMutex);
+    auto it = g_handleStates.find(root);
+    if (it == g_handleStates.end()) {
+        throw HandleNotFoundException(std::string("Encountered unknown ") + to_string(root.second) + " handle with value " +
+                                      std::to_string(root.first));
+    }
+    return CountHandleStatesInternal(*it->second, type);
+}
@@ -131,3 +131,7 @@ void RegisterHandleState(std::unique_ptr<HandleState> handleState);
 /// Retrieve common handle state based on a handle and object type enum.
 /// Throws if not found.
 HandleState* GetHandleState(HandleStateKey key);
+
+/// Count the handles of the given object type in the tree of handles rooted at @p root, including @p root.
+/// Throws if @p root is not found.
+uint32_t CountHandleStates(HandleStateKey root, XrObjectType type);
@@ -16,11 +16,44 @@
 
 #include "Common.h"
 #include "ConformanceHooks.h"
+#include "HandleCountQuery.h"
 #include "HandleState.h"
 #include "gen_dispatch.h"
 
+#include <cstring>
+
 namespace
 {
+    XRAPI_ATTR XrResult XRAPI_CALL ConformanceLayer_xrcGetConformanceLayerHandleCount(XrInstance instance, XrObjectType objectType,
+                                                                                     uint32_t* handleCount)
+    {
+        if (handleCount == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        try {
+            *handleCount = CountHandleStates({HandleToInt(instance), XR_OBJECT_TYPE_INSTANCE}, objectType);
+            return XR_SUCCESS;
+        }
+        catch (const HandleNotFoundException&) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        catch (...) {
+            return XR_ERROR_RUNTIME_FAILURE;
+        }
+    }
+
+    /// Adds the layer's own queries to the generated xrGetInstanceProcAddr.
+    XRAPI_ATTR XrResult XRAPI_CALL ConformanceLayer_GetInstanceProcAddr(XrInstance instance, const char* name,
+                                                                        PFN_xrVoidFunction* function)
+    {
+        if (instance != XR_NULL_HANDLE && name != nullptr && function != nullptr &&
+            strcmp(name, XRC_GET_CONFORMANCE_LAYER_HANDLE_COUNT_FUNCTION_NAME) == 0) {
+            *function = reinterpret_cast<PFN_xrVoidFunction>(ConformanceLayer_xrcGetConformanceLayerHandleCount);
+            return XR_SUCCESS;
+        }
+        return ConformanceLayer_xrGetInstanceProcAddr(instance, name, function);
+    }
+
     XRAPI_ATTR XrResult XRAPI_CALL ConformanceLayer_RegisterInstance(const XrInstanceCreateInfo* createInfo,
                                                                      const XrApiLayerCreateInfo* apiLayerInfo, XrInstance* instance)
     {
@@ -102,7 +135,7 @@ extern "C" LAYER_EXPORT XRAPI_ATTR XrResult XRAPI_CALL xrNegotiateLoaderApiLayer
 
     apiLayerRequest->layerInterfaceVersion = XR_CURRENT_LOADER_API_LAYER_VERSION;
     apiLayerRequest->layerApiVersion = XR_CURRENT_API_VERSION;
-    apiLayerRequest->getInstanceProcAddr = ConformanceLayer_xrGetInstanceProcAddr;
+    apiLayerRequest->getInstanceProcAddr = ConformanceLayer_GetInstanceProcAddr;
     apiLayerRequest->createApiLayerInstance = ConformanceLayer_RegisterInstance;
 
     return XR_SUCCESS;
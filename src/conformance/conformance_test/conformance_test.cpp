@@ -23,6 +23,7 @@
 #include "graphics_plugin.h"
 #include "platform_utils.hpp"  // for OPENXR_API_LAYER_PATH_ENV_VAR
 #include "report.h"
+#include "test_durations.h"
 #include "utilities/git_revision.h"
 #include "utilities/utils.h"
 
@@ -32,6 +33,7 @@
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_case_info.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/interfaces/catch_interfaces_testcase.hpp>
 #include <catch2/internal/catch_clara.hpp>  // for customizing arg parsing
 #include <catch2/reporters/catch_reporter_event_listener.hpp>
 #include <catch2/reporters/catch_reporter_registrars.hpp>
@@ -43,8 +45,10 @@
 #include <cstddef>
 #include <string>
 #include <cstring>
+#include <sstream>
 #include <streambuf>
 #include <algorithm>
+#include <vector>
 
 using namespace Conformance;
 
@@ -379,6 +383,74 @@ namespace
             return ParserResult::ok(ParseResultType::Matched);
         };
 
+        /// Handle exclusive session tests arg
+        auto const parseExclusiveSessionTests = [&](std::string const& arg) {
+            GlobalData& globalData = GetGlobalData();
+            if (striequal(arg.c_str(), "include"))
+                globalData.options.exclusiveSessionTests = "include";
+            else if (striequal(arg.c_str(), "exclude"))
+                globalData.options.exclusiveSessionTests = "exclude";
+            else if (striequal(arg.c_str(), "only"))
+                globalData.options.exclusiveSessionTests = "only";
+            else {
+                ReportConsoleOnlyF("invalid arg: %s", arg.c_str());
+                return ParserResult::runtimeError("invalid exclusive session tests mode '" + arg + "' passed on command line");
+            }
+            return ParserResult::ok(ParseResultType::Matched);
+        };
+
+        /// Handle duration regression threshold arg
+        auto const parseDurationRegressionThreshold = [&](std::string const& arg) {
+            GlobalData& globalData = GetGlobalData();
+            char* end = nullptr;
+            const double percent = std::strtod(arg.c_str(), &end);
+            if (end == arg.c_str() || percent < 0) {
+                ReportConsoleOnlyF("invalid arg: %s", arg.c_str());
+                return ParserResult::runtimeError("invalid duration regression threshold '" + arg + "' passed on command line");
+            }
+
+            globalData.options.durationRegressionThresholdPercent = percent;
+            return ParserResult::ok(ParseResultType::Matched);
+        };
+
+        /// Handle stress handle sharing arg
+        auto const parseStressHandleSharing = [&](std::string const& arg) {
+            GlobalData& globalData = GetGlobalData();
+            if (striequal(arg.c_str(), "shared"))
+                globalData.options.stressHandleSharing = "shared";
+            else if (striequal(arg.c_str(), "perThread"))
+                globalData.options.stressHandleSharing = "perThread";
+            else {
+                ReportConsoleOnlyF("invalid arg: %s", arg.c_str());
+                return ParserResult::runtimeError("invalid stress handle sharing '" + arg + "' passed on command line");
+            }
+            return ParserResult::ok(ParseResultType::Matched);
+        };
+
+        /// Handle action scaling counts arg: a comma-separated list of action counts
+        auto const parseActionScalingCounts = [&](std::string const& arg) {
+            GlobalData& globalData = GetGlobalData();
+            std::vector<uint32_t> counts;
+            std::istringstream iss(arg);
+            std::string item;
+            while (std::getline(iss, item, ',')) {
+                char* end = nullptr;
+                const unsigned long count = std::strtoul(item.c_str(), &end, 10);
+                if (end == item.c_str() || *end != '\0' || count == 0) {
+                    ReportConsoleOnlyF("invalid arg: %s", arg.c_str());
+                    return ParserResult::runtimeError("invalid action scaling counts '" + arg + "' passed on command line");
+                }
+                counts.push_back((uint32_t)count);
+            }
+            if (counts.empty()) {
+                ReportConsoleOnlyF("invalid arg: %s", arg.c_str());
+                return ParserResult::runtimeError("invalid action scaling counts '" + arg + "' passed on command line");
+            }
+
+            globalData.options.actionScalingCounts = counts;
+            return ParserResult::ok(ParseResultType::Matched);
+        };
+
         // NOTE: End of line comments are to encourage clang-format to work the way we want it to for this mini embedded DSL.
         // Clara requires that the "short" args be a single letter - we use capital letters here to avoid colliding with Catch2-provided
         // options.
@@ -464,6 +536,102 @@ namespace
                   ["--autoSkipTimeout"]("Automatic Skip Timeout (in milliseconds) for tests which support it")
                       .optional()
 
+            | Opt(parseExclusiveSessionTests, "include|exclude|only")  // tests needing a running session to themselves
+                  ["--exclusiveSessionTests"]                          //
+              ("Whether to run the tests that need exclusive use of a session. Default is include.")
+                  .optional()
+
+            | Opt(options.testDurations, "file")  // duration database
+                  ["--testDurations"]             //
+              ("Record test durations in this file, and use earlier ones to predict the run time, balance shards and flag "
+               "slower tests.")
+                  .optional()
+
+            | Opt(options.testDurationsOutput, "file")  // duration database output
+                  ["--testDurationsOutput"]             //
+              ("Write the durations of this run to this file instead of the --testDurations file.")
+                  .optional()
+
+            | Opt(parseDurationRegressionThreshold, "percent")  // duration regression threshold
+                  ["--durationRegressionThreshold"]            //
+              ("Flag tests that took this much longer than in the --testDurations file. Default is 50.")
+                  .optional()
+
+            | Opt(options.framePacingCsv, "file")  // frame pacing time series
+                  ["--framePacingCsv"]             //
+              ("Write the timestamps of each frame measured by the timed frame submission test to this CSV file.")
+                  .optional()
+
+            | Opt(options.soakDurationSeconds, "seconds")  // soak test duration
+                  ["--soakDuration"]                       //
+              ("How long the [soak] test runs its frame loop. Default is 600 seconds.")
+                  .optional()
+
+            | Opt(options.soakSampleFrames, "frames")  // soak test sampling interval
+                  ["--soakSampleFrames"]               //
+              ("The [soak] test samples memory, handles and latency every this many frames. Default is 900.")
+                  .optional()
+
+            | Opt(options.soakCsv, "file")  // soak test time series
+                  ["--soakCsv"]             //
+              ("Write the samples of the [soak] test to this CSV file.")
+                  .optional()
+
+            | Opt(options.instancePool)  // share an instance between pooled test cases
+                  ["--instancePool"]     //
+              ("Test cases tagged [pooled_instance] share one instance instead of each creating their own.")
+                  .optional()
+
+            | Opt(options.swapchainProbeThreads, "count")  // concurrent swapchain creation
+                  ["--swapchainProbeThreads"]              //
+              ("How many threads Swapchains creates swapchains from. Default is 4.")
+                  .optional()
+
+            | Opt(parseActionScalingCounts, "counts")  // action state scaling benchmark
+                  ["--actionScalingCounts"]            //
+              ("Comma-separated numbers of actions the [action_scaling] benchmark measures. Default is 1,10,50,100,200.")
+                  .optional()
+
+            | Opt(options.actionScalingActionSets, "count")  // action state scaling benchmark
+                  ["--actionScalingActionSets"]              //
+              ("How many action sets the [action_scaling] benchmark spreads its actions over. Default is 1.")
+                  .optional()
+
+            | Opt(options.actionScalingSubactionPaths, "count")  // action state scaling benchmark
+                  ["--actionScalingSubactionPaths"]              //
+              ("How many subaction paths, 0 to 2, each action of the [action_scaling] benchmark has. Default is 2.")
+                  .optional()
+
+            | Opt(options.actionScalingFrames, "frames")  // action state scaling benchmark
+                  ["--actionScalingFrames"]               //
+              ("How many frames the [action_scaling] benchmark measures for each number of actions. Default is 300.")
+                  .optional()
+
+            | Opt(options.stressThreads, "count")  // multithreading stress test
+                  ["--stressThreads"]              //
+              ("How many threads the [stress] test calls the runtime from. Default is 4.")
+                  .optional()
+
+            | Opt(options.stressDurationSeconds, "seconds")  // multithreading stress test
+                  ["--stressDuration"]                       //
+              ("How long the [stress] test runs. Default is 10 seconds.")
+                  .optional()
+
+            | Opt(options.stressCallMix, "mix")  // multithreading stress test
+                  ["--stressCallMix"]            //
+              ("The entry points the [stress] test calls and their weights, such as xrLocateSpace=4,xrSyncActions=1.")
+                  .optional()
+
+            | Opt(parseStressHandleSharing, "shared|perThread")  // multithreading stress test
+                  ["--stressHandleSharing"]                      //
+              ("Whether the [stress] test threads locate the same spaces or spaces of their own. Default is shared.")
+                  .optional()
+
+            | Opt(options.stressCsv, "file")  // multithreading stress test histograms
+                  ["--stressCsv"]             //
+              ("Write the latency histogram of each [stress] test thread and entry point to this CSV file.")
+                  .optional()
+
             //
             | Opt([&](bool enabled) { options.debugMode = enabled; })  //
                   ["-D"]["--debugMode"]                                //
@@ -472,6 +640,188 @@ namespace
 
         return cli;
     }
+
+    /// Tests carrying one of these tags run a session that must not compete with another process for focus or input.
+    /// Other tests (instance-level queries, path and string conversions, enumerations) may run concurrently.
+    bool IsExclusiveSessionTest(const Catch::TestCaseInfo& testCaseInfo)
+    {
+        static const char* const exclusiveTags[] = {"exclusive_session", "interactive", "actions", "composition", "scenario"};
+        for (const Catch::Tag& tag : testCaseInfo.tags) {
+            for (const char* exclusiveTag : exclusiveTags) {
+                if (tag == Catch::Tag(exclusiveTag)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// Escape characters that have a meaning in a Catch2 test spec, so the test name matches only itself.
+    std::string EscapeTestSpecName(const std::string& testName)
+    {
+        std::string escaped;
+        for (char c : testName) {
+            if (c == '\\' || c == ',' || c == '[' || c == ']' || c == '"') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    /// The test cases selected by the test specs, across all shards.
+    std::vector<Catch::TestCaseHandle> GetSelectedTestCasesOfAllShards(Catch::Session& catchSession)
+    {
+        Catch::ConfigData configData = catchSession.configData();
+        configData.shardCount = 1;
+        configData.shardIndex = 0;
+        Catch::Config unshardedConfig(configData);
+        return Catch::filterTests(Catch::getAllTestCasesSorted(unshardedConfig), unshardedConfig.testSpec(), unshardedConfig);
+    }
+
+    /// Replace the test specs with the names of exactly these test cases.
+    void SelectTestCasesByName(Catch::Session& catchSession, const std::vector<const Catch::TestCaseInfo*>& testCases)
+    {
+        std::string testSpec;
+        for (const Catch::TestCaseInfo* testCase : testCases) {
+            if (!testSpec.empty()) {
+                testSpec += ',';
+            }
+            testSpec += EscapeTestSpecName(testCase->name);
+        }
+        if (testSpec.empty()) {
+            testSpec = "~*";  // Matches nothing.
+        }
+
+        Catch::ConfigData configData = catchSession.configData();
+        configData.testsOrTags = {testSpec};
+        catchSession.useConfigData(configData);
+    }
+
+    /// Narrow the test specs given on the command line to the exclusive session tests or to the other tests.
+    /// Catch2 ANDs separate spec arguments only into the last comma-separated filter, so resolve the specs here
+    /// and replace them with the names of the matching test cases.
+    void ApplyExclusiveSessionTestsOption(Catch::Session& catchSession)
+    {
+        const std::string& mode = GetGlobalData().options.exclusiveSessionTests;
+        if (mode == "include") {
+            return;
+        }
+        const bool wantExclusive = mode == "only";
+
+        // Catch2 applies --shard-count and --shard-index to the narrowed selection when running.
+        std::vector<const Catch::TestCaseInfo*> testCases;
+        for (const Catch::TestCaseHandle& testCase : GetSelectedTestCasesOfAllShards(catchSession)) {
+            if (IsExclusiveSessionTest(testCase.getTestCaseInfo()) == wantExclusive) {
+                testCases.push_back(&testCase.getTestCaseInfo());
+            }
+        }
+        SelectTestCasesByName(catchSession, testCases);
+    }
+
+    /// Durations recorded with --testDurations: those of earlier runs, and those of this run.
+    struct TestDurationState
+    {
+        bool enabled{false};
+        /// Runtime and graphics plugin of this run.
+        std::string key;
+        TestDurationDatabase previous;
+        TestDurationDatabase current;
+    };
+    TestDurationState g_testDurations;
+
+    /// Changes in duration smaller than this are timing noise rather than regressions.
+    constexpr double MinimumDurationRegressionSeconds = 0.25;
+
+    /// Load earlier durations for the runtime and graphics plugin now initialized.
+    void LoadTestDurations()
+    {
+        GlobalData& globalData = GetGlobalData();
+        if (globalData.options.testDurations.empty()) {
+            return;
+        }
+        const XrInstanceProperties& instanceProperties = globalData.GetInstanceProperties();
+        g_testDurations.enabled = true;
+        g_testDurations.key =
+            TestDurationDatabase::MakeKey(instanceProperties.runtimeName, instanceProperties.runtimeVersion, globalData.options.graphicsPlugin);
+        if (!g_testDurations.previous.Load(globalData.options.testDurations)) {
+            ReportConsoleOnlyF("Ignoring test durations in %s: the file could not be parsed", globalData.options.testDurations.c_str());
+        }
+    }
+
+    /// With recorded durations, replace Catch2's contiguous sharding: assign the selected test cases to shards longest first,
+    /// each to the shard with the least predicted duration, and run this shard's share.
+    void ApplyDurationAwareSharding(Catch::Session& catchSession)
+    {
+        const size_t shardCount = (size_t)catchSession.configData().shardCount;
+        const size_t shardIndex = (size_t)catchSession.configData().shardIndex;
+        if (shardCount <= 1 || g_testDurations.previous.empty()) {
+            return;
+        }
+
+        const std::vector<Catch::TestCaseHandle> selected = GetSelectedTestCasesOfAllShards(catchSession);
+        std::vector<double> durations(selected.size(), -1.0);
+        for (size_t i = 0; i < selected.size(); ++i) {
+            g_testDurations.previous.TryGetDuration(g_testDurations.key, selected[i].getTestCaseInfo().name, durations[i]);
+        }
+        const std::vector<size_t> shards = AssignShardsLongestFirst(durations, shardCount);
+
+        std::vector<const Catch::TestCaseInfo*> testCases;
+        for (size_t i = 0; i < selected.size(); ++i) {
+            if (shards[i] == shardIndex) {
+                testCases.push_back(&selected[i].getTestCaseInfo());
+            }
+        }
+        SelectTestCasesByName(catchSession, testCases);
+
+        Catch::ConfigData configData = catchSession.configData();
+        configData.shardCount = 1;
+        configData.shardIndex = 0;
+        catchSession.useConfigData(configData);
+    }
+
+    void ReportPredictedDuration(Catch::Session& catchSession)
+    {
+        const Catch::Config& config = catchSession.config();
+        const std::vector<Catch::TestCaseHandle> selected =
+            Catch::filterTests(Catch::getAllTestCasesSorted(config), config.testSpec(), config);
+        double predictedSeconds = 0;
+        size_t unknownCount = 0;
+        for (const Catch::TestCaseHandle& testCase : selected) {
+            double seconds;
+            if (g_testDurations.previous.TryGetDuration(g_testDurations.key, testCase.getTestCaseInfo().name, seconds)) {
+                predictedSeconds += seconds;
+            }
+            else {
+                unknownCount++;
+            }
+        }
+        ReportConsoleOnlyF("Predicted duration: %.1f s for %d test cases, %d of which have no recorded duration\n", predictedSeconds,
+                           (int)selected.size(), (int)unknownCount);
+    }
+
+    /// Flag test cases and sections that got slower, then record the durations of this run.
+    void SaveTestDurations()
+    {
+        if (!g_testDurations.enabled) {
+            return;
+        }
+        const Options& options = GetGlobalData().options;
+        const std::vector<TestDurationRegression> regressions = g_testDurations.current.FindRegressions(
+            g_testDurations.previous, g_testDurations.key, options.durationRegressionThresholdPercent / 100.0,
+            MinimumDurationRegressionSeconds);
+        for (const TestDurationRegression& regression : regressions) {
+            ReportConsoleOnlyF("Duration regression: \"%s\" took %.2f s, previously %.2f s (+%.0f%%)", regression.path.c_str(),
+                               regression.currentSeconds, regression.previousSeconds,
+                               100.0 * (regression.currentSeconds / regression.previousSeconds - 1.0));
+        }
+
+        const std::string& path = options.testDurationsOutput.empty() ? options.testDurations : options.testDurationsOutput;
+        if (!g_testDurations.current.MergeInto(path)) {
+            ReportConsoleOnlyF("Failed to write test durations to %s", path.c_str());
+        }
+    }
+
     bool UpdateOptionsFromCommandLine(Catch::Session& catchSession, int argc, const char* const* argv)
     {
         auto& globalData = GetGlobalData();
@@ -492,6 +842,9 @@ namespace
         globalData.leftHandUnderTest = globalData.options.leftHandEnabled;
         globalData.rightHandUnderTest = globalData.options.rightHandEnabled;
         globalData.conformanceReport.apiVersion = globalData.options.desiredApiVersionValue;
+        if (result == 0) {
+            ApplyExclusiveSessionTestsOption(catchSession);
+        }
 
         if (!(catchSession.configData().listTests || catchSession.configData().listTags || catchSession.configData().listListeners ||
               catchSession.configData().listReporters)) {
@@ -514,11 +867,28 @@ namespace
 
         using EventListenerBase::EventListenerBase;  // inherit constructor
 
+        void testCaseStarting(Catch::TestCaseInfo const& testInfo) override
+        {
+            Base::testCaseStarting(testInfo);
+
+            Conformance::GlobalData& globalData = Conformance::GetGlobalData();
+            globalData.BeginTestCase(testInfo.name, IsExclusiveSessionTest(testInfo));
+            bool pooled = false;
+            if (globalData.options.instancePool) {
+                for (const Catch::Tag& tag : testInfo.tags) {
+                    pooled = pooled || tag.original == Catch::StringRef(InstancePool::TagName);
+                }
+            }
+            globalData.instancePool.BeginTestCase(pooled);
+        }
+
         void testCaseEnded(Catch::TestCaseStats const& testCaseStats) override
         {
             Base::testCaseEnded(testCaseStats);
 
             Conformance::GlobalData& globalData = Conformance::GetGlobalData();
+            globalData.instancePool.EndTestCase();
+            globalData.BeginTestCase({}, true);
             globalData.conformanceReport.testSuccessCount += testCaseStats.totals.testCases.passed;
             globalData.conformanceReport.testFailureCount += testCaseStats.totals.testCases.failed;
         }
@@ -526,6 +896,7 @@ namespace
         void sectionStarting(Catch::SectionInfo const& sectionInfo) override
         {
             Base::sectionStarting(sectionInfo);
+            m_sectionPath.push_back(sectionInfo.name);
 
             // Track test progress by outputting the current test section.
             std::string indentStr(static_cast<long>(m_sectionIndent) * 2, ' ');
@@ -543,6 +914,15 @@ namespace
                     (indentStr + std::to_string(sectionStats.assertions.failed) + " assertion(s) failed\n").c_str());
             }
 
+            if (g_testDurations.enabled) {
+                std::string path;
+                for (const std::string& name : m_sectionPath) {
+                    path += (path.empty() ? "" : "/") + name;
+                }
+                g_testDurations.current.Add(g_testDurations.key, path, sectionStats.durationInSeconds);
+            }
+            m_sectionPath.pop_back();
+
             Base::sectionEnded(sectionStats);
             m_sectionIndent--;
         }
@@ -557,12 +937,37 @@ namespace
         {
             Conformance::GlobalData& globalData = Conformance::GetGlobalData();
             globalData.conformanceReport.totals = testRunStats.totals;
+
+            SaveTestDurations();
+
+            globalData.instancePool.Clear();
+            if (globalData.options.instancePool) {
+                const InstancePoolStatistics statistics = globalData.instancePool.GetStatistics();
+                ReportConsoleOnlyF("Instance pool: %u created, %u reused, %u discarded as not clean", statistics.created,
+                                   statistics.reused, statistics.discarded);
+            }
+            const PathCacheStatistics pathStatistics = globalData.pathCache.GetStatistics();
+            ReportConsoleOnlyF("Path cache: %llu path conversions saved, %llu made by the runtime",
+                               (unsigned long long)pathStatistics.savedCalls, (unsigned long long)pathStatistics.runtimeCalls);
+
+            auto graphicsPlugin = globalData.GetGraphicsPlugin();
+            if (graphicsPlugin) {
+                const ViewCullingStatistics culling = graphicsPlugin->GetViewCullingStatistics();
+                if (culling.drawn + culling.culled > 0) {
+                    ReportConsoleOnlyF("View culling: %llu drawables drawn, %llu culled, %llu views reused the previous culling",
+                                       (unsigned long long)culling.drawn, (unsigned long long)culling.culled,
+                                       (unsigned long long)culling.sharedPasses);
+                }
+            }
         }
 
         int m_sectionIndent{0};
+        /// Names of the test case (its root section) and the sections currently running.
+        std::vector<std::string> m_sectionPath;
     };
     CATCH_REGISTER_LISTENER(ConformanceTestListener)
     CATCH_REGISTER_REPORTER("ctsxml", Catch::CTSReporter)
+    CATCH_REGISTER_REPORTER("ctsxml-streaming", Catch::CTSStreamingReporter)
 
     // static Catch::Session catchSession;  // Only one Catch Session can ever be created.
     static std::shared_ptr<Catch::Session> catchSession;
@@ -641,6 +1046,7 @@ XrcResult XRAPI_CALL xrcRunConformanceTests(const ConformanceLaunchSettings* con
     CreateOrGetCatchSession().cli(Catch::makeCommandLineParser(CreateOrGetCatchSession().configData()));
 
     ResetGlobalData();
+    g_testDurations = TestDurationState{};
     g_conformanceLaunchSettings = conformanceLaunchSettings;
 
     XrcResult result = XRC_SUCCESS;
@@ -681,7 +1087,6 @@ XrcResult XRAPI_CALL xrcRunConformanceTests(const ConformanceLaunchSettings* con
             ReportConsoleOnlyF("Test failure: Command line arguments were invalid or insufficient.");
             return XRC_ERROR_COMMAND_LINE_INVALID;
         }
-        auto& catchConfig = CreateOrGetCatchSession().config();
         auto& catchConfigData = CreateOrGetCatchSession().configData();
         bool skipActuallyTesting =
             catchConfigData.listTests || catchConfigData.listTags || catchConfigData.listListeners || catchConfigData.listReporters;
@@ -690,8 +1095,17 @@ XrcResult XRAPI_CALL xrcRunConformanceTests(const ConformanceLaunchSettings* con
             initialized = GetGlobalData().Initialize();
             if (initialized) {
                 ReportTestEnvironment();
+
+                // Durations are recorded per runtime, which is only known once initialized.
+                LoadTestDurations();
+                if (g_testDurations.enabled) {
+                    ApplyDurationAwareSharding(CreateOrGetCatchSession());
+                    ReportPredictedDuration(CreateOrGetCatchSession());
+                }
             }
         }
+        // Only now, since applying the options above replaces the config.
+        auto& catchConfig = CreateOrGetCatchSession().config();
 
         if (CreateOrGetCatchSession().configData().verbosity == Catch::Verbosity::Quiet) {
             // If we only want the test names, "run()" will just print them,
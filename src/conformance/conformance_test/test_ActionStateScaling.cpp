@@ -0,0 +1,230 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "action_utils.h"
+#include "composition_utils.h"
+#include "conformance_framework.h"
+#include "conformance_utils.h"
+#include "frame_pacing.h"
+#include "report.h"
+#include "utilities/throw_helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <openxr/openxr.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// One xrGetActionState* call made each frame.
+        struct ActionStateQuery
+        {
+            XrAction action;
+            XrActionType actionType;
+            XrPath subactionPath;
+        };
+
+        /// Queries the state of every action and subaction path in @p queries, as an application polling all of its
+        /// actions each frame would. Returns how many were active.
+        uint32_t QueryActionStates(XrSession session, const std::vector<ActionStateQuery>& queries)
+        {
+            uint32_t activeCount = 0;
+            XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            XrActionStateBoolean booleanState{XR_TYPE_ACTION_STATE_BOOLEAN};
+            XrActionStateFloat floatState{XR_TYPE_ACTION_STATE_FLOAT};
+            XrActionStateVector2f vectorState{XR_TYPE_ACTION_STATE_VECTOR2F};
+            XrActionStatePose poseState{XR_TYPE_ACTION_STATE_POSE};
+            for (const ActionStateQuery& query : queries) {
+                getInfo.action = query.action;
+                getInfo.subactionPath = query.subactionPath;
+                switch (query.actionType) {
+                case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                    XRC_CHECK_THROW_XRCMD(xrGetActionStateBoolean(session, &getInfo, &booleanState));
+                    activeCount += booleanState.isActive;
+                    break;
+                case XR_ACTION_TYPE_FLOAT_INPUT:
+                    XRC_CHECK_THROW_XRCMD(xrGetActionStateFloat(session, &getInfo, &floatState));
+                    activeCount += floatState.isActive;
+                    break;
+                case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                    XRC_CHECK_THROW_XRCMD(xrGetActionStateVector2f(session, &getInfo, &vectorState));
+                    activeCount += vectorState.isActive;
+                    break;
+                default:
+                    XRC_CHECK_THROW_XRCMD(xrGetActionStatePose(session, &getInfo, &poseState));
+                    activeCount += poseState.isActive;
+                    break;
+                }
+            }
+            return activeCount;
+        }
+
+        /// Creates @p actionCount actions of mixed types over @p actionSetCount action sets in a new session, and measures
+        /// xrSyncActions and the state queries of all actions over @p frameCount frames.
+        ActionStateScalingResult MeasureActionStateScaling(uint32_t actionCount, uint32_t actionSetCount,
+                                                           uint32_t subactionPathCount, uint32_t frameCount)
+        {
+            CompositionHelper compositionHelper("Action state scaling");
+            const XrInstance instance = compositionHelper.GetInstance();
+            const XrSession session = compositionHelper.GetSession();
+            InteractionManager& interactionManager = compositionHelper.GetInteractionManager();
+            ActionLayerManager actionLayerManager(compositionHelper);
+
+            const std::vector<XrPath> handPaths{StringToPath(instance, "/user/hand/left"),
+                                                StringToPath(instance, "/user/hand/right")};
+            const std::vector<XrPath> subactionPaths(handPaths.begin(), handPaths.begin() + subactionPathCount);
+            // Actions with subaction paths may only be bound to those paths.
+            const std::vector<XrPath>& boundHandPaths = subactionPaths.empty() ? handPaths : subactionPaths;
+            std::vector<XrPath> selectPaths, gripPaths;
+            for (XrPath handPath : boundHandPaths) {
+                selectPaths.push_back(StringToPath(instance, PathToString(instance, handPath) + "/input/select/click"));
+                gripPaths.push_back(StringToPath(instance, PathToString(instance, handPath) + "/input/grip/pose"));
+            }
+
+            std::vector<XrActiveActionSet> activeActionSets;
+            for (uint32_t i = 0; i < actionSetCount; ++i) {
+                XrActionSetCreateInfo actionSetInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+                strcpy(actionSetInfo.actionSetName, ("scaling_set_" + std::to_string(i)).c_str());
+                strcpy(actionSetInfo.localizedActionSetName, ("Scaling set " + std::to_string(i)).c_str());
+                XrActionSet actionSet{XR_NULL_HANDLE};
+                XRC_CHECK_THROW_XRCMD(xrCreateActionSet(instance, &actionSetInfo, &actionSet));
+                interactionManager.AddActionSet(actionSet);
+                activeActionSets.push_back({actionSet, XR_NULL_PATH});
+            }
+
+            // The simple controller has no vector2f input, so those actions stay unbound and inactive,
+            // like the actions of an application that only some interaction profiles bind.
+            constexpr XrActionType ActionTypes[] = {XR_ACTION_TYPE_BOOLEAN_INPUT, XR_ACTION_TYPE_FLOAT_INPUT,
+                                                    XR_ACTION_TYPE_VECTOR2F_INPUT, XR_ACTION_TYPE_POSE_INPUT};
+            std::vector<ActionStateQuery> queries;
+            std::vector<XrActionSuggestedBinding> bindings;
+            for (uint32_t i = 0; i < actionCount; ++i) {
+                XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
+                actionInfo.actionType = ActionTypes[i % 4];
+                strcpy(actionInfo.actionName, ("action_" + std::to_string(i)).c_str());
+                strcpy(actionInfo.localizedActionName, ("Action " + std::to_string(i)).c_str());
+                actionInfo.countSubactionPaths = (uint32_t)subactionPaths.size();
+                actionInfo.subactionPaths = subactionPaths.data();
+                XrAction action{XR_NULL_HANDLE};
+                XRC_CHECK_THROW_XRCMD(xrCreateAction(activeActionSets[i % actionSetCount].actionSet, &actionInfo, &action));
+
+                queries.push_back({action, actionInfo.actionType, XR_NULL_PATH});
+                for (XrPath subactionPath : subactionPaths) {
+                    queries.push_back({action, actionInfo.actionType, subactionPath});
+                }
+                if (actionInfo.actionType == XR_ACTION_TYPE_POSE_INPUT) {
+                    for (XrPath gripPath : gripPaths) {
+                        bindings.push_back({action, gripPath});
+                    }
+                }
+                else if (actionInfo.actionType != XR_ACTION_TYPE_VECTOR2F_INPUT) {
+                    for (XrPath selectPath : selectPaths) {
+                        bindings.push_back({action, selectPath});
+                    }
+                }
+            }
+            interactionManager.AddActionBindings(StringToPath(instance, "/interaction_profiles/khr/simple_controller"), bindings);
+            interactionManager.AttachActionSets();
+            compositionHelper.BeginSession();
+
+            if (GetGlobalData().IsUsingConformanceAutomation()) {
+                auto xrSetInputDeviceActiveEXT =
+                    GetInstanceExtensionFunction<PFN_xrSetInputDeviceActiveEXT>(instance, "xrSetInputDeviceActiveEXT");
+                for (XrPath handPath : boundHandPaths) {
+                    XRC_CHECK_THROW_XRCMD(xrSetInputDeviceActiveEXT(
+                        session, StringToPath(instance, "/interaction_profiles/khr/simple_controller"), handPath, XR_TRUE));
+                }
+            }
+
+            XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+            syncInfo.countActiveActionSets = (uint32_t)activeActionSets.size();
+            syncInfo.activeActionSets = activeActionSets.data();
+            actionLayerManager.SyncActionsUntilFocusWithMessage(syncInfo);
+
+            // Buffers are allocated before the loop so that the measurement does not include growing them.
+            std::vector<std::chrono::nanoseconds> syncTimes, queryTimes;
+            syncTimes.reserve(frameCount);
+            queryTimes.reserve(frameCount);
+            uint32_t activeCount = 0;
+            for (uint32_t frame = 0; frame < frameCount; ++frame) {
+                actionLayerManager.IterateFrame();
+
+                const int64_t syncStart = FrameTimingNow();
+                XRC_CHECK_THROW_XRCMD(xrSyncActions(session, &syncInfo));
+                const int64_t queryStart = FrameTimingNow();
+                activeCount = QueryActionStates(session, queries);
+                const int64_t queryEnd = FrameTimingNow();
+
+                syncTimes.emplace_back(queryStart - syncStart);
+                queryTimes.emplace_back(queryEnd - queryStart);
+            }
+
+            ActionStateScalingResult result;
+            result.actionSetCount = actionSetCount;
+            result.actionCount = actionCount;
+            result.subactionPathCount = subactionPathCount;
+            result.queriesPerFrame = (uint32_t)queries.size();
+            result.frameCount = frameCount;
+            std::chrono::nanoseconds totalQueryTime{0};
+            for (std::chrono::nanoseconds queryTime : queryTimes) {
+                totalQueryTime += queryTime;
+            }
+            result.meanQueryTime = totalQueryTime / std::max<int64_t>((int64_t)frameCount * (int64_t)queries.size(), 1);
+            result.syncTime = ComputeDurationPercentiles(std::move(syncTimes));
+            result.queryTime = ComputeDurationPercentiles(std::move(queryTimes));
+
+            using us = std::chrono::duration<float, std::micro>;
+            ReportF("Action state scaling: %u actions in %u sets, %u queries/frame (%u active): "
+                    "xrSyncActions p50 %.1fus p95 %.1fus, queries p50 %.1fus p95 %.1fus, %.3fus per query",
+                    actionCount, actionSetCount, result.queriesPerFrame, activeCount,
+                    std::chrono::duration_cast<us>(result.syncTime.p50).count(),
+                    std::chrono::duration_cast<us>(result.syncTime.p95).count(),
+                    std::chrono::duration_cast<us>(result.queryTime.p50).count(),
+                    std::chrono::duration_cast<us>(result.queryTime.p95).count(),
+                    std::chrono::duration_cast<us>(result.meanQueryTime).count());
+            return result;
+        }
+    }  // namespace
+
+    // Measures how xrSyncActions and the xrGetActionState* calls scale with the number of actions an application polls
+    // every frame. Hidden, since it only reports latencies: select with [action_scaling] and configure with
+    // --actionScalingCounts, --actionScalingActionSets, --actionScalingSubactionPaths and --actionScalingFrames.
+    TEST_CASE("ActionStateScaling", "[action_scaling][benchmark][exclusive_session][.]")
+    {
+        GlobalData& globalData = GetGlobalData();
+        if (!globalData.IsUsingGraphicsPlugin()) {
+            // Nothing to measure - no graphics plugin means no frame loop
+            return;
+        }
+        const uint32_t actionSetCount = std::max(globalData.options.actionScalingActionSets, 1u);
+        const uint32_t subactionPathCount = std::min(globalData.options.actionScalingSubactionPaths, 2u);
+        const uint32_t frameCount = std::max(globalData.options.actionScalingFrames, 1u);
+
+        std::vector<ActionStateScalingResult>& results = globalData.conformanceReport.actionStateScaling;
+        results.clear();
+        for (uint32_t actionCount : globalData.options.actionScalingCounts) {
+            INFO(actionCount << " actions");
+            results.push_back(
+                MeasureActionStateScaling(actionCount, std::min(actionSetCount, actionCount), subactionPathCount, frameCount));
+        }
+    }
+}  // namespace Conformance
@@ -0,0 +1,216 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "catch_reporter_cts.h"
+
+#include <catch2/catch_config.hpp>
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/interfaces/catch_interfaces_config.hpp>
+#include <catch2/interfaces/catch_interfaces_reporter.hpp>
+#include <catch2/internal/catch_istream.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Removes the file when the test ends, however it ends.
+        struct ScopedFile
+        {
+            explicit ScopedFile(std::string p) : path(std::move(p))
+            {
+                std::remove(path.c_str());
+            }
+            ~ScopedFile()
+            {
+                std::remove(path.c_str());
+            }
+            std::string path;
+        };
+
+        std::string ReadFile(const std::string& path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            return contents.str();
+        }
+
+        /// Returns an empty string if @p document has a single root element and every element is closed in order,
+        /// otherwise a description of the first problem. Enough to check the output of Catch::XmlWriter, not any XML.
+        std::string CheckElementsNested(const std::string& document)
+        {
+            std::vector<std::string> open;
+            size_t roots = 0;
+            size_t position = 0;
+            while ((position = document.find('<', position)) != std::string::npos) {
+                if (document.compare(position, 2, "<?") == 0 || document.compare(position, 4, "<!--") == 0) {
+                    const char* const terminator = document[position + 1] == '?' ? "?>" : "-->";
+                    position = document.find(terminator, position);
+                    if (position == std::string::npos) {
+                        return "Unterminated declaration or comment";
+                    }
+                    continue;
+                }
+
+                // Find the end of the tag, skipping over attribute values.
+                size_t end = position + 1;
+                char quote = 0;
+                for (; end < document.size(); ++end) {
+                    const char c = document[end];
+                    if (quote != 0) {
+                        quote = c == quote ? 0 : quote;
+                    }
+                    else if (c == '"' || c == '\'') {
+                        quote = c;
+                    }
+                    else if (c == '>') {
+                        break;
+                    }
+                }
+                if (end == document.size()) {
+                    return "Unterminated tag at offset " + std::to_string(position);
+                }
+                const std::string tag = document.substr(position + 1, end - position - 1);
+                position = end + 1;
+
+                if (tag[0] == '/') {
+                    const std::string name = tag.substr(1, tag.find_last_not_of(" \t\r\n"));
+                    if (open.empty() || open.back() != name) {
+                        return "Unexpected closing tag " + name;
+                    }
+                    open.pop_back();
+                    continue;
+                }
+                if (open.empty() && ++roots > 1) {
+                    return "More than one root element";
+                }
+                if (tag.back() != '/') {
+                    open.push_back(tag.substr(0, tag.find_first_of(" \t\r\n/")));
+                }
+            }
+            if (!open.empty()) {
+                return "Unclosed element " + open.back();
+            }
+            return roots == 1 ? "" : "No root element";
+        }
+
+        /// Value of attribute @p name of the testsuite element, or an empty string if it has none.
+        std::string GetTestsuiteAttribute(const std::string& document, const std::string& name)
+        {
+            const size_t tagStart = document.find("<testsuite ");
+            const size_t tagEnd = document.find('>', tagStart);
+            const std::string tag = document.substr(tagStart, tagEnd - tagStart);
+            const size_t valueStart = tag.find(" " + name + "=\"");
+            if (valueStart == std::string::npos) {
+                return "";
+            }
+            const size_t start = valueStart + name.size() + 3;
+            return tag.substr(start, tag.find('"', start) - start);
+        }
+
+        void StartTestCase(Catch::IEventListener& reporter, const Catch::TestCaseInfo& testCase)
+        {
+            reporter.testCaseStarting(testCase);
+            reporter.sectionStarting(Catch::SectionInfo(testCase.lineInfo, testCase.name));
+        }
+
+        void EndAssertion(Catch::IEventListener& reporter, bool passed)
+        {
+            const Catch::AssertionInfo info{"CHECK"_catch_sr, CATCH_INTERNAL_LINEINFO, "value == 1"_catch_sr,
+                                            Catch::ResultDisposition::ContinueOnFailure};
+            Catch::AssertionResultData data(passed ? Catch::ResultWas::Ok : Catch::ResultWas::ExpressionFailed,
+                                            Catch::LazyExpression(false));
+            data.reconstructedExpression = passed ? "1 == 1" : "0 == 1";
+            reporter.assertionEnded(Catch::AssertionStats(Catch::AssertionResult(info, std::move(data)), {}, Catch::Totals()));
+        }
+
+        void EndTestCase(Catch::IEventListener& reporter, const Catch::TestCaseInfo& testCase, const Catch::Totals& totals)
+        {
+            Catch::SectionInfo section(testCase.lineInfo, testCase.name);
+            reporter.sectionEnded(Catch::SectionStats(std::move(section), totals.assertions, 0.0, false));
+            reporter.testCaseEnded(Catch::TestCaseStats(testCase, totals, "", "", false));
+        }
+    }  // namespace
+
+    TEST_CASE("CTSStreamingReporter", "[self_test]")
+    {
+        ScopedFile file("ctsxml_streaming_self_test.xml");
+        const Catch::Config config{Catch::ConfigData()};
+        Catch::CTSStreamingReporter reporter(
+            Catch::ReporterConfig(&config, Catch::makeStream(file.path), Catch::ColourMode::None, {}));
+
+        const Catch::TestCaseInfo passing("", {"Passing test case", "[self_test]"}, CATCH_INTERNAL_LINEINFO);
+        const Catch::TestCaseInfo failing("", {"Failing test case", "[self_test]"}, CATCH_INTERNAL_LINEINFO);
+        const Catch::TestCaseInfo aborted("", {"Aborted test case", "[self_test]"}, CATCH_INTERNAL_LINEINFO);
+        Catch::Totals passed;
+        passed.assertions.passed = 1;
+        Catch::Totals failed;
+        failed.assertions.failed = 1;
+
+        const Catch::TestRunInfo runInfo("self_test"_catch_sr);
+        reporter.testRunStarting(runInfo);
+        StartTestCase(reporter, passing);
+        EndAssertion(reporter, true);
+        EndTestCase(reporter, passing, passed);
+        StartTestCase(reporter, failing);
+        EndAssertion(reporter, false);
+        EndTestCase(reporter, failing, failed);
+        StartTestCase(reporter, aborted);
+        EndAssertion(reporter, false);
+
+        SECTION("The report is well-formed if the run is aborted during a test case")
+        {
+            // Everything of the ended test cases has been flushed to the file, as if the process had crashed here.
+            const std::string report = ReadFile(file.path);
+            INFO(report);
+            CHECK(CheckElementsNested(report) == "");
+            CHECK(report.find("Failing test case") != std::string::npos);
+            CHECK(report.find("Aborted test case") == std::string::npos);
+            CHECK(report.find("cts:totals") == std::string::npos);
+
+            // The testsuite totals are those of the test cases that ended.
+            CHECK(GetTestsuiteAttribute(report, "tests") == "00000000000000000002");
+            CHECK(GetTestsuiteAttribute(report, "failures") == "00000000000000000001");
+            CHECK(GetTestsuiteAttribute(report, "errors") == "00000000000000000000");
+            CHECK(GetTestsuiteAttribute(report, "time").size() == 20);
+        }
+
+        SECTION("The totals are complete when the run ends")
+        {
+            EndTestCase(reporter, aborted, failed);
+            Catch::Totals totals = passed;
+            totals += failed;
+            totals += failed;
+            reporter.testRunEnded(Catch::TestRunStats(runInfo, totals, false));
+
+            const std::string report = ReadFile(file.path);
+            INFO(report);
+            CHECK(CheckElementsNested(report) == "");
+            CHECK(report.find("Aborted test case") != std::string::npos);
+            CHECK(report.find("<cts:totals errors=\"0\" failures=\"2\" skipped=\"0\" tests=\"3\"") != std::string::npos);
+            CHECK(GetTestsuiteAttribute(report, "tests") == "00000000000000000003");
+            CHECK(GetTestsuiteAttribute(report, "failures") == "00000000000000000002");
+        }
+    }
+}  // namespace Conformance
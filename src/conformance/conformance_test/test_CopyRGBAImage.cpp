@@ -0,0 +1,87 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "RGBAImage.h"
+#include "composition_utils.h"
+#include "conformance_framework.h"
+#include "graphics_plugin.h"
+#include "report.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openxr/openxr.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Conformance
+{
+    // Measures IGraphicsPlugin::CopyRGBAImage, which tests use to fill static swapchain images.
+    // Does not need a display or a fast GPU: software rasterizers such as Mesa llvmpipe show the per-call overhead best.
+    TEST_CASE("CopyRGBAImageBenchmark", "[benchmark][exclusive_session][.]")
+    {
+        GlobalData& globalData = GetGlobalData();
+        if (!globalData.IsUsingGraphicsPlugin()) {
+            SKIP("Cannot test CopyRGBAImage without a graphics plugin");
+        }
+
+        CompositionHelper compositionHelper("CopyRGBAImage benchmark");
+        const int64_t format = globalData.graphicsPlugin->GetSRGBA8Format();
+
+        struct UploadSize
+        {
+            uint32_t width;
+            uint32_t height;
+            uint32_t arraySize;
+        };
+        const UploadSize sizes[] = {{256, 256, 1}, {1024, 1024, 1}, {2048, 2048, 1}, {1024, 1024, 2}};
+
+        for (const UploadSize& size : sizes) {
+            XrSwapchainCreateInfo createInfo = compositionHelper.DefaultColorSwapchainCreateInfo(size.width, size.height, 0, format);
+            createInfo.usageFlags |= XR_SWAPCHAIN_USAGE_TRANSFER_DST_BIT;
+            createInfo.arraySize = size.arraySize;
+            const XrSwapchain swapchain = compositionHelper.CreateSwapchain(createInfo);
+
+            RGBAImage image((int)size.width, (int)size.height);
+            image.DrawRect(0, 0, image.width, image.height / 2, {1, 0, 0, 1});
+            image.DrawRect(0, image.height / 2, image.width, image.height / 2, {0, 0, 1, 1});
+            image.isSrgb = true;
+
+            const std::string name = std::to_string(size.width) + "x" + std::to_string(size.height) +
+                                     (size.arraySize > 1 ? ", array slice" : "");
+            const uint32_t arraySlice = size.arraySize - 1;
+            compositionHelper.AcquireWaitReleaseImage(swapchain, [&](const XrSwapchainImageBaseHeader* swapchainImage) {
+                // Report throughput directly as well, since Catch only reports time per call.
+                constexpr int Iterations = 20;
+                const auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < Iterations; ++i) {
+                    globalData.graphicsPlugin->CopyRGBAImage(swapchainImage, arraySlice, image);
+                }
+                globalData.graphicsPlugin->Flush();
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                const double megabytes = (double)image.pixels.size() * sizeof(RGBA8Color) * Iterations / (1024.0 * 1024.0);
+                ReportF("CopyRGBAImage %s: %.1f MiB/s", name.c_str(), megabytes / elapsed.count());
+
+                BENCHMARK("CopyRGBAImage " + name)
+                {
+                    globalData.graphicsPlugin->CopyRGBAImage(swapchainImage, arraySlice, image);
+                };
+            });
+        }
+    }
+}  // namespace Conformance
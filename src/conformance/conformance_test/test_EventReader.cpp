@@ -0,0 +1,211 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utilities/event_reader.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <openxr/openxr.h>
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Stands in for the runtime: events pushed here are returned by the next polls.
+        class FakeRuntimeEvents
+        {
+        public:
+            void PushStateChanged(XrSessionState state)
+            {
+                XrEventDataSessionStateChanged event{XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED};
+                event.state = state;
+                Push(&event, sizeof(event));
+            }
+
+            void PushPerfSettings(XrPerfSettingsNotificationLevelEXT level)
+            {
+                XrEventDataPerfSettingsEXT event{XR_TYPE_EVENT_DATA_PERF_SETTINGS_EXT};
+                event.toLevel = level;
+                Push(&event, sizeof(event));
+            }
+
+            EventQueue::PollFunction GetPollFunction()
+            {
+                return [this](XrEventDataBuffer* eventData) {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    if (m_events.empty()) {
+                        return XR_EVENT_UNAVAILABLE;
+                    }
+                    *eventData = m_events.front();
+                    m_events.pop_front();
+                    return XR_SUCCESS;
+                };
+            }
+
+        private:
+            void Push(const void* event, size_t size)
+            {
+                XrEventDataBuffer buffer{};
+                memcpy(&buffer, event, size);
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_events.push_back(buffer);
+            }
+
+            std::mutex m_mutex;
+            std::deque<XrEventDataBuffer> m_events;
+        };
+
+        XrSessionState GetState(const XrEventDataBuffer& eventData)
+        {
+            REQUIRE(eventData.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED);
+            return reinterpret_cast<const XrEventDataSessionStateChanged&>(eventData).state;
+        }
+    }  // namespace
+
+    TEST_CASE("EventReader", "[self_test]")
+    {
+        FakeRuntimeEvents runtime;
+        XrEventDataBuffer eventData;
+
+        SECTION("Events are stored at their own size")
+        {
+            REQUIRE(EventQueue::GetEventSize(XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) == sizeof(XrEventDataSessionStateChanged));
+            REQUIRE(EventQueue::GetEventSize(XR_TYPE_EVENT_DATA_BUFFER) == sizeof(XrEventDataBuffer));
+
+            EventQueue queue(runtime.GetPollFunction());
+            EventReader reader(queue);
+            EventReader slowReader(queue);
+            runtime.PushStateChanged(XR_SESSION_STATE_READY);
+            runtime.PushPerfSettings(XR_PERF_SETTINGS_NOTIF_LEVEL_WARNING_EXT);
+            REQUIRE(reader.TryReadNext(eventData));
+            REQUIRE(queue.GetStoredEventCount() == 2);
+            REQUIRE(queue.GetStoredBytes() == sizeof(XrEventDataSessionStateChanged) + sizeof(XrEventDataPerfSettingsEXT));
+        }
+
+        SECTION("Each reader sees every event added after it was created")
+        {
+            EventQueue queue(runtime.GetPollFunction());
+            EventReader first(queue);
+            runtime.PushStateChanged(XR_SESSION_STATE_IDLE);
+            REQUIRE(first.TryReadNext(eventData));
+            REQUIRE(GetState(eventData) == XR_SESSION_STATE_IDLE);
+
+            EventReader second(queue);
+            runtime.PushStateChanged(XR_SESSION_STATE_READY);
+            runtime.PushStateChanged(XR_SESSION_STATE_SYNCHRONIZED);
+            for (EventReader* reader : {&first, &second}) {
+                REQUIRE(reader->TryReadNext(eventData));
+                REQUIRE(GetState(eventData) == XR_SESSION_STATE_READY);
+                REQUIRE(reader->TryReadNext(eventData));
+                REQUIRE(GetState(eventData) == XR_SESSION_STATE_SYNCHRONIZED);
+                REQUIRE_FALSE(reader->TryReadNext(eventData));
+            }
+        }
+
+        SECTION("Events are reclaimed once every reader has read them")
+        {
+            EventQueue queue(runtime.GetPollFunction());
+            EventReader first(queue);
+            {
+                EventReader second(queue);
+                for (int i = 0; i < 10; ++i) {
+                    runtime.PushStateChanged(XR_SESSION_STATE_FOCUSED);
+                }
+                first.ReadUntilEmpty();
+                REQUIRE(queue.GetStoredEventCount() == 10);
+
+                REQUIRE(second.TryReadNext(eventData));
+                REQUIRE(queue.GetStoredEventCount() == 9);
+            }
+            // Destroying the slowest reader releases what it had not read.
+            REQUIRE(queue.GetStoredEventCount() == 0);
+            REQUIRE(queue.GetStoredBytes() == 0);
+        }
+
+        SECTION("A reader that falls behind is told how many events were lost")
+        {
+            // The smallest capacity allowed: one XrEventDataBuffer.
+            EventQueue queue(runtime.GetPollFunction(), 0);
+            const size_t eventsThatFit = sizeof(XrEventDataBuffer) / sizeof(XrEventDataSessionStateChanged);
+            EventReader fast(queue);
+            EventReader slow(queue);
+            const size_t eventCount = eventsThatFit + 5;
+            for (size_t i = 0; i < eventCount; ++i) {
+                runtime.PushStateChanged(XR_SESSION_STATE_FOCUSED);
+                REQUIRE(fast.TryReadNext(eventData));
+                REQUIRE(GetState(eventData) == XR_SESSION_STATE_FOCUSED);
+            }
+            REQUIRE(queue.GetStoredBytes() <= sizeof(XrEventDataBuffer));
+
+            REQUIRE(slow.TryReadNext(eventData));
+            REQUIRE(eventData.type == XR_TYPE_EVENT_DATA_EVENTS_LOST);
+            const uint32_t lost = reinterpret_cast<const XrEventDataEventsLost&>(eventData).lostEventCount;
+            REQUIRE(lost >= 5);
+            size_t remaining = 0;
+            while (slow.TryReadNext(eventData)) {
+                REQUIRE(GetState(eventData) == XR_SESSION_STATE_FOCUSED);
+                remaining++;
+            }
+            REQUIRE(lost + remaining == eventCount);
+        }
+
+        SECTION("Waiting for an event type")
+        {
+            EventQueue queue(runtime.GetPollFunction());
+            EventReader reader(queue);
+
+            REQUIRE_FALSE(reader.WaitForEvent(eventData, XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED, std::chrono::milliseconds(5)));
+
+            runtime.PushPerfSettings(XR_PERF_SETTINGS_NOTIF_LEVEL_NORMAL_EXT);
+            std::thread producer([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                runtime.PushStateChanged(XR_SESSION_STATE_STOPPING);
+            });
+            const bool received = reader.WaitForEvent(eventData, XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED, std::chrono::seconds(10));
+            producer.join();
+            REQUIRE(received);
+            REQUIRE(GetState(eventData) == XR_SESSION_STATE_STOPPING);
+        }
+
+        SECTION("Waiting for new events")
+        {
+            EventQueue queue(runtime.GetPollFunction());
+            EventReader reader(queue);
+
+            REQUIRE_FALSE(queue.WaitForNewEvents(std::chrono::milliseconds(5)));
+
+            // Events polled by the waiting thread itself end the wait at once.
+            runtime.PushPerfSettings(XR_PERF_SETTINGS_NOTIF_LEVEL_NORMAL_EXT);
+            REQUIRE(queue.WaitForNewEvents(std::chrono::seconds(10)));
+
+            // So do events polled by another thread.
+            std::thread producer([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                runtime.PushStateChanged(XR_SESSION_STATE_STOPPING);
+                reader.ReadUntilEmpty();
+            });
+            const bool woken = queue.WaitForNewEvents(std::chrono::seconds(10));
+            producer.join();
+            REQUIRE(woken);
+        }
+    }
+}  // namespace Conformance
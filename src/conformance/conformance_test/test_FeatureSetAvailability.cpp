@@ -51,6 +51,24 @@ namespace Conformance
         CHECK_FALSE(fsOnePointZeroPlusOpenGL.get_XR_KHR_opengl_es_enable());
     }
 
+    TEST_CASE("FeatureNameToBitIndex", "")
+    {
+        for (uint32_t i = 0; i < (uint32_t)FeatureBitIndex::FEATURE_COUNT; ++i) {
+            const FeatureBitIndex bit = (FeatureBitIndex)i;
+            INFO(FeatureBitToString(bit));
+            CHECK(FeatureNameToBitIndex(FeatureBitToString(bit)) == bit);
+        }
+        CHECK(FeatureNameToBitIndex("") == FeatureBitIndex::FEATURE_COUNT);
+        CHECK(FeatureNameToBitIndex("XR_VERSION_1_") == FeatureBitIndex::FEATURE_COUNT);
+        CHECK(FeatureNameToBitIndex("XR_KHR_opengl_enable2") == FeatureBitIndex::FEATURE_COUNT);
+        CHECK(FeatureNameToBitIndex("ZZZ") == FeatureBitIndex::FEATURE_COUNT);
+
+        FeatureSet features;
+        CHECK(features.SetByExtensionNameString("XR_KHR_opengl_enable"));
+        CHECK_FALSE(features.SetByExtensionNameString("XR_UNKNOWN_extension"));
+        CHECK(features == FeatureSet{FeatureBitIndex::BIT_XR_KHR_opengl_enable});
+    }
+
     TEST_CASE("FeatureSetAvailability", "")
     {
         CHECK(Availability{}.ToString() == "");
@@ -0,0 +1,139 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "frame_event_recorder.h"
+#include "spsc_ring.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <openxr/openxr.h>
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace Conformance
+{
+    TEST_CASE("SpscRing", "[self_test]")
+    {
+        SECTION("Push fails when full and pop when empty")
+        {
+            SpscRing<int, 4> ring;
+            int value = 0;
+            REQUIRE_FALSE(ring.TryPop(value));
+            for (int i = 0; i < 4; ++i) {
+                REQUIRE(ring.TryPush(i));
+            }
+            REQUIRE_FALSE(ring.TryPush(4));
+            REQUIRE(ring.TryPop(value));
+            REQUIRE(value == 0);
+            REQUIRE(ring.TryPush(4));
+            for (int i = 1; i <= 4; ++i) {
+                REQUIRE(ring.TryPop(value));
+                REQUIRE(value == i);
+            }
+            REQUIRE_FALSE(ring.TryPop(value));
+        }
+
+        SECTION("Values arrive in order across threads")
+        {
+            constexpr uint64_t valueCount = 100000;
+            SpscRing<uint64_t, 64> ring;
+            std::thread producer([&] {
+                for (uint64_t i = 0; i < valueCount; ++i) {
+                    while (!ring.TryPush(i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+            uint64_t expected = 0;
+            bool inOrder = true;
+            while (expected < valueCount) {
+                uint64_t value;
+                if (ring.TryPop(value)) {
+                    inOrder = inOrder && value == expected;
+                    ++expected;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+            producer.join();
+            REQUIRE(inOrder);
+        }
+    }
+
+    TEST_CASE("FrameEventRecorder", "[self_test]")
+    {
+        constexpr uint64_t warmupFrames = 3;
+        constexpr uint64_t frameCount = 20;
+        FrameEventRecorder recorder(2, warmupFrames, frameCount);
+
+        // An app thread waiting for frames and a render thread submitting them, as in a pipelined frame loop.
+        std::thread appThread([&] {
+            for (uint64_t frame = 0; frame < warmupFrames + frameCount; ++frame) {
+                XrFrameState frameState{XR_TYPE_FRAME_STATE};
+                frameState.predictedDisplayTime = (XrTime)(1000 + frame);
+                frameState.predictedDisplayPeriod = 10;
+                recorder.Record(0, frame, FrameEventType::WaitStart);
+                recorder.RecordWaitEnd(0, frame, frameState);
+            }
+        });
+        std::thread renderThread([&] {
+            for (uint64_t frame = 0; frame < warmupFrames + frameCount + 5; ++frame) {
+                recorder.Record(1, frame, FrameEventType::BeginStart);
+                recorder.Record(1, frame, FrameEventType::BeginEnd);
+                recorder.Record(1, frame, FrameEventType::EndFrameEnd);
+            }
+        });
+        appThread.join();
+        renderThread.join();
+
+        const std::vector<FrameTimingSample> samples = recorder.Finish();
+        REQUIRE(recorder.GetDroppedEventCount() == 0);
+        REQUIRE(samples.size() == frameCount);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            INFO("Frame " << i);
+            const FrameTimingSample& sample = samples[i];
+            REQUIRE(sample.predictedDisplayTime == (XrTime)(1000 + warmupFrames + i));
+            REQUIRE(sample.predictedDisplayPeriod == 10);
+            REQUIRE(sample.waitStart != 0);
+            REQUIRE(sample.waitEnd >= sample.waitStart);
+            REQUIRE(sample.beginStart != 0);
+            REQUIRE(sample.beginEnd >= sample.beginStart);
+            REQUIRE(sample.endFrameEnd >= sample.beginEnd);
+            REQUIRE(sample.complete);
+        }
+    }
+
+    TEST_CASE("FrameEventRecorderIncompleteFrames", "[self_test]")
+    {
+        FrameEventRecorder recorder(1, 0, 2);
+        for (uint64_t frame = 0; frame < 2; ++frame) {
+            recorder.Record(0, frame, FrameEventType::WaitStart);
+            recorder.RecordWaitEnd(0, frame, XrFrameState{XR_TYPE_FRAME_STATE});
+            recorder.Record(0, frame, FrameEventType::BeginStart);
+            recorder.Record(0, frame, FrameEventType::BeginEnd);
+        }
+        // Only the first frame ends, as if the xrEndFrame event of the second was dropped.
+        recorder.Record(0, 0, FrameEventType::EndFrameEnd);
+
+        const std::vector<FrameTimingSample> samples = recorder.Finish();
+        REQUIRE(samples.size() == 2);
+        REQUIRE(samples[0].complete);
+        REQUIRE_FALSE(samples[1].complete);
+    }
+}  // namespace Conformance
@@ -0,0 +1,155 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "frame_pacing.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        using ns = std::chrono::nanoseconds;
+
+        constexpr int64_t DisplayPeriod = 10000000;  // 10ms
+
+        /// A frame loop running exactly at the display period, with each frame displayed one period after it was waited for.
+        std::vector<FrameTimingSample> MakeSteadyFrames(size_t frameCount)
+        {
+            std::vector<FrameTimingSample> samples(frameCount);
+            for (size_t i = 0; i < frameCount; ++i) {
+                FrameTimingSample& sample = samples[i];
+                sample.waitStart = (int64_t)i * DisplayPeriod;
+                sample.waitEnd = sample.waitStart + 1000000;
+                sample.beginStart = sample.waitEnd + 2000000;
+                sample.beginEnd = sample.beginStart + 100000;
+                sample.endFrameEnd = sample.waitEnd + 8000000;
+                sample.predictedDisplayTime = 5000000000 + (int64_t)i * DisplayPeriod;
+                sample.predictedDisplayPeriod = DisplayPeriod;
+            }
+            return samples;
+        }
+    }  // namespace
+
+    TEST_CASE("FramePacing", "[self_test]")
+    {
+        SECTION("Percentiles use the nearest rank")
+        {
+            std::vector<ns> durations;
+            for (int i = 100; i >= 1; --i) {
+                durations.push_back(ns(i));
+            }
+            const DurationPercentiles percentiles = ComputeDurationPercentiles(durations);
+            REQUIRE(percentiles.p50 == ns(50));
+            REQUIRE(percentiles.p95 == ns(95));
+            REQUIRE(percentiles.p99 == ns(99));
+            REQUIRE(percentiles.max == ns(100));
+
+            const DurationPercentiles single = ComputeDurationPercentiles({ns(7)});
+            REQUIRE(single.p50 == ns(7));
+            REQUIRE(single.max == ns(7));
+        }
+
+        SECTION("A steady frame loop")
+        {
+            const FramePacingStatistics statistics = ComputeFramePacingStatistics(MakeSteadyFrames(200));
+            REQUIRE(statistics.frameCount == 200);
+            REQUIRE(statistics.waitTime.max == ns(1000000));
+            REQUIRE(statistics.beginTime.p50 == ns(100000));
+            REQUIRE(statistics.frameInterval.p50 == ns(DisplayPeriod));
+            REQUIRE(statistics.frameInterval.max == ns(DisplayPeriod));
+            REQUIRE(statistics.frameLatency.p99 == ns(8000000));
+            REQUIRE(statistics.missedDeadlines == 0);
+            REQUIRE(statistics.jitter == ns(0));
+            REQUIRE(statistics.displayTimeDrift == ns(0));
+        }
+
+        SECTION("A spike shows in the tail and as missed deadlines")
+        {
+            std::vector<FrameTimingSample> samples = MakeSteadyFrames(200);
+            // Frame 100 is throttled for two more display periods, and the frames after it are displayed that much later.
+            for (size_t i = 100; i < samples.size(); ++i) {
+                samples[i].waitStart += 2 * DisplayPeriod;
+                samples[i].waitEnd += 2 * DisplayPeriod;
+                samples[i].beginStart += 2 * DisplayPeriod;
+                samples[i].beginEnd += 2 * DisplayPeriod;
+                samples[i].endFrameEnd += 2 * DisplayPeriod;
+                samples[i].predictedDisplayTime += 2 * DisplayPeriod;
+            }
+            const FramePacingStatistics statistics = ComputeFramePacingStatistics(samples);
+            REQUIRE(statistics.frameInterval.p50 == ns(DisplayPeriod));
+            REQUIRE(statistics.frameInterval.p99 == ns(DisplayPeriod));
+            REQUIRE(statistics.frameInterval.max == ns(3 * DisplayPeriod));
+            REQUIRE(statistics.missedDeadlines == 2);
+            REQUIRE(statistics.jitter > ns(0));
+            REQUIRE(statistics.displayTimeDrift == ns(0));
+        }
+
+        SECTION("Incomplete samples are skipped")
+        {
+            std::vector<FrameTimingSample> samples = MakeSteadyFrames(200);
+            // As if the events of frame 100 after xrWaitFrame were dropped.
+            samples[100].beginStart = 0;
+            samples[100].beginEnd = 0;
+            samples[100].endFrameEnd = 0;
+            samples[100].complete = false;
+            const FramePacingStatistics statistics = ComputeFramePacingStatistics(samples);
+            REQUIRE(statistics.frameCount == 199);
+            REQUIRE(statistics.beginTime.max == ns(100000));
+            REQUIRE(statistics.frameLatency.max == ns(8000000));
+            REQUIRE(statistics.frameInterval.max == ns(DisplayPeriod));
+            REQUIRE(statistics.missedDeadlines == 0);
+            REQUIRE(statistics.displayTimeDrift == ns(0));
+        }
+
+        SECTION("Drift between the predicted display times and the frame loop")
+        {
+            std::vector<FrameTimingSample> samples = MakeSteadyFrames(100);
+            for (size_t i = 0; i < samples.size(); ++i) {
+                samples[i].predictedDisplayTime += (int64_t)i * 1000;
+            }
+            const FramePacingStatistics statistics = ComputeFramePacingStatistics(samples);
+            REQUIRE(statistics.displayTimeDrift == ns(99 * 1000));
+            REQUIRE(statistics.missedDeadlines == 0);
+        }
+
+        SECTION("CSV time series")
+        {
+            const std::string path = "frame_pacing_self_test.csv";
+            REQUIRE(WriteFramePacingCsv(path, MakeSteadyFrames(3)));
+            std::vector<std::string> lines;
+            {
+                std::ifstream file(path);
+                std::string line;
+                while (std::getline(file, line)) {
+                    lines.push_back(line);
+                }
+            }
+            std::remove(path.c_str());
+
+            REQUIRE(lines.size() == 4);
+            REQUIRE(lines[0].compare(0, 6, "frame,") == 0);
+            REQUIRE(lines[1] == "0,0,1000000,3000000,3100000,9000000,0,10000000");
+            REQUIRE(lines[3] == "2,20000000,21000000,23000000,23100000,29000000,20000000,10000000");
+        }
+    }
+}  // namespace Conformance
@@ -17,6 +17,8 @@
 #include "composition_utils.h"
 #include "conformance_framework.h"
 #include "conformance_utils.h"
+#include "frame_event_recorder.h"
+#include "frame_pacing.h"
 #include "report.h"
 #include "utilities/throw_helpers.h"
 
@@ -30,6 +32,7 @@
 #include <condition_variable>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #define ENUM_LIST(name, val) name,
 constexpr XrEnvironmentBlendMode SupportedBlendModes[] = {XR_LIST_ENUM_XrEnvironmentBlendMode(ENUM_LIST)};
@@ -38,7 +41,7 @@ constexpr XrEnvironmentBlendMode SupportedBlendModes[] = {XR_LIST_ENUM_XrEnviron
 namespace Conformance
 {
     // Tests for xrBeginFrame, xrWaitFrame, xrEndFrame without testing specific composition layer types.
-    TEST_CASE("FrameSubmission", "")
+    TEST_CASE("FrameSubmission", "[exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsUsingGraphicsPlugin()) {
@@ -273,7 +276,7 @@ namespace Conformance
 
     // Test uses spends 90% of a predictedDisplayPeriod on both the rendering thread and primary thread. Although the total time
     // spent is over 100% of allowable time, the OpenXR frame API calls should be made concurrently allowing full frame rate.
-    TEST_CASE("Timed_Pipelined_Frame_Submission", "")
+    TEST_CASE("Timed_Pipelined_Frame_Submission", "[exclusive_session]")
     {
         using ns = std::chrono::nanoseconds;
         using ms = std::chrono::duration<float, std::milli>;
@@ -307,9 +310,14 @@ namespace Conformance
         std::condition_variable displayCv;
         bool frameSubmissionCompleted = false;
 
-        ns totalFrameDisplayPeriod(0), totalWaitTime(0), totalBeginTime(0);
         Stopwatch frameLoopTimer;
 
+        // The app thread records the xrWaitFrame times of each frame and the render thread the rest, each to a ring of its own,
+        // and the recorder assembles them off the frame threads.
+        constexpr size_t appThreadEvents = 0;
+        constexpr size_t renderThreadEvents = 1;
+        FrameEventRecorder frameEventRecorder(2, warmupFrameCount, testFrameCount);
+
         XrResult appThreadResult = XR_SUCCESS;
 
         auto appThread = std::thread([&]() {
@@ -326,7 +334,8 @@ namespace Conformance
             };
 
             // Initially prime things by submitting 180 frames without measuring performance.
-            for (int frame = 0; frame < warmupFrameCount; ++frame) {
+            int frame = 0;
+            for (; frame < warmupFrameCount; ++frame) {
                 XrFrameState frameState{XR_TYPE_FRAME_STATE};
                 appThreadResult = xrWaitFrame(compositionHelper.GetSession(), nullptr, &frameState);
                 if (appThreadResult != XR_SUCCESS) {
@@ -345,23 +354,18 @@ namespace Conformance
             frameLoopTimer.Restart();
 
             // Now submit <testFrameCount> frames and measure the total time spent.
-            for (int frame = 0; frame < testFrameCount; ++frame) {
+            for (; frame < warmupFrameCount + testFrameCount; ++frame) {
                 XrFrameState frameState{XR_TYPE_FRAME_STATE};
-                {
-                    Stopwatch waitTimer(true);
-                    appThreadResult = xrWaitFrame(compositionHelper.GetSession(), nullptr, &frameState);
-                    if (appThreadResult != XR_SUCCESS) {
-                        signalNoMoreFrames();
-
-                        DETACH_THREAD;
-                        return;
-                    }
+                frameEventRecorder.Record(appThreadEvents, frame, FrameEventType::WaitStart);
+                appThreadResult = xrWaitFrame(compositionHelper.GetSession(), nullptr, &frameState);
+                frameEventRecorder.RecordWaitEnd(appThreadEvents, frame, frameState);
+                if (appThreadResult != XR_SUCCESS) {
+                    signalNoMoreFrames();
 
-                    totalWaitTime += waitTimer.Elapsed();
+                    DETACH_THREAD;
+                    return;
                 }
 
-                totalFrameDisplayPeriod += ns(frameState.predictedDisplayPeriod);
-
                 // Mimic a lot of time spent in game "simulation" phase.
                 int64_t sleepTime = static_cast<int64_t>(frameState.predictedDisplayPeriod * waitBlockPercentage);
                 YieldSleep(Stopwatch(true), ns(sleepTime));
@@ -374,7 +378,7 @@ namespace Conformance
             DETACH_THREAD;
         });
 
-        while (appThreadResult == XR_SUCCESS) {
+        for (int renderedFrame = 0; appThreadResult == XR_SUCCESS; ++renderedFrame) {
             // Dequeue a frame to render.
             XrFrameState frameState;
             {
@@ -388,11 +392,12 @@ namespace Conformance
                 queuedFramesForRender.pop();
             }
 
-            Stopwatch sw(true);
+            // Frames are rendered in the order they were waited for, so the render thread numbers them like the app thread.
+            frameEventRecorder.Record(renderThreadEvents, renderedFrame, FrameEventType::BeginStart);
             XRC_CHECK_THROW_XRCMD(xrBeginFrame(compositionHelper.GetSession(), nullptr));
-            totalBeginTime += sw.Elapsed();
+            frameEventRecorder.Record(renderThreadEvents, renderedFrame, FrameEventType::BeginEnd);
 
-            sw.Restart();
+            Stopwatch sw(true);
 
             std::vector<XrCompositionLayerBaseHeader*> layers;
             if (XrCompositionLayerBaseHeader* projLayer = simpleProjectionLayerHelper.TryGetUpdatedProjectionLayer(frameState)) {
@@ -404,6 +409,7 @@ namespace Conformance
             YieldSleep(sw, ns(sleepTime));
 
             compositionHelper.EndFrame(frameState.predictedDisplayTime, layers);
+            frameEventRecorder.Record(renderThreadEvents, renderedFrame, FrameEventType::EndFrameEnd);
         }
 
         frameLoopTimer.Stop();
@@ -412,19 +418,61 @@ namespace Conformance
             REQUIRE_RESULT_SUCCEEDED(appThreadResult);
         }
 
-        const ns averageWaitTime = totalWaitTime / testFrameCount;
+        const std::vector<FrameTimingSample> frameTimings = frameEventRecorder.Finish();
+        if (frameEventRecorder.GetDroppedEventCount() > 0) {
+            WARN(frameEventRecorder.GetDroppedEventCount() << " frame events were dropped, so some frame timings are incomplete");
+        }
+
+        // Samples whose events were dropped have times of zero, so leave them out rather than average them in.
+        ns totalFrameDisplayPeriod(0), totalWaitTime(0), totalBeginTime(0);
+        uint32_t completeFrameCount = 0;
+        for (const FrameTimingSample& frameTiming : frameTimings) {
+            if (!frameTiming.complete) {
+                continue;
+            }
+            totalWaitTime += ns(frameTiming.waitEnd - frameTiming.waitStart);
+            totalBeginTime += ns(frameTiming.beginEnd - frameTiming.beginStart);
+            totalFrameDisplayPeriod += ns(frameTiming.predictedDisplayPeriod);
+            completeFrameCount++;
+        }
+        ReportF("Incomplete frame timings skipped : %u of %u frames", (uint32_t)frameTimings.size() - completeFrameCount,
+                (uint32_t)frameTimings.size());
+        REQUIRE_MSG(completeFrameCount > 0, "Every frame timing is incomplete, so there is nothing to report");
+
+        const ns averageWaitTime = totalWaitTime / completeFrameCount;
         ReportF("Average xrWaitFrame wait time    : %.3fms", std::chrono::duration_cast<ms>(averageWaitTime).count());
 
         const ns averageAppFrameTime = frameLoopTimer.Elapsed() / testFrameCount;
         ReportF("Average time spent per frame     : %.3fms", std::chrono::duration_cast<ms>(averageAppFrameTime).count());
 
-        const ns averageDisplayPeriod = totalFrameDisplayPeriod / testFrameCount;
+        const ns averageDisplayPeriod = totalFrameDisplayPeriod / completeFrameCount;
         ReportF("Average predicted display period : %.3fms", std::chrono::duration_cast<ms>(averageDisplayPeriod).count());
 
-        const ns averageBeginTime = totalBeginTime / testFrameCount;
+        const ns averageBeginTime = totalBeginTime / completeFrameCount;
         ReportF("Average xrBeginFrame wait time   : %.3fms", std::chrono::duration_cast<ms>(averageBeginTime).count());
 
-        auto timingResults = TimedSubmissionResults{averageWaitTime, averageAppFrameTime, averageDisplayPeriod, averageBeginTime};
+        const FramePacingStatistics framePacing = ComputeFramePacingStatistics(frameTimings);
+        auto reportPercentiles = [&](const char* name, const DurationPercentiles& percentiles) {
+            ReportF("%s: p50 %.3fms, p95 %.3fms, p99 %.3fms, max %.3fms", name,
+                    std::chrono::duration_cast<ms>(percentiles.p50).count(), std::chrono::duration_cast<ms>(percentiles.p95).count(),
+                    std::chrono::duration_cast<ms>(percentiles.p99).count(), std::chrono::duration_cast<ms>(percentiles.max).count());
+        };
+        reportPercentiles("xrWaitFrame wait time            ", framePacing.waitTime);
+        reportPercentiles("xrBeginFrame wait time           ", framePacing.beginTime);
+        reportPercentiles("Frame interval                   ", framePacing.frameInterval);
+        reportPercentiles("Wait to end of frame latency     ", framePacing.frameLatency);
+        ReportF("Missed deadlines                 : %u of %u frames", framePacing.missedDeadlines, framePacing.frameCount);
+        ReportF("Frame interval jitter            : %.3fms", std::chrono::duration_cast<ms>(framePacing.jitter).count());
+        ReportF("Predicted display time drift     : %.3fms", std::chrono::duration_cast<ms>(framePacing.displayTimeDrift).count());
+
+        if (!globalData.options.framePacingCsv.empty()) {
+            if (!WriteFramePacingCsv(globalData.options.framePacingCsv, frameTimings)) {
+                WARN("Failed to write frame pacing time series to " << globalData.options.framePacingCsv);
+            }
+        }
+
+        auto timingResults =
+            TimedSubmissionResults{averageWaitTime, averageAppFrameTime, averageDisplayPeriod, averageBeginTime, framePacing};
         {
             std::unique_lock<std::recursive_mutex> lock(GetGlobalData().dataMutex);
             GetGlobalData().conformanceReport.timedSubmission = timingResults;
@@ -0,0 +1,180 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "interaction_info.h"
+#include "utilities/feature_availability.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// The input source of @p profile with @p bindingPath, found as callers did before FindInputSourcePath.
+        const InputSourcePathAvailData* SearchInputSourcePath(const InteractionProfileAvailMetadata& profile,
+                                                              const char* bindingPath)
+        {
+            for (const InputSourcePathAvailData& source : profile.InputSourcePaths) {
+                if (strcmp(source.Path, bindingPath) == 0) {
+                    return &source;
+                }
+            }
+            return nullptr;
+        }
+
+        InteractionProfileIndex GetIndex(const InteractionProfileAvailMetadata& profile)
+        {
+            return (InteractionProfileIndex)(&profile - GetAllInteractionProfiles().data());
+        }
+
+        /// Feature sets to evaluate availability with: none, each core version, and random combinations.
+        std::vector<FeatureSet> MakeFeatureSets()
+        {
+            std::vector<FeatureSet> featureSets{
+                FeatureSet{},
+                FeatureSet{FeatureBitIndex::BIT_XR_VERSION_1_0},
+                FeatureSet{FeatureBitIndex::BIT_XR_VERSION_1_0, FeatureBitIndex::BIT_XR_VERSION_1_1},
+            };
+            std::mt19937 engine(42);
+            std::bernoulli_distribution present(0.5);
+            for (int i = 0; i < 200; ++i) {
+                FeatureSet features;
+                for (uint32_t bit = 0; bit < (uint32_t)FeatureBitIndex::FEATURE_COUNT; ++bit) {
+                    features.Get((FeatureBitIndex)bit) = present(engine);
+                }
+                featureSets.push_back(features);
+            }
+            return featureSets;
+        }
+    }  // namespace
+
+    TEST_CASE("InteractionProfileLookup", "[self_test]")
+    {
+        REQUIRE_FALSE(GetAllInteractionProfiles().empty());
+        const std::string simplePath = GetSimpleInteractionProfile().InteractionProfilePathString;
+        CHECK(simplePath == "/interaction_profiles/khr/simple_controller");
+
+        for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+            INFO(profile.InteractionProfilePathString);
+            REQUIRE(FindInteractionProfile(profile.InteractionProfilePathString) == &profile);
+            REQUIRE_FALSE(profile.TopLevelPaths.empty());
+
+            for (const InputSourcePathAvailData& source : profile.InputSourcePaths) {
+                INFO(source.Path);
+                REQUIRE(FindInputSourcePath(GetIndex(profile), source.Path) == &source);
+            }
+        }
+
+        // Paths that are not in the tables, including known paths in the wrong place.
+        CHECK(FindInteractionProfile("") == nullptr);
+        CHECK(FindInteractionProfile("/interaction_profiles/khr/simple_controller/") == nullptr);
+        CHECK(FindInteractionProfile("/interaction_profiles/khr/no_such_controller") == nullptr);
+        CHECK(FindInteractionProfile("/user/hand/left/input/select/click") == nullptr);
+        const InteractionProfileIndex simple = InteractionProfileIndex::Profile_khr_simple_controller;
+        CHECK(FindInputSourcePath(simple, "") == nullptr);
+        CHECK(FindInputSourcePath(simple, "/user/hand/left/input/select") == nullptr);
+        CHECK(FindInputSourcePath(simple, "/user/hand/left/input/trigger/value") == nullptr);
+        CHECK(FindInputSourcePath(simple, "/interaction_profiles/khr/simple_controller") == nullptr);
+        for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+            // A binding path of every profile, checked against each other profile.
+            const char* bindingPath = profile.InputSourcePaths.begin()->Path;
+            for (const InteractionProfileAvailMetadata& other : GetAllInteractionProfiles()) {
+                INFO(bindingPath << " in " << other.InteractionProfilePathString);
+                REQUIRE(FindInputSourcePath(GetIndex(other), bindingPath) == SearchInputSourcePath(other, bindingPath));
+            }
+        }
+    }
+
+    TEST_CASE("InteractionAvailabilityMask", "[self_test]")
+    {
+        for (const FeatureSet& features : MakeFeatureSets()) {
+            INFO(features.ToString());
+            const InteractionAvailabilityMask mask(features);
+            for (size_t i = 0; i < kInteractionAvailabilities.size(); ++i) {
+                INFO(kInteractionAvailabilities[i].ToString());
+                const bool satisfied = kInteractionAvailabilities[i].IsSatisfiedBy(features);
+                REQUIRE(mask.IsSatisfied((InteractionProfileAvailability)i) == satisfied);
+            }
+            for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+                const span<const uint8_t> available = mask.GetInputSourceAvailability(profile);
+                REQUIRE(available.size() == profile.InputSourcePaths.size());
+                for (size_t i = 0; i < available.size(); ++i) {
+                    REQUIRE((available[i] != 0) == mask.IsAvailable(profile.InputSourcePaths[i]));
+                }
+            }
+        }
+    }
+
+    TEST_CASE("InteractionAvailabilityBenchmark", "[self_test][benchmark][.]")
+    {
+        const FeatureSet features{FeatureBitIndex::BIT_XR_VERSION_1_0, FeatureBitIndex::BIT_XR_EXT_palm_pose,
+                                  FeatureBitIndex::BIT_XR_EXT_dpad_binding};
+
+        // Which binding of every profile is available, as when suggesting bindings for the whole profile matrix.
+        BENCHMARK("Evaluate all binding availabilities: Availability::IsSatisfiedBy (before)")
+        {
+            size_t available = 0;
+            for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+                for (const InputSourcePathAvailData& source : profile.InputSourcePaths) {
+                    available += kInteractionAvailabilities[(size_t)source.Availability].IsSatisfiedBy(features);
+                }
+            }
+            return available;
+        };
+        BENCHMARK("Evaluate all binding availabilities: InteractionAvailabilityMask (after)")
+        {
+            const InteractionAvailabilityMask mask(features);
+            size_t available = 0;
+            for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+                for (uint8_t sourceAvailable : mask.GetInputSourceAvailability(profile)) {
+                    available += sourceAvailable;
+                }
+            }
+            return available;
+        };
+    }
+
+    TEST_CASE("InteractionProfileLookupBenchmark", "[self_test][benchmark][.]")
+    {
+        // Validate every binding path of every profile, as a test suggesting bindings for all profiles would.
+        BENCHMARK("Validate all binding paths: linear search (before)")
+        {
+            size_t found = 0;
+            for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+                for (const InputSourcePathAvailData& source : profile.InputSourcePaths) {
+                    found += SearchInputSourcePath(profile, source.Path) != nullptr;
+                }
+            }
+            return found;
+        };
+        BENCHMARK("Validate all binding paths: perfect hash (after)")
+        {
+            size_t found = 0;
+            for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+                for (const InputSourcePathAvailData& source : profile.InputSourcePaths) {
+                    found += FindInputSourcePath(GetIndex(profile), source.Path) != nullptr;
+                }
+            }
+            return found;
+        };
+    }
+}  // namespace Conformance
@@ -0,0 +1,86 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_histogram.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <stdint.h>
+#include <utility>
+
+namespace Conformance
+{
+    TEST_CASE("LatencyHistogram", "[self_test]")
+    {
+        using ns = std::chrono::nanoseconds;
+
+        SECTION("Buckets cover every latency in order")
+        {
+            size_t previousIndex = 0;
+            for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 1000ull, 123456789ull, (unsigned long long)INT64_MAX}) {
+                INFO(value);
+                const size_t index = LatencyHistogram::BucketIndex(value);
+                REQUIRE(index < LatencyHistogram::BucketCount);
+                REQUIRE(index >= previousIndex);
+                REQUIRE(LatencyHistogram::GetBucketUpperBound(index) >= ns((int64_t)value));
+                if (index > 0) {
+                    REQUIRE(LatencyHistogram::GetBucketUpperBound(index - 1) < ns((int64_t)value));
+                }
+                previousIndex = index;
+            }
+            // Below 8ns every bucket holds one value.
+            REQUIRE(LatencyHistogram::BucketIndex(7) == 7);
+            REQUIRE(LatencyHistogram::BucketIndex(8) == 8);
+            REQUIRE(LatencyHistogram::BucketIndex(9) == 9);
+            REQUIRE(LatencyHistogram::BucketIndex(16) == 16);
+            REQUIRE(LatencyHistogram::BucketIndex(17) == 16);
+        }
+
+        SECTION("Percentiles are within a bucket of the exact ones")
+        {
+            LatencyHistogram histogram;
+            REQUIRE(histogram.GetPercentile(50) == ns(0));
+            for (int64_t i = 1; i <= 1000; ++i) {
+                histogram.Add(ns(i * 1000));
+            }
+            REQUIRE(histogram.GetCount() == 1000);
+            REQUIRE(histogram.GetTotal() == ns(500500000));
+
+            const DurationPercentiles percentiles = histogram.GetPercentiles();
+            REQUIRE(percentiles.max == ns(1000000));
+            for (const auto& expected : {std::make_pair(percentiles.p50, 500000), std::make_pair(percentiles.p95, 950000),
+                                         std::make_pair(percentiles.p99, 990000)}) {
+                REQUIRE(expected.first >= ns(expected.second));
+                REQUIRE(expected.first <= ns(expected.second + expected.second / 8));
+            }
+            REQUIRE(histogram.GetPercentile(100) == percentiles.max);
+        }
+
+        SECTION("Merging adds the counts of both")
+        {
+            LatencyHistogram a, b;
+            a.Add(ns(10));
+            a.Add(ns(20));
+            b.Add(ns(5000));
+            a.Merge(b);
+            REQUIRE(a.GetCount() == 3);
+            REQUIRE(a.GetTotal() == ns(5030));
+            REQUIRE(a.GetPercentiles().max == ns(5000));
+            REQUIRE(a.GetBucketCount(LatencyHistogram::BucketIndex(5000)) == 1);
+        }
+    }
+}  // namespace Conformance
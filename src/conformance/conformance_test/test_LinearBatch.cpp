@@ -0,0 +1,365 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utilities/xr_linear_batch.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openxr/openxr.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Joints in XR_EXT_hand_tracking's default joint set.
+        constexpr size_t HandJointCount = 26;
+        /// Nodes in a large glTF model.
+        constexpr size_t ModelNodeCount = 1000;
+
+        class RandomTransforms
+        {
+        public:
+            explicit RandomTransforms(uint32_t seed) : m_engine(seed)
+            {
+            }
+
+            float Float(float low, float high)
+            {
+                return std::uniform_real_distribution<float>(low, high)(m_engine);
+            }
+
+            XrVector3f Vector(float extent)
+            {
+                return {Float(-extent, extent), Float(-extent, extent), Float(-extent, extent)};
+            }
+
+            XrPosef Pose()
+            {
+                XrPosef pose;
+                pose.orientation = {Float(-1, 1), Float(-1, 1), Float(-1, 1), Float(-1, 1)};
+                XrQuaternionf_Normalize(&pose.orientation);
+                pose.position = Vector(2.0f);
+                return pose;
+            }
+
+            /// An affine matrix: a rotation, translation and non-uniform scale.
+            XrMatrix4x4f AffineMatrix()
+            {
+                const XrPosef pose = Pose();
+                const XrVector3f scale{Float(0.1f, 2), Float(0.1f, 2), Float(0.1f, 2)};
+                XrMatrix4x4f matrix;
+                XrMatrix4x4f_CreateTranslationRotationScale(&matrix, &pose.position, &pose.orientation, &scale);
+                return matrix;
+            }
+
+            /// A projective matrix, as a view-projection: a perspective projection of a view from a random pose.
+            XrMatrix4x4f ViewProjection()
+            {
+                XrMatrix4x4f projection;
+                XrMatrix4x4f_CreateProjectionFov(&projection, GRAPHICS_VULKAN, XrFovf{-0.8f, 0.8f, 0.7f, -0.7f}, 0.05f, 100.0f);
+                const XrPosef pose = Pose();
+                XrMatrix4x4f toView;
+                XrMatrix4x4f_CreateFromRigidTransform(&toView, &pose);
+                XrMatrix4x4f view;
+                XrMatrix4x4f_InvertRigidBody(&view, &toView);
+                XrMatrix4x4f viewProjection;
+                XrMatrix4x4f_Multiply(&viewProjection, &projection, &view);
+                return viewProjection;
+            }
+
+            /// Bounds of up to 0.5 on a side around points within @p extent of the origin.
+            void Bounds(XrVector3f& mins, XrVector3f& maxs, float extent)
+            {
+                const XrVector3f center = Vector(extent);
+                const XrVector3f half{Float(0, 0.25f), Float(0, 0.25f), Float(0, 0.25f)};
+                mins = {center.x - half.x, center.y - half.y, center.z - half.z};
+                maxs = {center.x + half.x, center.y + half.y, center.z + half.z};
+            }
+
+        private:
+            std::mt19937 m_engine;
+        };
+
+        /// The kernels may round differently from the reference where the compiler contracts multiplies and adds into
+        /// fused operations on only one of the paths.
+        bool NearlyEqual(float a, float b)
+        {
+            return std::fabs(a - b) <= 1e-5f * std::max({1.0f, std::fabs(a), std::fabs(b)});
+        }
+
+        bool NearlyEqual(const XrVector3f& a, const XrVector3f& b)
+        {
+            return NearlyEqual(a.x, b.x) && NearlyEqual(a.y, b.y) && NearlyEqual(a.z, b.z);
+        }
+
+        bool NearlyEqual(const XrPosef& a, const XrPosef& b)
+        {
+            return NearlyEqual(a.orientation.x, b.orientation.x) && NearlyEqual(a.orientation.y, b.orientation.y) &&
+                   NearlyEqual(a.orientation.z, b.orientation.z) && NearlyEqual(a.orientation.w, b.orientation.w) &&
+                   NearlyEqual(a.position, b.position);
+        }
+
+        bool NearlyEqual(const XrMatrix4x4f& a, const XrMatrix4x4f& b)
+        {
+            for (int i = 0; i < 16; ++i) {
+                if (!NearlyEqual(a.m[i], b.m[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }  // namespace
+
+    TEST_CASE("LinearBatch", "[self_test]")
+    {
+        INFO("Instruction set: " << LinearBatch::GetInstructionSetName());
+
+        struct Inputs
+        {
+            std::vector<XrMatrix4x4f> matricesA, matricesB;
+            std::vector<XrPosef> poses;
+            std::vector<XrVector3f> points, mins, maxs;
+            XrMatrix4x4f affine;
+            XrMatrix4x4f viewProjection;
+            XrPosef pose;
+        };
+
+        // Every count up to a few vector widths, so both the vector loop and the scalar tail are covered.
+        auto forEachCount = [](const std::function<void(size_t, Inputs&)>& check) {
+            RandomTransforms random(1);
+            for (size_t count = 0; count <= 37; ++count) {
+                CAPTURE(count);
+                Inputs inputs;
+                for (size_t i = 0; i < count; ++i) {
+                    inputs.matricesA.push_back(random.AffineMatrix());
+                    inputs.matricesB.push_back(random.AffineMatrix());
+                    inputs.poses.push_back(random.Pose());
+                    inputs.points.push_back(random.Vector(10.0f));
+                    XrVector3f mins, maxs;
+                    random.Bounds(mins, maxs, 10.0f);
+                    inputs.mins.push_back(mins);
+                    inputs.maxs.push_back(maxs);
+                }
+                inputs.affine = random.AffineMatrix();
+                inputs.viewProjection = random.ViewProjection();
+                inputs.pose = random.Pose();
+                check(count, inputs);
+            }
+        };
+
+        SECTION("MultiplyMatrices")
+        {
+            forEachCount([](size_t count, Inputs& in) {
+                std::vector<XrMatrix4x4f> expected(count), actual(count);
+                LinearBatch::Reference::MultiplyMatrices(expected.data(), in.viewProjection, in.matricesB.data(), count);
+                LinearBatch::MultiplyMatrices(actual.data(), in.viewProjection, in.matricesB.data(), count);
+                for (size_t i = 0; i < count; ++i) {
+                    CAPTURE(i);
+                    CHECK(NearlyEqual(actual[i], expected[i]));
+                }
+            });
+        }
+
+        SECTION("MultiplyMatrixPairs")
+        {
+            forEachCount([](size_t count, Inputs& in) {
+                std::vector<XrMatrix4x4f> expected(count), actual(count);
+                LinearBatch::Reference::MultiplyMatrixPairs(expected.data(), in.matricesA.data(), in.matricesB.data(), count);
+                LinearBatch::MultiplyMatrixPairs(actual.data(), in.matricesA.data(), in.matricesB.data(), count);
+                for (size_t i = 0; i < count; ++i) {
+                    CAPTURE(i);
+                    CHECK(NearlyEqual(actual[i], expected[i]));
+                }
+            });
+        }
+
+        SECTION("MultiplyPoses")
+        {
+            forEachCount([](size_t count, Inputs& in) {
+                std::vector<XrPosef> expected(count), actual(count);
+                LinearBatch::Reference::MultiplyPoses(expected.data(), in.pose, in.poses.data(), count);
+                LinearBatch::MultiplyPoses(actual.data(), in.pose, in.poses.data(), count);
+                for (size_t i = 0; i < count; ++i) {
+                    CAPTURE(i);
+                    CHECK(NearlyEqual(actual[i], expected[i]));
+                }
+            });
+        }
+
+        SECTION("TransformPoints")
+        {
+            forEachCount([](size_t count, Inputs& in) {
+                std::vector<XrVector3f> expected(count), actual(count);
+                // A projective matrix would magnify rounding differences for points near w = 0.
+                LinearBatch::Reference::TransformPoints(expected.data(), in.affine, in.points.data(), count);
+                LinearBatch::TransformPoints(actual.data(), in.affine, in.points.data(), count);
+                for (size_t i = 0; i < count; ++i) {
+                    CAPTURE(i);
+                    CHECK(NearlyEqual(actual[i], expected[i]));
+                }
+            });
+        }
+
+        SECTION("TransformBounds")
+        {
+            forEachCount([](size_t count, Inputs& in) {
+                std::vector<XrVector3f> expectedMins(count), expectedMaxs(count), actualMins(count), actualMaxs(count);
+                LinearBatch::Reference::TransformBounds(expectedMins.data(), expectedMaxs.data(), in.matricesA.data(),
+                                                        in.mins.data(), in.maxs.data(), count);
+                LinearBatch::TransformBounds(actualMins.data(), actualMaxs.data(), in.matricesA.data(), in.mins.data(),
+                                             in.maxs.data(), count);
+                for (size_t i = 0; i < count; ++i) {
+                    CAPTURE(i);
+                    CHECK(NearlyEqual(actualMins[i], expectedMins[i]));
+                    CHECK(NearlyEqual(actualMaxs[i], expectedMaxs[i]));
+                }
+            });
+        }
+
+        SECTION("CullBounds")
+        {
+            forEachCount([](size_t count, Inputs& in) {
+                // Make one of the bounds empty, which is never culled.
+                if (count > 2) {
+                    in.maxs[2] = in.mins[2];
+                }
+                std::vector<uint8_t> expected(count), actual(count);
+                const size_t expectedCount =
+                    LinearBatch::Reference::CullBounds(expected.data(), in.viewProjection, in.mins.data(), in.maxs.data(), count);
+                const size_t actualCount =
+                    LinearBatch::CullBounds(actual.data(), in.viewProjection, in.mins.data(), in.maxs.data(), count);
+                CHECK(actualCount == expectedCount);
+                CHECK(actual == expected);
+            });
+        }
+    }
+
+    TEST_CASE("LinearBatchBenchmark", "[self_test][benchmark][.]")
+    {
+        INFO("Instruction set: " << LinearBatch::GetInstructionSetName());
+
+        RandomTransforms random(2);
+
+        const XrPosef handPose = random.Pose();
+        std::vector<XrPosef> jointPoses(HandJointCount);
+        std::vector<XrMatrix4x4f> jointMatrices(HandJointCount);
+        for (size_t i = 0; i < HandJointCount; ++i) {
+            jointPoses[i] = random.Pose();
+            jointMatrices[i] = random.AffineMatrix();
+        }
+
+        std::vector<XrMatrix4x4f> nodeTransforms(ModelNodeCount), parentTransforms(ModelNodeCount);
+        std::vector<XrVector3f> points(ModelNodeCount), mins(ModelNodeCount), maxs(ModelNodeCount);
+        for (size_t i = 0; i < ModelNodeCount; ++i) {
+            nodeTransforms[i] = random.AffineMatrix();
+            parentTransforms[i] = random.AffineMatrix();
+            points[i] = random.Vector(10.0f);
+            random.Bounds(mins[i], maxs[i], 10.0f);
+        }
+        const XrMatrix4x4f viewProjection = random.ViewProjection();
+
+        std::vector<XrPosef> poseResults(ModelNodeCount);
+        std::vector<XrMatrix4x4f> matrixResults(ModelNodeCount);
+        std::vector<XrVector3f> pointResults(ModelNodeCount), minResults(ModelNodeCount), maxResults(ModelNodeCount);
+        std::vector<uint8_t> culled(ModelNodeCount);
+
+        BENCHMARK("MultiplyPoses, 26 hand joints: reference")
+        {
+            LinearBatch::Reference::MultiplyPoses(poseResults.data(), handPose, jointPoses.data(), HandJointCount);
+            return poseResults[0].position.x;
+        };
+        BENCHMARK("MultiplyPoses, 26 hand joints: kernel")
+        {
+            LinearBatch::MultiplyPoses(poseResults.data(), handPose, jointPoses.data(), HandJointCount);
+            return poseResults[0].position.x;
+        };
+
+        BENCHMARK("MultiplyMatrices, 26 hand joints: reference")
+        {
+            LinearBatch::Reference::MultiplyMatrices(matrixResults.data(), viewProjection, jointMatrices.data(), HandJointCount);
+            return matrixResults[0].m[0];
+        };
+        BENCHMARK("MultiplyMatrices, 26 hand joints: kernel")
+        {
+            LinearBatch::MultiplyMatrices(matrixResults.data(), viewProjection, jointMatrices.data(), HandJointCount);
+            return matrixResults[0].m[0];
+        };
+
+        BENCHMARK("MultiplyMatrices, 1000 nodes: reference")
+        {
+            LinearBatch::Reference::MultiplyMatrices(matrixResults.data(), viewProjection, nodeTransforms.data(), ModelNodeCount);
+            return matrixResults[0].m[0];
+        };
+        BENCHMARK("MultiplyMatrices, 1000 nodes: kernel")
+        {
+            LinearBatch::MultiplyMatrices(matrixResults.data(), viewProjection, nodeTransforms.data(), ModelNodeCount);
+            return matrixResults[0].m[0];
+        };
+
+        BENCHMARK("MultiplyMatrixPairs, 1000 nodes: reference")
+        {
+            LinearBatch::Reference::MultiplyMatrixPairs(matrixResults.data(), parentTransforms.data(), nodeTransforms.data(),
+                                                        ModelNodeCount);
+            return matrixResults[0].m[0];
+        };
+        BENCHMARK("MultiplyMatrixPairs, 1000 nodes: kernel")
+        {
+            LinearBatch::MultiplyMatrixPairs(matrixResults.data(), parentTransforms.data(), nodeTransforms.data(), ModelNodeCount);
+            return matrixResults[0].m[0];
+        };
+
+        BENCHMARK("TransformPoints, 1000 points: reference")
+        {
+            LinearBatch::Reference::TransformPoints(pointResults.data(), viewProjection, points.data(), ModelNodeCount);
+            return pointResults[0].x;
+        };
+        BENCHMARK("TransformPoints, 1000 points: kernel")
+        {
+            LinearBatch::TransformPoints(pointResults.data(), viewProjection, points.data(), ModelNodeCount);
+            return pointResults[0].x;
+        };
+
+        BENCHMARK("TransformBounds, 1000 nodes: reference")
+        {
+            LinearBatch::Reference::TransformBounds(minResults.data(), maxResults.data(), nodeTransforms.data(), mins.data(),
+                                                    maxs.data(), ModelNodeCount);
+            return minResults[0].x;
+        };
+        BENCHMARK("TransformBounds, 1000 nodes: kernel")
+        {
+            LinearBatch::TransformBounds(minResults.data(), maxResults.data(), nodeTransforms.data(), mins.data(), maxs.data(),
+                                         ModelNodeCount);
+            return minResults[0].x;
+        };
+
+        BENCHMARK("CullBounds, 1000 nodes: reference")
+        {
+            return LinearBatch::Reference::CullBounds(culled.data(), viewProjection, mins.data(), maxs.data(), ModelNodeCount);
+        };
+        BENCHMARK("CullBounds, 1000 nodes: kernel")
+        {
+            return LinearBatch::CullBounds(culled.data(), viewProjection, mins.data(), maxs.data(), ModelNodeCount);
+        };
+    }
+}  // namespace Conformance
@@ -0,0 +1,72 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utilities/lru_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+
+namespace Conformance
+{
+    TEST_CASE("LruCache", "[self_test]")
+    {
+        LruCache<std::string, int> cache(100);
+        auto insert = [&](const std::string& key, int value, size_t bytes) {
+            return cache.Insert(key, std::make_shared<const int>(value), bytes);
+        };
+
+        SECTION("Evicts the least recently used values to stay within the budget")
+        {
+            insert("a", 1, 40);
+            insert("b", 2, 40);
+            REQUIRE(cache.GetStoredBytes() == 80);
+
+            // Using "a" makes "b" the least recently used.
+            REQUIRE(*cache.Find("a") == 1);
+            insert("c", 3, 40);
+            REQUIRE(cache.Find("b") == nullptr);
+            REQUIRE(*cache.Find("a") == 1);
+            REQUIRE(*cache.Find("c") == 3);
+            REQUIRE(cache.size() == 2);
+            REQUIRE(cache.GetStoredBytes() == 80);
+        }
+
+        SECTION("Keeps the existing value for a key")
+        {
+            insert("a", 1, 10);
+            REQUIRE(*insert("a", 2, 10) == 1);
+            REQUIRE(cache.GetStoredBytes() == 10);
+        }
+
+        SECTION("Does not cache values larger than the budget")
+        {
+            insert("a", 1, 10);
+            REQUIRE(*insert("big", 2, 101) == 2);
+            REQUIRE(cache.Find("big") == nullptr);
+            REQUIRE(*cache.Find("a") == 1);
+        }
+
+        SECTION("Clear drops everything")
+        {
+            insert("a", 1, 10);
+            cache.Clear();
+            REQUIRE(cache.Find("a") == nullptr);
+            REQUIRE(cache.GetStoredBytes() == 0);
+        }
+    }
+}  // namespace Conformance
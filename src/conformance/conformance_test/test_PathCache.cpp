@@ -0,0 +1,102 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "conformance_utils.h"
+#include "path_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <openxr/openxr.h>
+
+#include <string>
+
+namespace Conformance
+{
+    TEST_CASE("PathCache", "[self_test][pooled_instance]")
+    {
+        AutoBasicInstance instance;
+
+        // A cache of its own, so that the counts are not those of the rest of the run.
+        PathCache cache;
+        cache.AddInstance(instance);
+
+        SECTION("Paths are converted by the runtime once, then answered from the cache")
+        {
+            XrPath path = XR_NULL_PATH;
+            REQUIRE(cache.StringToPath(instance, "/path_cache/hit", &path) == XR_SUCCESS);
+            REQUIRE(path != XR_NULL_PATH);
+            CHECK(cache.GetStatistics().runtimeCalls == 1);
+            CHECK(cache.GetStatistics().savedCalls == 0);
+
+            XrPath cachedPath = XR_NULL_PATH;
+            REQUIRE(cache.StringToPath(instance, "/path_cache/hit", &cachedPath) == XR_SUCCESS);
+            CHECK(cachedPath == path);
+            CHECK(cache.GetStatistics().runtimeCalls == 1);
+            CHECK(cache.GetStatistics().savedCalls == 1);
+
+            // The reverse direction was cached along with it, saving both calls of the two-call idiom.
+            std::string pathString;
+            REQUIRE(cache.PathToString(instance, path, &pathString));
+            CHECK(pathString == "/path_cache/hit");
+            CHECK(cache.GetStatistics().runtimeCalls == 1);
+            CHECK(cache.GetStatistics().savedCalls == 3);
+        }
+
+        SECTION("A path the cache has not seen goes to the runtime, and is cached both ways")
+        {
+            XrPath path = XR_NULL_PATH;
+            REQUIRE(xrStringToPath(instance, "/path_cache/miss", &path) == XR_SUCCESS);
+
+            std::string pathString;
+            REQUIRE(cache.PathToString(instance, path, &pathString));
+            CHECK(pathString == "/path_cache/miss");
+            CHECK(cache.GetStatistics().runtimeCalls == 2);
+            CHECK(cache.GetStatistics().savedCalls == 0);
+
+            XrPath cachedPath = XR_NULL_PATH;
+            REQUIRE(cache.StringToPath(instance, "/path_cache/miss", &cachedPath) == XR_SUCCESS);
+            CHECK(cachedPath == path);
+            CHECK(cache.GetStatistics().runtimeCalls == 2);
+            CHECK(cache.GetStatistics().savedCalls == 1);
+        }
+
+        SECTION("Paths the runtime does not intern are not cached")
+        {
+            XrPath path = XR_NULL_PATH;
+            CHECK(cache.StringToPath(instance, "not a path", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+            CHECK(cache.StringToPath(instance, "not a path", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+            CHECK(cache.GetStatistics().runtimeCalls == 2);
+
+            std::string pathString;
+            CHECK_FALSE(cache.PathToString(instance, XR_NULL_PATH, &pathString));
+            CHECK_FALSE(cache.PathToString(instance, XR_NULL_PATH, &pathString));
+            CHECK(cache.GetStatistics().runtimeCalls == 4);
+            CHECK(cache.GetStatistics().savedCalls == 0);
+        }
+
+        SECTION("Instances that are not cached go straight to the runtime")
+        {
+            cache.RemoveInstance(instance);
+
+            XrPath path = XR_NULL_PATH;
+            REQUIRE(cache.StringToPath(instance, "/path_cache/uncached", &path) == XR_SUCCESS);
+            REQUIRE(cache.StringToPath(instance, "/path_cache/uncached", &path) == XR_SUCCESS);
+            CHECK(cache.GetStatistics().runtimeCalls == 2);
+            CHECK(cache.GetStatistics().savedCalls == 0);
+        }
+
+        cache.RemoveInstance(instance);
+    }
+}  // namespace Conformance
@@ -0,0 +1,124 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pbr/PbrDrawList.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        // Stand-ins for materials, meshes and instances: only their addresses are used.
+        int g_materials[3];
+        int g_meshes[3];
+        int g_instances[4];
+
+        /// Add the draws of a model instance the way a backend would: primitives in model order.
+        /// The model has three primitives: two opaque sharing a material, and one alpha-blended.
+        void AddModelInstance(Pbr::DrawList& drawList, std::vector<Pbr::DrawItem>& added, int instance)
+        {
+            const Pbr::DrawItem items[] = {
+                {1, false, &g_materials[0], &g_meshes[0], &g_instances[instance], 0},
+                {2, true, &g_materials[1], &g_meshes[1], &g_instances[instance], 0},
+                {1, false, &g_materials[0], &g_meshes[2], &g_instances[instance], 0},
+            };
+            for (Pbr::DrawItem item : items) {
+                item.userIndex = (uint32_t)added.size();
+                drawList.Add(item);
+                added.push_back(item);
+            }
+        }
+    }  // namespace
+
+    TEST_CASE("PbrDrawList", "[self_test]")
+    {
+        Pbr::DrawList drawList;
+        std::vector<Pbr::DrawItem> added;
+        for (int instance = 0; instance < 4; ++instance) {
+            AddModelInstance(drawList, added, instance);
+        }
+
+        const Pbr::DrawListStats unsorted = Pbr::CountBinds(added);
+        drawList.Sort();
+        const std::vector<Pbr::DrawItem>& sorted = drawList.GetItems();
+        REQUIRE(sorted.size() == added.size());
+
+        SECTION("Every draw is kept")
+        {
+            std::vector<bool> seen(added.size(), false);
+            for (const Pbr::DrawItem& item : sorted) {
+                REQUIRE(item.userIndex < added.size());
+                REQUIRE_FALSE(seen[item.userIndex]);
+                seen[item.userIndex] = true;
+            }
+        }
+
+        SECTION("Opaque draws are grouped and come before blended draws")
+        {
+            size_t firstBlended = sorted.size();
+            for (size_t i = 0; i < sorted.size(); ++i) {
+                if (sorted[i].alphaBlended) {
+                    firstBlended = std::min(firstBlended, i);
+                }
+                else {
+                    REQUIRE(i < firstBlended);
+                }
+            }
+            REQUIRE(firstBlended == 8);
+            for (size_t i = 1; i < firstBlended; ++i) {
+                // Each mesh is bound once, for all the instances that use it.
+                const bool sameMesh = sorted[i].mesh == sorted[i - 1].mesh;
+                REQUIRE((sameMesh || i == 4));
+            }
+        }
+
+        SECTION("Blended draws keep their submission order")
+        {
+            uint32_t previousIndex = 0;
+            for (const Pbr::DrawItem& item : sorted) {
+                if (item.alphaBlended) {
+                    REQUIRE(item.userIndex >= previousIndex);
+                    previousIndex = item.userIndex;
+                }
+            }
+        }
+
+        SECTION("Sorting saves binds")
+        {
+            const Pbr::DrawListStats stats = Pbr::CountBinds(sorted);
+            CAPTURE(unsorted.pipelineBinds, unsorted.materialBinds, unsorted.meshBinds);
+            CAPTURE(stats.pipelineBinds, stats.materialBinds, stats.meshBinds);
+            REQUIRE(stats.draws == 12);
+            REQUIRE(stats.pipelineBinds == 2);
+            REQUIRE(stats.meshBinds == 3);
+            // Instance bindings still change per draw in the opaque group, since it is ordered by mesh first.
+            REQUIRE(stats.materialBinds == 12);
+            REQUIRE(stats.BindsSaved() > unsorted.BindsSaved());
+        }
+
+        SECTION("Clear")
+        {
+            drawList.Clear();
+            REQUIRE(drawList.GetItems().empty());
+            REQUIRE(Pbr::CountBinds(drawList.GetItems()).BindsSaved() == 0);
+        }
+    }
+}  // namespace Conformance
@@ -0,0 +1,189 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pbr/PbrModel.h"
+
+#include "common/xr_linear.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdint.h>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Exposes the transform resolution that the graphics plugins perform before uploading transforms.
+        class TestModelInstance : public Pbr::ModelInstance
+        {
+        public:
+            explicit TestModelInstance(std::shared_ptr<const Pbr::Model> model) : ModelInstance(std::move(model))
+            {
+            }
+
+            /// Resolve and return the range of transforms a graphics plugin would upload.
+            Pbr::NodeIndexRange Resolve(bool transpose)
+            {
+                Pbr::NodeIndexRange range;
+                if (ResolvedTransformsNeedUpdate()) {
+                    ResolveTransformsAndVisibilities(transpose);
+                    range = GetUpdatedTransformRange();
+                    MarkResolvedTransformsUpdated();
+                }
+                return range;
+            }
+
+            using ModelInstance::GetResolvedTransforms;
+        };
+
+        struct NodeEdit
+        {
+            Pbr::NodeIndex_t node;
+            bool isVisibility;
+            Pbr::NodeVisibility visibility;
+            XrMatrix4x4f transform;
+        };
+
+        void ApplyEdit(Pbr::ModelInstance& instance, const NodeEdit& edit)
+        {
+            if (edit.isVisibility) {
+                instance.SetNodeVisibility(edit.node, edit.visibility);
+            }
+            else {
+                instance.SetNodeTransform(edit.node, edit.transform);
+            }
+        }
+
+        XrMatrix4x4f RandomTransform(std::mt19937& rng)
+        {
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            XrQuaternionf orientation{dist(rng), dist(rng), dist(rng), 1.0f};
+            XrQuaternionf_Normalize(&orientation);
+            const XrVector3f translation{dist(rng), dist(rng), dist(rng)};
+            const XrVector3f scale{1.0f, 1.0f, 1.0f};
+            XrMatrix4x4f transform;
+            XrMatrix4x4f_CreateTranslationRotationScale(&transform, &translation, &orientation, &scale);
+            return transform;
+        }
+
+        void RequireSameTransforms(const std::vector<XrMatrix4x4f>& actual, const std::vector<XrMatrix4x4f>& expected)
+        {
+            REQUIRE(actual.size() == expected.size());
+            for (size_t node = 0; node < actual.size(); ++node) {
+                CAPTURE(node);
+                for (int i = 0; i < 16; ++i) {
+                    REQUIRE_THAT(actual[node].m[i], Catch::Matchers::WithinAbs(expected[node].m[i], 1e-5));
+                }
+            }
+        }
+    }  // namespace
+
+    TEST_CASE("PbrModelInstance", "[self_test]")
+    {
+        // Node 0 is the root added by the Model constructor.
+        // 1 and 2 are children of the root, 3 and 4 of 1, 5 of 3, 6 of 2.
+        auto model = std::make_shared<Pbr::Model>();
+        std::mt19937 rng(1234);
+        const Pbr::NodeIndex_t parents[] = {0, 0, 1, 1, 3, 2};
+        for (Pbr::NodeIndex_t parent : parents) {
+            model->AddNode(RandomTransform(rng), parent);
+        }
+        const bool transpose = GENERATE(false, true);
+        CAPTURE(transpose);
+
+        TestModelInstance instance(model);
+        Pbr::NodeIndexRange range = instance.Resolve(transpose);
+        REQUIRE(range.begin == 0);
+        REQUIRE(range.end == model->GetNodeCount());
+
+        SECTION("Nothing changed")
+        {
+            REQUIRE(instance.Resolve(transpose).empty());
+        }
+
+        SECTION("Only the changed subtree is resolved")
+        {
+            // A leaf.
+            instance.SetNodeTransform(6, RandomTransform(rng));
+            range = instance.Resolve(transpose);
+            REQUIRE(range.begin == 6);
+            REQUIRE(range.size() == 1);
+
+            // 3 and its child 5, but not its sibling 4.
+            const std::vector<XrMatrix4x4f> before = instance.GetResolvedTransforms();
+            instance.SetNodeTransform(3, RandomTransform(rng));
+            range = instance.Resolve(transpose);
+            REQUIRE(range.begin == 3);
+            REQUIRE(range.end == 6);
+            const std::vector<XrMatrix4x4f>& after = instance.GetResolvedTransforms();
+            RequireSameTransforms({after[4]}, {before[4]});
+            REQUIRE(memcmp(&after[3], &before[3], sizeof(XrMatrix4x4f)) != 0);
+            REQUIRE(memcmp(&after[5], &before[5], sizeof(XrMatrix4x4f)) != 0);
+        }
+
+        SECTION("Visible child of an invisible node keeps its transform")
+        {
+            const XrMatrix4x4f childTransform = instance.GetResolvedTransforms()[5];
+            instance.SetNodeVisibility(3, Pbr::NodeVisibility::Invisible);
+            instance.SetNodeVisibility(5, Pbr::NodeVisibility::Visible);
+            instance.Resolve(transpose);
+
+            XrMatrix4x4f zero;
+            XrMatrix4x4f_CreateScale(&zero, 0, 0, 0);
+            RequireSameTransforms({instance.GetResolvedTransforms()[3]}, {zero});
+            RequireSameTransforms({instance.GetResolvedTransforms()[5]}, {childTransform});
+
+            // Changing only the child must still use the unzeroed transform of its invisible parent.
+            instance.SetNodeVisibility(5, Pbr::NodeVisibility::Inherit);
+            instance.SetNodeVisibility(5, Pbr::NodeVisibility::Visible);
+            range = instance.Resolve(transpose);
+            REQUIRE(range.begin == 5);
+            REQUIRE(range.size() == 1);
+            RequireSameTransforms({instance.GetResolvedTransforms()[5]}, {childTransform});
+        }
+
+        SECTION("Incremental resolution matches resolving everything")
+        {
+            std::vector<NodeEdit> edits;
+            std::uniform_int_distribution<int> nodeDist(0, model->GetNodeCount() - 1);
+            std::uniform_int_distribution<int> visibilityDist(0, 2);
+            for (int frame = 0; frame < 50; ++frame) {
+                CAPTURE(frame);
+                const int editCount = frame % 3;
+                for (int i = 0; i < editCount; ++i) {
+                    NodeEdit edit{(Pbr::NodeIndex_t)nodeDist(rng), (rng() % 4) == 0, (Pbr::NodeVisibility)visibilityDist(rng),
+                                  RandomTransform(rng)};
+                    ApplyEdit(instance, edit);
+                    edits.push_back(edit);
+                }
+                instance.Resolve(transpose);
+
+                TestModelInstance reference(model);
+                for (const NodeEdit& edit : edits) {
+                    ApplyEdit(reference, edit);
+                }
+                reference.Resolve(transpose);
+                RequireSameTransforms(instance.GetResolvedTransforms(), reference.GetResolvedTransforms());
+            }
+        }
+    }
+}  // namespace Conformance
@@ -0,0 +1,202 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "RGBAImage.h"
+#include "composition_utils.h"
+#include "utilities/colors.h"
+#include "utilities/pixel_kernels.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openxr/openxr.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        std::vector<uint8_t> MakeRandomBytes(size_t count, uint32_t seed)
+        {
+            std::mt19937 engine(seed);
+            std::uniform_int_distribution<int> dist(0, 255);
+            std::vector<uint8_t> bytes(count);
+            for (uint8_t& b : bytes) {
+                b = (uint8_t)dist(engine);
+            }
+            return bytes;
+        }
+
+        /// The per-pixel conversion RGBAImage::ConvertToSRGB used before the pixel kernels.
+        void ConvertToSRGBWithPow(RGBAImage& image)
+        {
+            for (RGBA8Color& pixel : image.pixels) {
+                pixel.Channels.R = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.R / 255.0) * 255.0);
+                pixel.Channels.G = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.G / 255.0) * 255.0);
+                pixel.Channels.B = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.B / 255.0) * 255.0);
+            }
+        }
+
+        constexpr const char* kBenchmarkText =
+            "The quick brown fox jumps over the lazy dog. This description is long enough to wrap over several lines, "
+            "like the instructions shown next to an interactive composition test.";
+    }  // namespace
+
+    TEST_CASE("PixelKernels", "[self_test]")
+    {
+        INFO("Instruction set: " << PixelKernels::GetInstructionSetName());
+
+        // Odd counts and offsets exercise unaligned access and the scalar tails of each kernel.
+        const size_t counts[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 67, 1000};
+
+        SECTION("ConvertLinearToSRGB matches ColorUtils::ToSRGB")
+        {
+            std::vector<uint8_t> rgba(256 * 4);
+            for (size_t i = 0; i < 256; ++i) {
+                rgba[i * 4 + 0] = rgba[i * 4 + 1] = rgba[i * 4 + 2] = (uint8_t)i;
+                rgba[i * 4 + 3] = (uint8_t)(255 - i);
+            }
+            PixelKernels::ConvertLinearToSRGB(rgba.data(), 256);
+            for (size_t i = 0; i < 256; ++i) {
+                INFO(i);
+                const uint8_t expected = (uint8_t)(ColorUtils::ToSRGB((double)i / 255.0) * 255.0);
+                REQUIRE(rgba[i * 4 + 0] == expected);
+                REQUIRE(rgba[i * 4 + 1] == expected);
+                REQUIRE(rgba[i * 4 + 2] == expected);
+                REQUIRE(rgba[i * 4 + 3] == (uint8_t)(255 - i));
+            }
+        }
+
+        SECTION("Fill")
+        {
+            for (size_t count : counts) {
+                INFO(count);
+                std::vector<uint32_t> actual(count + 2, 0xdeadbeef);
+                PixelKernels::Fill(actual.data() + 1, count, 0x11223344);
+                REQUIRE(actual.front() == 0xdeadbeef);
+                REQUIRE(actual.back() == 0xdeadbeef);
+                for (size_t i = 1; i <= count; ++i) {
+                    REQUIRE(actual[i] == 0x11223344);
+                }
+            }
+        }
+
+        SECTION("BlendCoverage matches reference")
+        {
+            const PixelKernels::RGBA8 colors[] = {{255, 255, 255, 255}, {0, 0, 0, 0}, {12, 200, 99, 200}};
+            for (const PixelKernels::RGBA8& color : colors) {
+                for (size_t count : counts) {
+                    INFO(count);
+                    std::vector<uint8_t> coverage = MakeRandomBytes(count + 1, (uint32_t)count);
+                    // Include the extremes, which must leave the destination untouched or replace it.
+                    if (count >= 2) {
+                        coverage[1] = 0;
+                        coverage[2] = 255;
+                    }
+                    std::vector<uint8_t> expected = MakeRandomBytes((count + 1) * 4, (uint32_t)count + 1000);
+                    std::vector<uint8_t> actual = expected;
+                    PixelKernels::Reference::BlendCoverage(expected.data() + 4, coverage.data() + 1, count, color);
+                    PixelKernels::BlendCoverage(actual.data() + 4, coverage.data() + 1, count, color);
+                    REQUIRE(actual == expected);
+                }
+            }
+        }
+
+        SECTION("ExpandRGBToRGBA matches reference")
+        {
+            for (size_t count : counts) {
+                INFO(count);
+                const std::vector<uint8_t> rgb = MakeRandomBytes(count * 3 + 1, (uint32_t)count);
+                std::vector<uint8_t> expected(count * 4 + 1, 0);
+                std::vector<uint8_t> actual(count * 4 + 1, 0);
+                PixelKernels::Reference::ExpandRGBToRGBA(rgb.data() + 1, expected.data() + 1, count);
+                PixelKernels::ExpandRGBToRGBA(rgb.data() + 1, actual.data() + 1, count);
+                REQUIRE(actual == expected);
+            }
+        }
+    }
+
+    TEST_CASE("PixelKernelsBenchmark", "[self_test][benchmark][.]")
+    {
+        INFO("Instruction set: " << PixelKernels::GetInstructionSetName());
+
+        constexpr int32_t Width = 1024;
+        constexpr int32_t Height = 1024;
+        const std::vector<uint8_t> noise = MakeRandomBytes(Width * Height * 4, 1);
+
+        RGBAImage image(Width, Height);
+        auto resetImage = [&] { memcpy(image.pixels.data(), noise.data(), noise.size()); };
+
+        resetImage();
+        BENCHMARK("ConvertToSRGB: pow per channel (before)")
+        {
+            ConvertToSRGBWithPow(image);
+            return image.pixels[0].Pixel;
+        };
+        resetImage();
+        BENCHMARK("ConvertToSRGB: lookup table (after)")
+        {
+            image.ConvertToSRGB();
+            return image.pixels[0].Pixel;
+        };
+
+        std::vector<uint32_t> row(Width);
+        BENCHMARK("Fill: reference")
+        {
+            PixelKernels::Reference::Fill(row.data(), row.size(), 0xff00ff00);
+            return row[0];
+        };
+        BENCHMARK("Fill: kernel")
+        {
+            PixelKernels::Fill(row.data(), row.size(), 0xff00ff00);
+            return row[0];
+        };
+
+        const std::vector<uint8_t> coverage = MakeRandomBytes(Width * Height, 2);
+        const PixelKernels::RGBA8 white{255, 255, 255, 255};
+        BENCHMARK("BlendCoverage: reference")
+        {
+            PixelKernels::Reference::BlendCoverage(&image.pixels.data()->Channels.R, coverage.data(), coverage.size(), white);
+            return image.pixels[0].Pixel;
+        };
+        BENCHMARK("BlendCoverage: kernel")
+        {
+            PixelKernels::BlendCoverage(&image.pixels.data()->Channels.R, coverage.data(), coverage.size(), white);
+            return image.pixels[0].Pixel;
+        };
+
+        const std::vector<uint8_t> rgb = MakeRandomBytes(Width * Height * 3, 3);
+        BENCHMARK("ExpandRGBToRGBA: reference")
+        {
+            PixelKernels::Reference::ExpandRGBToRGBA(rgb.data(), &image.pixels.data()->Channels.R, image.pixels.size());
+            return image.pixels[0].Pixel;
+        };
+        BENCHMARK("ExpandRGBToRGBA: kernel")
+        {
+            PixelKernels::ExpandRGBToRGBA(rgb.data(), &image.pixels.data()->Channels.R, image.pixels.size());
+            return image.pixels[0].Pixel;
+        };
+
+        BENCHMARK("CreateTextImage 1024x512")
+        {
+            return CreateTextImage(1024, 512, kBenchmarkText, 48).pixels[0].Pixel;
+        };
+    }
+}  // namespace Conformance
@@ -17,6 +17,7 @@
 #include "conformance_utils.h"
 #include "conformance_framework.h"
 #include "matchers.h"
+#include "utilities/event_reader.h"
 #include "utilities/utils.h"
 #include "utilities/throw_helpers.h"
 
@@ -31,7 +32,6 @@
 #include <initializer_list>
 #include <ratio>
 #include <string>
-#include <thread>
 #include <vector>
 
 #define AS_LIST(name, val) name,
@@ -41,7 +41,7 @@ constexpr XrViewConfigurationType KnownViewTypes[] = {XR_LIST_ENUM_XrViewConfigu
 namespace Conformance
 {
 
-    TEST_CASE("SessionState", "")
+    TEST_CASE("SessionState", "[exclusive_session]")
     {
         AutoBasicSession session(AutoBasicSession::createSession);
         REQUIRE_MSG(session != XR_NULL_HANDLE_CPP,
@@ -50,36 +50,24 @@ namespace Conformance
         XrInstance instance = session.GetInstance();
         XrSystemId systemId = session.GetSystemId();
 
-        auto tryReadEvent = [&](XrEventDataBuffer* evt) {
-            *evt = {XR_TYPE_EVENT_DATA_BUFFER};
-            XrResult res;
-            XRC_CHECK_THROW_XRCMD(res = xrPollEvent(session.GetInstance(), evt));
-            return res == XR_SUCCESS;
-        };
+        EventReader eventReader(session.GetEventQueue());
 
         auto tryGetNextSessionState = [&](XrEventDataSessionStateChanged* evt) {
             XrEventDataBuffer buffer;
-            while (tryReadEvent(&buffer)) {
-                if (buffer.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
-                    *evt = *reinterpret_cast<XrEventDataSessionStateChanged*>(&buffer);
-                    return true;
-                }
+            if (!eventReader.TryReadUntilEvent(buffer, XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED)) {
+                return false;
             }
-
-            return false;
+            *evt = *reinterpret_cast<XrEventDataSessionStateChanged*>(&buffer);
+            return true;
         };
 
         auto waitForNextSessionState = [&](XrEventDataSessionStateChanged* evt, std::chrono::nanoseconds duration = 1s) {
-            CountdownTimer countdown(duration);
-            while (!countdown.IsTimeUp()) {
-                if (tryGetNextSessionState(evt)) {
-                    return true;
-                }
-
-                std::this_thread::sleep_for(5ms);
+            XrEventDataBuffer buffer;
+            if (!eventReader.WaitForEvent(buffer, XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED, duration)) {
+                return false;
             }
-
-            return false;
+            *evt = *reinterpret_cast<XrEventDataSessionStateChanged*>(&buffer);
+            return true;
         };
 
         XrEventDataSessionStateChanged evt{};
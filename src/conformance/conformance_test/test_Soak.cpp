@@ -0,0 +1,227 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "composition_utils.h"
+#include "conformance_framework.h"
+#include "conformance_utils.h"
+#include "report.h"
+#include "soak_monitor.h"
+#include "utilities/colors.h"
+#include "utilities/throw_helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <openxr/openxr.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Resident memory growth below this is allocator and cache noise rather than a leak.
+        constexpr int64_t ResidentGrowthWarningBytes = 64 * 1024 * 1024;
+        /// p95 latency at the end of the run beyond this many times the p95 at the start is reported as latency creep.
+        constexpr double LatencyCreepWarningRatio = 1.5;
+
+        constexpr size_t SpaceHandleIndex = SoakHandleTypeIndex(XR_OBJECT_TYPE_SPACE);
+        static_assert(SpaceHandleIndex < SoakHandleTypes.size(), "Spaces must be sampled");
+
+        void ReportSample(const SoakSample& sample)
+        {
+            using ms = std::chrono::duration<float, std::milli>;
+            ReportF("Soak frame %llu (%.0fs): RSS %.1fMiB, process handles %llu, spaces %u, "
+                    "p95 frame %.3fms, sync %.3fms, locate %.3fms, end %.3fms",
+                    (unsigned long long)sample.frame, sample.elapsedSeconds, sample.residentBytes / (1024.0 * 1024.0),
+                    (unsigned long long)sample.processHandles, sample.xrHandles[SpaceHandleIndex],
+                    std::chrono::duration_cast<ms>(sample.frameInterval.p95).count(),
+                    std::chrono::duration_cast<ms>(sample.syncActions.p95).count(),
+                    std::chrono::duration_cast<ms>(sample.locateSpace.p95).count(),
+                    std::chrono::duration_cast<ms>(sample.endFrame.p95).count());
+        }
+
+        void WarnOnLatencyCreep(const char* call, double ratio)
+        {
+            if (ratio > LatencyCreepWarningRatio) {
+                WARN(call << " p95 latency grew " << ratio << "x over the soak run");
+            }
+        }
+    }  // namespace
+
+    // Runs a realistic frame loop - projection and quad layers, action sync and space location - for a long time,
+    // sampling memory, handles and latency to find leaks and latency creep that only appear after hours.
+    // Select with [soak] and set the duration with --soakDuration.
+    TEST_CASE("Soak_Frame_Loop", "[soak][exclusive_session][.]")
+    {
+        using Clock = std::chrono::steady_clock;
+
+        GlobalData& globalData = GetGlobalData();
+        if (!globalData.IsUsingGraphicsPlugin()) {
+            // Nothing to check - no graphics plugin means no frame submission
+            return;
+        }
+        const std::chrono::seconds soakDuration(globalData.options.soakDurationSeconds);
+        const uint32_t sampleFrames = std::max(globalData.options.soakSampleFrames, 1u);
+
+        CompositionHelper compositionHelper("Soak");
+        const XrInstance instance = compositionHelper.GetInstance();
+        const XrSession session = compositionHelper.GetSession();
+        InteractionManager& interactionManager = compositionHelper.GetInteractionManager();
+
+        XrActionSet actionSet{XR_NULL_HANDLE};
+        XrAction selectAction{XR_NULL_HANDLE};
+        XrAction gripPoseAction{XR_NULL_HANDLE};
+        {
+            XrActionSetCreateInfo actionSetInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+            strcpy(actionSetInfo.actionSetName, "soak");
+            strcpy(actionSetInfo.localizedActionSetName, "Soak");
+            XRC_CHECK_THROW_XRCMD(xrCreateActionSet(instance, &actionSetInfo, &actionSet));
+
+            XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
+            actionInfo.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
+            strcpy(actionInfo.actionName, "select");
+            strcpy(actionInfo.localizedActionName, "Select");
+            XRC_CHECK_THROW_XRCMD(xrCreateAction(actionSet, &actionInfo, &selectAction));
+
+            actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
+            strcpy(actionInfo.actionName, "grip_pose");
+            strcpy(actionInfo.localizedActionName, "Grip pose");
+            XRC_CHECK_THROW_XRCMD(xrCreateAction(actionSet, &actionInfo, &gripPoseAction));
+        }
+        interactionManager.AddActionSet(actionSet);
+        interactionManager.AddActionBindings(StringToPath(instance, "/interaction_profiles/khr/simple_controller"),
+                                             {{selectAction, StringToPath(instance, "/user/hand/left/input/select/click")},
+                                              {selectAction, StringToPath(instance, "/user/hand/right/input/select/click")},
+                                              {gripPoseAction, StringToPath(instance, "/user/hand/right/input/grip/pose")}});
+        interactionManager.AttachActionSets();
+        compositionHelper.BeginSession();
+
+        SimpleProjectionLayerHelper simpleProjectionLayerHelper(compositionHelper);
+        const XrSpace localSpace = simpleProjectionLayerHelper.GetLocalSpace();
+
+        XrSpace gripSpace{XR_NULL_HANDLE};
+        {
+            XrActionSpaceCreateInfo spaceCreateInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+            spaceCreateInfo.action = gripPoseAction;
+            spaceCreateInfo.poseInActionSpace = Pose::Identity;
+            XRC_CHECK_THROW_XRCMD(xrCreateActionSpace(session, &spaceCreateInfo, &gripSpace));
+        }
+
+        const XrSpace viewSpace = compositionHelper.CreateReferenceSpace(XR_REFERENCE_SPACE_TYPE_VIEW);
+        const XrSwapchain quadSwapchain = compositionHelper.CreateStaticSwapchainSolidColor(Colors::Orange);
+        XrCompositionLayerQuad* const quadLayer =
+            compositionHelper.CreateQuadLayer(quadSwapchain, viewSpace, 0.25f, XrPosef{Quat::Identity, {0.5f, -0.3f, -1.5f}});
+
+        XrHandleCounter xrHandleCounter(instance);
+        if (!xrHandleCounter.IsAvailable()) {
+            WARN("The conformance layer is not enabled: open XR handles are not sampled");
+        }
+
+        // Buffers are allocated before the loop so that the test itself does not grow while measuring.
+        // The samples are reserved for display rates up to 144Hz.
+        std::vector<SoakSample> samples;
+        samples.reserve((size_t)(soakDuration.count() * 144 / sampleFrames) + 2);
+        LatencyWindow frameIntervals(sampleFrames), syncLatencies(sampleFrames), locateLatencies(sampleFrames),
+            endFrameLatencies(sampleFrames);
+
+        const Clock::time_point start = Clock::now();
+        Clock::time_point lastFrameStart = start;
+        uint64_t frame = 0;
+
+        auto takeSample = [&](Clock::time_point now) {
+            SoakSample sample;
+            sample.frame = frame;
+            sample.elapsedSeconds = std::chrono::duration<double>(now - start).count();
+            GetProcessResidentMemory(sample.residentBytes);
+            GetProcessHandleCount(sample.processHandles);
+            for (size_t i = 0; i < SoakHandleTypes.size(); ++i) {
+                sample.xrHandles[i] = xrHandleCounter.Count(SoakHandleTypes[i]);
+            }
+            sample.frameInterval = frameIntervals.TakePercentiles();
+            sample.syncActions = syncLatencies.TakePercentiles();
+            sample.locateSpace = locateLatencies.TakePercentiles();
+            sample.endFrame = endFrameLatencies.TakePercentiles();
+            samples.push_back(sample);
+            ReportSample(sample);
+        };
+
+        std::vector<XrCompositionLayerBaseHeader*> layers;
+        layers.reserve(2);
+        auto endFrame = [&](const XrFrameState& frameState) {
+            const Clock::time_point frameStart = Clock::now();
+            if (frame > 0) {
+                frameIntervals.Add(frameStart - lastFrameStart);
+            }
+            lastFrameStart = frameStart;
+
+            Clock::time_point callStart = Clock::now();
+            interactionManager.SyncActions(XR_NULL_PATH);
+            syncLatencies.Add(Clock::now() - callStart);
+
+            XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+            callStart = Clock::now();
+            XRC_CHECK_THROW_XRCMD(xrLocateSpace(gripSpace, localSpace, frameState.predictedDisplayTime, &location));
+            locateLatencies.Add(Clock::now() - callStart);
+
+            layers.clear();
+            if (XrCompositionLayerBaseHeader* projLayer = simpleProjectionLayerHelper.TryGetUpdatedProjectionLayer(frameState)) {
+                layers.push_back(projLayer);
+            }
+            layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(quadLayer));
+
+            callStart = Clock::now();
+            compositionHelper.EndFrame(frameState.predictedDisplayTime, layers);
+            const Clock::time_point frameEnd = Clock::now();
+            endFrameLatencies.Add(frameEnd - callStart);
+
+            ++frame;
+            if (frame % sampleFrames == 0) {
+                takeSample(frameEnd);
+            }
+            return frameEnd - start < soakDuration;
+        };
+        RenderLoop(session, endFrame).Loop();
+        takeSample(Clock::now());
+
+        if (!globalData.options.soakCsv.empty() && !WriteSoakCsv(globalData.options.soakCsv, samples)) {
+            WARN("Failed to write soak samples to " << globalData.options.soakCsv);
+        }
+
+        const SoakTrend trend = ComputeSoakTrend(samples);
+        ReportF("Soak over %llu frames: RSS growth %.1fMiB, process handle growth %lld", (unsigned long long)frame,
+                trend.residentBytesGrowth / (1024.0 * 1024.0), (long long)trend.processHandlesGrowth);
+        if (trend.residentBytesGrowth > ResidentGrowthWarningBytes) {
+            WARN("Resident memory grew " << trend.residentBytesGrowth / (1024 * 1024) << "MiB over the soak run");
+        }
+        if (trend.processHandlesGrowth > 0) {
+            WARN("Process handle count grew by " << trend.processHandlesGrowth << " over the soak run");
+        }
+        WarnOnLatencyCreep("Frame interval", trend.frameIntervalP95Ratio);
+        WarnOnLatencyCreep("xrSyncActions", trend.syncActionsP95Ratio);
+        WarnOnLatencyCreep("xrLocateSpace", trend.locateSpaceP95Ratio);
+        WarnOnLatencyCreep("xrEndFrame", trend.endFrameP95Ratio);
+
+        // The loop creates no OpenXR handles, so any growth is a leak.
+        for (size_t i = 0; i < SoakHandleTypes.size(); ++i) {
+            INFO("Open " << SoakHandleTypeNames[i] << " handles");
+            CHECK(trend.xrHandlesGrowth[i] == 0);
+        }
+
+        XRC_CHECK_THROW_XRCMD(xrDestroySpace(gripSpace));
+    }
+}  // namespace Conformance
@@ -0,0 +1,132 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "soak_monitor.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        using ns = std::chrono::nanoseconds;
+
+        constexpr size_t SpaceHandleIndex = SoakHandleTypeIndex(XR_OBJECT_TYPE_SPACE);
+        static_assert(SpaceHandleIndex < SoakHandleTypes.size(), "Spaces must be sampled");
+
+        SoakSample MakeSample(uint64_t frame, uint64_t residentBytes, uint32_t spaces, int64_t endFrameP95)
+        {
+            SoakSample sample;
+            sample.frame = frame;
+            sample.residentBytes = residentBytes;
+            sample.processHandles = 10;
+            sample.xrHandles[SpaceHandleIndex] = spaces;
+            sample.frameInterval.p95 = ns(11000000);
+            sample.syncActions.p95 = ns(100000);
+            sample.locateSpace.p95 = ns(50000);
+            sample.endFrame.p95 = ns(endFrameP95);
+            return sample;
+        }
+    }  // namespace
+
+    TEST_CASE("SoakMonitor", "[self_test]")
+    {
+        SECTION("Latency windows restart after each sample")
+        {
+            LatencyWindow window(4);
+            for (int i = 1; i <= 6; ++i) {
+                window.Add(ns(i));
+            }
+            // Only the first four fit the preallocated window.
+            const DurationPercentiles first = window.TakePercentiles();
+            REQUIRE(first.max == ns(4));
+            REQUIRE(first.p50 == ns(2));
+
+            window.Add(ns(9));
+            REQUIRE(window.TakePercentiles().max == ns(9));
+            REQUIRE(window.TakePercentiles().max == ns(0));
+        }
+
+        SECTION("Steady samples show no trend")
+        {
+            std::vector<SoakSample> samples;
+            for (uint64_t i = 0; i < 8; ++i) {
+                samples.push_back(MakeSample(i * 900, 100000000, 4, 2000000));
+            }
+            const SoakTrend trend = ComputeSoakTrend(samples);
+            REQUIRE(trend.residentBytesGrowth == 0);
+            REQUIRE(trend.processHandlesGrowth == 0);
+            REQUIRE(trend.xrHandlesGrowth[SpaceHandleIndex] == 0);
+            REQUIRE(trend.frameIntervalP95Ratio == 1.0);
+            REQUIRE(trend.endFrameP95Ratio == 1.0);
+        }
+
+        SECTION("Leaks and latency creep compare the first and last quarters")
+        {
+            std::vector<SoakSample> samples;
+            for (uint64_t i = 0; i < 8; ++i) {
+                samples.push_back(MakeSample(i * 900, 100000000 + i * 1000000, 4 + (uint32_t)i, 2000000 + (int64_t)i * 1000000));
+            }
+            // A spike in the middle is not a trend.
+            samples[4].residentBytes = 900000000;
+
+            const SoakTrend trend = ComputeSoakTrend(samples);
+            // First quarter averages samples 0 and 1, the last quarter samples 6 and 7.
+            REQUIRE(trend.residentBytesGrowth == 6000000);
+            REQUIRE(trend.xrHandlesGrowth[SpaceHandleIndex] == 7);
+            REQUIRE(trend.endFrameP95Ratio == (8.5 / 2.5));
+            REQUIRE(trend.syncActionsP95Ratio == 1.0);
+        }
+
+        SECTION("Process state is reported")
+        {
+#if defined(XR_OS_LINUX) || defined(XR_OS_WINDOWS) || defined(XR_OS_APPLE)
+            uint64_t residentBytes = 0;
+            REQUIRE(GetProcessResidentMemory(residentBytes));
+            REQUIRE(residentBytes > 0);
+
+            uint64_t handles = 0;
+            REQUIRE(GetProcessHandleCount(handles));
+            REQUIRE(handles > 0);
+#endif
+        }
+
+        SECTION("CSV time series")
+        {
+            const std::string path = "soak_monitor_self_test.csv";
+            REQUIRE(WriteSoakCsv(path, {MakeSample(900, 1024, 3, 2000000), MakeSample(1800, 2048, 3, 2000000)}));
+            std::vector<std::string> lines;
+            {
+                std::ifstream file(path);
+                std::string line;
+                while (std::getline(file, line)) {
+                    lines.push_back(line);
+                }
+            }
+            std::remove(path.c_str());
+
+            REQUIRE(lines.size() == 3);
+            REQUIRE(lines[0].compare(0, 51, "frame,elapsedSeconds,residentBytes,processHandles,x") == 0);
+            REQUIRE(lines[2].compare(0, 23, "1800,0,2048,10,0,3,0,0,") == 0);
+        }
+    }
+}  // namespace Conformance
@@ -0,0 +1,136 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "conformance_framework.h"
+#include "conformance_utils.h"
+#include "report.h"
+#include "space_locator.h"
+#include "utilities/types_and_constants.h"
+#include "xr_math_approx.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <openxr/openxr.h>
+
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    using namespace openxr::math_operators;
+
+    TEST_CASE("SpaceLocator", "[benchmark][exclusive_session][.]")
+    {
+        GlobalData& globalData = GetGlobalData();
+
+        std::vector<const char*> extensions;
+        if (globalData.IsInstanceExtensionSupported(XR_KHR_LOCATE_SPACES_EXTENSION_NAME)) {
+            extensions.push_back(XR_KHR_LOCATE_SPACES_EXTENSION_NAME);
+        }
+        AutoBasicInstance instance(extensions, AutoBasicInstance::createSystemId);
+        AutoBasicSession session(AutoBasicSession::createSession | AutoBasicSession::beginSession | AutoBasicSession::createSwapchains |
+                                     AutoBasicSession::createSpaces,
+                                 instance);
+
+        FrameIterator frameIterator(&session);
+        frameIterator.RunToSessionState(XR_SESSION_STATE_FOCUSED);
+        REQUIRE(frameIterator.SubmitFrame() == FrameIterator::RunResult::Success);
+        const XrTime time = frameIterator.frameState.predictedDisplayTime;
+
+        XrSpace baseSpace = XR_NULL_HANDLE_CPP;
+        XrReferenceSpaceCreateInfo createInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+        createInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+        createInfo.poseInReferenceSpace = Pose::Identity;
+        REQUIRE_RESULT(xrCreateReferenceSpace(session, &createInfo, &baseSpace), XR_SUCCESS);
+        XrSpace viewSpace = XR_NULL_HANDLE_CPP;
+        createInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+        REQUIRE_RESULT(xrCreateReferenceSpace(session, &createInfo, &viewSpace), XR_SUCCESS);
+        createInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+
+        // Spaces in a grid in front of the base space, like the props of a scene.
+        constexpr size_t MaxSpaceCount = 500;
+        std::vector<XrSpace> spaces;
+        std::vector<XrPosef> poses;
+        for (size_t i = 0; i < MaxSpaceCount; ++i) {
+            createInfo.poseInReferenceSpace = XrPosef{{0, 0, 0, 1}, {float(i % 10), float((i / 10) % 10), -float(i / 100)}};
+            XrSpace space = XR_NULL_HANDLE_CPP;
+            REQUIRE_RESULT(xrCreateReferenceSpace(session, &createInfo, &space), XR_SUCCESS);
+            spaces.push_back(space);
+            poses.push_back(createInfo.poseInReferenceSpace);
+        }
+
+        SpaceLocator batched(instance, session);
+        SpaceLocator unbatched(instance, session, false);
+        ReportF("SpaceLocator: %s", batched.IsBatched() ? "locating spaces in batches" : "no xrLocateSpaces, falling back");
+
+        // The locator finds the same locations as locating each space on its own.
+        for (SpaceLocator* locator : {&batched, &unbatched}) {
+            std::vector<SpaceLocator::Ticket> tickets;
+            for (XrSpace space : spaces) {
+                tickets.push_back(locator->Request(space, baseSpace, time));
+            }
+            // A request relative to another base space is located separately.
+            const SpaceLocator::Ticket fromView = locator->Request(spaces[0], viewSpace, time);
+            REQUIRE_RESULT(locator->Resolve(), XR_SUCCESS);
+
+            for (size_t i = 0; i < spaces.size(); ++i) {
+                const XrSpaceLocation location = locator->GetLocation(tickets[i]);
+                INFO("Space " << i);
+                REQUIRE((location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) != 0);
+                REQUIRE((location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) != 0);
+                REQUIRE(location.pose.position == Vector::Approx(poses[i].position));
+                REQUIRE(location.pose.orientation == Quat::Approx(poses[i].orientation));
+            }
+            XrSpaceLocation expected{XR_TYPE_SPACE_LOCATION};
+            REQUIRE_RESULT(xrLocateSpace(spaces[0], viewSpace, time, &expected), XR_SUCCESS);
+            const XrSpaceLocation location = locator->GetLocation(fromView);
+            CHECK(location.locationFlags == expected.locationFlags);
+            if ((expected.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) != 0) {
+                CHECK(location.pose.position == Vector::Approx(expected.pose.position));
+            }
+            locator->Clear();
+        }
+
+        const uint64_t batchedCallsBefore = batched.GetRuntimeCallCount();
+        const uint64_t unbatchedCallsBefore = unbatched.GetRuntimeCallCount();
+        for (size_t spaceCount : {2, 50, 500}) {
+            // One frame's worth of locations.
+            const auto locateFrame = [&](SpaceLocator& locator) {
+                locator.Clear();
+                for (size_t i = 0; i < spaceCount; ++i) {
+                    locator.Request(spaces[i], baseSpace, time);
+                }
+                return locator.Resolve();
+            };
+            BENCHMARK("Locate " + std::to_string(spaceCount) + " spaces: xrLocateSpace each (before)")
+            {
+                return locateFrame(unbatched);
+            };
+            BENCHMARK("Locate " + std::to_string(spaceCount) + " spaces: SpaceLocator (after)")
+            {
+                return locateFrame(batched);
+            };
+        }
+        ReportF("SpaceLocator: %d runtime calls batched, %d unbatched", (int)(batched.GetRuntimeCallCount() - batchedCallsBefore),
+                (int)(unbatched.GetRuntimeCallCount() - unbatchedCallsBefore));
+
+        for (XrSpace space : spaces) {
+            REQUIRE_RESULT(xrDestroySpace(space), XR_SUCCESS);
+        }
+        REQUIRE_RESULT(xrDestroySpace(viewSpace), XR_SUCCESS);
+        REQUIRE_RESULT(xrDestroySpace(baseSpace), XR_SUCCESS);
+    }
+}  // namespace Conformance
@@ -20,6 +20,7 @@
 #include "matchers.h"
 #include "report.h"
 #include "swapchain_image_data.h"
+#include "swapchain_probe.h"
 #include "utilities/bitmask_to_string.h"
 #include "utilities/swapchain_parameters.h"
 #include "utilities/throw_helpers.h"
@@ -32,6 +33,7 @@
 #include <openxr/openxr.h>
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 XRC_DISABLE_MSVC_WARNING(4505)  // unreferenced local function has been removed
@@ -387,7 +389,7 @@ namespace Conformance
         return ret;
     }
 
-    TEST_CASE("Swapchains", "")
+    TEST_CASE("Swapchains", "[exclusive_session]")
     {
         const GlobalData& globalData = GetGlobalData();
         if (!globalData.IsUsingGraphicsPlugin()) {
@@ -473,15 +475,50 @@ namespace Conformance
                         {
                             GetGlobalData().PushSwapchainFormat(imageFormat, tp.imageFormatName);
 
+                            // Validate the images of every variation through the graphics plugin, one at a time.
+                            const auto cases = MakeSwapchainCreateInfoCases(session, imageFormat, tp);
                             SwapchainTestData data;
-                            for (const auto& nameAndCreateInfo : MakeSwapchainCreateInfoCases(session, imageFormat, tp)) {
+                            for (const auto& nameAndCreateInfo : cases) {
                                 INFO("XrSwapchainCreateInfo case: " << nameAndCreateInfo.first);
-                                auto createInfo = nameAndCreateInfo.second;
-                                testSwapchainCreation(session, data, createInfo, tp);
+                                testSwapchainCreation(session, data, nameAndCreateInfo.second, tp);
                             }
                             ReportF("    %d cases tested (%d unsupported)", data.swapchainCreateCount, data.unsupportedCount);
                             CAPTURE(data.swapchainCreateCount);
                             CAPTURE(data.unsupportedCount);
+
+                            // Then create, enumerate and destroy them again concurrently from a pool of worker threads.
+                            std::vector<XrSwapchainCreateInfo> createInfos;
+                            for (const auto& nameAndCreateInfo : cases) {
+                                createInfos.push_back(nameAndCreateInfo.second);
+                            }
+
+                            // The OpenGL context must not be bound on this thread while the workers' calls use it.
+                            globalData.graphicsPlugin->MakeCurrent(false);
+                            const std::vector<SwapchainProbeResult> results =
+                                RunSwapchainProbes(session, createInfos, globalData.options.swapchainProbeThreads);
+                            globalData.graphicsPlugin->MakeCurrent(true);
+
+                            // Check in case order, so failures read the same however the workers were scheduled.
+                            for (size_t i = 0; i < results.size(); ++i) {
+                                const XrSwapchainCreateInfo& createInfo = createInfos[i];
+                                const SwapchainProbeResult& result = results[i];
+                                INFO("XrSwapchainCreateInfo case: " << cases[i].first);
+                                CAPTURE(XrSwapchainCreateFlagsCPP(createInfo.createFlags));
+                                CAPTURE(createInfo.usageFlags);
+                                CAPTURE(createInfo.sampleCount);
+                                CAPTURE(createInfo.width);
+                                CAPTURE(createInfo.height);
+                                CAPTURE(createInfo.arraySize);
+                                CAPTURE(createInfo.mipCount);
+
+                                // A runtime is allowed to fail swapchain creation due to a unsupported creation flag.
+                                CHECK_THAT(result.createResult, In<XrResult>({XR_SUCCESS, XR_ERROR_FEATURE_UNSUPPORTED}));
+                                if (XR_SUCCEEDED(result.createResult)) {
+                                    CHECK_RESULT_UNQUALIFIED_SUCCESS(result.enumerateResult);
+                                    CHECK(result.imageCount > 0);
+                                    CHECK_RESULT_SUCCEEDED(result.destroyResult);
+                                }
+                            }
                         }
                     }
                 }
@@ -489,7 +526,7 @@ namespace Conformance
         }
     }
 
-    TEST_CASE("SwapchainsRender", "")
+    TEST_CASE("SwapchainsRender", "[exclusive_session]")
     {
         const GlobalData& globalData = GetGlobalData();
         if (!globalData.IsUsingGraphicsPlugin()) {
@@ -624,7 +661,7 @@ namespace Conformance
         }
     }
 
-    TEST_CASE("SwapchainsAcquire", "")
+    TEST_CASE("SwapchainsAcquire", "[exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsUsingGraphicsPlugin()) {
@@ -0,0 +1,164 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test_durations.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Removes the file when the test ends, however it ends.
+        struct ScopedFile
+        {
+            explicit ScopedFile(std::string p) : path(std::move(p))
+            {
+                std::remove(path.c_str());
+            }
+            ~ScopedFile()
+            {
+                std::remove(path.c_str());
+            }
+            std::string path;
+        };
+
+        std::vector<double> ShardTotals(const std::vector<double>& durations, const std::vector<size_t>& shards, size_t shardCount)
+        {
+            std::vector<double> totals(shardCount, 0.0);
+            for (size_t i = 0; i < durations.size(); ++i) {
+                totals[shards[i]] += durations[i];
+            }
+            return totals;
+        }
+    }  // namespace
+
+    TEST_CASE("TestDurations", "[self_test]")
+    {
+        const std::string key = TestDurationDatabase::MakeKey("Runtime", XR_MAKE_VERSION(1, 2, 3), "vulkan");
+        const std::string otherKey = TestDurationDatabase::MakeKey("Runtime", XR_MAKE_VERSION(1, 2, 3), "opengl");
+
+        SECTION("Durations accumulate per key and path")
+        {
+            TestDurationDatabase database;
+            database.Add(key, "xrCreateSession", 1.0);
+            database.Add(key, "xrCreateSession", 0.5);
+            database.Add(otherKey, "xrCreateSession", 4.0);
+
+            double seconds = 0;
+            REQUIRE(database.TryGetDuration(key, "xrCreateSession", seconds));
+            REQUIRE(seconds == 1.5);
+            REQUIRE(database.TryGetDuration(otherKey, "xrCreateSession", seconds));
+            REQUIRE(seconds == 4.0);
+            REQUIRE_FALSE(database.TryGetDuration(key, "xrDestroySession", seconds));
+        }
+
+        SECTION("Merging into a file keeps the entries of other runs")
+        {
+            ScopedFile file("test_durations_self_test.txt");
+
+            TestDurationDatabase missing;
+            REQUIRE(missing.Load(file.path));
+            REQUIRE(missing.empty());
+
+            TestDurationDatabase first;
+            first.Add(key, "Swapchains", 2.0);
+            first.Add(otherKey, "Swapchains", 3.0);
+            REQUIRE(first.MergeInto(file.path));
+
+            TestDurationDatabase second;
+            second.Add(key, "Swapchains", 2.5);
+            second.Add(key, "Swapchains/Sections with a, comma", 0.125);
+            REQUIRE(second.MergeInto(file.path));
+
+            TestDurationDatabase loaded;
+            REQUIRE(loaded.Load(file.path));
+            double seconds = 0;
+            REQUIRE(loaded.TryGetDuration(key, "Swapchains", seconds));
+            REQUIRE(seconds == 2.5);
+            REQUIRE(loaded.TryGetDuration(key, "Swapchains/Sections with a, comma", seconds));
+            REQUIRE(seconds == 0.125);
+            REQUIRE(loaded.TryGetDuration(otherKey, "Swapchains", seconds));
+            REQUIRE(seconds == 3.0);
+        }
+
+        SECTION("A malformed file is rejected")
+        {
+            ScopedFile file("test_durations_self_test.txt");
+            {
+                std::ofstream stream(file.path);
+                stream << "not a duration\n";
+            }
+            TestDurationDatabase loaded;
+            REQUIRE_FALSE(loaded.Load(file.path));
+            REQUIRE(loaded.empty());
+        }
+
+        SECTION("Regressions exceed both the threshold and the minimum change")
+        {
+            TestDurationDatabase previous;
+            previous.Add(key, "Slower", 2.0);
+            previous.Add(key, "Slightly slower", 2.0);
+            previous.Add(key, "Noisy", 0.01);
+            previous.Add(otherKey, "Slower", 2.0);
+
+            TestDurationDatabase current;
+            current.Add(key, "Slower", 4.0);
+            current.Add(key, "Slightly slower", 2.5);
+            current.Add(key, "Noisy", 0.1);
+            current.Add(key, "New", 10.0);
+            current.Add(otherKey, "Slower", 8.0);
+
+            const std::vector<TestDurationRegression> regressions = current.FindRegressions(previous, key, 0.5, 0.25);
+            REQUIRE(regressions.size() == 1);
+            REQUIRE(regressions[0].path == "Slower");
+            REQUIRE(regressions[0].previousSeconds == 2.0);
+            REQUIRE(regressions[0].currentSeconds == 4.0);
+        }
+
+        SECTION("Longest first sharding balances the shards")
+        {
+            const std::vector<double> durations{1, 9, 2, 8, 3, 7, 4, 6, 5, 5};
+            const std::vector<size_t> shards = AssignShardsLongestFirst(durations, 2);
+            REQUIRE(shards.size() == durations.size());
+            const std::vector<double> totals = ShardTotals(durations, shards, 2);
+            REQUIRE(totals[0] == 25);
+            REQUIRE(totals[1] == 25);
+
+            // Every process computes the same assignment.
+            REQUIRE(AssignShardsLongestFirst(durations, 2) == shards);
+        }
+
+        SECTION("Unknown durations are predicted as the average")
+        {
+            const std::vector<double> durations{10, -1, -1, 2};
+            const std::vector<size_t> shards = AssignShardsLongestFirst(durations, 2);
+            // Predicted at 10, 6, 6 and 2 seconds: the two unknown tests share a shard, the known ones the other.
+            REQUIRE(shards[1] == shards[2]);
+            REQUIRE(shards[0] == shards[3]);
+            REQUIRE(shards[0] != shards[1]);
+
+            const std::vector<size_t> allUnknown = AssignShardsLongestFirst({-1, -1, -1, -1}, 2);
+            REQUIRE(std::count(allUnknown.begin(), allUnknown.end(), (size_t)0) == 2);
+        }
+    }
+}  // namespace Conformance
@@ -0,0 +1,186 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "RGBAImage.h"
+#include "composition_utils.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openxr/openxr.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace Conformance
+{
+    namespace
+    {
+        // Sizes match those used by InteractiveLayerManager.
+        constexpr int32_t DescriptionWidth = 768;
+        constexpr int32_t DescriptionHeight = DescriptionWidth;
+        constexpr int32_t ActionsHeight = 128;
+        constexpr int32_t FontHeight = 48;
+
+        // A sample of the descriptions shown by interactive composition tests.
+        constexpr const char* kDescriptions[] = {
+            "This test includes a blue and green quad at Z=-2 with opposite rotations on Y axis forming X. The green quad should be"
+            " fully visible due to painter's algorithm. A red quad is facing away and should not be visible.",
+            "Render pairs of quads using similar poses to validate order of operations. The blue/green quads apply a"
+            " rotation around the Z axis on an XrSpace and then translate the quad out on the Z axis through the quad"
+            " layer's pose. The purple/yellow quads apply the same translation on the XrSpace and the rotation on the"
+            " quad layer's pose.",
+            "All three squares should have an identical blue-green gradient.",
+            "A checkerboard projection layer should be visible, with a different tint in each eye.",
+            "Stereo inset views.",
+            "glTF rendering",
+        };
+
+        // Layout of CreateTextImage.
+        constexpr int BorderPixels = 2;
+        constexpr int InsetPixels = BorderPixels + 4;
+
+        /// Largest difference between any channel of any pixel of two images of the same size.
+        int MaxChannelDifference(const RGBAImage& a, const RGBAImage& b)
+        {
+            REQUIRE(a.pixels.size() == b.pixels.size());
+            int maxDifference = 0;
+            for (size_t i = 0; i < a.pixels.size(); ++i) {
+                for (int shift = 0; shift < 32; shift += 8) {
+                    const int channelA = (int)((a.pixels[i].Pixel >> shift) & 0xFF);
+                    const int channelB = (int)((b.pixels[i].Pixel >> shift) & 0xFF);
+                    maxDifference = std::max(maxDifference, std::abs(channelA - channelB));
+                }
+            }
+            return maxDifference;
+        }
+
+        /// The text images created when an interactive test starts.
+        void CreateInteractiveTestTextImages(const char* description)
+        {
+            (void)CreateTextImage(DescriptionWidth, DescriptionHeight, description, FontHeight);
+            (void)CreateTextImage(DescriptionWidth, ActionsHeight, "Press Select to PASS. Press Menu for description", FontHeight);
+            (void)CreateTextImage(DescriptionWidth, ActionsHeight, "Press Select to FAIL", FontHeight);
+        }
+    }  // namespace
+
+    TEST_CASE("TextImages", "[self_test]")
+    {
+        ClearTextImageCaches();
+
+        SECTION("Cached text matches text drawn glyph by glyph")
+        {
+            const XrRect2Di rect{{InsetPixels, InsetPixels},
+                                 {DescriptionWidth - InsetPixels * 2, DescriptionHeight - InsetPixels * 2}};
+            for (const char* description : kDescriptions) {
+                INFO(description);
+                RGBAImage reference(DescriptionWidth, DescriptionHeight);
+                reference.DrawRect(0, 0, reference.width, reference.height, {0, 0, 0, 0.5f});
+                RGBAImage cached = reference;
+                reference.PutTextUncached(rect, description, FontHeight, {1, 1, 1, 1});
+
+                // The second draw uses the layout cached by the first.
+                RGBAImage first = cached;
+                first.PutText(rect, description, FontHeight, {1, 1, 1, 1});
+                cached.PutText(rect, description, FontHeight, {1, 1, 1, 1});
+
+                REQUIRE(MaxChannelDifference(first, reference) <= 1);
+                REQUIRE(MaxChannelDifference(cached, reference) <= 1);
+            }
+        }
+
+        SECTION("Cached text images match images drawn glyph by glyph")
+        {
+            for (const char* description : kDescriptions) {
+                INFO(description);
+                // What CreateTextImage drew before text images and layouts were cached.
+                RGBAImage reference(DescriptionWidth, DescriptionHeight);
+                reference.DrawRect(0, 0, reference.width, reference.height, {0, 0, 0, 0.5f});
+                reference.DrawRectBorder(0, 0, reference.width, reference.height, BorderPixels, {1, 1, 1, 1});
+                reference.PutTextUncached(
+                    XrRect2Di{{InsetPixels, InsetPixels}, {reference.width - InsetPixels * 2, reference.height - InsetPixels * 2}},
+                    description, FontHeight, {1, 1, 1, 1});
+
+                const RGBAImage first = CreateTextImage(DescriptionWidth, DescriptionHeight, description, FontHeight);
+                const RGBAImage cached = CreateTextImage(DescriptionWidth, DescriptionHeight, description, FontHeight);
+                REQUIRE(MaxChannelDifference(first, reference) <= 1);
+                REQUIRE(MaxChannelDifference(cached, reference) <= 1);
+            }
+        }
+
+        SECTION("Cached layouts blend over the existing contents")
+        {
+            const XrRect2Di rect{{10, 10}, {200, 100}};
+            RGBAImage red(256, 128);
+            red.DrawRect(0, 0, red.width, red.height, {1, 0, 0, 1});
+            RGBAImage blue(256, 128);
+            blue.DrawRect(0, 0, blue.width, blue.height, {0, 0, 1, 1});
+
+            red.PutText(rect, "Label", FontHeight, {1, 1, 1, 1});
+            blue.PutText(rect, "Label", FontHeight, {1, 1, 1, 1});
+
+            // Outside the glyphs, the backgrounds must be untouched.
+            REQUIRE(red.pixels[0].Channels.R == 255);
+            REQUIRE(blue.pixels[0].Channels.B == 255);
+            // Somewhere inside the glyphs, the text color must have been blended in.
+            bool foundText = false;
+            for (const RGBA8Color& pixel : red.pixels) {
+                foundText = foundText || pixel.Channels.G != 0;
+            }
+            REQUIRE(foundText);
+        }
+
+        ClearTextImageCaches();
+    }
+
+    TEST_CASE("TextImagesBenchmark", "[self_test][benchmark][.]")
+    {
+        BENCHMARK("Interactive test text images: uncached")
+        {
+            for (const char* description : kDescriptions) {
+                ClearTextImageCaches();
+                CreateInteractiveTestTextImages(description);
+            }
+        };
+
+        BENCHMARK("Interactive test text images: cached images")
+        {
+            for (const char* description : kDescriptions) {
+                CreateInteractiveTestTextImages(description);
+            }
+        };
+
+        BENCHMARK("PutText: uncached layout, new image")
+        {
+            RGBAImage::ClearTextLayoutCache();
+            RGBAImage image(DescriptionWidth, DescriptionHeight);
+            image.PutText(XrRect2Di{{6, 6}, {DescriptionWidth - 12, DescriptionHeight - 12}}, kDescriptions[1], FontHeight,
+                          {1, 1, 1, 1});
+            return image.pixels[0].Pixel;
+        };
+
+        BENCHMARK("PutText: cached layout, new image")
+        {
+            RGBAImage image(DescriptionWidth, DescriptionHeight);
+            image.PutText(XrRect2Di{{6, 6}, {DescriptionWidth - 12, DescriptionHeight - 12}}, kDescriptions[1], FontHeight,
+                          {1, 1, 1, 1});
+            return image.pixels[0].Pixel;
+        };
+
+        ClearTextImageCaches();
+    }
+}  // namespace Conformance
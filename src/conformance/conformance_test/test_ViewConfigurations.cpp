@@ -30,7 +30,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("ViewConfigurations", "")
+    TEST_CASE("ViewConfigurations", "[pooled_instance]")
     {
         // XrResult xrEnumerateViewConfigurations(XrInstance instance, XrSystemId systemId, uint32_t viewConfigurationTypeCapacityInput,
         // uint32_t* viewConfigurationTypeCountOutput, XrViewConfigurationType* viewConfigurationTypes); XrResult
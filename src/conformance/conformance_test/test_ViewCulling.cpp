@@ -0,0 +1,200 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "view_culling.h"
+#include "common/xr_linear.h"
+#include "utilities/xr_math_operators.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openxr/openxr.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Conformance
+{
+    using namespace openxr::math_operators;
+
+    namespace
+    {
+
+        XrView MakeView(XrVector3f position, XrQuaternionf orientation, XrFovf fov)
+        {
+            XrView view{XR_TYPE_VIEW};
+            view.pose = {orientation, position};
+            view.fov = fov;
+            return view;
+        }
+
+        XrMatrix4x4f MakeViewProjection(const XrView& view)
+        {
+            XrMatrix4x4f projection;
+            XrMatrix4x4f_CreateProjectionFov(&projection, GRAPHICS_OPENGL, view.fov, RenderViewNearZ, RenderViewFarZ);
+            return projection * Matrix::InvertRigidBody(Matrix::FromPose(view.pose));
+        }
+
+        /// Whether @p point is inside the frustum of @p viewProjection, allowing for rounding.
+        bool IsInside(const XrMatrix4x4f& viewProjection, const XrVector3f& point)
+        {
+            const XrVector4f p{point.x, point.y, point.z, 1.0f};
+            XrVector4f clip;
+            XrMatrix4x4f_TransformVector4f(&clip, &viewProjection, &p);
+            const float limit = clip.w * (1.0f + 1e-4f);
+            return std::fabs(clip.x) <= limit && std::fabs(clip.y) <= limit && std::fabs(clip.z) <= limit;
+        }
+
+        DrawableBounds GetNoBounds(GLTFModelInstanceHandle)
+        {
+            return {};
+        }
+    }  // namespace
+
+    TEST_CASE("ViewCulling", "[self_test]")
+    {
+        // Looking down -Z from the origin with a 90 degree field of view.
+        const XrView view = MakeView({0, 0, 0}, {0, 0, 0, 1}, {-0.785f, 0.785f, 0.785f, -0.785f});
+        const XrMatrix4x4f viewProjection = MakeViewProjection(view);
+
+        const std::vector<Cube> cubes{
+            Cube::Make({0, 0, -2}),      // in front
+            Cube::Make({0, 0, 2}),       // behind
+            Cube::Make({-5, 0, -2}),     // off to the left
+            Cube::Make({-2.1f, 0, -2}),  // partly inside on the left
+            Cube::Make({0, 0, -200}),    // beyond the far plane
+        };
+        const MeshHandle smallMesh(1);
+        const MeshHandle emptyMesh(2);
+        const auto getMeshBounds = [&](MeshHandle handle) {
+            DrawableBounds bounds;
+            if (handle == smallMesh) {
+                bounds.mins = {-0.1f, -0.1f, -0.1f};
+                bounds.maxs = {0.1f, 0.1f, 0.1f};
+            }
+            return bounds;
+        };
+        const std::vector<MeshDrawable> meshes{
+            MeshDrawable{smallMesh, XrPosef{{0, 0, 0, 1}, {0, 0, 3}}},
+            MeshDrawable{smallMesh, XrPosef{{0, 0, 0, 1}, {0, 0, -3}}},
+            // Empty bounds are never culled.
+            MeshDrawable{emptyMesh, XrPosef{{0, 0, 0, 1}, {0, 0, 3}}},
+        };
+
+        ViewCuller culler;
+
+        SECTION("Cubes and meshes")
+        {
+            culler.Cull(viewProjection, RenderParams{}.Draw(cubes).Draw(meshes), getMeshBounds, GetNoBounds);
+            CHECK(culler.IsCubeVisible(0));
+            CHECK_FALSE(culler.IsCubeVisible(1));
+            CHECK_FALSE(culler.IsCubeVisible(2));
+            CHECK(culler.IsCubeVisible(3));
+            CHECK_FALSE(culler.IsCubeVisible(4));
+            CHECK_FALSE(culler.IsMeshVisible(0));
+            CHECK(culler.IsMeshVisible(1));
+            CHECK(culler.IsMeshVisible(2));
+
+            CHECK(culler.GetStatistics().drawn == 4);
+            CHECK(culler.GetStatistics().culled == 4);
+            CHECK(culler.GetStatistics().sharedPasses == 0);
+        }
+
+        SECTION("Reuse for the same frustum and drawables")
+        {
+            // A second view sharing the culling frustum of the first.
+            const XrView otherView = MakeView({0.1f, 0, 0}, {0, 0, 0, 1}, view.fov);
+            const RenderParams params = RenderParams{}.Draw(cubes).CullWith(viewProjection);
+            culler.Cull(viewProjection, params, getMeshBounds, GetNoBounds);
+            culler.Cull(MakeViewProjection(otherView), params, getMeshBounds, GetNoBounds);
+            CHECK(culler.GetStatistics().sharedPasses == 1);
+            CHECK(culler.GetStatistics().drawn == 4);
+            CHECK(culler.GetStatistics().culled == 6);
+
+            // Moving a drawable means culling again.
+            std::vector<Cube> movedCubes = cubes;
+            movedCubes[0].params.pose.position = {0, 0, 2};
+            culler.Cull(viewProjection, RenderParams{}.Draw(movedCubes).CullWith(viewProjection), getMeshBounds, GetNoBounds);
+            CHECK(culler.GetStatistics().sharedPasses == 1);
+            CHECK_FALSE(culler.IsCubeVisible(0));
+        }
+    }
+
+    TEST_CASE("ViewCullingCombinedFrustum", "[self_test]")
+    {
+        // A stereo pair with asymmetric fields of view, looking somewhere other than down an axis.
+        XrQuaternionf orientation;
+        const XrVector3f axis{0.2f, 1.0f, 0.1f};
+        XrQuaternionf_CreateFromAxisAngle(&orientation, &axis, 0.7f);
+        const XrVector3f right{0.032f, 0, 0};
+        XrVector3f offset;
+        XrQuaternionf_RotateVector3f(&offset, &orientation, &right);
+        const XrVector3f center{0.3f, 1.6f, -0.2f};
+        const std::vector<XrView> views{
+            MakeView(center - offset, orientation, {-0.95f, 0.7f, 0.8f, -0.9f}),
+            MakeView(center + offset, orientation, {-0.7f, 0.95f, 0.85f, -0.8f}),
+        };
+
+        SECTION("Contains each view frustum")
+        {
+            XrMatrix4x4f combined;
+            REQUIRE(MakeCombinedViewProjection(&combined, views, RenderViewNearZ, RenderViewFarZ));
+
+            std::mt19937 engine(42);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            for (const XrView& view : views) {
+                const float tanLeft = std::tan(view.fov.angleLeft);
+                const float tanRight = std::tan(view.fov.angleRight);
+                const float tanDown = std::tan(view.fov.angleDown);
+                const float tanUp = std::tan(view.fov.angleUp);
+                for (int i = 0; i < 1000; ++i) {
+                    // Points throughout the view frustum, including its corners.
+                    const float x = i < 8 ? float(i & 1) : unit(engine);
+                    const float y = i < 8 ? float((i >> 1) & 1) : unit(engine);
+                    const float depth = i < 8 ? ((i & 4) ? RenderViewFarZ : RenderViewNearZ)
+                                              : RenderViewNearZ + (RenderViewFarZ - RenderViewNearZ) * unit(engine) * unit(engine);
+                    const XrVector3f local{(tanLeft + (tanRight - tanLeft) * x) * depth, (tanDown + (tanUp - tanDown) * y) * depth,
+                                           -depth};
+                    XrVector3f world;
+                    XrPosef_TransformVector3f(&world, &view.pose, &local);
+                    INFO("Point " << i);
+                    REQUIRE(IsInside(MakeViewProjection(view), world));
+                    REQUIRE(IsInside(combined, world));
+                }
+            }
+        }
+
+        SECTION("Views oriented differently are not combined")
+        {
+            std::vector<XrView> turned = views;
+            const XrVector3f up{0, 1, 0};
+            XrQuaternionf turn;
+            XrQuaternionf_CreateFromAxisAngle(&turn, &up, 0.1f);
+            turned[1].pose.orientation = turn * turned[1].pose.orientation;
+            XrMatrix4x4f combined;
+            CHECK_FALSE(MakeCombinedViewProjection(&combined, turned, RenderViewNearZ, RenderViewFarZ));
+        }
+
+        SECTION("Fields of view that exclude the view direction are not combined")
+        {
+            std::vector<XrView> offAxis = views;
+            offAxis[0].fov.angleLeft = 0.1f;
+            offAxis[1].fov.angleLeft = 0.1f;
+            XrMatrix4x4f combined;
+            CHECK_FALSE(MakeCombinedViewProjection(&combined, offAxis, RenderViewNearZ, RenderViewFarZ));
+        }
+    }
+}  // namespace Conformance
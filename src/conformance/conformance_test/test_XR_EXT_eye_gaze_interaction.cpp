@@ -45,7 +45,7 @@ namespace Conformance
         MakeSystemPropertiesBoolChecker(XrSystemEyeGazeInteractionPropertiesEXT{XR_TYPE_SYSTEM_EYE_GAZE_INTERACTION_PROPERTIES_EXT},
                                         &XrSystemEyeGazeInteractionPropertiesEXT::supportsEyeGazeInteraction);
 
-    TEST_CASE("XR_EXT_eye_gaze_interaction-system_support_optional", "[XR_EXT_eye_gaze_interaction]")
+    TEST_CASE("XR_EXT_eye_gaze_interaction-system_support_optional", "[XR_EXT_eye_gaze_interaction][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_EXT_EYE_GAZE_INTERACTION_EXTENSION_NAME)) {
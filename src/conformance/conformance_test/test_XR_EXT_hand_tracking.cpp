@@ -39,7 +39,7 @@ namespace Conformance
         MakeSystemPropertiesBoolChecker(XrSystemHandTrackingPropertiesEXT{XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT},
                                         &XrSystemHandTrackingPropertiesEXT::supportsHandTracking);
 
-    TEST_CASE("XR_EXT_hand_tracking-create-destroy", "[XR_EXT_hand_tracking]")
+    TEST_CASE("XR_EXT_hand_tracking-create-destroy", "[XR_EXT_hand_tracking][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_EXT_HAND_TRACKING_EXTENSION_NAME)) {
@@ -98,7 +98,7 @@ namespace Conformance
         }
     }
 
-    TEST_CASE("XR_EXT_hand_tracking-simple-queries", "[XR_EXT_hand_tracking]")
+    TEST_CASE("XR_EXT_hand_tracking-simple-queries", "[XR_EXT_hand_tracking][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_EXT_HAND_TRACKING_EXTENSION_NAME)) {
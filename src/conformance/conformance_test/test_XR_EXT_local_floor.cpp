@@ -307,12 +307,12 @@ namespace Conformance
             }
         }
     }
-    TEST_CASE("XR_EXT_local_floor", "[XR_EXT_local_floor]")
+    TEST_CASE("XR_EXT_local_floor", "[XR_EXT_local_floor][exclusive_session]")
     {
         SharedLocalFloorAutomated(kExtensionRequirements);
     }
 
-    TEST_CASE("XR_VERSION_1_1-local_floor", "[XR_VERSION_1_1]")
+    TEST_CASE("XR_VERSION_1_1-local_floor", "[XR_VERSION_1_1][exclusive_session]")
     {
         SharedLocalFloorAutomated(kPromotedCoreRequirements);
     }
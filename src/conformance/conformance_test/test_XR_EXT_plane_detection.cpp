@@ -73,7 +73,7 @@ namespace Conformance
         return SystemPlaneDetectionCapabilities(instance, systemId) & XR_PLANE_DETECTION_CAPABILITY_PLANE_DETECTION_BIT_EXT;
     }
 
-    TEST_CASE("XR_EXT_plane_detection", "[XR_EXT_plane_detection]")
+    TEST_CASE("XR_EXT_plane_detection", "[XR_EXT_plane_detection][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_EXT_PLANE_DETECTION_EXTENSION_NAME)) {
@@ -478,7 +478,7 @@ namespace Conformance
                      XR_PLANE_DETECTOR_SEMANTIC_TYPE_PLATFORM_EXT);
     }
 
-    TEST_CASE("XR_EXT_plane_detection-invalid-arguments", "[XR_EXT_plane_detection]")
+    TEST_CASE("XR_EXT_plane_detection-invalid-arguments", "[XR_EXT_plane_detection][exclusive_session]")
     {
         // basic setup stuff
         GlobalData& globalData = GetGlobalData();
@@ -30,7 +30,7 @@ namespace Conformance
         MakeSystemPropertiesBoolChecker(XrSystemUserPresencePropertiesEXT{XR_TYPE_SYSTEM_USER_PRESENCE_PROPERTIES_EXT},
                                         &XrSystemUserPresencePropertiesEXT::supportsUserPresence);
 
-    TEST_CASE("XR_EXT_user_presence", "[XR_EXT_user_presence]")
+    TEST_CASE("XR_EXT_user_presence", "[XR_EXT_user_presence][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_EXT_USER_PRESENCE_EXTENSION_NAME)) {
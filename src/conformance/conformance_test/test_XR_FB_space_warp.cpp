@@ -28,7 +28,7 @@
 
 namespace Conformance
 {
-    TEST_CASE("XR_FB_space_warp", "[XR_FB_space_warp]")
+    TEST_CASE("XR_FB_space_warp", "[XR_FB_space_warp][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_FB_SPACE_WARP_EXTENSION_NAME)) {
@@ -33,7 +33,7 @@ namespace Conformance
 {
     // This implements an automated programmatic test of the cubemap layer. However, a separate visual
     // test is required in order to validate that it looks correct.
-    TEST_CASE("XR_KHR_composition_layer_cube", "[XR_KHR_composition_layer_cube]")
+    TEST_CASE("XR_KHR_composition_layer_cube", "[XR_KHR_composition_layer_cube][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_KHR_COMPOSITION_LAYER_CUBE_EXTENSION_NAME)) {
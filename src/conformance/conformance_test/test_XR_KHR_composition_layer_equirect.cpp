@@ -38,7 +38,7 @@ namespace Conformance
 {
     // This implements an automated programmatic test of the equirect layer. However, a separate visual
     // test is required in order to validate that it looks correct.
-    TEST_CASE("XR_KHR_composition_layer_equirect", "[XR_KHR_composition_layer_equirect]")
+    TEST_CASE("XR_KHR_composition_layer_equirect", "[XR_KHR_composition_layer_equirect][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsInstanceExtensionSupported(XR_KHR_COMPOSITION_LAYER_EQUIRECT_EXTENSION_NAME)) {
@@ -546,12 +546,12 @@ namespace Conformance
         }
     }
 
-    TEST_CASE("xrLocateSpaces", "[XR_VERSION_1_1]")
+    TEST_CASE("xrLocateSpaces", "[XR_VERSION_1_1][exclusive_session]")
     {
         SharedLocateSpaces(kPromotedCoreRequirements);
     }
 
-    TEST_CASE("XR_KHR_locate_spaces", "[XR_KHR_locate_spaces]")
+    TEST_CASE("XR_KHR_locate_spaces", "[XR_KHR_locate_spaces][exclusive_session]")
     {
         SharedLocateSpaces(kExtensionRequirements);
     }
@@ -29,7 +29,7 @@
 
 namespace Conformance
 {
-    TEST_CASE("XR_META_performance_metrics", "[XR_META_performance_metrics]")
+    TEST_CASE("XR_META_performance_metrics", "[XR_META_performance_metrics][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
 
@@ -21,6 +21,7 @@
 #include "utilities/types_and_constants.h"
 #include "utilities/utils.h"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <openxr/openxr.h>
@@ -128,7 +129,7 @@ namespace Conformance
         ext.CheckInvalidModelKey(session, XR_NULL_CONTROLLER_MODEL_KEY_MSFT);
     }
 
-    TEST_CASE("XR_MSFT_controller_model", "[XR_MSFT_controller_model]")
+    TEST_CASE("XR_MSFT_controller_model", "[XR_MSFT_controller_model][exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
 
@@ -314,6 +315,166 @@ namespace Conformance
         }
     }
 
+    namespace
+    {
+        /// A model instance that only resolves transforms:
+        /// the part of animating a controller model that does not depend on the graphics API.
+        class ResolveOnlyModelInstance : public Pbr::ModelInstance
+        {
+        public:
+            explicit ResolveOnlyModelInstance(std::shared_ptr<const Pbr::Model> model) : ModelInstance(std::move(model))
+            {
+            }
+
+            /// Resolve as the graphics plugins do before uploading, returning the number of transforms they would upload.
+            uint32_t Resolve()
+            {
+                uint32_t uploaded = 0;
+                if (ResolvedTransformsNeedUpdate()) {
+                    ResolveTransformsAndVisibilities(false);
+                    uploaded = GetUpdatedTransformRange().size();
+                    MarkResolvedTransformsUpdated();
+                }
+                return uploaded;
+            }
+        };
+    }  // namespace
+
+    TEST_CASE("XR_MSFT_controller_model-transform_benchmark", "[XR_MSFT_controller_model][benchmark][exclusive_session][.]")
+    {
+        GlobalData& globalData = GetGlobalData();
+
+        if (!globalData.IsInstanceExtensionSupported(XR_MSFT_CONTROLLER_MODEL_EXTENSION_NAME)) {
+            SKIP(XR_MSFT_CONTROLLER_MODEL_EXTENSION_NAME " not supported");
+        }
+        if (!globalData.IsUsingGraphicsPlugin()) {
+            SKIP("Loading controller models requires a graphics plugin");
+        }
+
+        CompositionHelper compositionHelper("XR_MSFT_controller_model", {"XR_MSFT_controller_model"});
+        XrInstance instance = compositionHelper.GetInstance();
+
+        ExtensionDataForXR_MSFT_controller_model ext(instance);
+
+        ActionLayerManager actionLayerManager(compositionHelper);
+        XrPath motionController = StringToPath(instance, "/interaction_profiles/microsoft/motion_controller");
+        const std::vector<XrPath> subactionPaths{StringToPath(instance, "/user/hand/left"),
+                                                 StringToPath(instance, "/user/hand/right")};
+        std::vector<std::shared_ptr<IInputTestDevice>> inputDevices;
+        for (XrPath subactionPath : subactionPaths) {
+            inputDevices.push_back(CreateTestDevice(
+                &actionLayerManager, &compositionHelper.GetInteractionManager(), instance, compositionHelper.GetSession(),
+                motionController, subactionPath,
+                GetInteractionProfile(InteractionProfileIndex::Profile_microsoft_motion_controller).InputSourcePaths));
+        }
+
+        XrActionSet actionSet;
+        XrAction gripPoseAction;
+        {
+            XrActionSetCreateInfo actionSetInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+            strcpy(actionSetInfo.actionSetName, "transform_benchmark");
+            strcpy(actionSetInfo.localizedActionSetName, "Transform Benchmark");
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(xrCreateActionSet(instance, &actionSetInfo, &actionSet));
+
+            XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
+            actionInfo.subactionPaths = subactionPaths.data();
+            actionInfo.countSubactionPaths = (uint32_t)subactionPaths.size();
+            actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
+            strcpy(actionInfo.actionName, "grip_pose");
+            strcpy(actionInfo.localizedActionName, "Grip pose");
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(xrCreateAction(actionSet, &actionInfo, &gripPoseAction));
+        }
+
+        Image::InitKTX2();
+
+        compositionHelper.BeginSession();
+        actionLayerManager.WaitForSessionFocusWithMessage();
+
+        compositionHelper.GetInteractionManager().AddActionSet(actionSet);
+        compositionHelper.GetInteractionManager().AddActionBindings(
+            motionController, {{{gripPoseAction, StringToPath(instance, "/user/hand/left/input/grip")},
+                                {gripPoseAction, StringToPath(instance, "/user/hand/right/input/grip")}}});
+        compositionHelper.GetInteractionManager().AttachActionSets();
+
+        XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+        XrActiveActionSet activeActionSet{actionSet};
+        syncInfo.activeActionSets = &activeActionSet;
+        syncInfo.countActiveActionSets = 1;
+        actionLayerManager.SyncActionsUntilFocusWithMessage(syncInfo);
+
+        XrSession session = compositionHelper.GetSession();
+        std::vector<XrControllerModelKeyMSFT> modelKeys;
+        WaitUntilPredicateWithTimeout(
+            [&]() {
+                actionLayerManager.IterateFrame();
+                xrSyncActions(session, &syncInfo);
+
+                modelKeys.clear();
+                for (XrPath subactionPath : subactionPaths) {
+                    XrControllerModelKeyStateMSFT modelKeyState{XR_TYPE_CONTROLLER_MODEL_KEY_STATE_MSFT};
+                    CHECK_RESULT_UNQUALIFIED_SUCCESS(ext.xrGetControllerModelKeyMSFT_(session, subactionPath, &modelKeyState));
+                    if (modelKeyState.modelKey != XR_NULL_CONTROLLER_MODEL_KEY_MSFT) {
+                        modelKeys.push_back(modelKeyState.modelKey);
+                    }
+                }
+                return modelKeys.size() == subactionPaths.size();
+            },
+            20s, kActionWaitDelay);
+
+        if (modelKeys.empty()) {
+            SKIP("No bound subaction paths have controller model keys");
+        }
+
+        for (XrControllerModelKeyMSFT modelKey : modelKeys) {
+            uint32_t modelBufferSize;
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(ext.xrLoadControllerModelMSFT_(session, modelKey, 0, &modelBufferSize, nullptr));
+            std::vector<uint8_t> modelBuffer(modelBufferSize);
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(
+                ext.xrLoadControllerModelMSFT_(session, modelKey, modelBufferSize, &modelBufferSize, modelBuffer.data()));
+            GLTFModelHandle gltfModel = globalData.graphicsPlugin->LoadGLTF(modelBuffer);
+            std::shared_ptr<Pbr::Model> pbrModel = globalData.graphicsPlugin->GetPbrModel(gltfModel);
+
+            XrControllerModelPropertiesMSFT modelProperties{XR_TYPE_CONTROLLER_MODEL_PROPERTIES_MSFT};
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(ext.xrGetControllerModelPropertiesMSFT_(session, modelKey, &modelProperties));
+            std::vector<XrControllerModelNodePropertiesMSFT> nodeProperties(modelProperties.nodeCountOutput);
+            modelProperties.nodeCapacityInput = (uint32_t)nodeProperties.size();
+            modelProperties.nodeProperties = nodeProperties.data();
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(ext.xrGetControllerModelPropertiesMSFT_(session, modelKey, &modelProperties));
+
+            XrControllerModelStateMSFT modelState{XR_TYPE_CONTROLLER_MODEL_STATE_MSFT};
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(ext.xrGetControllerModelStateMSFT_(session, modelKey, &modelState));
+            std::vector<XrControllerModelNodeStateMSFT> nodeStates(modelState.nodeCountOutput);
+            modelState.nodeCapacityInput = (uint32_t)nodeStates.size();
+            modelState.nodeStates = nodeStates.data();
+            REQUIRE_RESULT_UNQUALIFIED_SUCCESS(ext.xrGetControllerModelStateMSFT_(session, modelKey, &modelState));
+
+            ControllerAnimationHandler animationHandler{*pbrModel, std::move(nodeProperties)};
+            ResolveOnlyModelInstance modelInstance(pbrModel);
+            modelInstance.Resolve();
+
+            // Report how much of the transform buffer each approach uploads per frame.
+            animationHandler.UpdateControllerParts(nodeStates, modelInstance);
+            const uint32_t incrementalUploads = modelInstance.Resolve();
+            ReportF("Controller model %s: %d nodes, %d animated, %d transforms uploaded per frame",
+                    Uint64ToHexString(modelKey).c_str(), (int)pbrModel->GetNodeCount(), (int)nodeStates.size(), (int)incrementalUploads);
+
+            // Like the interactive test, apply the state of every animated node each frame, whether or not it moved.
+            // The first benchmark marks the root changed, so every node is resolved and uploaded. It bounds the cost
+            // of resolving everything each frame, but still runs the subtree tracking, so it is not the old algorithm.
+            BENCHMARK("Resolve controller transforms: every node, root marked changed")
+            {
+                animationHandler.UpdateControllerParts(nodeStates, modelInstance);
+                modelInstance.SetNodeVisibility(Pbr::RootNodeIndex, Pbr::NodeVisibility::Inherit);
+                return modelInstance.Resolve();
+            };
+            BENCHMARK("Resolve controller transforms: changed subtrees")
+            {
+                animationHandler.UpdateControllerParts(nodeStates, modelInstance);
+                return modelInstance.Resolve();
+            };
+        }
+    }
+
     TEST_CASE("XR_MSFT_controller_model-interactive", "[XR_MSFT_controller_model][scenario][interactive][no_auto]")
     {
 
@@ -83,7 +83,7 @@ namespace Conformance
 
     }  // namespace
 
-    TEST_CASE("XR_VARJO_quad_views", "[XR_VARJO_quad_views]")
+    TEST_CASE("XR_VARJO_quad_views", "[XR_VARJO_quad_views][exclusive_session]")
     {
         FeatureSet enabled;
         GetGlobalData().PopulateVersionAndEnabledExtensions(enabled);
@@ -178,12 +178,12 @@ namespace Conformance
         }
     }  // namespace
 
-    TEST_CASE("XR_VARJO_quad_views-fov", "[XR_VARJO_quad_views]")
+    TEST_CASE("XR_VARJO_quad_views-fov", "[XR_VARJO_quad_views][exclusive_session]")
     {
         StereoWithFoveatedInsetNonInteractiveFOV(kExtensionRequirements);
     }
 
-    TEST_CASE("StereoWithFoveatedInset", "[XR_VERSION_1_1]")
+    TEST_CASE("StereoWithFoveatedInset", "[XR_VERSION_1_1][exclusive_session]")
     {
         StereoWithFoveatedInsetNonInteractiveFOV(kPromotedCoreRequirements);
     }
@@ -65,7 +65,7 @@ namespace Conformance
         std::vector<XrCompositionLayerProjectionView> ProjectionViews;
     };
 
-    TEST_CASE("XrCompositionLayerProjection", "")
+    TEST_CASE("XrCompositionLayerProjection", "[exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsUsingGraphicsPlugin()) {
@@ -36,7 +36,7 @@ namespace Conformance
 {
     using namespace openxr::math_operators;
 
-    TEST_CASE("XrCompositionLayerQuad", "")
+    TEST_CASE("XrCompositionLayerQuad", "[exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
         if (!globalData.IsUsingGraphicsPlugin()) {
@@ -5,6 +5,7 @@
 #include "composition_utils.h"
 #include "conformance_framework.h"
 #include "graphics_plugin.h"
+#include "space_locator.h"
 
 #include "common/xr_linear.h"
 #include "gltf/GltfHelper.h"
@@ -110,6 +111,9 @@ namespace Conformance
             }
         }
 
+        // Locates the grip spaces each frame, in one call if the runtime can locate spaces in batches.
+        SpaceLocator gripSpaceLocator(instance, session);
+
         struct glTFTestCase
         {
             const char* filePath;
@@ -237,35 +241,40 @@ namespace Conformance
             std::vector<Cube> renderedCubes;
             std::vector<GLTFDrawable> renderedGLTFs;
 
-            for (size_t i = 0; i < gltfModelInstances.size(); ++i) {
-                const auto& space = gripSpaces[i];
-                XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
-                if (XR_SUCCEEDED(xrLocateSpace(space, localSpace, frameState.predictedDisplayTime, &location))) {
-                    if ((location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) &&
-                        (location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)) {
+            gripSpaceLocator.Clear();
+            for (XrSpace space : gripSpaces) {
+                gripSpaceLocator.Request(space, localSpace, frameState.predictedDisplayTime);
+            }
+            // A space that could not be located keeps empty location flags, so is not drawn.
+            (void)gripSpaceLocator.Resolve();
 
-                        if (gltfModelInstances[i] != GLTFModelInstanceHandle{}) {
+            for (size_t i = 0; i < gltfModelInstances.size(); ++i) {
+                // The tickets of the requests are their indices, since the locator was cleared first.
+                const XrSpaceLocation location = gripSpaceLocator.GetLocation(i);
+                if ((location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) &&
+                    (location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)) {
+
+                    if (gltfModelInstances[i] != GLTFModelInstanceHandle{}) {
+                        XrPosef adjustedPose = location.pose * testCase.poseInGripSpace;
+                        renderedGLTFs.push_back(
+                            GLTFDrawable{gltfModelInstances[i], adjustedPose, {testCase.scale, testCase.scale, testCase.scale}});
+                    }
+                    else {
+                        // loading spinner
+                        constexpr int zones = 12;
+                        constexpr int darkenCount = 3;
+                        auto now = std::chrono::system_clock::now();
+                        auto msSinceEpoch = std::chrono::time_point_cast<std::chrono::milliseconds>(now).time_since_epoch();
+                        int offset = uint64_t(msSinceEpoch / 250ms) % zones;
+                        for (int zone = 0; zone < zones; ++zone) {
+                            int darken = std::max(darkenCount - (zone + offset) % zones, 0);
+                            float value = 0.5f - 0.125f * darken;
+                            auto tintColor = XrColor4f{value, value, value, 1.0f};
+                            XrPosef relativePose = {Quat::FromAxisAngle({0, 1, 0}, (2 * MATH_PI / zones) * zone)};
+                            XrVector3f radialOffset = {0, 0, 0.1f};
+                            XrPosef_TransformVector3f(&relativePose.position, &relativePose, &radialOffset);
                             XrPosef adjustedPose = location.pose * testCase.poseInGripSpace;
-                            renderedGLTFs.push_back(
-                                GLTFDrawable{gltfModelInstances[i], adjustedPose, {testCase.scale, testCase.scale, testCase.scale}});
-                        }
-                        else {
-                            // loading spinner
-                            constexpr int zones = 12;
-                            constexpr int darkenCount = 3;
-                            auto now = std::chrono::system_clock::now();
-                            auto msSinceEpoch = std::chrono::time_point_cast<std::chrono::milliseconds>(now).time_since_epoch();
-                            int offset = uint64_t(msSinceEpoch / 250ms) % zones;
-                            for (int zone = 0; zone < zones; ++zone) {
-                                int darken = std::max(darkenCount - (zone + offset) % zones, 0);
-                                float value = 0.5f - 0.125f * darken;
-                                auto tintColor = XrColor4f{value, value, value, 1.0f};
-                                XrPosef relativePose = {Quat::FromAxisAngle({0, 1, 0}, (2 * MATH_PI / zones) * zone)};
-                                XrVector3f radialOffset = {0, 0, 0.1f};
-                                XrPosef_TransformVector3f(&relativePose.position, &relativePose, &radialOffset);
-                                XrPosef adjustedPose = location.pose * testCase.poseInGripSpace;
-                                renderedCubes.push_back(Cube{adjustedPose, {0.02f, 0.02f, 0.1f}, tintColor});
-                            }
+                            renderedCubes.push_back(Cube{adjustedPose, {0.02f, 0.02f, 0.1f}, tintColor});
                         }
                     }
                 }
@@ -17,7 +17,10 @@
 #include "conformance_framework.h"
 #include "conformance_utils.h"
 #include "graphics_plugin.h"
+#include "latency_histogram.h"
+#include "report.h"
 #include "swapchain_image_data.h"
+#include "two_call_util.h"
 #include "utilities/throw_helpers.h"
 #include "utilities/utils.h"
 
@@ -30,9 +33,12 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <fstream>
 #include <initializer_list>
 #include <mutex>
 #include <random>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -284,7 +290,68 @@ namespace Conformance
         }
     }
 
-    TEST_CASE("multithreading", "")
+    // Begins a session with actions, spaces and swapchains in @p env, and runs it to the focused state.
+    void InitSessionTestEnvironment(ThreadTestEnvironment& env)
+    {
+        env.GetAutoBasicSession().Init(AutoBasicSession::beginSession | AutoBasicSession::createActions |
+                                       AutoBasicSession::createSpaces | AutoBasicSession::createSwapchains);
+
+        // AutoBasicSession does not add vibrations or attach action sets
+        {
+            XrActionCreateInfo actionInfo = {XR_TYPE_ACTION_CREATE_INFO};
+            actionInfo.subactionPaths = env.GetAutoBasicSession().handSubactionArray.data();
+            actionInfo.countSubactionPaths = (uint32_t)env.GetAutoBasicSession().handSubactionArray.size();
+
+            actionInfo.actionType = XR_ACTION_TYPE_VIBRATION_OUTPUT;
+            strcpy(actionInfo.actionName, "haptics");
+            strcpy(actionInfo.localizedActionName, "haptics");
+            XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.hapticsAction));
+
+            actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
+            strcpy(actionInfo.actionName, "grip_pose");
+            strcpy(actionInfo.localizedActionName, "Grip pose");
+            XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.gripPoseAction));
+
+            // Ensure the actions are bound
+            XrPath interactionProfilePath = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/interaction_profiles/khr/simple_controller",
+                                                 &interactionProfilePath));
+            XrPath gripPathL = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/input/grip/pose", &gripPathL));
+            XrPath gripPathR = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/input/grip/pose", &gripPathR));
+            XrPath hapticPathL = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/output/haptic", &hapticPathL));
+            XrPath hapticPathR = XR_NULL_PATH;
+            XRC_CHECK_THROW_XRCMD(
+                xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/output/haptic", &hapticPathR));
+            std::vector<XrActionSuggestedBinding> bindings{{env.gripPoseAction, gripPathL},
+                                                           {env.gripPoseAction, gripPathR},
+                                                           {env.hapticsAction, hapticPathL},
+                                                           {env.hapticsAction, hapticPathR}};
+            XrInteractionProfileSuggestedBinding suggestedBindings = {XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+            suggestedBindings.interactionProfile = interactionProfilePath;
+            suggestedBindings.suggestedBindings = (const XrActionSuggestedBinding*)bindings.data();
+            suggestedBindings.countSuggestedBindings = (uint32_t)bindings.size();
+            XRC_CHECK_THROW_XRCMD(xrSuggestInteractionProfileBindings(env.GetAutoBasicSession().GetInstance(), &suggestedBindings));
+
+            XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+            attachInfo.countActionSets = 1;
+            attachInfo.actionSets = &env.GetAutoBasicSession().actionSet;
+            XRC_CHECK_THROW_XRCMD(xrAttachSessionActionSets(env.GetAutoBasicSession(), &attachInfo));
+        }
+
+        // Get frames iterating to the point of app focused state. This will draw frames along the way.
+        FrameIterator frameIterator(&env.GetAutoBasicSession());
+        frameIterator.RunToSessionState(XR_SESSION_STATE_FOCUSED);
+
+        env.lastFrameTime = frameIterator.frameState.predictedDisplayTime;
+    }
+
+    TEST_CASE("multithreading", "[exclusive_session]")
     {
         // As of May 2019, Catch2 documents that multithreaded tests must not access test primitives (e.g. REQUIRE)
         // from multiple threads simultaneously, though it is planned to be supported at some point in the future.
@@ -332,62 +399,7 @@ namespace Conformance
         // Exercise session multithreading.
         {
             ThreadTestEnvironment env(invocationCount);
-            env.GetAutoBasicSession().Init(AutoBasicSession::beginSession | AutoBasicSession::createActions |
-                                           AutoBasicSession::createSpaces | AutoBasicSession::createSwapchains);
-
-            // AutoBasicSession does not add vibrations or attach action sets
-            {
-                XrActionCreateInfo actionInfo = {XR_TYPE_ACTION_CREATE_INFO};
-                actionInfo.subactionPaths = env.GetAutoBasicSession().handSubactionArray.data();
-                actionInfo.countSubactionPaths = (uint32_t)env.GetAutoBasicSession().handSubactionArray.size();
-
-                actionInfo.actionType = XR_ACTION_TYPE_VIBRATION_OUTPUT;
-                strcpy(actionInfo.actionName, "haptics");
-                strcpy(actionInfo.localizedActionName, "haptics");
-                XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.hapticsAction));
-
-                actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
-                strcpy(actionInfo.actionName, "grip_pose");
-                strcpy(actionInfo.localizedActionName, "Grip pose");
-                XRC_CHECK_THROW_XRCMD(xrCreateAction(env.GetAutoBasicSession().actionSet, &actionInfo, &env.gripPoseAction));
-
-                // Ensure the actions are bound
-                XrPath interactionProfilePath = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/interaction_profiles/khr/simple_controller",
-                                                     &interactionProfilePath));
-                XrPath gripPathL = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/input/grip/pose", &gripPathL));
-                XrPath gripPathR = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/input/grip/pose", &gripPathR));
-                XrPath hapticPathL = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/left/output/haptic", &hapticPathL));
-                XrPath hapticPathR = XR_NULL_PATH;
-                XRC_CHECK_THROW_XRCMD(
-                    xrStringToPath(env.GetAutoBasicSession().GetInstance(), "/user/hand/right/output/haptic", &hapticPathR));
-                std::vector<XrActionSuggestedBinding> bindings{{env.gripPoseAction, gripPathL},
-                                                               {env.gripPoseAction, gripPathR},
-                                                               {env.hapticsAction, hapticPathL},
-                                                               {env.hapticsAction, hapticPathR}};
-                XrInteractionProfileSuggestedBinding suggestedBindings = {XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
-                suggestedBindings.interactionProfile = interactionProfilePath;
-                suggestedBindings.suggestedBindings = (const XrActionSuggestedBinding*)bindings.data();
-                suggestedBindings.countSuggestedBindings = (uint32_t)bindings.size();
-                XRC_CHECK_THROW_XRCMD(xrSuggestInteractionProfileBindings(env.GetAutoBasicSession().GetInstance(), &suggestedBindings));
-
-                XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
-                attachInfo.countActionSets = 1;
-                attachInfo.actionSets = &env.GetAutoBasicSession().actionSet;
-                XRC_CHECK_THROW_XRCMD(xrAttachSessionActionSets(env.GetAutoBasicSession(), &attachInfo));
-            }
-
-            // Get frames iterating to the point of app focused state. This will draw frames along the way.
-            FrameIterator frameIterator(&env.GetAutoBasicSession());
-            frameIterator.RunToSessionState(XR_SESSION_STATE_FOCUSED);
-
-            env.lastFrameTime = frameIterator.frameState.predictedDisplayTime;
+            InitSessionTestEnvironment(env);
 
             GlobalData& globalData = GetGlobalData();
 
@@ -403,6 +415,370 @@ namespace Conformance
         }
     }
 
+    // State of one thread of the stress test.
+    struct StressThreadState
+    {
+        StressThreadState(ThreadTestEnvironment& env, const std::vector<XrSpace>& spaces, uint64_t seed)
+            : env(env), spaces(spaces), engine(seed)
+        {
+        }
+
+        // Picks an index below @p count with this thread's engine, so that the threads do not contend on the shared one.
+        size_t RandomIndex(size_t count)
+        {
+            return std::uniform_int_distribution<size_t>(0, count - 1)(engine);
+        }
+
+        ThreadTestEnvironment& env;
+        // The spaces this thread locates: its own, or the session's.
+        const std::vector<XrSpace>& spaces;
+        std::mt19937_64 engine;
+        // Paths this thread made with xrStringToPath, for xrPathToString.
+        std::vector<XrPath> paths;
+        // Sized before the thread begins, so that xrEnumerateReferenceSpaces is a single call.
+        std::vector<XrReferenceSpaceType> referenceSpaceTypes;
+    };
+
+    // Makes exactly one call to an entry point and returns how long the runtime took, excluding the preparation of its
+    // arguments. Throws if the call fails.
+    typedef std::chrono::nanoseconds (*StressCallFunction)(StressThreadState& state);
+
+    // Times a single OpenXR call.
+    template <typename Call>
+    std::chrono::nanoseconds TimeStressCall(const char* functionName, Call&& call)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const XrResult result = call();
+        const auto end = std::chrono::steady_clock::now();
+        XRC_CHECK_THROW_XRRESULT(result, functionName);
+        return end - start;
+    }
+
+    std::chrono::nanoseconds Stress_xrLocateSpace(StressThreadState& state)
+    {
+        const XrSpace space = state.spaces[state.RandomIndex(state.spaces.size())];
+        const XrSpace baseSpace = state.spaces[state.RandomIndex(state.spaces.size())];
+        const XrTime time = state.env.lastFrameTime;
+        XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+        return TimeStressCall("xrLocateSpace", [&] { return xrLocateSpace(space, baseSpace, time, &location); });
+    }
+
+    std::chrono::nanoseconds Stress_xrSyncActions(StressThreadState& state)
+    {
+        AutoBasicSession& session = state.env.GetAutoBasicSession();
+        const XrActiveActionSet activeActionSets[] = {{session.actionSet, session.handSubactionArray[0]},
+                                                      {session.actionSet, session.handSubactionArray[1]}};
+        XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+        syncInfo.countActiveActionSets = 2;
+        syncInfo.activeActionSets = activeActionSets;
+        const XrSession handle = session.GetSession();
+        return TimeStressCall("xrSyncActions", [&] { return xrSyncActions(handle, &syncInfo); });
+    }
+
+    std::chrono::nanoseconds Stress_xrGetActionStatePose(StressThreadState& state)
+    {
+        AutoBasicSession& session = state.env.GetAutoBasicSession();
+        XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+        getInfo.action = state.env.gripPoseAction;
+        getInfo.subactionPath = session.handSubactionArray[state.RandomIndex(session.handSubactionArray.size())];
+        XrActionStatePose actionState{XR_TYPE_ACTION_STATE_POSE};
+        const XrSession handle = session.GetSession();
+        return TimeStressCall("xrGetActionStatePose", [&] { return xrGetActionStatePose(handle, &getInfo, &actionState); });
+    }
+
+    std::chrono::nanoseconds Stress_xrStringToPath(StressThreadState& state)
+    {
+        const std::string pathString = "/stress/" + std::to_string(state.RandomIndex(10000));
+        const XrInstance instance = state.env.GetAutoBasicSession().GetInstance();
+        XrPath path = XR_NULL_PATH;
+        const std::chrono::nanoseconds latency =
+            TimeStressCall("xrStringToPath", [&] { return xrStringToPath(instance, pathString.c_str(), &path); });
+        // Kept bounded, so that recording paths does not allocate once the thread is running.
+        if (state.paths.size() < state.paths.capacity()) {
+            state.paths.push_back(path);
+        }
+        else {
+            state.paths[state.RandomIndex(state.paths.size())] = path;
+        }
+        return latency;
+    }
+
+    std::chrono::nanoseconds Stress_xrPathToString(StressThreadState& state)
+    {
+        const XrPath path = state.paths[state.RandomIndex(state.paths.size())];
+        const XrInstance instance = state.env.GetAutoBasicSession().GetInstance();
+        char buffer[XR_MAX_PATH_LENGTH];
+        uint32_t length = 0;
+        return TimeStressCall("xrPathToString",
+                              [&] { return xrPathToString(instance, path, (uint32_t)sizeof(buffer), &length, buffer); });
+    }
+
+    std::chrono::nanoseconds Stress_xrGetInstanceProperties(StressThreadState& state)
+    {
+        const XrInstance instance = state.env.GetAutoBasicSession().GetInstance();
+        XrInstanceProperties instanceProperties{XR_TYPE_INSTANCE_PROPERTIES};
+        return TimeStressCall("xrGetInstanceProperties", [&] { return xrGetInstanceProperties(instance, &instanceProperties); });
+    }
+
+    std::chrono::nanoseconds Stress_xrEnumerateReferenceSpaces(StressThreadState& state)
+    {
+        const XrSession session = state.env.GetAutoBasicSession().GetSession();
+        std::vector<XrReferenceSpaceType>& types = state.referenceSpaceTypes;
+        uint32_t countOutput = 0;
+        return TimeStressCall("xrEnumerateReferenceSpaces", [&] {
+            return xrEnumerateReferenceSpaces(session, (uint32_t)types.size(), &countOutput, types.data());
+        });
+    }
+
+    std::chrono::nanoseconds Stress_xrGetReferenceSpaceBoundsRect(StressThreadState& state)
+    {
+        const XrSession session = state.env.GetAutoBasicSession().GetSession();
+        // Only the enumerated types are supported; STAGE in particular is optional.
+        const XrReferenceSpaceType type = state.referenceSpaceTypes[state.RandomIndex(state.referenceSpaceTypes.size())];
+        XrExtent2Df bounds{};
+        return TimeStressCall("xrGetReferenceSpaceBoundsRect",
+                              [&] { return xrGetReferenceSpaceBoundsRect(session, type, &bounds); });
+    }
+
+    std::chrono::nanoseconds Stress_xrPollEvent(StressThreadState& state)
+    {
+        const XrInstance instance = state.env.GetAutoBasicSession().GetInstance();
+        XrEventDataBuffer eventDataBuffer{XR_TYPE_EVENT_DATA_BUFFER};
+        return TimeStressCall("xrPollEvent", [&] { return xrPollEvent(instance, &eventDataBuffer); });
+    }
+
+    std::chrono::nanoseconds Stress_xrGetInstanceProcAddr(StressThreadState& state)
+    {
+        const XrInstance instance = state.env.GetAutoBasicSession().GetInstance();
+        PFN_xrVoidFunction function = nullptr;
+        return TimeStressCall("xrGetInstanceProcAddr", [&] { return xrGetInstanceProcAddr(instance, "xrPollEvent", &function); });
+    }
+
+    std::chrono::nanoseconds Stress_xrResultToString(StressThreadState& state)
+    {
+        const XrInstance instance = state.env.GetAutoBasicSession().GetInstance();
+        const XrResult value = (XrResult)((int32_t)state.RandomIndex(55) - 45);
+        char buffer[XR_MAX_RESULT_STRING_SIZE];
+        return TimeStressCall("xrResultToString", [&] { return xrResultToString(instance, value, buffer); });
+    }
+
+    // An entry point the stress test can call, by the name used in --stressCallMix.
+    struct StressEntryPoint
+    {
+        const char* functionName;
+        StressCallFunction call;
+    };
+
+    const StressEntryPoint stressEntryPoints[] = {
+        {"xrLocateSpace", Stress_xrLocateSpace},
+        {"xrSyncActions", Stress_xrSyncActions},
+        {"xrGetActionStatePose", Stress_xrGetActionStatePose},
+        {"xrStringToPath", Stress_xrStringToPath},
+        {"xrPathToString", Stress_xrPathToString},
+        {"xrGetInstanceProperties", Stress_xrGetInstanceProperties},
+        {"xrEnumerateReferenceSpaces", Stress_xrEnumerateReferenceSpaces},
+        {"xrGetReferenceSpaceBoundsRect", Stress_xrGetReferenceSpaceBoundsRect},
+        {"xrPollEvent", Stress_xrPollEvent},
+        {"xrGetInstanceProcAddr", Stress_xrGetInstanceProcAddr},
+        {"xrResultToString", Stress_xrResultToString},
+    };
+
+    // An entry point called by the stress test, and how often it is picked relative to the others.
+    struct StressCall
+    {
+        const StressEntryPoint* entryPoint;
+        uint32_t weight;
+    };
+
+    // Parses a call mix such as "xrLocateSpace=4,xrSyncActions=1" into the matching entries of stressEntryPoints.
+    // Throws if a name is not one of them or a weight is missing.
+    std::vector<StressCall> ParseStressCallMix(const std::string& mix)
+    {
+        std::vector<StressCall> calls;
+        std::istringstream iss(mix);
+        std::string item;
+        while (std::getline(iss, item, ',')) {
+            const size_t separator = item.find('=');
+            const std::string name = item.substr(0, separator);
+            char* end = nullptr;
+            const char* weightString = separator == std::string::npos ? "" : item.c_str() + separator + 1;
+            const unsigned long weight = std::strtoul(weightString, &end, 10);
+            if (end == weightString || *end != '\0' || weight == 0) {
+                throw std::invalid_argument("Stress call mix entry '" + item + "' is not name=weight");
+            }
+            auto it = std::find_if(std::begin(stressEntryPoints), std::end(stressEntryPoints),
+                                   [&](const StressEntryPoint& entryPoint) { return name == entryPoint.functionName; });
+            if (it == std::end(stressEntryPoints)) {
+                throw std::invalid_argument("Stress call mix entry '" + name + "' is not an entry point the stress test calls");
+            }
+            calls.push_back({&*it, (uint32_t)weight});
+        }
+        if (calls.empty()) {
+            throw std::invalid_argument("Stress call mix is empty");
+        }
+        return calls;
+    }
+
+    // StressThreadFunction
+    //
+    // Executes a single thread of the stress test: calls entry points picked by weight until the deadline, recording the
+    // latency of each call in the histogram of its entry point. Stops at the first error.
+    void StressThreadFunction(ThreadTestEnvironment& env, const std::vector<StressCall>& calls, const std::vector<XrSpace>& spaces,
+                              uint64_t seed, const std::chrono::steady_clock::time_point& deadline,
+                              std::vector<LatencyHistogram>& latencies)
+    {
+        StressThreadState state(env, spaces, seed);
+        std::vector<uint32_t> weights;
+        for (const StressCall& call : calls) {
+            weights.push_back(call.weight);
+        }
+        std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+
+        try {
+            // Prepared before beginning, so that every call the thread makes while running is measured.
+            const XrInstance instance = env.GetAutoBasicSession().GetInstance();
+            state.paths.reserve(1000);
+            state.paths.push_back(XR_NULL_PATH);
+            XRC_CHECK_THROW_XRCMD(xrStringToPath(instance, "/stress", &state.paths.back()));
+            XRC_CHECK_THROW_XRCMD(doTwoCallInPlace(state.referenceSpaceTypes, xrEnumerateReferenceSpaces,
+                                                   env.GetAutoBasicSession().GetSession()));
+        }
+        catch (const std::exception& ex) {
+            env.AppendError(ex.what());
+            return;
+        }
+
+        env.WaitToBegin();
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            const size_t index = pick(state.engine);
+            try {
+                latencies[index].Add(calls[index].entryPoint->call(state));
+            }
+            catch (const std::exception& ex) {
+                env.AppendError(ex.what());
+                return;
+            }
+        }
+    }
+
+    // Characterizes how the runtime scales with the number of threads calling it, rather than only checking that
+    // concurrent calls work. Configured with --stressThreads, --stressDuration, --stressCallMix and --stressHandleSharing.
+    TEST_CASE("multithreading_stress", "[exclusive_session][stress][.]")
+    {
+        using Clock = std::chrono::steady_clock;
+        using us = std::chrono::duration<double, std::micro>;
+
+        GlobalData& globalData = GetGlobalData();
+        const size_t threadCount = std::max(globalData.options.stressThreads, 1u);
+        const std::chrono::seconds duration(globalData.options.stressDurationSeconds);
+        const bool perThreadSpaces = globalData.options.stressHandleSharing == "perThread";
+
+        ThreadTestEnvironment env(0);
+        InitSessionTestEnvironment(env);
+        XrSession session = env.GetAutoBasicSession().GetSession();
+
+        std::vector<StressCall> calls;
+        REQUIRE_NOTHROW(calls = ParseStressCallMix(globalData.options.stressCallMix));
+
+        // Spaces are created before the threads, so that nothing throws while they wait to begin.
+        std::vector<std::vector<XrSpace>> threadSpaces(perThreadSpaces ? threadCount : 0);
+        if (perThreadSpaces) {
+            std::vector<XrReferenceSpaceType> referenceSpaceTypes;
+            XRC_CHECK_THROW_XRCMD(doTwoCallInPlace(referenceSpaceTypes, xrEnumerateReferenceSpaces, session));
+            for (std::vector<XrSpace>& spaces : threadSpaces) {
+                for (XrReferenceSpaceType referenceSpaceType : referenceSpaceTypes) {
+                    XrReferenceSpaceCreateInfo createInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+                    createInfo.referenceSpaceType = referenceSpaceType;
+                    createInfo.poseInReferenceSpace = Pose::Identity;
+                    XrSpace space;
+                    XRC_CHECK_THROW_XRCMD(xrCreateReferenceSpace(session, &createInfo, &space));
+                    spaces.push_back(space);
+                }
+            }
+        }
+
+        if (globalData.GetGraphicsPlugin()) {
+            globalData.GetGraphicsPlugin()->MakeCurrent(false);
+        }
+
+        // Histograms are allocated before the threads start, one per thread and entry point.
+        std::vector<std::vector<LatencyHistogram>> threadLatencies(threadCount, std::vector<LatencyHistogram>(calls.size()));
+        Clock::time_point deadline;
+        std::vector<std::thread>& threadVector = env.ThreadVector();
+        for (size_t i = 0; i < threadCount; ++i) {
+            const uint64_t seed = globalData.GetRandEngine().RandUint64(0, UINT64_MAX);
+            const std::vector<XrSpace>& spaces = perThreadSpaces ? threadSpaces[i] : env.GetAutoBasicSession().spaceVector;
+            threadVector.emplace_back(StressThreadFunction, std::ref(env), std::cref(calls), std::cref(spaces), seed,
+                                      std::cref(deadline), std::ref(threadLatencies[i]));
+        }
+
+        const Clock::time_point start = Clock::now();
+        deadline = start + duration;
+        env.SignalBegin();
+        for (std::thread& thread : threadVector) {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (globalData.GetGraphicsPlugin()) {
+            globalData.GetGraphicsPlugin()->MakeCurrent(true);
+        }
+        for (const std::vector<XrSpace>& spaces : threadSpaces) {
+            for (XrSpace space : spaces) {
+                XRC_CHECK_THROW_XRCMD(xrDestroySpace(space));
+            }
+        }
+
+        std::vector<LatencyHistogram> callLatencies(calls.size());
+        uint64_t totalCalls = 0;
+        for (size_t thread = 0; thread < threadCount; ++thread) {
+            LatencyHistogram threadTotal;
+            for (size_t call = 0; call < calls.size(); ++call) {
+                threadTotal.Merge(threadLatencies[thread][call]);
+                callLatencies[call].Merge(threadLatencies[thread][call]);
+            }
+            totalCalls += threadTotal.GetCount();
+            ReportF("Stress thread %u: %llu calls, %.0f calls/s, p50 %.1fus, p99 %.1fus", (unsigned)thread,
+                    (unsigned long long)threadTotal.GetCount(), threadTotal.GetCount() / seconds,
+                    std::chrono::duration_cast<us>(threadTotal.GetPercentile(50)).count(),
+                    std::chrono::duration_cast<us>(threadTotal.GetPercentile(99)).count());
+        }
+        for (size_t call = 0; call < calls.size(); ++call) {
+            const DurationPercentiles percentiles = callLatencies[call].GetPercentiles();
+            ReportF("Stress %s (weight %u): %llu calls, %.0f calls/s, p50 %.1fus, p95 %.1fus, p99 %.1fus, max %.1fus",
+                    calls[call].entryPoint->functionName, calls[call].weight, (unsigned long long)callLatencies[call].GetCount(),
+                    callLatencies[call].GetCount() / seconds, std::chrono::duration_cast<us>(percentiles.p50).count(),
+                    std::chrono::duration_cast<us>(percentiles.p95).count(),
+                    std::chrono::duration_cast<us>(percentiles.p99).count(),
+                    std::chrono::duration_cast<us>(percentiles.max).count());
+        }
+        ReportF("Stress: %u threads, %s spaces, %llu calls in %.1fs, %.0f calls/s", (unsigned)threadCount,
+                perThreadSpaces ? "per-thread" : "shared", (unsigned long long)totalCalls, seconds, totalCalls / seconds);
+
+        if (!globalData.options.stressCsv.empty()) {
+            std::ofstream csv(globalData.options.stressCsv);
+            csv << "thread,entryPoint,bucketUpperBoundNs,count\n";
+            for (size_t thread = 0; thread < threadCount; ++thread) {
+                for (size_t call = 0; call < calls.size(); ++call) {
+                    const LatencyHistogram& histogram = threadLatencies[thread][call];
+                    for (size_t bucket = 0; bucket < LatencyHistogram::BucketCount; ++bucket) {
+                        if (histogram.GetBucketCount(bucket) != 0) {
+                            csv << thread << ',' << calls[call].entryPoint->functionName << ','
+                                << LatencyHistogram::GetBucketUpperBound(bucket).count() << ',' << histogram.GetBucketCount(bucket)
+                                << '\n';
+                        }
+                    }
+                }
+            }
+            if (!csv) {
+                WARN("Could not write the stress latency histograms to " << globalData.options.stressCsv);
+            }
+        }
+
+        REQUIRE_MSG(env.ErrorCount() == 0, env.OutputText())
+    }
+
     // To consider: We could have exercise functions below auto-add themselves to a vector on startup.
     // A challenge with that is that code linkers will often elide such auto-add functions unless you
     // annotate them specially [e.g. GCC's __attribute__((constructor)) ] See XRC_BEGIN_ON_STARTUP.
@@ -32,7 +32,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrCreateSession", "")
+    TEST_CASE("xrCreateSession", "[exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
 
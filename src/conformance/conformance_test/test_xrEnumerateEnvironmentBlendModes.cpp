@@ -37,7 +37,7 @@ constexpr XrViewConfigurationType KnownViewTypes[] = {XR_LIST_ENUM_XrViewConfigu
 namespace Conformance
 {
 
-    TEST_CASE("xrEnumerateEnvironmentBlendModes", "")
+    TEST_CASE("xrEnumerateEnvironmentBlendModes", "[pooled_instance]")
     {
         GlobalData& globalData = GetGlobalData();
 
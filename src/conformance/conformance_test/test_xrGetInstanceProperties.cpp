@@ -27,7 +27,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrGetInstanceProperties", "")
+    TEST_CASE("xrGetInstanceProperties", "[pooled_instance]")
     {
         // XrResult xrGetInstanceProperties(XrInstance instance, XrInstanceProperties* instanceProperties);
 
@@ -26,7 +26,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrGetSystem", "")
+    TEST_CASE("xrGetSystem", "[pooled_instance]")
     {
         // XrResult xrGetSystem(XrInstance instance, const XrSystemGetInfo* getInfo, XrSystemId* systemId);
         auto &globalData = GetGlobalData();
@@ -27,7 +27,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrGetSystemProperties", "")
+    TEST_CASE("xrGetSystemProperties", "[pooled_instance]")
     {
         XrSystemProperties systemProperties{XR_TYPE_SYSTEM_PROPERTIES};
 
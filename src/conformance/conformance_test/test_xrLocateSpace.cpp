@@ -33,7 +33,7 @@ namespace Conformance
 {
     using namespace openxr::math_operators;
 
-    TEST_CASE("xrLocateSpace", "")
+    TEST_CASE("xrLocateSpace", "[exclusive_session]")
     {
         // Get a session started.
         AutoBasicSession session(AutoBasicSession::createInstance | AutoBasicSession::createSession | AutoBasicSession::beginSession |
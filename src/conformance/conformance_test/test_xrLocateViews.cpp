@@ -29,7 +29,7 @@ static constexpr std::pair<XrViewConfigurationType, const char*> KnownViewTypes[
 
 namespace Conformance
 {
-    TEST_CASE("xrLocateViews", "")
+    TEST_CASE("xrLocateViews", "[exclusive_session]")
     {
         GlobalData& globalData = GetGlobalData();
 
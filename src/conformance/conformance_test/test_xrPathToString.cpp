@@ -23,7 +23,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrPathToString", "")
+    TEST_CASE("xrPathToString", "[pooled_instance]")
     {
         // XrResult xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char*
         // buffer);
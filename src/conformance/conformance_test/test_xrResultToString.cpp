@@ -34,7 +34,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrResultToString", "")
+    TEST_CASE("xrResultToString", "[pooled_instance]")
     {
         // XrResult xrResultToString(XrInstance instance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE]);
 
@@ -30,7 +30,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrStringToPath", "")
+    TEST_CASE("xrStringToPath", "[pooled_instance]")
     {
         // XrResult xrStringToPath(XrInstance instance, const char* pathString, XrPath* path);
         // XrResult xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char*
@@ -34,7 +34,7 @@
 namespace Conformance
 {
 
-    TEST_CASE("xrStructureTypeToString", "")
+    TEST_CASE("xrStructureTypeToString", "[pooled_instance]")
     {
         // XrResult xrStructureTypeToString(XrInstance instance, XrStructureType value, char buffer[XR_MAX_STRUCTURE_NAME_SIZE]);
 
@@ -4,7 +4,8 @@
 
 #include "RGBAImage.h"
 
-#include "utilities/colors.h"
+#include "utilities/lru_cache.h"
+#include "utilities/pixel_kernels.h"
 #include "conformance_framework.h"
 #include "report.h"
 
@@ -27,8 +28,10 @@
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 
@@ -40,6 +43,13 @@ namespace
         return {{(uint8_t)(255 * r), (uint8_t)(255 * g), (uint8_t)(255 * b), (uint8_t)(255 * a)}};
     };
 
+    // Convert a premultiplied R32G32B32A_FLOAT color to 8-bit channels for blending, rounding to nearest.
+    Conformance::PixelKernels::RGBA8 AsBlendColor(XrColor4f color)
+    {
+        auto toChannel = [](float c) { return (uint8_t)std::lround(std::min(std::max(c, 0.0f), 1.0f) * 255.0f); };
+        return {toChannel(color.r), toChannel(color.g), toChannel(color.b), toChannel(color.a)};
+    }
+
     // Cached TrueType font baked as glyphs.
     struct BakedFont
     {
@@ -95,7 +105,10 @@ namespace
 
         static std::shared_ptr<const BakedFont> GetOrCreate(int pixelHeight)
         {
-            std::unordered_map<int, std::shared_ptr<BakedFont>> s_bakedFonts;
+            // Each size is baked once and kept for the lifetime of the process.
+            static std::mutex s_bakedFontsMutex;
+            static std::unordered_map<int, std::shared_ptr<BakedFont>> s_bakedFonts;
+            std::lock_guard<std::mutex> lock(s_bakedFontsMutex);
             auto it = s_bakedFonts.find(pixelHeight);
             if (it == s_bakedFonts.end()) {
                 std::shared_ptr<BakedFont> font = std::make_shared<BakedFont>(pixelHeight);
@@ -126,6 +139,187 @@ namespace
         int m_bitmapWidth;
         int m_bitmapHeight;
     };
+
+    /// Glyph coverage of a laid-out string, relative to its destination rectangle.
+    struct TextMask
+    {
+        int32_t width;
+        int32_t height;
+        std::vector<uint8_t> coverage;
+        /// For each row, the range of columns with any coverage (empty if first == second).
+        std::vector<std::pair<int32_t, int32_t>> rowSpans;
+
+        const uint8_t* GetRow(int32_t row) const
+        {
+            return coverage.data() + (size_t)row * width;
+        }
+    };
+
+    /// Cache of laid-out and rasterized text, so that drawing a label again only needs to blend its coverage.
+    class TextLayoutCache
+    {
+    public:
+        static TextLayoutCache& Get()
+        {
+            static TextLayoutCache s_cache;
+            return s_cache;
+        }
+
+        std::shared_ptr<const TextMask> GetOrCreate(const XrRect2Di& rect, const char* text, int pixelHeight,
+                                                    Conformance::WordWrap wordWrap)
+        {
+            Key key{text, pixelHeight, rect.offset.x, rect.offset.y, rect.extent.width, rect.extent.height, wordWrap};
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (std::shared_ptr<const TextMask> cached = m_masks.Find(key)) {
+                    return cached;
+                }
+            }
+
+            std::shared_ptr<const TextMask> mask = Layout(rect, text, pixelHeight, wordWrap);
+            if (!mask)
+                return nullptr;
+
+            const size_t bytes = mask->coverage.size() + mask->rowSpans.size() * sizeof(mask->rowSpans[0]) + key.text.size();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // If the key already exists then the existing mask will be returned.
+            return m_masks.Insert(key, std::move(mask), bytes);
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_masks.Clear();
+        }
+
+    private:
+        /// Room for a few dozen of the largest labels, the full-screen descriptions of interactive tests.
+        static constexpr size_t BudgetBytes = 16 * 1024 * 1024;
+
+        struct Key
+        {
+            std::string text;
+            int pixelHeight;
+            int32_t x;
+            int32_t y;
+            int32_t width;
+            int32_t height;
+            Conformance::WordWrap wordWrap;
+
+            bool operator<(const Key& other) const
+            {
+                return std::tie(text, pixelHeight, x, y, width, height, wordWrap) <
+                       std::tie(other.text, other.pixelHeight, other.x, other.y, other.width, other.height, other.wordWrap);
+            }
+        };
+
+        static std::shared_ptr<const TextMask> Layout(const XrRect2Di& rect, const char* text, int pixelHeight,
+                                                      Conformance::WordWrap wordWrap)
+        {
+            using Conformance::WordWrap;
+
+            const std::shared_ptr<const BakedFont> font = BakedFont::GetOrCreate(pixelHeight);
+            if (!font)
+                return nullptr;
+
+            auto mask = std::make_shared<TextMask>();
+            mask->width = std::max(rect.extent.width, 0);
+            mask->height = std::max(rect.extent.height, 0);
+            mask->coverage.resize((size_t)mask->width * mask->height);
+            mask->rowSpans.resize(mask->height, {mask->width, 0});
+
+            float xadvance = (float)rect.offset.x;
+            // Adjust down because glyphs are relative to the font baseline. This is hacky.
+            int yadvance = rect.offset.y + (int)(pixelHeight * 0.8f);
+
+            const char* const fullText = text;
+
+            // Loop through each character and copy over the chracters' glyphs.
+            for (; *text; text++) {
+                if (*text == '\n') {
+                    xadvance = (float)rect.offset.x;
+                    yadvance += pixelHeight;
+                    continue;
+                }
+
+                // Word wrap.
+                {
+                    float remainingWordWidth = 0;
+                    for (const char* w = text; *w > ' '; w++) {
+                        const stbtt_bakedchar& bakedChar = font->GetBakedChar(*w);
+                        remainingWordWidth += bakedChar.xadvance;
+                    }
+
+                    // Wrap to new line if there isn't enough room for this word.
+                    if (xadvance + remainingWordWidth > rect.offset.x + rect.extent.width) {
+                        // But only if the word isn't longer than the destination.
+                        if (remainingWordWidth <= (rect.extent.width - rect.offset.x)) {
+                            if (wordWrap == WordWrap::Enabled) {
+                                xadvance = (float)rect.offset.x;
+                                yadvance += pixelHeight;
+                            }
+                            else {
+                                Conformance::ReportConsoleOnlyF(
+                                    "CTS dev warning: Would have wrapped this text but told to disable word wrap! Text: %s",
+                                    fullText);
+                            }
+                        }
+                    }
+                }
+
+                const stbtt_bakedchar& bakedChar = font->GetBakedChar(*text);
+                const int characterWidth = (int)(bakedChar.x1 - bakedChar.x0);
+                const int characterHeight = (int)(bakedChar.y1 - bakedChar.y0);
+
+                if ((xadvance + characterWidth) > (rect.offset.x + rect.extent.width)) {
+                    if (wordWrap == WordWrap::Enabled) {
+
+                        // Wrap to new line if there isn't enough room for this char.
+                        xadvance = (float)rect.offset.x;
+                        yadvance += pixelHeight;
+                    }
+                    else {
+                        Conformance::ReportConsoleOnlyF(
+                            "CTS dev warning: Would have wrapped this text but told to disable word wrap! Text: %s", fullText);
+                    }
+                }
+
+                // Clip the glyph columns against the destination rectangle, in mask coordinates.
+                const int maskStartX = (int)std::lround(bakedChar.xoff + xadvance) - rect.offset.x;
+                const int cxBegin = std::max(0, -maskStartX);
+                const int cxEnd = std::min(characterWidth, mask->width - maskStartX);
+
+                // For each row of the glyph bitmap
+                for (int cy = 0; cy < characterHeight && cxBegin < cxEnd; cy++) {
+                    // Compute the destination row in the mask.
+                    const int maskY = yadvance + cy + (int)bakedChar.yoff - rect.offset.y;
+                    if (maskY < 0 || maskY >= mask->height) {
+                        continue;  // Don't bother copying if out of bounds.
+                    }
+
+                    // Glyphs are 0-255 intensity. Combine with any overlapping glyph as if they were blended in turn.
+                    const uint8_t* const srcGlyphRow = font->GetBakedCharRow(bakedChar, cy) + bakedChar.x0;
+                    // Start from the first column inside the mask, since maskStartX itself may be negative.
+                    uint8_t* dest = mask->coverage.data() + (size_t)maskY * mask->width + (size_t)(maskStartX + cxBegin);
+                    for (int cx = cxBegin; cx < cxEnd; cx++, dest++) {
+                        const int existing = *dest;
+                        *dest = (uint8_t)(existing + (srcGlyphRow[cx] * (255 - existing) + 127) / 255);
+                    }
+
+                    std::pair<int32_t, int32_t>& span = mask->rowSpans[maskY];
+                    span.first = std::min(span.first, maskStartX + cxBegin);
+                    span.second = std::max(span.second, maskStartX + cxEnd);
+                }
+
+                xadvance += bakedChar.xadvance;
+            }
+
+            return mask;
+        }
+
+        std::mutex m_mutex;
+        Conformance::LruCache<Key, TextMask> m_masks{BudgetBytes};
+    };
 }  // namespace
 
 namespace Conformance
@@ -181,6 +375,34 @@ namespace Conformance
     }
 
     void RGBAImage::PutText(const XrRect2Di& rect, const char* text, int pixelHeight, XrColor4f color, WordWrap wordWrap)
+    {
+        const std::shared_ptr<const TextMask> mask = TextLayoutCache::Get().GetOrCreate(rect, text, pixelHeight, wordWrap);
+        if (!mask)
+            return;
+
+        const PixelKernels::RGBA8 blendColor = AsBlendColor(color);
+
+        for (int32_t row = 0; row < mask->height; row++) {
+            const int destY = rect.offset.y + row;
+            if (destY < 0 || destY >= height) {
+                continue;  // Don't bother copying if out of bounds.
+            }
+
+            // Clip the covered columns of this row against the image.
+            const int32_t begin = std::max(mask->rowSpans[row].first, -rect.offset.x);
+            const int32_t end = std::min(mask->rowSpans[row].second, width - rect.offset.x);
+            if (begin >= end) {
+                continue;
+            }
+
+            // Do blending (assuming premultiplication).
+            RGBA8Color* const destImageRow = pixels.data() + (destY * width);
+            PixelKernels::BlendCoverage(&destImageRow[rect.offset.x + begin].Channels.R, mask->GetRow(row) + begin, end - begin,
+                                        blendColor);
+        }
+    }
+
+    void RGBAImage::PutTextUncached(const XrRect2Di& rect, const char* text, int pixelHeight, XrColor4f color, WordWrap wordWrap)
     {
         const std::shared_ptr<const BakedFont> font = BakedFont::GetOrCreate(pixelHeight);
         if (!font)
@@ -191,6 +413,7 @@ namespace Conformance
             rect.offset.y + (int)(pixelHeight * 0.8f);  // Adjust down because glyphs are relative to the font baseline. This is hacky.
 
         const char* const fullText = text;
+        const PixelKernels::RGBA8 blendColor = AsBlendColor(color);
 
         // Loop through each character and copy over the chracters' glyphs.
         for (; *text; text++) {
@@ -204,7 +427,7 @@ namespace Conformance
             {
                 float remainingWordWidth = 0;
                 for (const char* w = text; *w > ' '; w++) {
-                    const stbtt_bakedchar& bakedChar = font->GetBakedChar(*text);
+                    const stbtt_bakedchar& bakedChar = font->GetBakedChar(*w);
                     remainingWordWidth += bakedChar.xadvance;
                 }
 
@@ -240,8 +463,15 @@ namespace Conformance
                 }
             }
 
+            // Clip the glyph columns against the image and the destination rectangle.
+            const int destStartX = (int)std::lround(bakedChar.xoff + xadvance);
+            const int clipMinX = std::max(0, rect.offset.x);
+            const int clipMaxX = std::min(width, rect.offset.x + rect.extent.width);
+            const int cxBegin = std::max(0, clipMinX - destStartX);
+            const int cxEnd = std::min(characterWidth, clipMaxX - destStartX);
+
             // For each row of the glyph bitmap
-            for (int cy = 0; cy < characterHeight; cy++) {
+            for (int cy = 0; cy < characterHeight && cxBegin < cxEnd; cy++) {
                 // Compute the destination row in the image.
                 const int destY = yadvance + cy + (int)bakedChar.yoff;
                 if (destY < 0 || destY >= height || destY < rect.offset.y || destY >= rect.offset.y + rect.extent.height) {
@@ -252,23 +482,9 @@ namespace Conformance
                 const uint8_t* const srcGlyphRow = font->GetBakedCharRow(bakedChar, cy);
                 RGBA8Color* const destImageRow = pixels.data() + (destY * width);
 
-                for (int cx = 0; cx < characterWidth; cx++) {
-                    const int destX = (int)std::lround(bakedChar.xoff + xadvance) + cx;
-                    if (destX < 0 || destX >= width || destX < rect.offset.x || destX >= rect.offset.x + rect.extent.width) {
-                        continue;  // Don't bother copying if out of bounds.
-                    }
-
-                    // Glyphs are 0-255 intensity.
-                    const uint8_t srcGlyphPixel = srcGlyphRow[cx + bakedChar.x0];
-
-                    // Do blending (assuming premultiplication).
-                    RGBA8Color pixel = destImageRow[destX];
-                    pixel.Channels.R = (uint8_t)(srcGlyphPixel * color.r) + (pixel.Channels.R * (255 - srcGlyphPixel) / 255);
-                    pixel.Channels.G = (uint8_t)(srcGlyphPixel * color.g) + (pixel.Channels.G * (255 - srcGlyphPixel) / 255);
-                    pixel.Channels.B = (uint8_t)(srcGlyphPixel * color.b) + (pixel.Channels.B * (255 - srcGlyphPixel) / 255);
-                    pixel.Channels.A = (uint8_t)(srcGlyphPixel * color.a) + (pixel.Channels.A * (255 - srcGlyphPixel) / 255);
-                    destImageRow[destX] = pixel;
-                }
+                // Glyphs are 0-255 intensity. Do blending (assuming premultiplication).
+                PixelKernels::BlendCoverage(&destImageRow[destStartX + cxBegin].Channels.R, srcGlyphRow + bakedChar.x0 + cxBegin,
+                                            cxEnd - cxBegin, blendColor);
             }
 
             xadvance += bakedChar.xadvance;
@@ -284,9 +500,7 @@ namespace Conformance
         const RGBA8Color color32 = AsRGBA(color.r, color.g, color.b, color.a);
         for (int row = 0; row < h; row++) {
             RGBA8Color* start = pixels.data() + ((row + y) * width) + x;
-            for (int col = 0; col < w; col++) {
-                *(start + col) = color32;
-            }
+            PixelKernels::Fill(&start->Pixel, w, color32.Pixel);
         }
     }
 
@@ -300,31 +514,26 @@ namespace Conformance
         for (int row = 0; row < h; row++) {
             RGBA8Color* start = pixels.data() + ((row + y) * width) + x;
             if (row < thickness || row >= h - thickness) {
-                for (int col = 0; col < w; col++) {
-                    *(start + col) = color32;
-                }
+                PixelKernels::Fill(&start->Pixel, w, color32.Pixel);
             }
             else {
                 int leftBorderEnd = std::min(thickness, w);
-                for (int col = 0; col < leftBorderEnd; col++) {
-                    *(start + col) = color32;
-                }
+                PixelKernels::Fill(&start->Pixel, leftBorderEnd, color32.Pixel);
 
                 int rightBorderBegin = std::max(w - thickness, 0);
-                for (int col = rightBorderBegin; col < w; col++) {
-                    *(start + col) = color32;
-                }
+                PixelKernels::Fill(&(start + rightBorderBegin)->Pixel, w - rightBorderBegin, color32.Pixel);
             }
         }
     }
 
     void RGBAImage::ConvertToSRGB()
     {
-        for (RGBA8Color& pixel : pixels) {
-            pixel.Channels.R = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.R / 255.0) * 255.0);
-            pixel.Channels.G = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.G / 255.0) * 255.0);
-            pixel.Channels.B = (uint8_t)(ColorUtils::ToSRGB((double)pixel.Channels.B / 255.0) * 255.0);
-        }
+        PixelKernels::ConvertLinearToSRGB(&pixels.data()->Channels.R, pixels.size());
+    }
+
+    void RGBAImage::ClearTextLayoutCache()
+    {
+        TextLayoutCache::Get().Clear();
     }
 
     void RGBAImage::CopyWithStride(uint8_t* data, uint32_t rowPitch, uint32_t offset) const
@@ -46,11 +46,25 @@ namespace Conformance
 
         static RGBAImage Load(const char* path);
 
+        /// Draw text into @p rect, blending over the existing contents.
+        ///
+        /// The layout and glyph coverage of each distinct (text, rect, pixelHeight, wordWrap) combination is cached,
+        /// so drawing the same label again only blends the cached coverage.
         void PutText(const XrRect2Di& rect, const char* text, int pixelHeight, XrColor4f color, WordWrap wordWrap = WordWrap::Enabled);
+
+        /// Draw text glyph by glyph straight into the image, without the layout cache, as PutText did before layouts were
+        /// cached. Overlapping glyphs are blended in turn rather than combined first, which may round differently by one.
+        /// Much slower than PutText: kept as the reference that the cached path is tested against.
+        void PutTextUncached(const XrRect2Di& rect, const char* text, int pixelHeight, XrColor4f color,
+                             WordWrap wordWrap = WordWrap::Enabled);
+
         void DrawRect(int x, int y, int w, int h, XrColor4f color);
         void DrawRectBorder(int x, int y, int w, int h, int thickness, XrColor4f color);
         void ConvertToSRGB();
 
+        /// Drop the text layouts cached by PutText, e.g. to measure uncached text rendering.
+        static void ClearTextLayoutCache();
+
         /// Copy image data row-by-row to a buffer with a (probably different) row pitch explicitly specified,
         /// and optionally an offset from the start of that buffer.
         void CopyWithStride(uint8_t* data, uint32_t rowPitch, uint32_t offset = 0) const;
@@ -26,12 +26,15 @@
 #include <ctime>
 #include <algorithm>
 #include <iomanip>
+#include <string>
 
 namespace Catch
 {
 
     namespace
     {
+        using SectionNode = CumulativeReporterBase::SectionNode;
+
         std::string getCurrentTimestamp()
         {
             time_t rawtime;
@@ -76,6 +79,18 @@ namespace Catch
             return rss.str();
         }
 
+        // Attribute values are padded with leading zeros to this width, enough for any 64-bit count, so that they can be
+        // overwritten in place as they change.
+        constexpr size_t PatchableAttributeWidth = 20;
+
+        std::string padAttribute(std::string value)
+        {
+            if (value.size() < PatchableAttributeWidth) {
+                value.insert(0, PatchableAttributeWidth - value.size(), '0');
+            }
+            return value;
+        }
+
         static void normalizeNamespaceMarkers(std::string& str)
         {
             std::size_t pos = str.find("::");
@@ -86,6 +101,156 @@ namespace Catch
             }
         }
 
+        void writeAssertion(XmlWriter& xml, AssertionStats const& stats)
+        {
+            AssertionResult const& result = stats.assertionResult;
+            if (!result.isOk() || result.getResultType() == ResultWas::ExplicitSkip ||
+                result.getResultType() == ResultWas::Warning) {
+                std::string elementName;
+                switch (result.getResultType()) {
+                case ResultWas::ThrewException:
+                case ResultWas::FatalErrorCondition:
+                    elementName = "error";
+                    break;
+                case ResultWas::ExplicitFailure:
+                case ResultWas::ExpressionFailed:
+                case ResultWas::DidntThrowException:
+                    elementName = "failure";
+                    break;
+
+                case ResultWas::ExplicitSkip:
+                    elementName = "skipped";
+                    break;
+
+                    // CTS also cares about warnings, write them out too unlike junit
+                case ResultWas::Warning:
+                    elementName = "cts:warning";
+                    break;
+
+                // We should never see these here:
+                case ResultWas::Info:
+                case ResultWas::Ok:
+                case ResultWas::Unknown:
+                case ResultWas::FailureBit:
+                case ResultWas::Exception:
+                    elementName = "internalError";
+                    break;
+                }
+
+                XmlWriter::ScopedElement e = xml.scopedElement(elementName);
+
+                xml.writeAttribute("message"_sr, result.getExpression());
+                xml.writeAttribute("type"_sr, result.getTestMacroName());
+
+                ReusableStringStream rss;
+                if (result.getResultType() == ResultWas::ExplicitSkip) {
+                    rss << "SKIPPED\n";
+                }
+                else {
+                    // modified to save warnings just like failures
+                    auto messageKind = (result.getResultType() == ResultWas::Warning) ? "WARNING" : "FAILED";
+
+                    rss << messageKind << ":\n";
+                    if (result.hasExpression()) {
+                        rss << "  ";
+                        rss << result.getExpressionInMacro();
+                        rss << '\n';
+                    }
+                    if (result.hasExpandedExpression()) {
+                        rss << "with expansion:\n";
+                        rss << TextFlow::Column(result.getExpandedExpression()).indent(2) << '\n';
+                    }
+                }
+                if (!result.getMessage().empty())
+                    rss << result.getMessage() << '\n';
+                for (auto const& msg : stats.infoMessages)
+                    if (msg.type == ResultWas::Info)
+                        rss << msg.message << '\n';
+
+                rss << "at " << result.getSourceInfo();
+                xml.writeText(rss.str(), XmlFormatting::Newline);
+            }
+        }
+
+        void writeAssertions(XmlWriter& xml, SectionNode const& sectionNode)
+        {
+            for (auto const& assertionOrBenchmark : sectionNode.assertionsAndBenchmarks) {
+                if (assertionOrBenchmark.isAssertion()) {
+                    writeAssertion(xml, assertionOrBenchmark.asAssertion());
+                }
+            }
+        }
+
+        void writeSection(XmlWriter& xml, std::string const& className, std::string const& rootName, SectionNode const& sectionNode,
+                          bool testOkToFail)
+        {
+            std::string name = trim(sectionNode.stats.sectionInfo.name);
+            if (!rootName.empty())
+                name = rootName + '/' + name;
+
+            if (sectionNode.hasAnyAssertions() || !sectionNode.stdOut.empty() || !sectionNode.stdErr.empty()) {
+                XmlWriter::ScopedElement e = xml.scopedElement("testcase");
+                if (className.empty()) {
+                    xml.writeAttribute("classname"_sr, name);
+                    xml.writeAttribute("name"_sr, "root"_sr);
+                }
+                else {
+                    xml.writeAttribute("classname"_sr, className);
+                    xml.writeAttribute("name"_sr, name);
+                }
+                xml.writeAttribute("time"_sr, formatDuration(sectionNode.stats.durationInSeconds));
+                // This is not ideal, but it should be enough to mimic gtest's
+                // junit output.
+                // Ideally the JUnit reporter would also handle `skipTest`
+                // events and write those out appropriately.
+                xml.writeAttribute("status"_sr, "run"_sr);
+
+                if (sectionNode.stats.assertions.failedButOk) {
+                    xml.scopedElement("skipped").writeAttribute("message", "TEST_CASE tagged with !mayfail");
+                }
+
+                writeAssertions(xml, sectionNode);
+
+                if (!sectionNode.stdOut.empty())
+                    xml.scopedElement("system-out").writeText(trim(sectionNode.stdOut), XmlFormatting::Newline);
+                if (!sectionNode.stdErr.empty())
+                    xml.scopedElement("system-err").writeText(trim(sectionNode.stdErr), XmlFormatting::Newline);
+            }
+            for (auto const& childNode : sectionNode.childSections)
+                if (className.empty())
+                    writeSection(xml, name, "", *childNode, testOkToFail);
+                else
+                    writeSection(xml, className, name, *childNode, testOkToFail);
+        }
+
+        void writeTestCase(XmlWriter& xml, IConfig const& config, TestCaseStats const& stats, SectionNode const& rootSection)
+        {
+            std::string className = static_cast<std::string>(stats.testInfo->className);
+
+            if (className.empty()) {
+                className = fileNameTag(stats.testInfo->tags);
+                if (className.empty()) {
+                    className = "global";
+                }
+            }
+
+            if (!config.name().empty())
+                className = static_cast<std::string>(config.name()) + '.' + className;
+
+            normalizeNamespaceMarkers(className);
+
+            writeSection(xml, className, "", rootSection, stats.testInfo->okToFail());
+        }
+
+        void writeProperties(XmlWriter& xml, IConfig const& config)
+        {
+            auto properties = xml.scopedElement("properties");
+            xml.scopedElement("property").writeAttribute("name"_sr, "random-seed"_sr).writeAttribute("value"_sr, config.rngSeed());
+            if (config.testSpec().hasFilters()) {
+                xml.scopedElement("property").writeAttribute("name"_sr, "filters"_sr).writeAttribute("value"_sr, config.testSpec());
+            }
+        }
+
     }  // anonymous namespace
 
     CTSReporter::CTSReporter(ReporterConfig&& _config) : CumulativeReporterBase(CATCH_MOVE(_config)), xml(m_stream)
@@ -159,14 +324,7 @@ namespace Catch
             xml.writeAttribute("time"_sr, formatDuration(suiteTime));
         xml.writeAttribute("timestamp"_sr, getCurrentTimestamp());
 
-        // Write properties
-        {
-            auto properties = xml.scopedElement("properties");
-            xml.scopedElement("property").writeAttribute("name"_sr, "random-seed"_sr).writeAttribute("value"_sr, m_config->rngSeed());
-            if (m_config->testSpec().hasFilters()) {
-                xml.scopedElement("property").writeAttribute("name"_sr, "filters"_sr).writeAttribute("value"_sr, m_config->testSpec());
-            }
-        }
+        writeProperties(xml, *m_config);
 
         // Output CTS-specific info
         Conformance::WriteTestEnvironment(xml, Conformance::GetGlobalData());
@@ -174,158 +332,205 @@ namespace Catch
         Conformance::WriteConformanceReportSummary(xml, Conformance::GetGlobalData().GetConformanceReport());
 
         // Write test cases
-        for (auto const& child : testRunNode.children)
-            writeTestCase(*child);
+        for (auto const& child : testRunNode.children) {
+            // All test cases have exactly one section - which represents the
+            // test case itself. That section may have 0-n nested sections
+            assert(child->children.size() == 1);
+            writeTestCase(xml, *m_config, child->value, *child->children.front());
+        }
 
         xml.scopedElement("system-out").writeText(trim(stdOutForSuite), XmlFormatting::Newline);
         xml.scopedElement("system-err").writeText(trim(stdErrForSuite), XmlFormatting::Newline);
     }
 
-    void CTSReporter::writeTestCase(TestCaseNode const& testCaseNode)
+    CTSStreamingReporter::CTSStreamingReporter(ReporterConfig&& _config) : StreamingReporterBase(CATCH_MOVE(_config)), xml(m_stream)
     {
-        TestCaseStats const& stats = testCaseNode.value;
+        m_preferences.shouldRedirectStdOut = true;
+        m_preferences.shouldReportAllAssertions = true;
+    }
 
-        // All test cases have exactly one section - which represents the
-        // test case itself. That section may have 0-n nested sections
-        assert(testCaseNode.children.size() == 1);
-        SectionNode const& rootSection = *testCaseNode.children.front();
+    CTSStreamingReporter::~CTSStreamingReporter() = default;
 
-        std::string className = static_cast<std::string>(stats.testInfo->className);
+    std::string CTSStreamingReporter::getDescription()
+    {
+        return "Like ctsxml, but writes each test case as soon as it ends, keeping memory use bounded on long runs and leaving a well-formed partial report if the run is aborted";
+    }
 
-        if (className.empty()) {
-            className = fileNameTag(stats.testInfo->tags);
-            if (className.empty()) {
-                className = "global";
-            }
+    void CTSStreamingReporter::testRunStarting(TestRunInfo const& runInfo)
+    {
+        StreamingReporterBase::testRunStarting(runInfo);
+        xml.startElement("testsuites");
+
+        // Add CTS-specific namespace
+        Conformance::WriteXmlnsAttribute(xml);
+
+        suiteTimer.start();
+        unexpectedExceptions = 0;
+
+        m_totals = Totals();
+        xml.startElement("testsuite");
+        xml.writeAttribute("name"_sr, runInfo.name);
+        // The attributes are written by the XmlWriter as they are passed to it, so can be written directly to the stream.
+        m_totalsPosition = m_stream.tellp();
+        if (m_totalsPosition != std::streampos(-1)) {
+            writeTotalsAttributes();
         }
+        xml.writeAttribute("hostname"_sr, "tbd"_sr);  // !TBD
+        xml.writeAttribute("timestamp"_sr, getCurrentTimestamp());
 
-        if (!m_config->name().empty())
-            className = static_cast<std::string>(m_config->name()) + '.' + className;
+        writeProperties(xml, *m_config);
 
-        normalizeNamespaceMarkers(className);
+        // Output CTS-specific info
+        Conformance::WriteTestEnvironment(xml, Conformance::GetGlobalData());
+        Conformance::WriteActiveApiLayersAndExtensions(xml, Conformance::GetGlobalData());
 
-        writeSection(className, "", rootSection, stats.testInfo->okToFail());
+        writeCheckpoint();
     }
 
-    void CTSReporter::writeSection(std::string const& className, std::string const& rootName, SectionNode const& sectionNode,
-                                   bool testOkToFail)
+    void CTSStreamingReporter::testCaseStarting(TestCaseInfo const& testCaseInfo)
     {
-        std::string name = trim(sectionNode.stats.sectionInfo.name);
-        if (!rootName.empty())
-            name = rootName + '/' + name;
+        StreamingReporterBase::testCaseStarting(testCaseInfo);
+        m_okToFail = testCaseInfo.okToFail();
+    }
 
-        if (sectionNode.hasAnyAssertions() || !sectionNode.stdOut.empty() || !sectionNode.stdErr.empty()) {
-            XmlWriter::ScopedElement e = xml.scopedElement("testcase");
-            if (className.empty()) {
-                xml.writeAttribute("classname"_sr, name);
-                xml.writeAttribute("name"_sr, "root"_sr);
+    void CTSStreamingReporter::sectionStarting(SectionInfo const& sectionInfo)
+    {
+        StreamingReporterBase::sectionStarting(sectionInfo);
+
+        // Build the same tree of sections as CumulativeReporterBase, but for the current test case only.
+        SectionStats incompleteStats(SectionInfo(sectionInfo), Counts(), 0, false);
+        SectionNode* node;
+        if (m_sectionNodeStack.empty()) {
+            if (!m_rootSection) {
+                m_rootSection = Detail::make_unique<SectionNode>(incompleteStats);
             }
-            else {
-                xml.writeAttribute("classname"_sr, className);
-                xml.writeAttribute("name"_sr, name);
+            node = m_rootSection.get();
+        }
+        else {
+            SectionNode& parentNode = *m_sectionNodeStack.back();
+            auto it = std::find_if(parentNode.childSections.begin(), parentNode.childSections.end(),
+                                   [&](Detail::unique_ptr<SectionNode> const& child) {
+                                       return child->stats.sectionInfo.name == sectionInfo.name &&
+                                              child->stats.sectionInfo.lineInfo == sectionInfo.lineInfo;
+                                   });
+            if (it == parentNode.childSections.end()) {
+                parentNode.childSections.push_back(Detail::make_unique<SectionNode>(incompleteStats));
+                node = parentNode.childSections.back().get();
             }
-            xml.writeAttribute("time"_sr, formatDuration(sectionNode.stats.durationInSeconds));
-            // This is not ideal, but it should be enough to mimic gtest's
-            // junit output.
-            // Ideally the JUnit reporter would also handle `skipTest`
-            // events and write those out appropriately.
-            xml.writeAttribute("status"_sr, "run"_sr);
-
-            if (sectionNode.stats.assertions.failedButOk) {
-                xml.scopedElement("skipped").writeAttribute("message", "TEST_CASE tagged with !mayfail");
+            else {
+                node = it->get();
             }
+        }
 
-            writeAssertions(sectionNode);
+        m_deepestSection = node;
+        m_sectionNodeStack.push_back(node);
+    }
 
-            if (!sectionNode.stdOut.empty())
-                xml.scopedElement("system-out").writeText(trim(sectionNode.stdOut), XmlFormatting::Newline);
-            if (!sectionNode.stdErr.empty())
-                xml.scopedElement("system-err").writeText(trim(sectionNode.stdErr), XmlFormatting::Newline);
+    void CTSStreamingReporter::assertionEnded(AssertionStats const& assertionStats)
+    {
+        AssertionResult const& result = assertionStats.assertionResult;
+        if (result.getResultType() == ResultWas::ThrewException && !m_okToFail)
+            unexpectedExceptions++;
+
+        assert(!m_sectionNodeStack.empty());
+        SectionNode& sectionNode = *m_sectionNodeStack.back();
+        if (!result.isOk() || result.getResultType() == ResultWas::ExplicitSkip || result.getResultType() == ResultWas::Warning) {
+            // Expand now: the expression refers to temporaries that are gone by the time the test case is written.
+            static_cast<void>(result.getExpandedExpression());
+            sectionNode.assertionsAndBenchmarks.emplace_back(assertionStats);
+        }
+        else if (sectionNode.assertionsAndBenchmarks.empty()) {
+            // Passed assertions are not written, but a section with any assertion gets a testcase element,
+            // so keep the first one as a marker.
+            sectionNode.assertionsAndBenchmarks.emplace_back(assertionStats);
         }
-        for (auto const& childNode : sectionNode.childSections)
-            if (className.empty())
-                writeSection(name, "", *childNode, testOkToFail);
-            else
-                writeSection(className, name, *childNode, testOkToFail);
     }
 
-    void CTSReporter::writeAssertions(SectionNode const& sectionNode)
+    void CTSStreamingReporter::sectionEnded(SectionStats const& sectionStats)
     {
-        for (auto const& assertionOrBenchmark : sectionNode.assertionsAndBenchmarks) {
-            if (assertionOrBenchmark.isAssertion()) {
-                writeAssertion(assertionOrBenchmark.asAssertion());
-            }
+        assert(!m_sectionNodeStack.empty());
+        m_sectionNodeStack.back()->stats = sectionStats;
+        m_sectionNodeStack.pop_back();
+        StreamingReporterBase::sectionEnded(sectionStats);
+    }
+
+    void CTSStreamingReporter::testCaseEnded(TestCaseStats const& testCaseStats)
+    {
+        assert(m_sectionNodeStack.empty());
+        m_totals += testCaseStats.totals;
+        if (m_rootSection) {
+            m_deepestSection->stdOut = testCaseStats.stdOut;
+            m_deepestSection->stdErr = testCaseStats.stdErr;
+
+            writeTestCase(xml, *m_config, testCaseStats, *m_rootSection);
+            writeCheckpoint();
         }
+
+        m_rootSection.reset();
+        m_deepestSection = nullptr;
+        StreamingReporterBase::testCaseEnded(testCaseStats);
     }
 
-    void CTSReporter::writeAssertion(AssertionStats const& stats)
+    void CTSStreamingReporter::testRunEnded(TestRunStats const& testRunStats)
     {
-        AssertionResult const& result = stats.assertionResult;
-        if (!result.isOk() || result.getResultType() == ResultWas::ExplicitSkip || result.getResultType() == ResultWas::Warning) {
-            std::string elementName;
-            switch (result.getResultType()) {
-            case ResultWas::ThrewException:
-            case ResultWas::FatalErrorCondition:
-                elementName = "error";
-                break;
-            case ResultWas::ExplicitFailure:
-            case ResultWas::ExpressionFailed:
-            case ResultWas::DidntThrowException:
-                elementName = "failure";
-                break;
-
-            case ResultWas::ExplicitSkip:
-                elementName = "skipped";
-                break;
-
-                // CTS also cares about warnings, write them out too unlike junit
-            case ResultWas::Warning:
-                elementName = "cts:warning";
-                break;
-
-            // We should never see these here:
-            case ResultWas::Info:
-            case ResultWas::Ok:
-            case ResultWas::Unknown:
-            case ResultWas::FailureBit:
-            case ResultWas::Exception:
-                elementName = "internalError";
-                break;
-            }
+        {
+            XmlWriter::ScopedElement e = xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "totals");
+            xml.writeAttribute("errors"_sr, unexpectedExceptions);
+            xml.writeAttribute("failures"_sr, testRunStats.totals.assertions.failed - unexpectedExceptions);
+            xml.writeAttribute("skipped"_sr, testRunStats.totals.assertions.skipped);
+            xml.writeAttribute("tests"_sr, testRunStats.totals.assertions.total());
+            if (m_config->showDurations() == ShowDurations::Never)
+                xml.writeAttribute("time"_sr, ""_sr);
+            else
+                xml.writeAttribute("time"_sr, formatDuration(suiteTimer.getElapsedSeconds()));
+        }
+        Conformance::WriteConformanceReportSummary(xml, Conformance::GetGlobalData().GetConformanceReport());
 
-            XmlWriter::ScopedElement e = xml.scopedElement(elementName);
+        xml.endElement();  // testsuite
+        xml.endElement();  // testsuites
 
-            xml.writeAttribute("message"_sr, result.getExpression());
-            xml.writeAttribute("type"_sr, result.getTestMacroName());
+        m_totals = testRunStats.totals;
+        updateTotalsAttributes();
+        m_stream.flush();
+        StreamingReporterBase::testRunEnded(testRunStats);
+    }
 
-            ReusableStringStream rss;
-            if (result.getResultType() == ResultWas::ExplicitSkip) {
-                rss << "SKIPPED\n";
-            }
-            else {
-                // modified to save warnings just like failures
-                auto messageKind = (result.getResultType() == ResultWas::Warning) ? "WARNING" : "FAILED";
-
-                rss << messageKind << ":\n";
-                if (result.hasExpression()) {
-                    rss << "  ";
-                    rss << result.getExpressionInMacro();
-                    rss << '\n';
-                }
-                if (result.hasExpandedExpression()) {
-                    rss << "with expansion:\n";
-                    rss << TextFlow::Column(result.getExpandedExpression()).indent(2) << '\n';
-                }
-            }
-            if (!result.getMessage().empty())
-                rss << result.getMessage() << '\n';
-            for (auto const& msg : stats.infoMessages)
-                if (msg.type == ResultWas::Info)
-                    rss << msg.message << '\n';
-
-            rss << "at " << result.getSourceInfo();
-            xml.writeText(rss.str(), XmlFormatting::Newline);
+    void CTSStreamingReporter::writeCheckpoint()
+    {
+        // XmlWriter has closed every element but testsuite and testsuites here, and writes nothing until the next element,
+        // so close those two directly on the stream.
+        const std::streampos position = m_stream.tellp();
+        if (position == std::streampos(-1)) {
+            // Not a file, e.g. the console: the closing tags could not be overwritten.
+            m_stream.flush();
+            return;
+        }
+        m_stream << "\n  </testsuite>\n</testsuites>\n";
+        updateTotalsAttributes();
+        m_stream.flush();
+        m_stream.seekp(position);
+    }
+
+    void CTSStreamingReporter::writeTotalsAttributes()
+    {
+        m_stream << " errors=\"" << padAttribute(std::to_string(unexpectedExceptions)) << '"';
+        m_stream << " failures=\"" << padAttribute(std::to_string(m_totals.assertions.failed - unexpectedExceptions)) << '"';
+        m_stream << " skipped=\"" << padAttribute(std::to_string(m_totals.assertions.skipped)) << '"';
+        m_stream << " tests=\"" << padAttribute(std::to_string(m_totals.assertions.total())) << '"';
+        if (m_config->showDurations() != ShowDurations::Never) {
+            m_stream << " time=\"" << padAttribute(formatDuration(suiteTimer.getElapsedSeconds())) << '"';
+        }
+    }
+
+    void CTSStreamingReporter::updateTotalsAttributes()
+    {
+        if (m_totalsPosition == std::streampos(-1)) {
+            return;
         }
+        const std::streampos position = m_stream.tellp();
+        m_stream.seekp(m_totalsPosition);
+        writeTotalsAttributes();
+        m_stream.seekp(position);
     }
 
 }  // end namespace Catch
@@ -15,6 +15,7 @@
 XRC_DISABLE_MSVC_WARNING(4324)
 
 #include <catch2/reporters/catch_reporter_cumulative_base.hpp>
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
 #include <catch2/internal/catch_xmlwriter.hpp>
 #include <catch2/catch_timer.hpp>
 #include <catch2/interfaces/catch_interfaces_reporter_factory.hpp>
@@ -46,19 +47,71 @@ namespace Catch
     private:
         void writeRun(TestRunNode const& testRunNode, double suiteTime);
 
-        void writeTestCase(TestCaseNode const& testCaseNode);
+        XmlWriter xml;
+        Timer suiteTimer;
+        std::string stdOutForSuite;
+        std::string stdErrForSuite;
+        unsigned int unexpectedExceptions = 0;
+        bool m_okToFail = false;
+    };
+
+    /// Writes the same test cases as CTSReporter, but each as soon as it ends instead of keeping every test case in memory
+    /// until the end of the run. Only the assertions that appear in the report are kept, for one test case at a time.
+    ///
+    /// After each test case the open elements are closed and the output flushed, then the closing tags are overwritten by
+    /// the next test case, so a report file is well-formed XML even if the run is aborted.
+    /// When writing to a file, the errors, failures, skipped, tests and time attributes of the testsuite element are
+    /// zero-padded to a fixed width and overwritten with the totals so far at each of those checkpoints. Since those can
+    /// not be updated when writing to the console, the totals are also written in a cts:totals element after the test
+    /// cases, followed by the conformance report summary. Output of each test case is written with the test case only,
+    /// not again for the whole suite.
+    class CTSStreamingReporter final : public StreamingReporterBase
+    {
+    public:
+        CTSStreamingReporter(ReporterConfig&& _config);
+
+        ~CTSStreamingReporter() override;
+
+        static std::string getDescription();
+
+        void testRunStarting(TestRunInfo const& runInfo) override;
+
+        void testCaseStarting(TestCaseInfo const& testCaseInfo) override;
+        void sectionStarting(SectionInfo const& sectionInfo) override;
+        void assertionEnded(AssertionStats const& assertionStats) override;
+        void sectionEnded(SectionStats const& sectionStats) override;
+
+        void testCaseEnded(TestCaseStats const& testCaseStats) override;
+
+        void testRunEnded(TestRunStats const& testRunStats) override;
 
-        void writeSection(std::string const& className, std::string const& rootName, SectionNode const& sectionNode, bool testOkToFail);
+    private:
+        using SectionNode = CumulativeReporterBase::SectionNode;
+
+        /// Close the open elements, update the testsuite totals and flush, then seek back to before the closing tags
+        /// if the stream supports it.
+        void writeCheckpoint();
 
-        void writeAssertions(SectionNode const& sectionNode);
-        void writeAssertion(AssertionStats const& stats);
+        /// Write the totals of the test cases ended so far as fixed-width testsuite attributes.
+        void writeTotalsAttributes();
+
+        /// Overwrite the testsuite attributes written by writeTotalsAttributes() with the current totals.
+        void updateTotalsAttributes();
 
         XmlWriter xml;
         Timer suiteTimer;
-        std::string stdOutForSuite;
-        std::string stdErrForSuite;
         unsigned int unexpectedExceptions = 0;
         bool m_okToFail = false;
+
+        /// Totals of the test cases ended so far.
+        Totals m_totals;
+        /// Where the totals attributes of the testsuite start, or -1 if the stream can not seek back to them.
+        std::streampos m_totalsPosition{-1};
+
+        /// Sections of the current test case.
+        Detail::unique_ptr<SectionNode> m_rootSection;
+        std::vector<SectionNode*> m_sectionNodeStack;
+        SectionNode* m_deepestSection = nullptr;
     };
 
 }  // end namespace Catch
@@ -20,10 +20,12 @@
 #include "conformance_framework.h"
 #include "conformance_utils.h"
 #include "swapchain_image_data.h"
+#include "view_culling.h"
 
 #include "common/xr_dependencies.h"
 #include "common/xr_linear.h"
 #include "utilities/event_reader.h"
+#include "utilities/lru_cache.h"
 #include "utilities/throw_helpers.h"
 
 #include <catch2/catch_test_macros.hpp>
@@ -34,15 +36,67 @@
 #include <cassert>
 #include <chrono>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ratio>
+#include <string>
+#include <tuple>
 #include <utility>
 
 using namespace std::chrono_literals;
 
 namespace Conformance
 {
+    namespace
+    {
+        /// Finished text images, keyed by everything CreateTextImage uses.
+        /// Labels such as the interactive action prompts are created again by every test, so these become a copy.
+        class TextImageCache
+        {
+        public:
+            static TextImageCache& Get()
+            {
+                static TextImageCache s_cache;
+                return s_cache;
+            }
+
+            std::shared_ptr<const RGBAImage> Find(int32_t width, int32_t height, const char* text, int32_t fontHeight,
+                                                  WordWrap wordWrap)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_images.Find(std::make_tuple(width, height, std::string(text), fontHeight, wordWrap));
+            }
+
+            void Insert(int32_t width, int32_t height, const char* text, int32_t fontHeight, WordWrap wordWrap,
+                        const RGBAImage& image)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_images.Insert(std::make_tuple(width, height, std::string(text), fontHeight, wordWrap),
+                                std::make_shared<const RGBAImage>(image), image.pixels.size() * sizeof(RGBA8Color));
+            }
+
+            void Clear()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_images.Clear();
+            }
+
+        private:
+            /// Room for the full-screen description and the prompts of a dozen interactive tests.
+            static constexpr size_t BudgetBytes = 32 * 1024 * 1024;
+
+            std::mutex m_mutex;
+            LruCache<std::tuple<int32_t, int32_t, std::string, int32_t, WordWrap>, RGBAImage> m_images{BudgetBytes};
+        };
+    }  // namespace
+
     RGBAImage CreateTextImage(int32_t width, int32_t height, const char* text, int32_t fontHeight, WordWrap wordWrap)
     {
+        if (std::shared_ptr<const RGBAImage> cached = TextImageCache::Get().Find(width, height, text, fontHeight, wordWrap)) {
+            return *cached;
+        }
+
         constexpr int FontPaddingPixels = 4;
         constexpr int BorderPixels = 2;
         constexpr int InsetPixels = BorderPixels + FontPaddingPixels;
@@ -52,13 +106,20 @@ namespace Conformance
         image.DrawRectBorder(0, 0, image.width, image.height, BorderPixels, {1, 1, 1, 1});
         image.PutText(XrRect2Di{{InsetPixels, InsetPixels}, {image.width - InsetPixels * 2, image.height - InsetPixels * 2}}, text,
                       fontHeight, {1, 1, 1, 1}, wordWrap);
+        TextImageCache::Get().Insert(width, height, text, fontHeight, wordWrap, image);
         return image;
     }
 
+    void ClearTextImageCaches()
+    {
+        TextImageCache::Get().Clear();
+        RGBAImage::ClearTextLayoutCache();
+    }
+
     XrPath StringToPath(XrInstance instance, const std::string& pathStr)
     {
         XrPath path;
-        XRC_CHECK_THROW_XRCMD(xrStringToPath(instance, pathStr.c_str(), &path));
+        XRC_CHECK_THROW_XRCMD(GetGlobalData().pathCache.StringToPath(instance, pathStr, &path));
         return path;
     }
 
@@ -315,11 +376,12 @@ namespace Conformance
 
                 return false;
             },
-            15s, 10ms);
+            15s, *m_eventQueue);
         XRC_CHECK_THROW_MSG(result, "Failed to reach session ready state");
 
         XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
         beginInfo.primaryViewConfigurationType = m_primaryViewType;
+        CheckSessionTestCaseTags();
         XRC_CHECK_THROW_XRCMD(xrBeginSession(m_session, &beginInfo));
     }
 
@@ -636,6 +698,8 @@ namespace Conformance
 
         if (viewState.viewStateFlags & XR_VIEW_STATE_POSITION_VALID_BIT && viewState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT) {
             const auto& views = std::get<std::vector<XrView>>(viewData);
+            m_hasCullingViewProjection =
+                MakeCombinedViewProjection(&m_cullingViewProjection, views, RenderViewNearZ, RenderViewFarZ);
 
             // Render into each view swapchain using the recommended view fov and pose.
             for (uint32_t viewIndex = 0; viewIndex < GetViewCount(); viewIndex++) {
@@ -49,8 +49,13 @@ namespace Conformance
     class EventReader;
     class ISwapchainImageData;
 
+    /// Create an image with a translucent background, a border and the given text.
+    /// Images are cached, so creating the same label again is a copy.
     RGBAImage CreateTextImage(int32_t width, int32_t height, const char* text, int32_t fontHeight, WordWrap wordWrap = WordWrap::Enabled);
 
+    /// Drop all cached text images and layouts, e.g. to measure uncached text rendering.
+    void ClearTextImageCaches();
+
     XrPath StringToPath(XrInstance instance, const std::string& pathStr);
 
     using UpdateLayers = std::function<void(const XrFrameState&)>;
@@ -305,6 +310,7 @@ namespace Conformance
             /// and the geometry to draw.
             /// Projection view pose/fov fields are preset to match the corresponding view fields.
             /// Views are located relative to GetLocalSpace()
+            /// Pass the geometry through BaseProjectionLayerHelper::WithCulling to cull it once for all views.
             virtual void RenderView(const BaseProjectionLayerHelper& projectionLayerHelper, uint32_t viewIndex,
                                     const XrViewState& viewState, const XrView& view, XrCompositionLayerProjectionView& projectionView,
                                     const XrSwapchainImageBaseHeader* swapchainImage) = 0;
@@ -324,11 +330,30 @@ namespace Conformance
             return m_projLayer->viewCount;
         }
 
+        /// Frustum containing every view of the frame being rendered, from MakeCombinedViewProjection, for the
+        /// ViewRenderer to pass to RenderParams::CullWith so drawables are culled once for all views.
+        /// Returns nullptr if the views could not be combined, in which case each view is culled separately.
+        const XrMatrix4x4f* GetCullingViewProjection() const
+        {
+            return m_hasCullingViewProjection ? &m_cullingViewProjection : nullptr;
+        }
+
+        /// The drawables of @p params, culled with GetCullingViewProjection() if there is one.
+        RenderParams WithCulling(RenderParams params) const
+        {
+            if (m_hasCullingViewProjection) {
+                params.CullWith(m_cullingViewProjection);
+            }
+            return params;
+        }
+
     private:
         CompositionHelper& m_compositionHelper;
         XrSpace m_localSpace;
         XrCompositionLayerProjection* m_projLayer;
         std::vector<XrSwapchain> m_swapchains;
+        XrMatrix4x4f m_cullingViewProjection{};
+        bool m_hasCullingViewProjection{false};
     };
 
     /// Helper class to provide simple world-locked projection layer of some cubes. Each view of the projection is a separate swapchain.
@@ -363,12 +388,13 @@ namespace Conformance
             }
 
             ~ViewRenderer() override = default;
-            void RenderView(const BaseProjectionLayerHelper& /* projectionLayerHelper */, uint32_t /* viewIndex */,
+            void RenderView(const BaseProjectionLayerHelper& projectionLayerHelper, uint32_t /* viewIndex */,
                             const XrViewState& /* viewState */, const XrView& /* view */, XrCompositionLayerProjectionView& projectionView,
                             const XrSwapchainImageBaseHeader* swapchainImage) override
             {
                 GetGlobalData().graphicsPlugin->ClearImageSlice(swapchainImage);
-                GetGlobalData().graphicsPlugin->RenderView(projectionView, swapchainImage, RenderParams{}.Draw(m_cubes));
+                GetGlobalData().graphicsPlugin->RenderView(projectionView, swapchainImage,
+                                                           projectionLayerHelper.WithCulling(RenderParams{}.Draw(m_cubes)));
             }
 
         private:
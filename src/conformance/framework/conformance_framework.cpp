@@ -33,7 +33,6 @@
 #include <exception>
 #include <mutex>
 #include <sstream>
-#include <thread>
 #include <unordered_map>
 #include <utility>
 
@@ -98,6 +97,40 @@ namespace Conformance
 
         AppendSprintf(result, "   pollGetSystem: %s\n", pollGetSystem ? "yes" : "no");
 
+        AppendSprintf(result, "   exclusiveSessionTests: %s\n", exclusiveSessionTests.c_str());
+
+        AppendSprintf(result, "   testDurations: %s\n", testDurations.c_str());
+
+        AppendSprintf(result, "   framePacingCsv: %s\n", framePacingCsv.c_str());
+
+        AppendSprintf(result, "   soakDurationSeconds: %llu\n", (unsigned long long)soakDurationSeconds);
+
+        AppendSprintf(result, "   soakSampleFrames: %u\n", soakSampleFrames);
+
+        AppendSprintf(result, "   instancePool: %s\n", instancePool ? "yes" : "no");
+
+        AppendSprintf(result, "   swapchainProbeThreads: %u\n", swapchainProbeThreads);
+
+        std::string counts;
+        for (uint32_t count : actionScalingCounts) {
+            AppendSprintf(counts, counts.empty() ? "%u" : ",%u", count);
+        }
+        AppendSprintf(result, "   actionScalingCounts: %s\n", counts.c_str());
+
+        AppendSprintf(result, "   actionScalingActionSets: %u\n", actionScalingActionSets);
+
+        AppendSprintf(result, "   actionScalingSubactionPaths: %u\n", actionScalingSubactionPaths);
+
+        AppendSprintf(result, "   actionScalingFrames: %u\n", actionScalingFrames);
+
+        AppendSprintf(result, "   stressThreads: %u\n", stressThreads);
+
+        AppendSprintf(result, "   stressDurationSeconds: %llu\n", (unsigned long long)stressDurationSeconds);
+
+        AppendSprintf(result, "   stressCallMix: %s\n", stressCallMix.c_str());
+
+        AppendSprintf(result, "   stressHandleSharing: %s\n", stressHandleSharing.c_str());
+
         AppendSprintf(result, "   debugMode: %s", debugMode ? "yes" : "no");
 
         return result;
@@ -265,19 +298,16 @@ namespace Conformance
             // Consistency check: enabled should always be a subset of available
             XRC_CHECK_THROW_MSG(enabled.IsSatisfiedBy(available), "An unavailable extension is enabled.");
 
-            const auto beginProfiles = std::begin(GetAllInteractionProfiles());
-            const auto endProfiles = std::end(GetAllInteractionProfiles());
             for (auto& str : globalData.enabledInteractionProfiles) {
-                auto ipIt = std::find_if(beginProfiles, endProfiles, [&](const InteractionProfileAvailMetadata& ip) {
-                    return strcmp(ip.InteractionProfileShortname, str) == 0;
-                });
+                const std::string interactionProfilePath = std::string("/interaction_profiles/") + str;
+                const InteractionProfileAvailMetadata* profile = FindInteractionProfile(interactionProfilePath.c_str());
 
-                if (ipIt == endProfiles) {
+                if (profile == nullptr) {
                     // Interaction profile path not found in the generated database, presumably missing from XML.
                     ReportF("GlobalData::Initialize: Interaction profile \"%s\" not supported by conformance test", str);
                     return false;
                 }
-                Availability availability = kInteractionAvailabilities[(size_t)ipIt->Availability];
+                Availability availability = kInteractionAvailabilities[(size_t)profile->Availability];
 
                 if (availability.IsSatisfiedBy(enabled)) {
                     // The currently enabled extensions are enough to get this profile, no need to add more.
@@ -364,13 +394,15 @@ namespace Conformance
             ReportF(
                 "GlobalData::Initialize: xrGetSystem will be polled until success or timeout, as requested. This behavior may be less compatible with applications.");
 
-            const auto timeout = std::chrono::steady_clock::now() + kGetSystemPollingTimeout;
-            while (systemId == XR_NULL_SYSTEM_ID && std::chrono::steady_clock::now() < timeout) {
-                if (!tryGetSystem()) {
-                    return false;
-                }
-                // pause briefly before trying again
-                std::this_thread::sleep_for(std::chrono::milliseconds{50});
+            bool getSystemFailed = false;
+            WaitUntilPredicateWithTimeout(
+                [&] {
+                    getSystemFailed = !tryGetSystem();
+                    return getSystemFailed || systemId != XR_NULL_SYSTEM_ID;
+                },
+                kGetSystemPollingTimeout, std::chrono::milliseconds{50});
+            if (getSystemFailed) {
+                return false;
             }
 
             if (systemId == XR_NULL_SYSTEM_ID) {
@@ -432,6 +464,8 @@ namespace Conformance
     {
         std::lock_guard<std::recursive_mutex> lock(dataMutex);
 
+        instancePool.Clear();
+
         if (IsUsingGraphicsPlugin() && graphicsPlugin) {
             if (graphicsPlugin->IsInitialized()) {
                 graphicsPlugin->ShutdownDevice();
@@ -555,6 +589,19 @@ namespace Conformance
         conformanceReport.swapchainFormats.emplace_back(format, name);
     }
 
+    void GlobalData::BeginTestCase(const std::string& name, bool exclusiveSession)
+    {
+        std::unique_lock<std::recursive_mutex> lock(dataMutex);
+        currentTestCaseName = name;
+        currentTestCaseExclusiveSession = exclusiveSession;
+    }
+
+    bool GlobalData::IsCurrentTestCaseExclusiveSession() const
+    {
+        std::unique_lock<std::recursive_mutex> lock(dataMutex);
+        return currentTestCaseExclusiveSession;
+    }
+
     XrColor4f GlobalData::GetClearColorForBackground() const
     {
         switch (options.environmentBlendModeValue) {
@@ -17,6 +17,9 @@
 #pragma once
 
 #include "conformance_utils.h"
+#include "frame_pacing.h"
+#include "instance_pool.h"
+#include "path_cache.h"
 #include "utilities/feature_availability.h"
 #include "utilities/stringification.h"
 #include "utilities/types_and_constants.h"
@@ -221,6 +224,81 @@ namespace Conformance
         /// before beginning a test case.
         bool pollGetSystem{false};
 
+        /// Options include "include" "exclude" "only": whether to run the selected test cases that need
+        /// exclusive use of a running session (tagged [exclusive_session], [interactive], [actions],
+        /// [composition] or [scenario]). conformance_cli --shards runs "exclude" in parallel worker
+        /// processes and then "only" by itself.
+        /// Default is "include".
+        std::string exclusiveSessionTests{"include"};
+
+        /// File recording the duration of each test case and section by runtime and graphics plugin.
+        /// If set, earlier durations are used to predict the run time, to balance --shard-count shards and to flag
+        /// tests that got slower, and the durations of this run are added to the file.
+        /// Default is empty (not recorded).
+        std::string testDurations{};
+
+        /// File to add the durations of this run to instead of testDurations, so that concurrent runs can read
+        /// the same testDurations file. Default is empty (use testDurations).
+        std::string testDurationsOutput{};
+
+        /// Flag tests that took more than this percentage longer than their duration in testDurations.
+        /// Default is 50.
+        double durationRegressionThresholdPercent{50.0};
+
+        /// If set, the timestamps of each frame measured by Timed_Pipelined_Frame_Submission are written to this
+        /// file as CSV. Default is empty (not written).
+        std::string framePacingCsv{};
+
+        /// How long the soak test ([soak]) runs its frame loop, in seconds. Default is 600.
+        uint64_t soakDurationSeconds{600};
+
+        /// The soak test samples memory, handles and latency every this many frames. Default is 900.
+        uint32_t soakSampleFrames{900};
+
+        /// If set, the soak test writes its samples to this file as CSV. Default is empty (not written).
+        std::string soakCsv{};
+
+        /// Whether test cases tagged [pooled_instance] share one instance instead of each creating their own.
+        /// Default is false.
+        bool instancePool{false};
+
+        /// How many worker threads the Swapchains test spreads its swapchain creation probes over. 1 runs the probes one
+        /// after another. Default is 4.
+        uint32_t swapchainProbeThreads{4};
+
+        /// The numbers of actions the action state scaling benchmark ([action_scaling]) measures, one session each.
+        /// Default is 1, 10, 50, 100 and 200.
+        std::vector<uint32_t> actionScalingCounts{1, 10, 50, 100, 200};
+
+        /// How many action sets the action state scaling benchmark spreads its actions over. Default is 1.
+        uint32_t actionScalingActionSets{1};
+
+        /// How many subaction paths (left and right hand, at most 2) each action of the action state scaling benchmark
+        /// has. Its states are queried for each of them and without a subaction path. Default is 2.
+        uint32_t actionScalingSubactionPaths{2};
+
+        /// How many frames the action state scaling benchmark measures for each number of actions. Default is 300.
+        uint32_t actionScalingFrames{300};
+
+        /// How many threads the multithreading stress test ([stress]) calls the runtime from. Default is 4.
+        uint32_t stressThreads{4};
+
+        /// How long the multithreading stress test runs, in seconds. Default is 10.
+        uint64_t stressDurationSeconds{10};
+
+        /// The entry points the multithreading stress test calls, with their relative weights, such as
+        /// "xrLocateSpace=4,xrSyncActions=1". Default is a mix of calls an application makes every frame.
+        std::string stressCallMix{"xrLocateSpace=4,xrSyncActions=4,xrStringToPath=2,xrGetInstanceProperties=1,"
+                                  "xrEnumerateReferenceSpaces=1,xrPollEvent=1"};
+
+        /// Whether the threads of the multithreading stress test locate the same spaces ("shared") or spaces of their
+        /// own ("perThread"). Default is shared.
+        std::string stressHandleSharing{"shared"};
+
+        /// If set, the multithreading stress test writes the latency histogram of each thread and entry point to this
+        /// file as CSV. Default is empty (not written).
+        std::string stressCsv{};
+
         /// Defines if executing in debug mode. By default this follows the build type.
         bool debugMode
         {
@@ -239,12 +317,14 @@ namespace Conformance
     public:
         TimedSubmissionResults() = default;
         TimedSubmissionResults(std::chrono::nanoseconds averageWaitTime_, std::chrono::nanoseconds averageAppFrameTime_,
-                               std::chrono::nanoseconds averageDisplayPeriod_, std::chrono::nanoseconds averageBeginWaitTime_)
+                               std::chrono::nanoseconds averageDisplayPeriod_, std::chrono::nanoseconds averageBeginWaitTime_,
+                               const FramePacingStatistics& framePacing_)
             : valid(true)
             , averageWaitTime(averageWaitTime_)
             , averageAppFrameTime(averageAppFrameTime_)
             , averageDisplayPeriod(averageDisplayPeriod_)
             , averageBeginWaitTime(averageBeginWaitTime_)
+            , framePacing(framePacing_)
         {
         }
 
@@ -274,6 +354,11 @@ namespace Conformance
         {
             return averageBeginWaitTime;
         }
+        /// Percentiles, missed deadlines, jitter and drift of the measured frames
+        const FramePacingStatistics& GetFramePacing() const noexcept
+        {
+            return framePacing;
+        }
 
         /// Get the frame overhead: A value of 1 means 100%.
         ///
@@ -297,6 +382,26 @@ namespace Conformance
         std::chrono::nanoseconds averageDisplayPeriod;
         /// Average xrBeginFrame wait time
         std::chrono::nanoseconds averageBeginWaitTime;
+        /// Percentiles, missed deadlines, jitter and drift of the measured frames
+        FramePacingStatistics framePacing;
+    };
+
+    /// Latencies measured by the action state scaling benchmark for one number of actions.
+    struct ActionStateScalingResult
+    {
+        uint32_t actionSetCount{0};
+        uint32_t actionCount{0};
+        uint32_t subactionPathCount{0};
+        /// xrGetActionState* calls made each frame
+        uint32_t queriesPerFrame{0};
+        uint32_t frameCount{0};
+
+        /// Time spent in xrSyncActions each frame
+        DurationPercentiles syncTime;
+        /// Time spent in all the xrGetActionState* calls of a frame
+        DurationPercentiles queryTime;
+        /// Mean time of one xrGetActionState* call
+        std::chrono::nanoseconds meanQueryTime{0};
     };
 
     /// Records and produces a conformance report.
@@ -316,6 +421,7 @@ namespace Conformance
         bool unmatchedTestSpecs{false};
         Catch::Totals totals{};
         TimedSubmissionResults timedSubmission;
+        std::vector<ActionStateScalingResult> actionStateScaling;
         std::vector<std::pair<int64_t, std::string>> swapchainFormats;
     };
 
@@ -377,6 +483,13 @@ namespace Conformance
         /// Record a swapchain format as being supported and tested.
         void PushSwapchainFormat(int64_t format, const std::string& name);
 
+        /// Called as each test case starts. @p exclusiveSession is whether its tags give it exclusive use of a session,
+        /// such as [exclusive_session], so that --shards never runs it concurrently with another process.
+        void BeginTestCase(const std::string& name, bool exclusiveSession);
+
+        /// Whether the current test case is tagged for exclusive use of a session, or none is running.
+        bool IsCurrentTestCaseExclusiveSession() const;
+
         /// Calculate the clear color to use for the background based on the XrEnvironmentBlendMode in use.
         XrColor4f GetClearColorForBackground() const;
 
@@ -401,8 +514,18 @@ namespace Conformance
 
         ConformanceReport conformanceReport;
 
+        /// The instance shared by test cases tagged [pooled_instance], if options.instancePool is set.
+        InstancePool instancePool;
+
+        /// Paths converted by StringToPath and PathToString, for the instances whose lifetime the framework tracks.
+        PathCache pathCache;
+
         XrInstanceProperties instanceProperties{XR_TYPE_INSTANCE_PROPERTIES};
 
+        /// The test case now running, as passed to BeginTestCase. Sessions begun outside of a test case are not checked.
+        std::string currentTestCaseName;
+        bool currentTestCaseExclusiveSession{true};
+
         FunctionInfo nullFunctionInfo;
 
         std::shared_ptr<IPlatformPlugin> platformPlugin;
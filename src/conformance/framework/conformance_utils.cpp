@@ -63,11 +63,9 @@ namespace Conformance
 
     std::string PathToString(XrInstance instance, XrPath path)
     {
-        uint32_t count = 0;
-        if (XR_SUCCEEDED(xrPathToString(instance, path, 0, &count, nullptr))) {
-            std::vector<char> buff(count);
-            xrPathToString(instance, path, count, &count, buff.data());
-            return std::string(buff.data());
+        std::string pathString;
+        if (GetGlobalData().pathCache.PathToString(instance, path, &pathString)) {
+            return pathString;
         }
         return "<unknown XrPath " + std::to_string(uint64_t(path)) + ">";
     }
@@ -336,10 +334,16 @@ namespace Conformance
             assert(additionalEnabledExtensions.size() == 0);
             instance = instance_;
         }
+        else if (additionalEnabledExtensions.empty() && permitDebugMessenger &&
+                 GetGlobalData().instancePool.TryBorrow(&instance, &instanceCreateResult)) {
+            XRC_CHECK_THROW_XRRESULT(instanceCreateResult, "CreateBasicInstance");
+            instancePooled = true;
+        }
         else {
             instanceCreateResult = CreateBasicInstance(&instance, permitDebugMessenger, additionalEnabledExtensions);
             XRC_CHECK_THROW_XRRESULT(instanceCreateResult, "CreateBasicInstance");
         }
+        GetGlobalData().pathCache.AddInstance(instance);
 
         if (permitDebugMessenger) {
             XrDebugUtilsMessengerCreateInfoEXT debugInfo = MakeMessengerCreateInfo();
@@ -355,7 +359,14 @@ namespace Conformance
             XrResult getSystemResult = FindBasicSystem(instance, &systemId);
 
             if (XR_FAILED(getSystemResult)) {
-                xrDestroyInstance(instance);
+                GetGlobalData().pathCache.RemoveInstance(instance);
+                if (instancePooled) {
+                    GetGlobalData().instancePool.Return(instance);
+                    instancePooled = false;
+                }
+                else {
+                    xrDestroyInstance(instance);
+                }
                 instance = XR_NULL_HANDLE;
                 systemId = XR_NULL_SYSTEM_ID;
 
@@ -375,6 +386,12 @@ namespace Conformance
             debugMessenger = XR_NULL_HANDLE_CPP;
         }
         if (instance != XR_NULL_HANDLE) {
+            GetGlobalData().pathCache.RemoveInstance(instance);
+        }
+        if (instancePooled) {
+            GetGlobalData().instancePool.Return(instance);
+        }
+        else if (instance != XR_NULL_HANDLE) {
             xrDestroyInstance(instance);
         }
     }
@@ -473,8 +490,15 @@ namespace Conformance
                 return;
             }
             if (instance_ == XR_NULL_HANDLE) {
-                XRC_CHECK_THROW_XRCMD(CreateBasicInstance(&instance));
-                instanceOwned.adopt(instance);
+                XrResult createResult;
+                if (globalData.instancePool.TryBorrow(&instance, &createResult)) {
+                    XRC_CHECK_THROW_XRCMD(createResult);
+                    instancePooled = true;
+                }
+                else {
+                    XRC_CHECK_THROW_XRCMD(CreateBasicInstance(&instance));
+                    instanceOwned.adopt(instance);
+                }
             }
 
             assert(instance != XR_NULL_HANDLE);
@@ -500,8 +524,9 @@ namespace Conformance
             // Set up the enumerated types
             XRC_CHECK_THROW_XRCMD(doTwoCallInPlace(swapchainFormatVector, xrEnumerateSwapchainFormats, session));
             XRC_CHECK_THROW_XRCMD(doTwoCallInPlace(spaceTypeVector, xrEnumerateReferenceSpaces, session));
-            XRC_CHECK_THROW_XRCMD(xrStringToPath(instance, "/user/hand/left", &handSubactionArray[0]));
-            XRC_CHECK_THROW_XRCMD(xrStringToPath(instance, "/user/hand/right", &handSubactionArray[1]));
+            PathCache& pathCache = GetGlobalData().pathCache;
+            XRC_CHECK_THROW_XRCMD(pathCache.StringToPath(instance, "/user/hand/left", &handSubactionArray[0]));
+            XRC_CHECK_THROW_XRCMD(pathCache.StringToPath(instance, "/user/hand/right", &handSubactionArray[1]));
 
             // Note that while we are enumerating this, normally our testing is done via a pre-chosen one (globalData.options.viewConfigurationValue).
             XRC_CHECK_THROW_XRCMD(doTwoCallInPlace(viewConfigurationTypeVector, xrEnumerateViewConfigurations, instance, systemId));
@@ -564,18 +589,20 @@ namespace Conformance
 
         // timeout in case the runtime will never transition to READY: 10s in release, no practical limit in debug
         auto timeoutToTransitionToSessionState = (GetGlobalData().options.debugMode ? 60s : 10s);
-        CountdownTimer countdownTimer(timeoutToTransitionToSessionState);
 
-        while ((sessionState != XR_SESSION_STATE_READY) && (!countdownTimer.IsTimeUp())) {
-            XrEventDataBuffer eventBuffer;
-            while (m_privateEventReader->TryReadNext(eventBuffer)) {
-                if (eventBuffer.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
-                    XrEventDataSessionStateChanged sessionStateChanged;
-                    memcpy(&sessionStateChanged, &eventBuffer, sizeof(sessionStateChanged));
-                    sessionState = sessionStateChanged.state;
+        WaitUntilPredicateWithTimeout(
+            [&] {
+                XrEventDataBuffer eventBuffer;
+                while (m_privateEventReader->TryReadNext(eventBuffer)) {
+                    if (eventBuffer.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
+                        XrEventDataSessionStateChanged sessionStateChanged;
+                        memcpy(&sessionStateChanged, &eventBuffer, sizeof(sessionStateChanged));
+                        sessionState = sessionStateChanged.state;
+                    }
                 }
-            }
-        }
+                return sessionState == XR_SESSION_STATE_READY;
+            },
+            timeoutToTransitionToSessionState, *m_eventQueue);
 
         if (sessionState != XR_SESSION_STATE_READY) {
             // We have failed this check with the timeout. This is a pretty common place to fail
@@ -605,6 +632,7 @@ namespace Conformance
         XrSessionBeginInfo sessionBeginInfo{XR_TYPE_SESSION_BEGIN_INFO,
                                             globalData.GetPlatformPlugin()->PopulateNextFieldForStruct(XR_TYPE_SESSION_BEGIN_INFO),
                                             globalData.options.viewConfigurationValue};
+        CheckSessionTestCaseTags();
         XRC_CHECK_THROW_XRCMD(xrBeginSession(session, &sessionBeginInfo));
     }
 
@@ -651,6 +679,10 @@ namespace Conformance
         m_eventQueue.reset();
 
         instanceOwned.reset();
+        if (instancePooled) {
+            GetGlobalData().instancePool.Return(instance);
+            instancePooled = false;
+        }
 
         instance = XR_NULL_HANDLE;
     }
@@ -907,6 +939,7 @@ namespace Conformance
                     XrSessionBeginInfo sessionBeginInfo{
                         XR_TYPE_SESSION_BEGIN_INFO, globalData.GetPlatformPlugin()->PopulateNextFieldForStruct(XR_TYPE_SESSION_BEGIN_INFO),
                         globalData.options.viewConfigurationValue};
+                    CheckSessionTestCaseTags();
                     REQUIRE(xrBeginSession(autoBasicSession->GetSession(), &sessionBeginInfo) == XR_SUCCESS);
                 }
 
@@ -947,21 +980,40 @@ namespace Conformance
     bool WaitUntilPredicateWithTimeout(const std::function<bool()>& predicate, const std::chrono::nanoseconds timeout,
                                        const std::chrono::nanoseconds delay)
     {
-        const auto timeoutTime = std::chrono::system_clock::now() + timeout;
+        const auto timeoutTime = std::chrono::steady_clock::now() + timeout;
+        std::chrono::nanoseconds pause = std::min<std::chrono::nanoseconds>(delay, 1ms);
 
         while (!predicate()) {
-            if (std::chrono::system_clock::now() >= timeoutTime) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= timeoutTime) {
                 return false;
             }
             const std::chrono::nanoseconds minDelay{0};
-            if (delay > minDelay) {
-                std::this_thread::sleep_for(delay);
+            if (pause > minDelay) {
+                std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(pause, timeoutTime - now));
+                pause = std::min(pause * 2, delay);
             }
         }
 
         return true;
     }
 
+    bool WaitUntilPredicateWithTimeout(const std::function<bool()>& predicate, const std::chrono::nanoseconds timeout,
+                                       const EventQueue& eventQueue)
+    {
+        const auto timeoutTime = std::chrono::steady_clock::now() + timeout;
+
+        while (!predicate()) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= timeoutTime) {
+                return false;
+            }
+            eventQueue.WaitForNewEvents(std::min<std::chrono::nanoseconds>(timeoutTime - now, EventQueue::WaitPollInterval));
+        }
+
+        return true;
+    }
+
     XrResult GetAvailableAPILayers(std::vector<XrApiLayerProperties>& availableAPILayers)
     {
         availableAPILayers.clear();
@@ -994,6 +1046,18 @@ namespace Conformance
         return result;
     }
 
+    void CheckSessionTestCaseTags()
+    {
+        // Only the workers of --shards depend on the tags: in any other run, a test case has the runtime to itself.
+        const GlobalData& globalData = GetGlobalData();
+        if (globalData.options.exclusiveSessionTests != "exclude") {
+            return;
+        }
+        CHECK_MSG(globalData.IsCurrentTestCaseExclusiveSession(),
+                  "Test cases that begin a session must be tagged [exclusive_session] (or another tag that makes --shards run "
+                  "them by themselves)");
+    }
+
     bool IsInstanceExtensionEnabled(const char* extensionName)
     {
         GlobalData& globalData = GetGlobalData();
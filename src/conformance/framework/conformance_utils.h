@@ -523,6 +523,10 @@ namespace Conformance
         XrResult instanceCreateResult{XR_SUCCESS};
         XrDebugUtilsMessengerEXT debugMessenger{XR_NULL_HANDLE_CPP};
         XrSystemId systemId{XR_NULL_SYSTEM_ID};
+
+    private:
+        /// Whether instance was borrowed from GlobalData::instancePool and is returned to it rather than destroyed.
+        bool instancePooled{false};
     };
 
     /// Output operator for the `XrInstance` handle in a @ref AutoBasicInstance
@@ -644,6 +648,8 @@ namespace Conformance
 
         XrInstance instance{XR_NULL_HANDLE};
         InstanceScoped instanceOwned;
+        /// Whether instance was borrowed from GlobalData::instancePool and is returned to it rather than destroyed.
+        bool instancePooled{false};
 
         XrSystemId systemId{XR_NULL_SYSTEM_ID};
 
@@ -675,13 +681,26 @@ namespace Conformance
     /// @relates AutoBasicSession
     std::ostream& operator<<(std::ostream& os, AutoBasicSession const& sess);
 
-    /// Calls your @p predicate repeatedly, pausing @p delay in between, until either it returns `true` or @p timeout has elapsed.
+    /// Calls your @p predicate repeatedly until either it returns `true` or @p timeout has elapsed.
+    /// The pause between calls starts at a millisecond and doubles up to @p delay, so that a predicate that is soon true
+    /// does not wait a whole @p delay.
     ///
     /// @note This does not inherently submit frames and is thus likely to cause problems if a session is running unless your predicate submits a frame!
     /// It is intended for use outside of a frame loop.
     bool WaitUntilPredicateWithTimeout(const std::function<bool()>& predicate, const std::chrono::nanoseconds timeout,
                                        const std::chrono::nanoseconds delay);
 
+    /// Calls your @p predicate each time events are added to @p eventQueue, and at least every
+    /// EventQueue::WaitPollInterval (events only arrive when polled), until either it returns `true` or @p timeout has elapsed.
+    /// Use this rather than a fixed delay when the predicate waits for an event, so that it sees the event as soon as it arrives.
+    bool WaitUntilPredicateWithTimeout(const std::function<bool()>& predicate, const std::chrono::nanoseconds timeout,
+                                       const EventQueue& eventQueue);
+
+    /// When run with `--exclusiveSessionTests exclude`, as the workers of --shards are, fails the current test case if it is
+    /// not tagged for exclusive use of a session, such as with [exclusive_session], since those workers run concurrently.
+    /// Does nothing otherwise. Called by the framework before it begins a session.
+    void CheckSessionTestCaseTags();
+
     /// Identifies conformance-related information about individual OpenXR functions.
     struct FunctionInfo
     {
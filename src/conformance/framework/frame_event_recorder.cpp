@@ -0,0 +1,95 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "frame_event_recorder.h"
+
+#include <chrono>
+
+namespace Conformance
+{
+    constexpr size_t FrameEventRecorder::RingCapacity;
+
+    FrameEventRecorder::FrameEventRecorder(size_t producerCount, uint64_t firstFrame, uint64_t frameCount)
+        : m_firstFrame(firstFrame), m_samples((size_t)frameCount), m_consumedEvents((size_t)frameCount, 0)
+    {
+        for (size_t i = 0; i < producerCount; ++i) {
+            m_rings.emplace_back(new Ring());
+        }
+        m_analysisThread = std::thread([this] { Analyze(); });
+    }
+
+    FrameEventRecorder::~FrameEventRecorder()
+    {
+        if (m_analysisThread.joinable()) {
+            m_finishing.store(true, std::memory_order_release);
+            m_analysisThread.join();
+        }
+    }
+
+    std::vector<FrameTimingSample> FrameEventRecorder::Finish()
+    {
+        if (m_analysisThread.joinable()) {
+            m_finishing.store(true, std::memory_order_release);
+            m_analysisThread.join();
+        }
+        constexpr uint8_t allEvents = (1 << ((int)FrameEventType::EndFrameEnd + 1)) - 1;
+        for (size_t i = 0; i < m_samples.size(); ++i) {
+            m_samples[i].complete = m_consumedEvents[i] == allEvents;
+        }
+        return std::move(m_samples);
+    }
+
+    void FrameEventRecorder::Analyze()
+    {
+        FrameEvent event;
+        for (;;) {
+            // Read before draining, so that the last drain sees every event published before Finish.
+            const bool finishing = m_finishing.load(std::memory_order_acquire);
+            bool consumed = false;
+            for (const std::unique_ptr<Ring>& ring : m_rings) {
+                while (ring->TryPop(event)) {
+                    Consume(event);
+                    consumed = true;
+                }
+            }
+            if (finishing) {
+                return;
+            }
+            if (!consumed) {
+                // A frame loop publishes a few events per frame, so a millisecond is far from filling a ring,
+                // and the analysis thread does not compete with the frame threads for a core.
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    void FrameEventRecorder::Consume(const FrameEvent& event)
+    {
+        if (event.frame < m_firstFrame || event.frame - m_firstFrame >= m_samples.size()) {
+            return;
+        }
+        const size_t index = (size_t)(event.frame - m_firstFrame);
+        m_consumedEvents[index] |= (uint8_t)(1 << (int)event.type);
+        FrameTimingSample& sample = m_samples[index];
+        switch (event.type) {
+        case FrameEventType::WaitStart:
+            sample.waitStart = event.time;
+            break;
+        case FrameEventType::WaitEnd:
+            sample.waitEnd = event.time;
+            sample.predictedDisplayTime = event.predictedDisplayTime;
+            sample.predictedDisplayPeriod = event.predictedDisplayPeriod;
+            break;
+        case FrameEventType::BeginStart:
+            sample.beginStart = event.time;
+            break;
+        case FrameEventType::BeginEnd:
+            sample.beginEnd = event.time;
+            break;
+        case FrameEventType::EndFrameEnd:
+            sample.endFrameEnd = event.time;
+            break;
+        }
+    }
+}  // namespace Conformance
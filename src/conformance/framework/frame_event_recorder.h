@@ -0,0 +1,115 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "frame_pacing.h"
+#include "spsc_ring.h"
+
+#include <openxr/openxr.h>
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace Conformance
+{
+    enum class FrameEventType : uint8_t
+    {
+        WaitStart,
+        WaitEnd,
+        BeginStart,
+        BeginEnd,
+        EndFrameEnd,
+    };
+
+    /// A timestamped point in the frame loop, in nanoseconds of FrameTimingNow().
+    struct FrameEvent
+    {
+        uint64_t frame{0};
+        int64_t time{0};
+        FrameEventType type{FrameEventType::WaitStart};
+        /// From the XrFrameState returned by xrWaitFrame, for WaitEnd events only
+        XrTime predictedDisplayTime{0};
+        XrDuration predictedDisplayPeriod{0};
+    };
+
+    /// Collects the FrameTimingSample of each frame of a frame loop that may run on several threads, such as an app thread
+    /// calling xrWaitFrame and a render thread calling xrBeginFrame and xrEndFrame.
+    /// Each thread publishes its events to a lock-free ring of its own, and an analysis thread assembles them into samples,
+    /// so recording an event costs the frame threads a clock read and a few stores: cheap enough to leave on.
+    class FrameEventRecorder
+    {
+    public:
+        /// Events each thread can publish before the analysis thread catches up; more are dropped.
+        static constexpr size_t RingCapacity = 1024;
+
+        /// Assembles the frames [@p firstFrame, @p firstFrame + @p frameCount) published by up to @p producerCount threads,
+        /// ignoring the events of other frames, such as warmup frames.
+        FrameEventRecorder(size_t producerCount, uint64_t firstFrame, uint64_t frameCount);
+        ~FrameEventRecorder();
+
+        FrameEventRecorder(const FrameEventRecorder&) = delete;
+        FrameEventRecorder& operator=(const FrameEventRecorder&) = delete;
+
+        /// Timestamps an event of @p frame now. Only one thread may record to each @p producer.
+        void Record(size_t producer, uint64_t frame, FrameEventType type)
+        {
+            FrameEvent event;
+            event.frame = frame;
+            event.time = FrameTimingNow();
+            event.type = type;
+            Publish(producer, event);
+        }
+
+        /// Timestamps the return of xrWaitFrame for @p frame now.
+        void RecordWaitEnd(size_t producer, uint64_t frame, const XrFrameState& frameState)
+        {
+            FrameEvent event;
+            event.frame = frame;
+            event.time = FrameTimingNow();
+            event.type = FrameEventType::WaitEnd;
+            event.predictedDisplayTime = frameState.predictedDisplayTime;
+            event.predictedDisplayPeriod = frameState.predictedDisplayPeriod;
+            Publish(producer, event);
+        }
+
+        /// Stops the analysis thread once it has consumed every event published so far, and returns the samples in frame
+        /// order. Samples missing any of their events, such as because they were dropped, are marked incomplete.
+        /// Call once the frame threads have stopped recording.
+        std::vector<FrameTimingSample> Finish();
+
+        /// Number of events dropped because a ring was full. The samples of their frames are incomplete.
+        uint64_t GetDroppedEventCount() const
+        {
+            return m_droppedEvents.load(std::memory_order_relaxed);
+        }
+
+    private:
+        using Ring = SpscRing<FrameEvent, RingCapacity>;
+
+        void Publish(size_t producer, const FrameEvent& event)
+        {
+            if (!m_rings[producer]->TryPush(event)) {
+                m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void Analyze();
+        void Consume(const FrameEvent& event);
+
+        std::vector<std::unique_ptr<Ring>> m_rings;
+        uint64_t m_firstFrame;
+        /// Only accessed by the analysis thread until it is joined.
+        std::vector<FrameTimingSample> m_samples;
+        /// Bit mask of the FrameEventType of each sample that has been consumed.
+        std::vector<uint8_t> m_consumedEvents;
+        std::atomic<bool> m_finishing{false};
+        std::atomic<uint64_t> m_droppedEvents{0};
+        std::thread m_analysisThread;
+    };
+}  // namespace Conformance
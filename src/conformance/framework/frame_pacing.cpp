@@ -0,0 +1,125 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "frame_pacing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+namespace Conformance
+{
+    int64_t FrameTimingNow()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    DurationPercentiles ComputeDurationPercentiles(std::vector<std::chrono::nanoseconds> durations)
+    {
+        DurationPercentiles percentiles;
+        if (durations.empty()) {
+            return percentiles;
+        }
+        std::sort(durations.begin(), durations.end());
+        auto nearestRank = [&](double percent) {
+            const size_t rank = (size_t)std::ceil(percent / 100.0 * (double)durations.size());
+            return durations[std::max(rank, (size_t)1) - 1];
+        };
+        percentiles.p50 = nearestRank(50);
+        percentiles.p95 = nearestRank(95);
+        percentiles.p99 = nearestRank(99);
+        percentiles.max = durations.back();
+        return percentiles;
+    }
+
+    FramePacingStatistics ComputeFramePacingStatistics(const std::vector<FrameTimingSample>& samples)
+    {
+        using ns = std::chrono::nanoseconds;
+
+        std::vector<FrameTimingSample> completeSamples;
+        completeSamples.reserve(samples.size());
+        std::copy_if(samples.begin(), samples.end(), std::back_inserter(completeSamples),
+                     [](const FrameTimingSample& sample) { return sample.complete; });
+
+        FramePacingStatistics statistics;
+        statistics.frameCount = (uint32_t)completeSamples.size();
+        if (completeSamples.empty()) {
+            return statistics;
+        }
+
+        std::vector<ns> durations(completeSamples.size());
+        std::transform(completeSamples.begin(), completeSamples.end(), durations.begin(),
+                       [](const FrameTimingSample& sample) { return ns(sample.waitEnd - sample.waitStart); });
+        statistics.waitTime = ComputeDurationPercentiles(durations);
+        std::transform(completeSamples.begin(), completeSamples.end(), durations.begin(),
+                       [](const FrameTimingSample& sample) { return ns(sample.beginEnd - sample.beginStart); });
+        statistics.beginTime = ComputeDurationPercentiles(durations);
+        std::transform(completeSamples.begin(), completeSamples.end(), durations.begin(),
+                       [](const FrameTimingSample& sample) { return ns(sample.endFrameEnd - sample.waitEnd); });
+        statistics.frameLatency = ComputeDurationPercentiles(durations);
+
+        // Intervals only span successive frames, so none are taken across an incomplete sample.
+        std::vector<ns> intervals;
+        intervals.reserve(samples.size());
+        double intervalSum = 0;
+        for (size_t i = 1; i < samples.size(); ++i) {
+            const FrameTimingSample& previous = samples[i - 1];
+            const FrameTimingSample& sample = samples[i];
+            if (!previous.complete || !sample.complete) {
+                continue;
+            }
+            intervals.push_back(ns(sample.waitEnd - previous.waitEnd));
+            intervalSum += (double)intervals.back().count();
+
+            if (sample.predictedDisplayPeriod > 0) {
+                const XrDuration displayTimeStep = sample.predictedDisplayTime - previous.predictedDisplayTime;
+                const int64_t periods = (int64_t)std::llround((double)displayTimeStep / (double)sample.predictedDisplayPeriod);
+                if (periods > 1) {
+                    statistics.missedDeadlines += (uint32_t)(periods - 1);
+                }
+            }
+        }
+        if (intervals.empty()) {
+            return statistics;
+        }
+        statistics.frameInterval = ComputeDurationPercentiles(intervals);
+
+        const double intervalMean = intervalSum / (double)intervals.size();
+        double squaredDeviationSum = 0;
+        for (ns interval : intervals) {
+            const double deviation = (double)interval.count() - intervalMean;
+            squaredDeviationSum += deviation * deviation;
+        }
+        statistics.jitter = ns((int64_t)std::sqrt(squaredDeviationSum / (double)intervals.size()));
+
+        const FrameTimingSample& first = completeSamples.front();
+        const FrameTimingSample& last = completeSamples.back();
+        statistics.displayTimeDrift = ns((last.predictedDisplayTime - first.predictedDisplayTime) - (last.waitEnd - first.waitEnd));
+        return statistics;
+    }
+
+    bool WriteFramePacingCsv(const std::string& path, const std::vector<FrameTimingSample>& samples)
+    {
+        std::ofstream file(path);
+        file << "frame,waitStartNs,waitEndNs,beginStartNs,beginEndNs,endFrameEndNs,"
+                "predictedDisplayTimeNs,predictedDisplayPeriodNs\n";
+        const auto firstComplete =
+            std::find_if(samples.begin(), samples.end(), [](const FrameTimingSample& sample) { return sample.complete; });
+        if (firstComplete != samples.end()) {
+            const int64_t origin = firstComplete->waitStart;
+            const XrTime displayOrigin = firstComplete->predictedDisplayTime;
+            for (size_t i = 0; i < samples.size(); ++i) {
+                const FrameTimingSample& sample = samples[i];
+                if (!sample.complete) {
+                    continue;
+                }
+                file << i << ',' << sample.waitStart - origin << ',' << sample.waitEnd - origin << ',' << sample.beginStart - origin
+                     << ',' << sample.beginEnd - origin << ',' << sample.endFrameEnd - origin << ','
+                     << sample.predictedDisplayTime - displayOrigin << ',' << sample.predictedDisplayPeriod << '\n';
+            }
+        }
+        return (bool)file;
+    }
+}  // namespace Conformance
@@ -0,0 +1,84 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    /// Timestamps of one frame of a frame loop. All times except those reported by the runtime are in nanoseconds
+    /// of FrameTimingNow(), so that they can be recorded from several threads and compared.
+    struct FrameTimingSample
+    {
+        /// Before and after xrWaitFrame
+        int64_t waitStart{0};
+        int64_t waitEnd{0};
+        /// Before and after xrBeginFrame
+        int64_t beginStart{0};
+        int64_t beginEnd{0};
+        /// After xrEndFrame
+        int64_t endFrameEnd{0};
+        /// From the XrFrameState returned by xrWaitFrame
+        XrTime predictedDisplayTime{0};
+        XrDuration predictedDisplayPeriod{0};
+        /// False if some of the times were never recorded, such as when FrameEventRecorder dropped their events,
+        /// leaving them zero. Statistics skip incomplete samples.
+        bool complete{true};
+    };
+
+    /// Monotonic time in nanoseconds, for FrameTimingSample.
+    int64_t FrameTimingNow();
+
+    /// Nearest-rank percentiles of a set of durations.
+    struct DurationPercentiles
+    {
+        std::chrono::nanoseconds p50{0};
+        std::chrono::nanoseconds p95{0};
+        std::chrono::nanoseconds p99{0};
+        std::chrono::nanoseconds max{0};
+    };
+
+    DurationPercentiles ComputeDurationPercentiles(std::vector<std::chrono::nanoseconds> durations);
+
+    /// Frame pacing of a frame loop beyond its averages: the spikes that averages hide.
+    struct FramePacingStatistics
+    {
+        uint32_t frameCount{0};
+
+        /// Time spent in xrWaitFrame
+        DurationPercentiles waitTime;
+        /// Time spent in xrBeginFrame
+        DurationPercentiles beginTime;
+        /// Time between the returns of successive xrWaitFrame calls
+        DurationPercentiles frameInterval;
+        /// Time from the return of xrWaitFrame to the return of the xrEndFrame of the same frame
+        DurationPercentiles frameLatency;
+
+        /// Number of display periods skipped between the predicted display times of successive frames.
+        /// Each is a frame the application was throttled past, so a deadline it missed.
+        uint32_t missedDeadlines{0};
+
+        /// Standard deviation of the frame interval.
+        std::chrono::nanoseconds jitter{0};
+
+        /// How far the predicted display times moved against the frame loop's clock over the sampled frames:
+        /// the change in predicted display time minus the time elapsed between the first and last xrWaitFrame returns.
+        /// Near zero when the runtime's display timeline keeps pace with the frame loop.
+        std::chrono::nanoseconds displayTimeDrift{0};
+    };
+
+    /// Samples must be in frame order. Needs at least two complete samples for interval statistics,
+    /// which only use successive samples that are both complete.
+    FramePacingStatistics ComputeFramePacingStatistics(const std::vector<FrameTimingSample>& samples);
+
+    /// Write one line per complete frame, with times in nanoseconds relative to the first complete frame.
+    /// Returns false if the file could not be written.
+    bool WriteFramePacingCsv(const std::string& path, const std::vector<FrameTimingSample>& samples);
+}  // namespace Conformance
@@ -10,6 +10,7 @@
 
 #include "common/xr_linear.h"
 #include <utilities/image.h>
+#include "utilities/pixel_kernels.h"
 #include "utilities/xr_math_operators.h"
 
 #include <openxr/openxr.h>
@@ -736,17 +737,9 @@ namespace GltfHelper
         // Not supported: STBI_grey (DXGI_FORMAT_R8_UNORM?) and STBI_grey_alpha.
         if (image.component == 3 && formatParams.channels == Image::Channels::RGBA) {
             // Convert RGB to RGBA.
+            // Rows are tightly packed in both buffers, so the whole image can be expanded in one span.
             tempBuffer.resize(image.width * image.height * 4);
-            for (int y = 0; y < image.height; ++y) {
-                const uint8_t* src = image.image.data() + y * image.width * 3;
-                uint8_t* dest = tempBuffer.data() + y * image.width * 4;
-                for (int x = image.width - 1; x >= 0; --x, src += 3, dest += 4) {
-                    dest[0] = src[0];
-                    dest[1] = src[1];
-                    dest[2] = src[2];
-                    dest[3] = 255;
-                }
-            }
+            Conformance::PixelKernels::ExpandRGBToRGBA(image.image.data(), tempBuffer.data(), (size_t)image.width * image.height);
 
             std::vector<Image::ImageLevel> imageLevels = {Image::ImageLevel{metadata, tempBuffer}};
             return Image::Image{formatParams, imageLevels};
@@ -217,9 +217,30 @@ namespace Conformance
             return *this;
         }
 
+        /// Cull against @p viewProjection_ instead of the frustum of the view being rendered, which must be inside it.
+        /// Pass the same matrix for each view of a frame, for example from MakeCombinedViewProjection, and the drawables
+        /// are only culled once for all of them. @p viewProjection_ must outlive the RenderView calls.
+        RenderParams& CullWith(const XrMatrix4x4f& viewProjection_)
+        {
+            cullingViewProjection = &viewProjection_;
+            return *this;
+        }
+
         span<const Cube> cubes{};
         span<const MeshDrawable> meshes{};
         span<const GLTFDrawable> glTFs{};
+        const XrMatrix4x4f* cullingViewProjection{nullptr};
+    };
+
+    /// Counts of drawables culled by IGraphicsPlugin::RenderView, summed over every view rendered.
+    struct ViewCullingStatistics
+    {
+        /// Drawables that were at least partly inside the frustum, so were drawn.
+        uint64_t drawn{0};
+        /// Drawables that were entirely outside the frustum, so were skipped.
+        uint64_t culled{0};
+        /// Views that reused the culling of the previous view, because it had the same drawables and culling frustum.
+        uint64_t sharedPasses{0};
     };
 
 #define IGRAPHICSPLUGIN_UNIMPLEMENTED_METHOD() \
@@ -399,8 +420,16 @@ namespace Conformance
         }
 
         /// Render a list of drawables to a swapchain image. ClearImageSlice must be called first to clear internal state.
+        /// Drawables entirely outside the view frustum may be skipped.
         virtual void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* colorSwapchainImage,
                                 const RenderParams& params) = 0;
+
+        /// How many drawables RenderView has drawn and culled so far.
+        virtual ViewCullingStatistics GetViewCullingStatistics() const
+        {
+            // Default implementation for APIs which don't cull.
+            return {};
+        }
     };
 
     /// Create a graphics plugin for the graphics API specified in the options.
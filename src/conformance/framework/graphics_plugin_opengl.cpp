@@ -25,6 +25,7 @@
 #include "graphics_plugin_opengl_gltf.h"
 #include "report.h"
 #include "swapchain_image_data.h"
+#include "view_culling.h"
 
 #include "common/gfxwrapper_opengl.h"
 #include "common/xr_dependencies.h"
@@ -208,12 +209,14 @@ namespace Conformance
         GLuint m_vertexBuffer{0};
         GLuint m_indexBuffer{0};
         uint32_t m_numIndices;
+        DrawableBounds m_bounds;
 
         OpenGLMesh(GLint vertexAttribCoords, GLint vertexAttribColor,  //
                    const uint16_t* idx_data, uint32_t idx_count,       //
                    const Geometry::Vertex* vtx_data, uint32_t vtx_count)
         {
             m_numIndices = idx_count;
+            m_bounds = ComputeBounds({vtx_data, vtx_count});
 
             XRC_CHECK_THROW_GLCMD(glGenBuffers(1, &m_vertexBuffer));
             XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer));
@@ -244,6 +247,7 @@ namespace Conformance
             swap(m_vertexBuffer, other.m_vertexBuffer);
             swap(m_indexBuffer, other.m_indexBuffer);
             swap(m_numIndices, other.m_numIndices);
+            swap(m_bounds, other.m_bounds);
         }
 
         OpenGLMesh(const OpenGLMesh&) = delete;
@@ -435,6 +439,11 @@ namespace Conformance
         void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* colorSwapchainImage,
                         const RenderParams& params) override;
 
+        ViewCullingStatistics GetViewCullingStatistics() const override
+        {
+            return m_viewCuller.GetStatistics();
+        }
+
     private:
         bool initialized = false;
         bool deviceInitialized = false;
@@ -458,6 +467,7 @@ namespace Conformance
 #endif
 
         SwapchainImageDataMap<OpenGLSwapchainImageData> m_swapchainImageDataMap;
+        GLImageUploader m_imageUploader;
         GLuint m_swapchainFramebuffer{0};
         GLuint m_program{0};
         GLint m_modelViewProjectionUniformLocation{0};
@@ -470,6 +480,7 @@ namespace Conformance
         VectorWithGenerationCountedHandles<std::shared_ptr<Pbr::Model>, GLTFModelHandle> m_gltfModels;
         VectorWithGenerationCountedHandles<GLGLTF, GLTFModelInstanceHandle> m_gltfInstances;
         std::unique_ptr<Pbr::GLResources> m_pbrResources;
+        ViewCuller m_viewCuller;
     };
 
     OpenGLGraphicsPlugin::OpenGLGraphicsPlugin(const std::shared_ptr<IPlatformPlugin>& /*unused*/)
@@ -813,6 +824,7 @@ namespace Conformance
         if (m_program != 0) {
             glDeleteProgram(m_program);
         }
+        m_imageUploader.Reset();
 
         // Reset the swapchains to avoid calling Vulkan functions in the dtors after
         // we've shut down the device.
@@ -1001,25 +1013,9 @@ namespace Conformance
         std::tie(swapchainData, imageIndex) = m_swapchainImageDataMap.GetDataAndIndexFromBasePointer(swapchainImage);
 
         const uint32_t colorTexture = reinterpret_cast<const XrSwapchainImageOpenGLKHR*>(swapchainImage)->image;
-        const GLint mip = 0;
-        const GLint x = 0;
-        const GLint z = arraySlice;
-        const GLsizei w = swapchainData->Width();
-        const GLsizei h = swapchainData->Height();
-        if (swapchainData->HasMultipleSlices()) {
-            XRC_CHECK_THROW_GLCMD(glBindTexture(GL_TEXTURE_2D_ARRAY, colorTexture));
-            for (GLint y = 0; y < h; ++y) {
-                const void* pixels = &image.pixels[(h - 1 - y) * w];
-                XRC_CHECK_THROW_GLCMD(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, mip, x, y, z, w, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
-        else {
-            XRC_CHECK_THROW_GLCMD(glBindTexture(GL_TEXTURE_2D, colorTexture));
-            for (GLint y = 0; y < h; ++y) {
-                const void* pixels = &image.pixels[(h - 1 - y) * w];
-                XRC_CHECK_THROW_GLCMD(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, w, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
+        const GLenum target = swapchainData->HasMultipleSlices() ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+        m_imageUploader.UploadRGBA8(target, colorTexture, arraySlice, swapchainData->Width(), swapchainData->Height(),
+                                    image.pixels.data());
     }
 
     void OpenGLGraphicsPlugin::ClearImageSlice(const XrSwapchainImageBaseHeader* colorSwapchainImage, uint32_t imageArrayIndex,
@@ -1140,7 +1136,7 @@ namespace Conformance
 
         const auto& pose = layerView.pose;
         XrMatrix4x4f proj;
-        XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_OPENGL, layerView.fov, 0.05f, 100.0f);
+        XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_OPENGL, layerView.fov, RenderViewNearZ, RenderViewFarZ);
         XrMatrix4x4f toView = Matrix::FromPose(pose);
         XrMatrix4x4f view = Matrix::InvertRigidBody(toView);
         XrMatrix4x4f vp = proj * view;
@@ -1168,18 +1164,36 @@ namespace Conformance
             glDrawElements(GL_TRIANGLES, GLsizei(glMesh.m_numIndices), GL_UNSIGNED_SHORT, nullptr);
         };
 
+        // Skip the drawables entirely outside the view.
+        m_viewCuller.Cull(
+            vp, params, [this](MeshHandle handle) { return m_meshes[handle].m_bounds; },
+            [this](GLTFModelInstanceHandle handle) {
+                DrawableBounds bounds;
+                GetModelInstance(handle).GetBounds(&bounds.mins, &bounds.maxs);
+                return bounds;
+            });
+
         // Render each cube
-        for (const Cube& cube : params.cubes) {
-            drawMesh(MeshDrawable{m_cubeMesh, cube.params.pose, cube.params.scale, cube.tintColor});
+        for (size_t i = 0; i < params.cubes.size(); ++i) {
+            if (m_viewCuller.IsCubeVisible(i)) {
+                const Cube& cube = params.cubes[i];
+                drawMesh(MeshDrawable{m_cubeMesh, cube.params.pose, cube.params.scale, cube.tintColor});
+            }
         }
 
         // Render each mesh
-        for (const auto& mesh : params.meshes) {
-            drawMesh(mesh);
+        for (size_t i = 0; i < params.meshes.size(); ++i) {
+            if (m_viewCuller.IsMeshVisible(i)) {
+                drawMesh(params.meshes[i]);
+            }
         }
 
         // Render each gltf
-        for (const auto& gltfDrawable : params.glTFs) {
+        for (size_t i = 0; i < params.glTFs.size(); ++i) {
+            if (!m_viewCuller.IsGLTFVisible(i)) {
+                continue;
+            }
+            const GLTFDrawable& gltfDrawable = params.glTFs[i];
             GLGLTF& gltf = m_gltfInstances[gltfDrawable.handle];
             // Compute and update the model transform.
 
@@ -30,6 +30,7 @@
 #include "pbr/OpenGL/GLResources.h"
 #include "pbr/OpenGL/GLTexture.h"
 #include "utilities/Geometry.h"
+#include "utilities/opengl_utils.h"
 #include "utilities/swapchain_format_data.h"
 #include "utilities/swapchain_parameters.h"
 #include "utilities/throw_helpers.h"
@@ -336,6 +337,7 @@ namespace Conformance
         std::unique_ptr<Pbr::GLResources> m_pbrResources;
 
         SwapchainImageDataMap<OpenGLESSwapchainImageData> m_swapchainImageDataMap;
+        GLImageUploader m_imageUploader;
     };
 
     OpenGLESGraphicsPlugin::OpenGLESGraphicsPlugin(std::shared_ptr<IPlatformPlugin>& /*unused*/) : initialized(false)
@@ -396,30 +398,9 @@ namespace Conformance
 
         std::tie(swapchainData, imageIndex) = m_swapchainImageDataMap.GetDataAndIndexFromBasePointer(swapchainImage);
 
-        // auto imageInfoIt = m_imageInfo.find(swapchainImage);
-        // XRC_CHECK_THROW(imageInfoIt != m_imageInfo.end());
-
-        // SwapchainInfo& swapchainInfo = m_swapchainInfo[imageInfoIt->second.swapchainIndex];
-        // GLuint arraySize = swapchainInfo.createInfo.arraySize;
-        const bool isArray = swapchainData->HasMultipleSlices();
-        GLuint width = swapchainData->Width();
-        GLuint height = swapchainData->Height();
-        GLenum target = isArray ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
-
+        const GLenum target = swapchainData->HasMultipleSlices() ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
         const uint32_t img = swapchainData->GetTypedImage(imageIndex).image;
-        GL(glBindTexture(target, img));
-        if (isArray) {
-            for (GLuint y = 0; y < height; ++y) {
-                const void* pixels = &image.pixels[(height - 1 - y) * width];
-                GL(glTexSubImage3D(target, 0, 0, y, arraySlice, width, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
-        else {
-            for (GLuint y = 0; y < height; ++y) {
-                const void* pixels = &image.pixels[(height - 1 - y) * width];
-                GL(glTexSubImage2D(target, 0, 0, y, width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-            }
-        }
+        m_imageUploader.UploadRGBA8(target, img, arraySlice, swapchainData->Width(), swapchainData->Height(), image.pixels.data());
         GL(glBindTexture(target, 0));
     }
 
@@ -594,6 +575,7 @@ namespace Conformance
             if (m_program != 0) {
                 GL(glDeleteProgram(m_program));
             }
+            m_imageUploader.Reset();
 
             m_swapchainImageDataMap.Reset();
 
@@ -23,6 +23,7 @@
 #include "graphics_plugin_vulkan_gltf.h"
 #include "report.h"
 #include "swapchain_image_data.h"
+#include "view_culling.h"
 
 #include "common/hex_and_handles.h"
 #include "common/vulkan_debug_object_namer.hpp"
@@ -30,6 +31,7 @@
 #include "common/xr_linear.h"
 #include "pbr/PbrCommon.h"
 #include "pbr/Vulkan/VkCommon.h"
+#include "pbr/Vulkan/VkDrawList.h"
 #include "pbr/Vulkan/VkResources.h"
 #include "pbr/Vulkan/VkTexture.h"
 #include "pbr/Vulkan/VkModel.h"
@@ -523,6 +525,7 @@ namespace Conformance
         static constexpr VkVertexInputBindingDescription c_bindingDesc = VertexBuffer<Geometry::Vertex>::c_bindingDesc;
 
         VertexBuffer<Geometry::Vertex> m_DrawBuffer;
+        DrawableBounds m_bounds;
 
         VulkanMesh(VkDevice device, const VulkanDebugObjectNamer& namer,  //
                    const MemoryAllocator* memAllocator,                   //
@@ -537,12 +540,14 @@ namespace Conformance
 
             m_DrawBuffer.UpdateIndices(nonstd::span<const uint16_t>(idx_data, idx_count), 0);
             m_DrawBuffer.UpdateVertices(nonstd::span<const Geometry::Vertex>(vtx_data, vtx_count), 0);
+            m_bounds = ComputeBounds({vtx_data, vtx_count});
         }
 
         VulkanMesh(VulkanMesh&& other) noexcept
         {
             using std::swap;
             swap(m_DrawBuffer, other.m_DrawBuffer);
+            swap(m_bounds, other.m_bounds);
         }
 
         VulkanMesh(const VulkanMesh&) = delete;
@@ -669,6 +674,11 @@ namespace Conformance
         void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* colorSwapchainImage,
                         const RenderParams& params) override;
 
+        ViewCullingStatistics GetViewCullingStatistics() const override
+        {
+            return m_viewCuller.GetStatistics();
+        }
+
         /// Get data on a known swapchain format
         const SwapchainFormatData& FindFormatData(int64_t format) const;
 
@@ -723,6 +733,9 @@ namespace Conformance
         VectorWithGenerationCountedHandles<std::shared_ptr<Pbr::Model>, GLTFModelHandle> m_gltfModels;
         VectorWithGenerationCountedHandles<VulkanGLTF, GLTFModelInstanceHandle> m_gltfInstances;
         std::unique_ptr<Pbr::VulkanResources> m_pbrResources;
+        // Reused by each RenderView to avoid reallocating.
+        Pbr::VulkanDrawList m_gltfDrawList;
+        ViewCuller m_viewCuller;
 
 #if defined(USE_MIRROR_WINDOW)
         Swapchain m_swapchain{};
@@ -2047,7 +2060,7 @@ namespace Conformance
         // Note all matrixes (including OpenXR's) are column-major, right-handed.
         const auto& pose = layerView.pose;
         XrMatrix4x4f proj;
-        XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_VULKAN, layerView.fov, 0.05f, 100.0f);
+        XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_VULKAN, layerView.fov, RenderViewNearZ, RenderViewFarZ);
         XrMatrix4x4f toView = Matrix::FromPose(pose);
         XrMatrix4x4f view = Matrix::InvertRigidBody(toView);
         XrMatrix4x4f vp = proj * view;
@@ -2086,29 +2099,48 @@ namespace Conformance
             CHECKPOINT();
         };
 
+        // Skip the drawables entirely outside the view.
+        m_viewCuller.Cull(
+            vp, params, [this](MeshHandle handle) { return m_meshes[handle].m_bounds; },
+            [this](GLTFModelInstanceHandle handle) {
+                DrawableBounds bounds;
+                GetModelInstance(handle).GetBounds(&bounds.mins, &bounds.maxs);
+                return bounds;
+            });
+
         // Render each cube
-        for (const Cube& cube : params.cubes) {
-            drawMesh(MeshDrawable{m_cubeMesh, cube.params.pose, cube.params.scale, cube.tintColor});
+        for (size_t i = 0; i < params.cubes.size(); ++i) {
+            if (m_viewCuller.IsCubeVisible(i)) {
+                const Cube& cube = params.cubes[i];
+                drawMesh(MeshDrawable{m_cubeMesh, cube.params.pose, cube.params.scale, cube.tintColor});
+            }
         }
 
         // Render each mesh
-        for (const auto& mesh : params.meshes) {
-            drawMesh(mesh);
+        for (size_t i = 0; i < params.meshes.size(); ++i) {
+            if (m_viewCuller.IsMeshVisible(i)) {
+                drawMesh(params.meshes[i]);
+            }
         }
 
-        // Render each gltf
-        for (const auto& gltfDrawable : params.glTFs) {
-            VulkanGLTF& gltf = m_gltfInstances[gltfDrawable.handle];
-            // Compute and update the model transform.
-
-            XrMatrix4x4f modelToWorld = Matrix::FromTranslationRotationScale(
-                gltfDrawable.params.pose.position, gltfDrawable.params.pose.orientation, gltfDrawable.params.scale);
-            // XrMatrix4x4f viewMatrix = Matrix::FromPose(layerView.pose);
-            // XrMatrix4x4f viewMatrixInverse = Matrix::InvertRigidBody(viewMatrix);
+        // Render the gltfs together, so that their primitives can be grouped by pipeline and mesh
+        if (!params.glTFs.empty()) {
             m_pbrResources->SetViewProjection(view, proj);
 
-            gltf.Render(m_cmdBuffer, *m_pbrResources, modelToWorld, renderPassBeginInfo.renderPass,
-                        (VkSampleCountFlagBits)swapchainData->GetCreateInfo().sampleCount);
+            m_gltfDrawList.Clear();
+            for (size_t i = 0; i < params.glTFs.size(); ++i) {
+                if (!m_viewCuller.IsGLTFVisible(i)) {
+                    continue;
+                }
+                const GLTFDrawable& gltfDrawable = params.glTFs[i];
+                VulkanGLTF& gltf = m_gltfInstances[gltfDrawable.handle];
+                // Compute and update the model transform.
+                XrMatrix4x4f modelToWorld = Matrix::FromTranslationRotationScale(
+                    gltfDrawable.params.pose.position, gltfDrawable.params.pose.orientation, gltfDrawable.params.scale);
+                gltf.AddToDrawList(*m_pbrResources, modelToWorld, m_gltfDrawList);
+            }
+            m_gltfDrawList.Render(m_cmdBuffer, *m_pbrResources, renderPassBeginInfo.renderPass,
+                                  (VkSampleCountFlagBits)swapchainData->GetCreateInfo().sampleCount);
         }
 
         vkCmdEndRenderPass(m_cmdBuffer.buf);
@@ -6,6 +6,7 @@
 
 #include "graphics_plugin_vulkan_gltf.h"
 
+#include "pbr/Vulkan/VkDrawList.h"
 #include "pbr/Vulkan/VkModel.h"
 #include "pbr/Vulkan/VkPrimitive.h"
 #include "pbr/Vulkan/VkResources.h"
@@ -21,5 +22,10 @@ namespace Conformance
         GetModelInstance().Render(resources, directCommandBuffer, renderPass, sampleCount, modelToWorld);
     }
 
+    void VulkanGLTF::AddToDrawList(Pbr::VulkanResources& resources, const XrMatrix4x4f& modelToWorld, Pbr::VulkanDrawList& drawList)
+    {
+        GetModelInstance().AddToDrawList(resources, modelToWorld, GetFillMode(), drawList);
+    }
+
 }  // namespace Conformance
 #endif
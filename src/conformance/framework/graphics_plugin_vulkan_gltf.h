@@ -22,6 +22,7 @@
 namespace Pbr
 {
     class Model;
+    class VulkanDrawList;
     struct VulkanResources;
 }  // namespace Pbr
 
@@ -36,6 +37,9 @@ namespace Conformance
 
         void Render(CmdBuffer& directCommandBuffer, Pbr::VulkanResources& resources, const XrMatrix4x4f& modelToWorld,
                     VkRenderPass renderPass, VkSampleCountFlagBits sampleCount);
+
+        /// Add this instance's primitives to a draw list shared with the other glTF instances in the view.
+        void AddToDrawList(Pbr::VulkanResources& resources, const XrMatrix4x4f& modelToWorld, Pbr::VulkanDrawList& drawList);
     };
 }  // namespace Conformance
 #endif
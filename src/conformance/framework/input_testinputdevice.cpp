@@ -108,12 +108,13 @@ namespace Conformance
 
             FeatureSet enabled;
             GetGlobalData().PopulateVersionAndEnabledExtensions(enabled);
+            const InteractionAvailabilityMask availability(enabled);
 
             for (const InputSourcePathAvailData& inputSourceData : interactionProfilePaths) {
                 if (!starts_with(inputSourceData.Path, topLevelPathString)) {
                     continue;
                 }
-                if (!kInteractionAvailabilities[(size_t)inputSourceData.Availability].IsSatisfiedBy(enabled)) {
+                if (!availability.IsAvailable(inputSourceData)) {
                     continue;
                 }
 
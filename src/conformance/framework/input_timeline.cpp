@@ -0,0 +1,224 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "input_timeline.h"
+
+#include "composition_utils.h"
+#include "conformance_framework.h"
+#include "utilities/throw_helpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace Conformance
+{
+    InputTimeline::InputTimeline(XrInstance instance, XrSession session)
+        : m_session(session)
+        , m_setInputDeviceActive(GetInstanceExtensionFunction<PFN_xrSetInputDeviceActiveEXT>(instance, "xrSetInputDeviceActiveEXT"))
+        , m_setInputDeviceStateBool(
+              GetInstanceExtensionFunction<PFN_xrSetInputDeviceStateBoolEXT>(instance, "xrSetInputDeviceStateBoolEXT"))
+        , m_setInputDeviceStateFloat(
+              GetInstanceExtensionFunction<PFN_xrSetInputDeviceStateFloatEXT>(instance, "xrSetInputDeviceStateFloatEXT"))
+        , m_setInputDeviceStateVector2f(
+              GetInstanceExtensionFunction<PFN_xrSetInputDeviceStateVector2fEXT>(instance, "xrSetInputDeviceStateVector2fEXT"))
+        , m_setInputDeviceLocation(
+              GetInstanceExtensionFunction<PFN_xrSetInputDeviceLocationEXT>(instance, "xrSetInputDeviceLocationEXT"))
+    {
+    }
+
+    InputTimeline& InputTimeline::SetDeviceActive(XrDuration time, XrPath interactionProfile, XrPath topLevelPath, bool isActive)
+    {
+        return AddEvent({time, EventType::Active, interactionProfile, topLevelPath, XR_NULL_PATH, {isActive ? 1.f : 0.f, 0.f}});
+    }
+
+    InputTimeline& InputTimeline::SetBool(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, bool state)
+    {
+        return AddEvent({time, EventType::Bool, XR_NULL_PATH, topLevelPath, inputSourcePath, {state ? 1.f : 0.f, 0.f}});
+    }
+
+    InputTimeline& InputTimeline::SetFloat(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, float state)
+    {
+        return AddEvent({time, EventType::Float, XR_NULL_PATH, topLevelPath, inputSourcePath, {state, 0.f}});
+    }
+
+    InputTimeline& InputTimeline::SetVector2f(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, XrVector2f state)
+    {
+        return AddEvent({time, EventType::Vector2f, XR_NULL_PATH, topLevelPath, inputSourcePath, state});
+    }
+
+    InputTimeline& InputTimeline::SetLocation(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, XrSpace space,
+                                              XrPosef pose)
+    {
+        return AddEvent({time, EventType::Location, XR_NULL_PATH, topLevelPath, inputSourcePath, {0.f, 0.f}, space, pose});
+    }
+
+    InputTimeline& InputTimeline::ExpectBool(XrDuration time, XrAction action, bool state, XrPath subactionPath)
+    {
+        return AddExpectation({0, time, action, subactionPath, XR_ACTION_TYPE_BOOLEAN_INPUT, true, {state ? 1.f : 0.f, 0.f}, 0.f});
+    }
+
+    InputTimeline& InputTimeline::ExpectFloat(XrDuration time, XrAction action, float state, float epsilon, XrPath subactionPath)
+    {
+        return AddExpectation({0, time, action, subactionPath, XR_ACTION_TYPE_FLOAT_INPUT, true, {state, 0.f}, epsilon});
+    }
+
+    InputTimeline& InputTimeline::ExpectVector2f(XrDuration time, XrAction action, XrVector2f state, float epsilon,
+                                                 XrPath subactionPath)
+    {
+        return AddExpectation({0, time, action, subactionPath, XR_ACTION_TYPE_VECTOR2F_INPUT, true, state, epsilon});
+    }
+
+    InputTimeline& InputTimeline::ExpectInactive(XrDuration time, XrAction action, XrActionType actionType, XrPath subactionPath)
+    {
+        return AddExpectation({0, time, action, subactionPath, actionType, false, {0.f, 0.f}, 0.f});
+    }
+
+    XrDuration InputTimeline::GetDuration() const
+    {
+        XrDuration duration = 0;
+        if (!m_events.empty()) {
+            duration = std::max(duration, m_events.back().time);
+        }
+        if (!m_expectations.empty()) {
+            duration = std::max(duration, m_expectations.back().time);
+        }
+        return duration;
+    }
+
+    std::vector<InputTimelineMismatch> InputTimeline::Replay(RenderLoop& renderLoop, const XrActionsSyncInfo& syncInfo) const
+    {
+        std::vector<InputTimelineMismatch> mismatches;
+        auto nextEvent = m_events.begin();
+        auto nextExpectation = m_expectations.begin();
+
+        XrTime start = 0;
+        while (nextEvent != m_events.end() || nextExpectation != m_expectations.end()) {
+            if (!renderLoop.IterateFrame()) {
+                break;
+            }
+            const XrTime displayTime = renderLoop.GetLastPredictedDisplayTime();
+            if (start == 0) {
+                start = displayTime;
+            }
+            const XrDuration elapsed = displayTime - start;
+
+            // Apply everything due by this frame before syncing once, so the runtime sees the changes together.
+            for (; nextEvent != m_events.end() && nextEvent->time <= elapsed; ++nextEvent) {
+                Apply(*nextEvent);
+            }
+            const XrResult syncResult = xrSyncActions(m_session, &syncInfo);
+            XRC_CHECK_THROW(XR_SUCCEEDED(syncResult));
+
+            for (; nextExpectation != m_expectations.end() && nextExpectation->time <= elapsed; ++nextExpectation) {
+                // Without focus every action is inactive, which is not what the timeline is testing.
+                std::string description = syncResult == XR_SESSION_NOT_FOCUSED ? "session not focused" : Check(*nextExpectation);
+                if (!description.empty()) {
+                    mismatches.push_back({nextExpectation->index, nextExpectation->time, std::move(description)});
+                }
+            }
+        }
+
+        for (; nextExpectation != m_expectations.end(); ++nextExpectation) {
+            mismatches.push_back({nextExpectation->index, nextExpectation->time, "not checked: render loop stopped"});
+        }
+        return mismatches;
+    }
+
+    InputTimeline& InputTimeline::AddEvent(const Event& event)
+    {
+        const auto after = [](const Event& a, const Event& b) { return a.time < b.time; };
+        m_events.insert(std::upper_bound(m_events.begin(), m_events.end(), event, after), event);
+        return *this;
+    }
+
+    InputTimeline& InputTimeline::AddExpectation(const Expectation& expectation)
+    {
+        const auto after = [](const Expectation& a, const Expectation& b) { return a.time < b.time; };
+        const auto position = std::upper_bound(m_expectations.begin(), m_expectations.end(), expectation, after);
+        m_expectations.insert(position, expectation)->index = m_expectations.size() - 1;
+        return *this;
+    }
+
+    void InputTimeline::Apply(const Event& event) const
+    {
+        switch (event.type) {
+        case EventType::Active:
+            XRC_CHECK_THROW_XRCMD(m_setInputDeviceActive(m_session, event.interactionProfile, event.topLevelPath,
+                                                         event.value.x != 0.f ? XR_TRUE : XR_FALSE));
+            break;
+        case EventType::Bool:
+            XRC_CHECK_THROW_XRCMD(m_setInputDeviceStateBool(m_session, event.topLevelPath, event.inputSourcePath,
+                                                            event.value.x != 0.f ? XR_TRUE : XR_FALSE));
+            break;
+        case EventType::Float:
+            XRC_CHECK_THROW_XRCMD(m_setInputDeviceStateFloat(m_session, event.topLevelPath, event.inputSourcePath, event.value.x));
+            break;
+        case EventType::Vector2f:
+            XRC_CHECK_THROW_XRCMD(m_setInputDeviceStateVector2f(m_session, event.topLevelPath, event.inputSourcePath, event.value));
+            break;
+        case EventType::Location:
+            XRC_CHECK_THROW_XRCMD(
+                m_setInputDeviceLocation(m_session, event.topLevelPath, event.inputSourcePath, event.space, event.pose));
+            break;
+        }
+    }
+
+    std::string InputTimeline::Check(const Expectation& expectation) const
+    {
+        XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+        getInfo.action = expectation.action;
+        getInfo.subactionPath = expectation.subactionPath;
+
+        XrBool32 isActive = XR_FALSE;
+        XrVector2f value{0.f, 0.f};
+        switch (expectation.actionType) {
+        case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+            XrActionStateBoolean state{XR_TYPE_ACTION_STATE_BOOLEAN};
+            XRC_CHECK_THROW_XRCMD(xrGetActionStateBoolean(m_session, &getInfo, &state));
+            isActive = state.isActive;
+            value.x = state.currentState ? 1.f : 0.f;
+            break;
+        }
+        case XR_ACTION_TYPE_FLOAT_INPUT: {
+            XrActionStateFloat state{XR_TYPE_ACTION_STATE_FLOAT};
+            XRC_CHECK_THROW_XRCMD(xrGetActionStateFloat(m_session, &getInfo, &state));
+            isActive = state.isActive;
+            value.x = state.currentState;
+            break;
+        }
+        case XR_ACTION_TYPE_VECTOR2F_INPUT: {
+            XrActionStateVector2f state{XR_TYPE_ACTION_STATE_VECTOR2F};
+            XRC_CHECK_THROW_XRCMD(xrGetActionStateVector2f(m_session, &getInfo, &state));
+            isActive = state.isActive;
+            value = state.currentState;
+            break;
+        }
+        case XR_ACTION_TYPE_POSE_INPUT: {
+            XrActionStatePose state{XR_TYPE_ACTION_STATE_POSE};
+            XRC_CHECK_THROW_XRCMD(xrGetActionStatePose(m_session, &getInfo, &state));
+            isActive = state.isActive;
+            break;
+        }
+        default:
+            XRC_THROW("InputTimeline cannot check actions of type " + std::to_string(expectation.actionType));
+        }
+
+        std::ostringstream oss;
+        if ((isActive != XR_FALSE) != expectation.isActive) {
+            oss << "expected isActive " << expectation.isActive << ", was " << (isActive != XR_FALSE);
+            return oss.str();
+        }
+        if (!expectation.isActive) {
+            return {};
+        }
+        if (std::fabs(value.x - expectation.value.x) > expectation.epsilon ||
+            std::fabs(value.y - expectation.value.y) > expectation.epsilon) {
+            oss << "expected state (" << expectation.value.x << ", " << expectation.value.y << "), was (" << value.x << ", "
+                << value.y << ")";
+            return oss.str();
+        }
+        return {};
+    }
+}  // namespace Conformance
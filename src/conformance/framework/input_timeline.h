@@ -0,0 +1,126 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    class RenderLoop;
+
+    /// An expectation of an InputTimeline that did not hold when it was checked.
+    struct InputTimelineMismatch
+    {
+        /// Index of the expectation, in the order they were added.
+        size_t expectation;
+        /// Time of the expectation from the start of the replay.
+        XrDuration time;
+        std::string description;
+    };
+
+    /// A script of input device changes through XR_EXT_conformance_automation and the action states they should cause,
+    /// replayed against the runtime in one pass.
+    ///
+    /// Events and expectations are timed from the start of the replay. Replay iterates frames and, after each
+    /// `xrWaitFrame`, applies every input event due by the predicted display time, calls `xrSyncActions` once, and checks
+    /// every expectation that is due, so an expectation sees the events at or before its time. Mismatches are collected
+    /// rather than failing on the first one, to verify many action states per run.
+    ///
+    /// This is an alternative to the IInputTestDevice pattern of setting one state, then iterating frames and syncing
+    /// actions until it shows, for new tests that only run with the extension. So far only xrSyncActions_timeline uses it.
+    /// The existing interactive tests, such as StateQueryFunctionsInteractive, keep using IInputTestDevice, since they also
+    /// run with a person operating real controllers, where input can not be scripted.
+    class InputTimeline
+    {
+    public:
+        /// Looks up the XR_EXT_conformance_automation functions, which must be enabled on @p instance.
+        InputTimeline(XrInstance instance, XrSession session);
+
+        /// Input events, applied with the `xrSetInputDevice*EXT` function of the same name.
+        ///@{
+        InputTimeline& SetDeviceActive(XrDuration time, XrPath interactionProfile, XrPath topLevelPath, bool isActive);
+        InputTimeline& SetBool(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, bool state);
+        InputTimeline& SetFloat(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, float state);
+        InputTimeline& SetVector2f(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, XrVector2f state);
+        InputTimeline& SetLocation(XrDuration time, XrPath topLevelPath, XrPath inputSourcePath, XrSpace space, XrPosef pose);
+        ///@}
+
+        /// Expectations that an action is active with the given current state.
+        ///@{
+        InputTimeline& ExpectBool(XrDuration time, XrAction action, bool state, XrPath subactionPath = XR_NULL_PATH);
+        InputTimeline& ExpectFloat(XrDuration time, XrAction action, float state, float epsilon,
+                                   XrPath subactionPath = XR_NULL_PATH);
+        InputTimeline& ExpectVector2f(XrDuration time, XrAction action, XrVector2f state, float epsilon,
+                                      XrPath subactionPath = XR_NULL_PATH);
+        ///@}
+
+        /// Expectation that an action of type @p actionType is inactive.
+        InputTimeline& ExpectInactive(XrDuration time, XrAction action, XrActionType actionType,
+                                      XrPath subactionPath = XR_NULL_PATH);
+
+        /// Time of the last event or expectation.
+        XrDuration GetDuration() const;
+
+        /// Replays the timeline, iterating frames with @p renderLoop and syncing the action sets in @p syncInfo.
+        /// The session should be focused. Throws if a runtime call fails.
+        /// Returns the expectations that did not hold, including any not checked because the render loop stopped.
+        std::vector<InputTimelineMismatch> Replay(RenderLoop& renderLoop, const XrActionsSyncInfo& syncInfo) const;
+
+    private:
+        enum class EventType
+        {
+            Active,
+            Bool,
+            Float,
+            Vector2f,
+            Location,
+        };
+
+        struct Event
+        {
+            XrDuration time;
+            EventType type;
+            XrPath interactionProfile;
+            XrPath topLevelPath;
+            XrPath inputSourcePath;
+            XrVector2f value;
+            XrSpace space;
+            XrPosef pose;
+        };
+
+        struct Expectation
+        {
+            size_t index;
+            XrDuration time;
+            XrAction action;
+            XrPath subactionPath;
+            XrActionType actionType;
+            bool isActive;
+            XrVector2f value;
+            float epsilon;
+        };
+
+        InputTimeline& AddEvent(const Event& event);
+        InputTimeline& AddExpectation(const Expectation& expectation);
+        void Apply(const Event& event) const;
+        /// Returns an empty string if @p expectation holds, or else what was found instead.
+        std::string Check(const Expectation& expectation) const;
+
+        XrSession m_session;
+        PFN_xrSetInputDeviceActiveEXT m_setInputDeviceActive;
+        PFN_xrSetInputDeviceStateBoolEXT m_setInputDeviceStateBool;
+        PFN_xrSetInputDeviceStateFloatEXT m_setInputDeviceStateFloat;
+        PFN_xrSetInputDeviceStateVector2fEXT m_setInputDeviceStateVector2f;
+        PFN_xrSetInputDeviceLocationEXT m_setInputDeviceLocation;
+
+        // Each sorted by time, keeping the order they were added in for the same time.
+        std::vector<Event> m_events;
+        std::vector<Expectation> m_expectations;
+    };
+}  // namespace Conformance
@@ -0,0 +1,134 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "instance_pool.h"
+
+#include "conformance_framework.h"
+#include "conformance_utils.h"
+#include "soak_monitor.h"
+
+#include <array>
+#include <cassert>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Child handles that a test case borrowing the pooled instance must destroy before returning it.
+        constexpr std::array<XrObjectType, 6> PooledChildHandleTypes{
+            {XR_OBJECT_TYPE_SESSION, XR_OBJECT_TYPE_SPACE, XR_OBJECT_TYPE_SWAPCHAIN, XR_OBJECT_TYPE_ACTION_SET,
+             XR_OBJECT_TYPE_ACTION, XR_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT}};
+    }  // namespace
+
+    constexpr const char* InstancePool::TagName;
+
+    void InstancePool::BeginTestCase(bool pooled)
+    {
+        if (!pooled) {
+            Clear();
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_testCasePooled = pooled;
+    }
+
+    void InstancePool::EndTestCase()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_testCasePooled = false;
+    }
+
+    bool InstancePool::TryBorrow(XrInstance* instance, XrResult* createResult)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_testCasePooled || m_lent) {
+            return false;
+        }
+
+        if (m_instance != XR_NULL_HANDLE) {
+            m_statistics.reused++;
+            *createResult = XR_SUCCESS;
+        }
+        else {
+            *createResult = CreateBasicInstance(&m_instance);
+            if (XR_FAILED(*createResult)) {
+                m_instance = XR_NULL_HANDLE;
+                *instance = XR_NULL_HANDLE;
+                return true;
+            }
+            m_statistics.created++;
+
+            // The pooled instance outlives many test cases, so it is worth converting every path they might bind up front.
+            PathCache& pathCache = GetGlobalData().pathCache;
+            pathCache.AddInstance(m_instance);
+            pathCache.PreInternInteractionProfilePaths(m_instance);
+        }
+
+        m_lent = true;
+        *instance = m_instance;
+        return true;
+    }
+
+    void InstancePool::Return(XrInstance instance)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        assert(m_lent && instance == m_instance);
+        m_lent = false;
+
+        bool destroy = false;
+        if (!IsClean(instance, destroy)) {
+            GetGlobalData().pathCache.RemoveInstance(instance);
+            if (destroy) {
+                xrDestroyInstance(instance);
+            }
+            m_instance = XR_NULL_HANDLE;
+            m_statistics.discarded++;
+        }
+    }
+
+    void InstancePool::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_instance != XR_NULL_HANDLE && !m_lent) {
+            GetGlobalData().pathCache.RemoveInstance(m_instance);
+            xrDestroyInstance(m_instance);
+            m_instance = XR_NULL_HANDLE;
+        }
+    }
+
+    InstancePoolStatistics InstancePool::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_statistics;
+    }
+
+    bool InstancePool::IsClean(XrInstance instance, bool& destroy)
+    {
+        // Events left over from the previous test case, such as state changes of its destroyed sessions,
+        // must not reach the next one.
+        XrResult result;
+        do {
+            XrEventDataBuffer eventData{XR_TYPE_EVENT_DATA_BUFFER};
+            result = xrPollEvent(instance, &eventData);
+        } while (result == XR_SUCCESS);
+
+        if (result != XR_EVENT_UNAVAILABLE) {
+            // The test case destroyed the instance itself, or it was lost.
+            destroy = (result != XR_ERROR_HANDLE_INVALID);
+            return false;
+        }
+
+        destroy = true;
+        XrHandleCounter handleCounter(instance);
+        if (!handleCounter.IsAvailable()) {
+            // Without the conformance layer, leftover child handles can not be ruled out.
+            return false;
+        }
+        for (XrObjectType objectType : PooledChildHandleTypes) {
+            if (handleCounter.Count(objectType) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+}  // namespace Conformance
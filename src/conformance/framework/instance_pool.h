@@ -0,0 +1,71 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <mutex>
+#include <stdint.h>
+
+namespace Conformance
+{
+    /// Counts of what an InstancePool did over a run.
+    struct InstancePoolStatistics
+    {
+        /// Instances created by the pool.
+        uint32_t created{0};
+        /// Borrows served by an instance that an earlier test case created.
+        uint32_t reused{0};
+        /// Instances destroyed on return because they were not left in a clean state.
+        uint32_t discarded{0};
+    };
+
+    /// Keeps one plain instance alive across consecutive test cases tagged [pooled_instance], so that they skip
+    /// xrCreateInstance and xrDestroyInstance. Used only when the instancePool option is set.
+    ///
+    /// AutoBasicInstance and AutoBasicSession borrow the pooled instance instead of creating one when the current test case
+    /// is tagged. On return the pool discards any pending events and checks with the conformance layer that no child handles
+    /// remain. An instance that is not clean, or that can not be checked because the layer is not enabled, is destroyed,
+    /// so the next borrow creates a fresh one.
+    /// The pooled instance is also destroyed when a test case without the tag starts, since a runtime may support only
+    /// one instance at a time.
+    class InstancePool
+    {
+    public:
+        /// Name of the tag, without brackets, that opts a test case into the pool.
+        static constexpr const char* TagName = "pooled_instance";
+
+        /// Called as each test case starts. @p pooled is whether the test case may borrow the pooled instance.
+        void BeginTestCase(bool pooled);
+
+        /// Called as each test case ends.
+        void EndTestCase();
+
+        /// Returns false if the current test case does not use the pool or the pooled instance is already lent out,
+        /// in which case the caller creates its own instance as usual.
+        /// Otherwise sets @p instance to the pooled instance, creating it if needed, and @p createResult to the result
+        /// of creating it (XR_SUCCESS when reused). @p instance is XR_NULL_HANDLE if creating it failed.
+        bool TryBorrow(XrInstance* instance, XrResult* createResult);
+
+        /// Takes back the instance from TryBorrow, keeping it for the next borrow if it is clean.
+        void Return(XrInstance instance);
+
+        /// Destroys the pooled instance if it is not lent out.
+        void Clear();
+
+        InstancePoolStatistics GetStatistics() const;
+
+    private:
+        /// Polls away pending events and checks for leftover child handles, which needs the conformance layer.
+        /// Returns false if @p instance cannot be reused, and sets @p destroy to whether it still needs to be destroyed.
+        static bool IsClean(XrInstance instance, bool& destroy);
+
+        mutable std::mutex m_mutex;
+        bool m_testCasePooled{false};
+        bool m_lent{false};
+        XrInstance m_instance{XR_NULL_HANDLE};
+        InstancePoolStatistics m_statistics;
+    };
+}  // namespace Conformance
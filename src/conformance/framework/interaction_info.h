@@ -6,8 +6,16 @@
 
 #include "interaction_info_generated.h"
 
+#include <nonstd/span.hpp>
+
+#include <array>
+#include <bitset>
+#include <stdint.h>
+
 namespace Conformance
 {
+    using nonstd::span;
+
     struct InputSourcePathAvailData
     {
         const char* Path;
@@ -15,7 +23,7 @@ namespace Conformance
         InteractionProfileAvailability Availability;
         bool systemOnly = false;
     };
-    using InputSourcePathAvailCollection = std::initializer_list<InputSourcePathAvailData>;
+    using InputSourcePathAvailCollection = span<const InputSourcePathAvailData>;
 
     struct InteractionProfileAvailMetadata
     {
@@ -25,15 +33,59 @@ namespace Conformance
         const char* InteractionProfileShortname;
 
         /// Top level user paths
-        std::vector<const char*> TopLevelPaths;
+        span<const char* const> TopLevelPaths;
 
         /// Index into @ref kInteractionAvailabilities
         InteractionProfileAvailability Availability;
         InputSourcePathAvailCollection InputSourcePaths;
     };
 
-    /// Get the generated list of all interaction profiles with availability and other metadata
-    const std::vector<InteractionProfileAvailMetadata>& GetAllInteractionProfiles();
+    /// Get the generated list of all interaction profiles with availability and other metadata.
+    /// The tables are compile-time constants, so this is safe to use during static initialization.
+    span<const InteractionProfileAvailMetadata> GetAllInteractionProfiles();
+
+    /// Get the interaction profile with path @p interactionProfilePath (starting with `/interaction_profiles/`),
+    /// or nullptr if there is none. Uses a generated perfect hash, so costs one pass over the string and no searching.
+    const InteractionProfileAvailMetadata* FindInteractionProfile(const char* interactionProfilePath);
+
+    /// Get the input or output source of @p profile with the full binding path @p bindingPath
+    /// (such as `/user/hand/left/input/select/click`), or nullptr if the profile has no such binding path.
+    /// Uses a generated perfect hash, like FindInteractionProfile.
+    const InputSourcePathAvailData* FindInputSourcePath(InteractionProfileIndex profile, const char* bindingPath);
+
+    /// Which interaction profiles and input sources are available with a set of features (core versions and extensions).
+    ///
+    /// Evaluates every generated availability expression at once, as masks over the few features they use, which
+    /// are precomputed by the generator. Construct one for a set of features and query it for each profile and binding,
+    /// rather than calling Availability::IsSatisfiedBy each time.
+    class InteractionAvailabilityMask
+    {
+    public:
+        explicit InteractionAvailabilityMask(const FeatureSet& features);
+
+        bool IsSatisfied(InteractionProfileAvailability availability) const
+        {
+            return m_satisfied[(size_t)availability];
+        }
+
+        bool IsAvailable(const InteractionProfileAvailMetadata& profile) const
+        {
+            return IsSatisfied(profile.Availability);
+        }
+
+        bool IsAvailable(const InputSourcePathAvailData& inputSource) const
+        {
+            return IsSatisfied(inputSource.Availability);
+        }
+
+        /// Whether each input source of @p profile is available (nonzero) or not, in the order of its InputSourcePaths.
+        span<const uint8_t> GetInputSourceAvailability(const InteractionProfileAvailMetadata& profile) const;
+
+    private:
+        std::bitset<kInteractionAvailabilities.size()> m_satisfied;
+        std::array<uint8_t, kInputSourcePathCount> m_inputSources;
+    };
+
     inline const InteractionProfileAvailMetadata& GetInteractionProfile(InteractionProfileIndex profile)
     {
         return GetAllInteractionProfiles()[(size_t)profile];
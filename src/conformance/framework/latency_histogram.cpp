@@ -0,0 +1,60 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Conformance
+{
+    constexpr size_t LatencyHistogram::BucketCount;
+
+    void LatencyHistogram::Merge(const LatencyHistogram& other)
+    {
+        for (size_t i = 0; i < BucketCount; ++i) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_count += other.m_count;
+        m_total += other.m_total;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::GetPercentile(double percent) const
+    {
+        if (m_count == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const uint64_t rank = std::max<uint64_t>((uint64_t)std::ceil(percent / 100.0 * (double)m_count), 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BucketCount; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                return std::min(GetBucketUpperBound(i), std::chrono::nanoseconds((int64_t)m_max));
+            }
+        }
+        return std::chrono::nanoseconds((int64_t)m_max);
+    }
+
+    DurationPercentiles LatencyHistogram::GetPercentiles() const
+    {
+        DurationPercentiles percentiles;
+        percentiles.p50 = GetPercentile(50);
+        percentiles.p95 = GetPercentile(95);
+        percentiles.p99 = GetPercentile(99);
+        percentiles.max = std::chrono::nanoseconds((int64_t)m_max);
+        return percentiles;
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::GetBucketUpperBound(size_t index)
+    {
+        if (index < 8) {
+            return std::chrono::nanoseconds((int64_t)index);
+        }
+        const size_t exponent = index / 8 + 2;
+        const uint64_t lower = (uint64_t)(8 + index % 8) << (exponent - 3);
+        const uint64_t upper = lower + ((uint64_t)1 << (exponent - 3)) - 1;
+        return std::chrono::nanoseconds((int64_t)std::min<uint64_t>(upper, (uint64_t)INT64_MAX));
+    }
+}  // namespace Conformance
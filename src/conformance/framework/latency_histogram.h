@@ -0,0 +1,85 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "frame_pacing.h"
+
+#include <array>
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Conformance
+{
+    /// Counts latencies in logarithmic buckets of fixed memory, so that any number of them can be added from a hot loop
+    /// without allocating. Each power of two is split into 8 buckets, so percentiles are within 1/8 of the true value.
+    class LatencyHistogram
+    {
+    public:
+        /// Number of buckets: 8 exact ones below 8ns, then 8 for each power of two up to 2^63ns.
+        static constexpr size_t BucketCount = 8 * 62;
+
+        void Add(std::chrono::nanoseconds latency)
+        {
+            const uint64_t value = latency.count() > 0 ? (uint64_t)latency.count() : 0;
+            m_buckets[BucketIndex(value)]++;
+            m_count++;
+            m_total += value;
+            if (value > m_max) {
+                m_max = value;
+            }
+        }
+
+        /// Adds the latencies counted by @p other, for instance to combine the histograms of several threads.
+        void Merge(const LatencyHistogram& other);
+
+        uint64_t GetCount() const
+        {
+            return m_count;
+        }
+
+        /// Sum of all latencies added.
+        std::chrono::nanoseconds GetTotal() const
+        {
+            return std::chrono::nanoseconds((int64_t)m_total);
+        }
+
+        /// The largest latency of the nearest-rank @p percent percentile's bucket, or 0 when empty.
+        /// Never more than the largest latency added.
+        std::chrono::nanoseconds GetPercentile(double percent) const;
+
+        /// 50th, 95th and 99th percentile and the largest latency added.
+        DurationPercentiles GetPercentiles() const;
+
+        /// Number of latencies in bucket @p index.
+        uint64_t GetBucketCount(size_t index) const
+        {
+            return m_buckets[index];
+        }
+
+        /// The largest latency that falls into bucket @p index.
+        static std::chrono::nanoseconds GetBucketUpperBound(size_t index);
+
+        static size_t BucketIndex(uint64_t nanoseconds)
+        {
+            if (nanoseconds < 8) {
+                return (size_t)nanoseconds;
+            }
+            size_t exponent = 3;
+            while ((nanoseconds >> (exponent + 1)) != 0) {
+                ++exponent;
+            }
+            // The three bits after the leading one pick the bucket within the power of two.
+            const size_t subBucket = (size_t)(nanoseconds >> (exponent - 3)) & 7;
+            return (exponent - 2) * 8 + subBucket;
+        }
+
+    private:
+        std::array<uint64_t, BucketCount> m_buckets{};
+        uint64_t m_count{0};
+        uint64_t m_total{0};
+        uint64_t m_max{0};
+    };
+}  // namespace Conformance
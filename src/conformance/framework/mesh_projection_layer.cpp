@@ -42,7 +42,7 @@ namespace
         }
 
         ~MeshViewRenderer() override = default;
-        void RenderView(const BaseProjectionLayerHelper& /* projectionLayerHelper */, uint32_t viewIndex,
+        void RenderView(const BaseProjectionLayerHelper& projectionLayerHelper, uint32_t viewIndex,
                         const XrViewState& /* viewState */, const XrView& view, XrCompositionLayerProjectionView& projectionView,
                         const XrSwapchainImageBaseHeader* swapchainImage) override
         {
@@ -51,7 +51,8 @@ namespace
 
             // Draw the mesh
             auto meshHandles = {MeshDrawable(m_meshes[viewIndex], view.pose, {1.0, 1.0, 1.0})};
-            GetGlobalData().graphicsPlugin->RenderView(projectionView, swapchainImage, RenderParams{}.Draw(meshHandles));
+            GetGlobalData().graphicsPlugin->RenderView(projectionView, swapchainImage,
+                                                       projectionLayerHelper.WithCulling(RenderParams{}.Draw(meshHandles)));
         }
 
     private:
@@ -0,0 +1,140 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "path_cache.h"
+
+#include "interaction_info.h"
+
+#include <set>
+#include <vector>
+
+namespace Conformance
+{
+    namespace
+    {
+        /// Every distinct path string in the generated interaction profile tables.
+        const std::vector<std::string>& GetInteractionProfilePathStrings()
+        {
+            static const std::vector<std::string> pathStrings = [] {
+                std::set<std::string> unique;
+                for (const InteractionProfileAvailMetadata& profile : GetAllInteractionProfiles()) {
+                    unique.insert(profile.InteractionProfilePathString);
+                    unique.insert(profile.TopLevelPaths.begin(), profile.TopLevelPaths.end());
+                    for (const InputSourcePathAvailData& source : profile.InputSourcePaths) {
+                        unique.insert(source.Path);
+                    }
+                }
+                return std::vector<std::string>(unique.begin(), unique.end());
+            }();
+            return pathStrings;
+        }
+    }  // namespace
+
+    void PathCache::AddInstance(XrInstance instance)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_instances[instance].owners++;
+    }
+
+    void PathCache::RemoveInstance(XrInstance instance)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_instances.find(instance);
+        if (it != m_instances.end() && --it->second.owners == 0) {
+            m_instances.erase(it);
+        }
+    }
+
+    XrResult PathCache::StringToPath(XrInstance instance, const std::string& pathString, XrPath* path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto instanceIt = m_instances.find(instance);
+            if (instanceIt != m_instances.end()) {
+                auto pathIt = instanceIt->second.paths.find(pathString);
+                if (pathIt != instanceIt->second.paths.end()) {
+                    m_statistics.savedCalls++;
+                    *path = pathIt->second;
+                    return XR_SUCCESS;
+                }
+            }
+            m_statistics.runtimeCalls++;
+        }
+
+        // Not under the lock, so other threads are not held up by the runtime.
+        XrResult result = xrStringToPath(instance, pathString.c_str(), path);
+        if (result == XR_SUCCESS) {
+            Insert(instance, pathString, *path);
+        }
+        return result;
+    }
+
+    bool PathCache::PathToString(XrInstance instance, XrPath path, std::string* pathString)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto instanceIt = m_instances.find(instance);
+            if (instanceIt != m_instances.end()) {
+                auto stringIt = instanceIt->second.strings.find(path);
+                if (stringIt != instanceIt->second.strings.end()) {
+                    // Both calls of the two-call idiom.
+                    m_statistics.savedCalls += 2;
+                    *pathString = stringIt->second;
+                    return true;
+                }
+            }
+            m_statistics.runtimeCalls++;
+        }
+
+        uint32_t count = 0;
+        if (XR_FAILED(xrPathToString(instance, path, 0, &count, nullptr))) {
+            return false;
+        }
+        std::vector<char> buffer(count);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_statistics.runtimeCalls++;
+        }
+        if (XR_FAILED(xrPathToString(instance, path, count, &count, buffer.data()))) {
+            return false;
+        }
+        *pathString = buffer.data();
+        Insert(instance, *pathString, path);
+        return true;
+    }
+
+    void PathCache::PreInternInteractionProfilePaths(XrInstance instance)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_instances.find(instance) == m_instances.end()) {
+                return;
+            }
+        }
+        for (const std::string& pathString : GetInteractionProfilePathStrings()) {
+            XrPath path;
+            if (StringToPath(instance, pathString, &path) == XR_ERROR_PATH_COUNT_EXCEEDED) {
+                // The runtime has no room for more. The rest are converted as the tests ask for them.
+                break;
+            }
+        }
+    }
+
+    PathCacheStatistics PathCache::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_statistics;
+    }
+
+    void PathCache::Insert(XrInstance instance, const std::string& pathString, XrPath path)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto instanceIt = m_instances.find(instance);
+        if (instanceIt == m_instances.end()) {
+            return;
+        }
+        instanceIt->second.paths.emplace(pathString, path);
+        instanceIt->second.strings.emplace(path, pathString);
+    }
+}  // namespace Conformance
@@ -0,0 +1,71 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+namespace Conformance
+{
+    /// Counts of what a PathCache did over a run.
+    struct PathCacheStatistics
+    {
+        /// Calls to xrStringToPath and xrPathToString made on behalf of StringToPath and PathToString.
+        uint64_t runtimeCalls{0};
+        /// Calls to xrStringToPath and xrPathToString avoided by answering from the cache.
+        uint64_t savedCalls{0};
+    };
+
+    /// Remembers the paths converted by the StringToPath and PathToString helpers, in both directions, so each path
+    /// string of an instance goes to the runtime once. Tests of xrStringToPath and xrPathToString themselves call the
+    /// runtime directly and are unaffected.
+    ///
+    /// Paths are only valid for the instance they came from, and a new instance may reuse the handle value of a destroyed
+    /// one, so only instances whose lifetime the framework tracks are cached: AddInstance when one is created, and
+    /// RemoveInstance before it is destroyed. AutoBasicInstance and InstancePool do this. Other instances are passed
+    /// straight through to the runtime.
+    class PathCache
+    {
+    public:
+        /// Starts caching paths for @p instance. Calls are counted, so an instance shared by several owners is cached
+        /// until each of them has called RemoveInstance.
+        void AddInstance(XrInstance instance);
+
+        /// Stops caching paths for @p instance, forgetting them. Must be called before the instance is destroyed.
+        void RemoveInstance(XrInstance instance);
+
+        /// xrStringToPath, answered from the cache if possible.
+        XrResult StringToPath(XrInstance instance, const std::string& pathString, XrPath* path);
+
+        /// xrPathToString, answered from the cache if possible. Returns false if the runtime does not know @p path.
+        bool PathToString(XrInstance instance, XrPath path, std::string* pathString);
+
+        /// Converts every path in the generated interaction profile tables (the profiles, their top level user paths
+        /// and their input and output sources) for a cached @p instance in one go. Worth it for a long-lived instance,
+        /// such as the pooled one, that many test cases bind actions with.
+        void PreInternInteractionProfilePaths(XrInstance instance);
+
+        PathCacheStatistics GetStatistics() const;
+
+    private:
+        struct InstancePaths
+        {
+            uint32_t owners{0};
+            std::unordered_map<std::string, XrPath> paths;
+            std::unordered_map<XrPath, std::string> strings;
+        };
+
+        /// Records a converted path, if @p instance is still cached.
+        void Insert(XrInstance instance, const std::string& pathString, XrPath path);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<XrInstance, InstancePaths> m_instances;
+        PathCacheStatistics m_statistics;
+    };
+}  // namespace Conformance
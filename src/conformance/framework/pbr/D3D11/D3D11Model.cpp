@@ -86,8 +86,15 @@ namespace Pbr
         if (ResolvedTransformsNeedUpdate()) {
             ResolveTransformsAndVisibilities(true);
 
-            // Update node transform structured buffer.
-            context->UpdateSubresource(m_modelTransformsStructuredBuffer.Get(), 0, nullptr, GetResolvedTransforms().data(), 0, 0);
+            // Update the part of the node transform structured buffer that changed.
+            const NodeIndexRange range = GetUpdatedTransformRange();
+            if (!range.empty()) {
+                const UINT left = (UINT)(sizeof(XrMatrix4x4f) * range.begin);
+                const UINT right = (UINT)(sizeof(XrMatrix4x4f) * range.end);
+                const D3D11_BOX box{left, 0, 0, right, 1, 1};
+                const XrMatrix4x4f* data = &GetResolvedTransforms()[range.begin];
+                context->UpdateSubresource(m_modelTransformsStructuredBuffer.Get(), 0, &box, data, 0, 0);
+            }
             MarkResolvedTransformsUpdated();
         }
     }
@@ -100,13 +100,17 @@ namespace Pbr
         if (ResolvedTransformsNeedUpdate()) {
             ResolveTransformsAndVisibilities(true);
 
-            // Update node transform structured buffer.
-            auto& resolvedTransforms = GetResolvedTransforms();
-            m_modelTransformsStructuredBuffer.AsyncUpload(directCommandList, resolvedTransforms.data(), resolvedTransforms.size());
-            auto barrier =
-                CD3DX12_RESOURCE_BARRIER::Transition(m_modelTransformsStructuredBuffer.GetResource(), D3D12_RESOURCE_STATE_COPY_DEST,
-                                                     D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-            directCommandList->ResourceBarrier(1, &barrier);
+            // Update the part of the node transform structured buffer that changed.
+            const NodeIndexRange range = GetUpdatedTransformRange();
+            if (!range.empty()) {
+                auto& resolvedTransforms = GetResolvedTransforms();
+                m_modelTransformsStructuredBuffer.AsyncUploadRange(directCommandList, &resolvedTransforms[range.begin], range.begin,
+                                                                   range.size());
+                auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(m_modelTransformsStructuredBuffer.GetResource(),
+                                                                    D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                    D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                directCommandList->ResourceBarrier(1, &barrier);
+            }
             MarkResolvedTransformsUpdated();
         }
     }
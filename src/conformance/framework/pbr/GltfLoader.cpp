@@ -194,7 +194,7 @@ namespace Gltf
             const Pbr::PrimitiveBuilder& primitiveBuilder = primitiveBuilderPair.second;
             const std::shared_ptr<Pbr::Material>& material = materialMap.find(primitiveBuilderPair.first)->second;
             auto handle = gltfBuilder.MakePrimitive(primitiveBuilder, material);
-            m_pbrModel->AddPrimitive(handle);
+            m_pbrModel->AddPrimitive(handle, primitiveBuilder);
         }
 
         gltfBuilder.DropLoaderCaches();
@@ -72,10 +72,15 @@ namespace Pbr
         if (ResolvedTransformsNeedUpdate()) {
             ResolveTransformsAndVisibilities(false);
 
-            // Update node transform structured buffer.
-            memcpy(m_modelTransformsStructuredBuffer->contents(), GetResolvedTransforms().data(),
-                   m_modelTransformsStructuredBuffer->length());
-            m_modelTransformsStructuredBuffer->didModifyRange(NS::Range(0, m_modelTransformsStructuredBuffer->length()));
+            // Update the part of the node transform structured buffer that changed.
+            const NodeIndexRange range = GetUpdatedTransformRange();
+            if (!range.empty()) {
+                const size_t offset = sizeof(XrMatrix4x4f) * range.begin;
+                const size_t length = sizeof(XrMatrix4x4f) * range.size();
+                uint8_t* contents = static_cast<uint8_t*>(m_modelTransformsStructuredBuffer->contents());
+                memcpy(contents + offset, &GetResolvedTransforms()[range.begin], length);
+                m_modelTransformsStructuredBuffer->didModifyRange(NS::Range(offset, length));
+            }
 
             MarkResolvedTransformsUpdated();
         }
@@ -82,11 +82,14 @@ namespace Pbr
         if (ResolvedTransformsNeedUpdate()) {
             ResolveTransformsAndVisibilities(false);
 
-            // Update node transform structured buffer.
-            auto& resolvedTransforms = GetResolvedTransforms();
-            XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_modelTransformsStructuredBuffer.get()));
-            XRC_CHECK_THROW_GLCMD(
-                glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(XrMatrix4x4f) * resolvedTransforms.size(), resolvedTransforms.data()));
+            // Update the part of the node transform structured buffer that changed.
+            const NodeIndexRange range = GetUpdatedTransformRange();
+            if (!range.empty()) {
+                auto& resolvedTransforms = GetResolvedTransforms();
+                XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_modelTransformsStructuredBuffer.get()));
+                XRC_CHECK_THROW_GLCMD(glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(XrMatrix4x4f) * range.begin,
+                                                      sizeof(XrMatrix4x4f) * range.size(), &resolvedTransforms[range.begin]));
+            }
             MarkResolvedTransformsUpdated();
         }
     }
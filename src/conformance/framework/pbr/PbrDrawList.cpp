@@ -0,0 +1,56 @@
+// Copyright 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PbrDrawList.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Pbr
+{
+    DrawListStats CountBinds(span<const DrawItem> items)
+    {
+        DrawListStats stats;
+        const DrawItem* previous = nullptr;
+        for (const DrawItem& item : items) {
+            stats.draws++;
+            if (previous == nullptr || previous->pipelineKey != item.pipelineKey) {
+                stats.pipelineBinds++;
+            }
+            if (previous == nullptr || previous->material != item.material || previous->instance != item.instance) {
+                stats.materialBinds++;
+            }
+            if (previous == nullptr || previous->mesh != item.mesh) {
+                stats.meshBinds++;
+            }
+            previous = &item;
+        }
+        return stats;
+    }
+
+    void DrawList::Sort()
+    {
+        // std::less gives a total order on pointers, unlike the built-in operator<.
+        const std::less<const void*> less;
+        std::stable_sort(m_items.begin(), m_items.end(), [&](const DrawItem& a, const DrawItem& b) {
+            if (a.alphaBlended != b.alphaBlended) {
+                return !a.alphaBlended;
+            }
+            if (a.alphaBlended) {
+                // Keep blended draws in submission order.
+                return false;
+            }
+            if (a.pipelineKey != b.pipelineKey) {
+                return a.pipelineKey < b.pipelineKey;
+            }
+            if (a.material != b.material) {
+                return less(a.material, b.material);
+            }
+            if (a.mesh != b.mesh) {
+                return less(a.mesh, b.mesh);
+            }
+            return less(a.instance, b.instance);
+        });
+    }
+}  // namespace Pbr
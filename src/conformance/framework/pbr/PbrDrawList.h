@@ -0,0 +1,87 @@
+// Copyright 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <nonstd/span.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+namespace Pbr
+{
+    using nonstd::span;
+
+    /// One primitive of one model instance, as gathered into a DrawList.
+    struct DrawItem
+    {
+        /// Identifies the pipeline state (blend state, culling, fill mode, ...) needed to draw the primitive.
+        uint32_t pipelineKey;
+
+        /// Alpha-blended primitives are drawn after all opaque primitives, in the order they were added.
+        bool alphaBlended;
+
+        /// Identifies the material bindings, or null if the backend binds them for every draw anyway.
+        /// Only compared, never dereferenced.
+        const void* material;
+
+        /// Identifies the vertex and index buffers. Only compared, never dereferenced.
+        const void* mesh;
+
+        /// Identifies the model instance, whose constants and transforms are bound along with the material.
+        /// Only compared, never dereferenced.
+        const void* instance;
+
+        /// For use by the backend, typically an index into its own per-draw data.
+        uint32_t userIndex;
+    };
+
+    /// Number of state changes needed to submit a list of draws.
+    struct DrawListStats
+    {
+        uint32_t draws{0};
+        uint32_t pipelineBinds{0};
+        uint32_t materialBinds{0};
+        uint32_t meshBinds{0};
+
+        /// Binds avoided compared to binding every kind of state for every draw,
+        /// as rendering each model instance separately does.
+        uint32_t BindsSaved() const
+        {
+            return 3 * draws - (pipelineBinds + materialBinds + meshBinds);
+        }
+    };
+
+    /// Count the binds needed to submit @p items in order, binding each kind of state only when it changes.
+    /// Material bindings include the instance bindings, so they change when either does.
+    DrawListStats CountBinds(span<const DrawItem> items);
+
+    /// Primitives gathered from all the model instances drawn in a view, so they can be submitted
+    /// grouped by pipeline state, material and mesh rather than one model instance at a time.
+    class DrawList
+    {
+    public:
+        void Clear()
+        {
+            m_items.clear();
+        }
+
+        void Add(const DrawItem& item)
+        {
+            m_items.push_back(item);
+        }
+
+        /// Order opaque draws by pipeline, material, mesh and then instance, followed by the alpha-blended
+        /// draws in the order they were added (so blending results do not change).
+        void Sort();
+
+        const std::vector<DrawItem>& GetItems() const
+        {
+            return m_items;
+        }
+
+    private:
+        std::vector<DrawItem> m_items;
+    };
+}  // namespace Pbr
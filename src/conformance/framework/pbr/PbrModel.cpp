@@ -10,7 +10,10 @@
 #include "PbrCommon.h"
 
 #include "common/xr_linear.h"
+#include "utilities/xr_linear_batch.h"
 
+#include <algorithm>
+#include <cassert>
 #include <stdexcept>
 
 namespace Pbr
@@ -46,9 +49,33 @@ namespace Pbr
         return false;
     }
 
-    void Model::AddPrimitive(PrimitiveHandle primitive)
+    void Model::AddPrimitive(PrimitiveHandle primitive, const PrimitiveBuilder& primitiveBuilder)
     {
         m_primitiveHandles.push_back(primitive);
+
+        // Slot of each node in the bounded node arrays, if it has one yet.
+        constexpr size_t noSlot = (size_t)-1;
+        std::vector<size_t> slots(m_nodes.size(), noSlot);
+        for (size_t slot = 0; slot < m_boundedNodes.size(); ++slot) {
+            slots[m_boundedNodes[slot]] = slot;
+        }
+
+        for (const Vertex& vertex : primitiveBuilder.Vertices) {
+            const NodeIndex_t nodeIndex = vertex.ModelTransformIndex;
+            if (nodeIndex >= m_nodes.size()) {
+                throw std::out_of_range("Vertex references a node that is not in the model");
+            }
+            size_t& slot = slots[nodeIndex];
+            if (slot == noSlot) {
+                slot = m_boundedNodes.size();
+                m_boundedNodes.push_back(nodeIndex);
+                m_boundedNodeMins.push_back(vertex.Position);
+                m_boundedNodeMaxs.push_back(vertex.Position);
+                continue;
+            }
+            XrVector3f_Min(&m_boundedNodeMins[slot], &m_boundedNodeMins[slot], &vertex.Position);
+            XrVector3f_Max(&m_boundedNodeMaxs[slot], &m_boundedNodeMaxs[slot], &vertex.Position);
+        }
     }
 
     Node::Node(Node&& other) noexcept
@@ -69,4 +96,132 @@ namespace Pbr
         return *this;
     }
 
+    void ModelInstance::ResolveTransformsAndVisibilities(bool transpose)
+    {
+        const auto& nodes = m_model->GetNodes();
+        const auto nodeCount = (NodeIndex_t)nodes.size();
+        assert(nodes.size() == m_nodeLocalTransforms.size());
+        assert(nodes.size() == m_resolvedTransforms.size());
+
+        if (transpose != m_transposed) {
+            // Everything resolved so far is in the other layout.
+            m_transposed = transpose;
+            std::fill(m_nodeNeedsResolve.begin(), m_nodeNeedsResolve.end(), true);
+            m_firstNodeNeedingResolve = 0;
+        }
+        if (m_firstNodeNeedingResolve >= nodeCount) {
+            return;
+        }
+
+        // Nodes are guaranteed to come after their parents, so each node transform can be multiplied by its parent transform in a single pass.
+        // A node needs resolving if it changed or its parent was resolved in this pass,
+        // so flag nodes as we go, starting from the first changed one.
+        constexpr XrMatrix4x4f identityMatrix = Matrix::Identity;
+        NodeIndex_t firstResolved = nodeCount;
+        NodeIndex_t lastResolved = 0;
+        for (NodeIndex_t nodeIndex = m_firstNodeNeedingResolve; nodeIndex < nodeCount; ++nodeIndex) {
+            const Node& node = nodes[nodeIndex];
+            const NodeIndex_t parentIndex = node.GetParentNodeIndex();
+            bool parentIsRoot = parentIndex == Model::RootParentNodeIndex;
+            assert(parentIsRoot || parentIndex < nodeIndex);
+
+            if (!m_nodeNeedsResolve[nodeIndex]) {
+                if (parentIsRoot || !m_nodeNeedsResolve[parentIndex]) {
+                    continue;
+                }
+                m_nodeNeedsResolve[nodeIndex] = true;
+            }
+
+            bool parentVisibility = (parentIsRoot) ? true : m_resolvedVisibilities[parentIndex];
+            NodeVisibility nodeVisibility = m_nodeLocalVisibilities[nodeIndex];
+            const bool visible =
+                nodeVisibility == NodeVisibility::Inherit ? parentVisibility : nodeVisibility == NodeVisibility::Visible;
+            m_resolvedVisibilities[nodeIndex] = visible;
+
+            const XrMatrix4x4f& parentTransform = (parentIsRoot) ? identityMatrix : m_unmaskedTransforms[parentIndex];
+            const XrMatrix4x4f& nodeTransform = m_nodeLocalTransforms[nodeIndex];
+            XrMatrix4x4f& unmaskedTransform = m_unmaskedTransforms[nodeIndex];
+            if (transpose) {
+                XrMatrix4x4f nodeTransformTranspose = Matrix::Transposed(nodeTransform);
+                unmaskedTransform = nodeTransformTranspose * parentTransform;
+            }
+            else {
+                unmaskedTransform = parentTransform * nodeTransform;
+            }
+
+            // Invisible nodes have their transforms zeroed, but their children still see the real transform above.
+            if (visible) {
+                m_resolvedTransforms[nodeIndex] = unmaskedTransform;
+            }
+            else {
+                XrMatrix4x4f_CreateScale(&m_resolvedTransforms[nodeIndex], 0, 0, 0);
+            }
+
+            firstResolved = std::min(firstResolved, nodeIndex);
+            lastResolved = nodeIndex;
+        }
+
+        std::fill(m_nodeNeedsResolve.begin() + m_firstNodeNeedingResolve, m_nodeNeedsResolve.end(), false);
+        m_firstNodeNeedingResolve = nodeCount;
+
+        if (firstResolved <= lastResolved) {
+            if (m_updatedTransforms.empty()) {
+                m_updatedTransforms = {firstResolved, (NodeIndex_t)(lastResolved + 1)};
+            }
+            else {
+                m_updatedTransforms.begin = std::min(m_updatedTransforms.begin, firstResolved);
+                m_updatedTransforms.end = std::max(m_updatedTransforms.end, (NodeIndex_t)(lastResolved + 1));
+            }
+        }
+    }
+
+    bool ModelInstance::GetBounds(XrVector3f* mins, XrVector3f* maxs)
+    {
+        if (m_boundsNeedUpdate) {
+            m_boundsNeedUpdate = false;
+
+            // Unlike the resolved transforms, these are never transposed or zeroed, and are only needed for the bounded nodes.
+            // Nodes come after their parents, so one pass is enough.
+            const auto& nodes = m_model->GetNodes();
+            m_boundsNodeTransforms.resize(nodes.size());
+            for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex) {
+                const NodeIndex_t parentIndex = nodes[nodeIndex].GetParentNodeIndex();
+                if (parentIndex == Model::RootParentNodeIndex) {
+                    m_boundsNodeTransforms[nodeIndex] = m_nodeLocalTransforms[nodeIndex];
+                }
+                else {
+                    m_boundsNodeTransforms[nodeIndex] = m_boundsNodeTransforms[parentIndex] * m_nodeLocalTransforms[nodeIndex];
+                }
+            }
+
+            const std::vector<NodeIndex_t>& boundedNodes = m_model->GetBoundedNodes();
+            m_boundsTransforms.resize(boundedNodes.size());
+            for (size_t i = 0; i < boundedNodes.size(); ++i) {
+                m_boundsTransforms[i] = m_boundsNodeTransforms[boundedNodes[i]];
+            }
+            m_boundsNodeMins.resize(boundedNodes.size());
+            m_boundsNodeMaxs.resize(boundedNodes.size());
+            Conformance::LinearBatch::TransformBounds(m_boundsNodeMins.data(), m_boundsNodeMaxs.data(), m_boundsTransforms.data(),
+                                                      m_model->GetBoundedNodeMins().data(), m_model->GetBoundedNodeMaxs().data(),
+                                                      boundedNodes.size());
+
+            m_hasBounds = !boundedNodes.empty();
+            if (m_hasBounds) {
+                m_boundsMins = m_boundsNodeMins[0];
+                m_boundsMaxs = m_boundsNodeMaxs[0];
+                for (size_t i = 1; i < boundedNodes.size(); ++i) {
+                    XrVector3f_Min(&m_boundsMins, &m_boundsMins, &m_boundsNodeMins[i]);
+                    XrVector3f_Max(&m_boundsMaxs, &m_boundsMaxs, &m_boundsNodeMaxs[i]);
+                }
+            }
+        }
+
+        if (!m_hasBounds) {
+            return false;
+        }
+        *mins = m_boundsMins;
+        *maxs = m_boundsMaxs;
+        return true;
+    }
+
 }  // namespace Pbr
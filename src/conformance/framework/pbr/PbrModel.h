@@ -15,6 +15,7 @@
 
 #include <nonstd/span.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <stdint.h>
 #include <string>
@@ -86,8 +87,8 @@ namespace Pbr
         /// Add a node to the model.
         NodeIndex_t AddNode(const XrMatrix4x4f& transform, NodeIndex_t parentIndex, std::string name = "");
 
-        /// Add a primitive to the model.
-        void AddPrimitive(PrimitiveHandle primitive);
+        /// Add a primitive to the model, extending the bounds of the nodes referenced by the vertices it was built from.
+        void AddPrimitive(PrimitiveHandle primitive, const PrimitiveBuilder& primitiveBuilder);
 
         NodeIndex_t GetNodeCount() const
         {
@@ -126,6 +127,21 @@ namespace Pbr
         {
             return m_nodes;
         }
+
+        /// The nodes referenced by the vertices of any primitive, in no particular order.
+        /// The matching elements of GetBoundedNodeMins() and GetBoundedNodeMaxs() bound those vertices in the space of the node.
+        const std::vector<NodeIndex_t>& GetBoundedNodes() const
+        {
+            return m_boundedNodes;
+        }
+        const std::vector<XrVector3f>& GetBoundedNodeMins() const
+        {
+            return m_boundedNodeMins;
+        }
+        const std::vector<XrVector3f>& GetBoundedNodeMaxs() const
+        {
+            return m_boundedNodeMaxs;
+        }
         static constexpr Pbr::NodeIndex_t RootParentNodeIndex = (Pbr::NodeIndex_t)-1;
 
     private:
@@ -136,6 +152,27 @@ namespace Pbr
         // A model contains one or more nodes. Each vertex of a primitive references a node to have the
         // node's transform applied.
         Node::Collection m_nodes;
+
+        std::vector<NodeIndex_t> m_boundedNodes;
+        std::vector<XrVector3f> m_boundedNodeMins;
+        std::vector<XrVector3f> m_boundedNodeMaxs;
+    };
+
+    /// A half-open range [begin, end) of node indices.
+    struct NodeIndexRange
+    {
+        NodeIndex_t begin{0};
+        NodeIndex_t end{0};
+
+        bool empty() const noexcept
+        {
+            return begin >= end;
+        }
+
+        NodeIndex_t size() const noexcept
+        {
+            return empty() ? 0 : end - begin;
+        }
     };
 
     /// A model instance is a collection of node transforms for an instance of a model.
@@ -157,6 +194,11 @@ namespace Pbr
             }
             constexpr XrMatrix4x4f identityMatrix = Matrix::Identity;  // or better yet poison it
             m_resolvedTransforms.resize(nodeCount, identityMatrix);
+            m_unmaskedTransforms.resize(nodeCount, identityMatrix);
+
+            // Nothing has been resolved yet.
+            m_nodeNeedsResolve.resize(nodeCount, true);
+            m_firstNodeNeedingResolve = 0;
         }
 
     public:
@@ -165,16 +207,21 @@ namespace Pbr
         {
             m_nodeLocalVisibilities[nodeIndex] = visibility;
             // Visibility is implemented by scaling to 0
-            m_resolvedTransformsNeedUpdate = true;
+            MarkNodeNeedsResolve(nodeIndex);
         }
 
         /// Overrides the local transform of a node
         void SetNodeTransform(NodeIndex_t nodeIndex, const XrMatrix4x4f& transform)
         {
             m_nodeLocalTransforms[nodeIndex] = transform;
-            m_resolvedTransformsNeedUpdate = true;
+            MarkNodeNeedsResolve(nodeIndex);
         }
 
+        /// Gets axis-aligned bounds of the vertices of the model in model space, with the current node transforms.
+        /// The bounds are conservative: they include invisible nodes. Returns false, leaving @p mins and @p maxs unchanged,
+        /// if the model has no vertices.
+        bool GetBounds(XrVector3f* mins, XrVector3f* maxs);
+
         /// Combine a transform with the original transform from the asset
         void SetAdditionalNodeTransform(NodeIndex_t nodeIndex, const XrMatrix4x4f& transform)
         {
@@ -192,44 +239,19 @@ namespace Pbr
         void MarkResolvedTransformsUpdated() noexcept
         {
             m_resolvedTransformsNeedUpdate = false;
+            m_updatedTransforms = {};
         }
-        void ResolveTransformsAndVisibilities(bool transpose)
-        {
-            const auto& nodes = m_model->GetNodes();
-
-            // Nodes are guaranteed to come after their parents, so each node transform can be multiplied by its parent transform in a single pass.
-            assert(nodes.size() == m_nodeLocalTransforms.size());
-            assert(nodes.size() == m_resolvedTransforms.size());
-            constexpr XrMatrix4x4f identityMatrix = Matrix::Identity;
-            for (const auto& node : nodes) {
-                bool parentIsRoot = node.GetParentNodeIndex() == Model::RootParentNodeIndex;
-                assert(parentIsRoot || node.GetParentNodeIndex() < node.GetNodeIndex());
 
-                bool parentVisibility = (parentIsRoot) ? true : m_resolvedVisibilities[node.GetParentNodeIndex()];
-                NodeVisibility nodeVisibility = m_nodeLocalVisibilities[node.GetNodeIndex()];
-
-                m_resolvedVisibilities[node.GetNodeIndex()] =
-                    nodeVisibility == NodeVisibility::Inherit ? parentVisibility : nodeVisibility == NodeVisibility::Visible;
-
-                const XrMatrix4x4f& parentTransform = (parentIsRoot) ? identityMatrix : m_resolvedTransforms[node.GetParentNodeIndex()];
-                const XrMatrix4x4f& nodeTransform = m_nodeLocalTransforms[node.GetNodeIndex()];
-
-                if (transpose) {
-                    XrMatrix4x4f nodeTransformTranspose = Matrix::Transposed(nodeTransform);
-                    m_resolvedTransforms[node.GetNodeIndex()] = nodeTransformTranspose * parentTransform;
-                }
-                else {
-                    m_resolvedTransforms[node.GetNodeIndex()] = parentTransform * nodeTransform;
-                }
-            }
+        /// Recompute the resolved transforms and visibilities of the nodes changed since the last call, and their descendants.
+        /// The resolved transforms of invisible nodes are zeroed. Pass @p transpose for row-major shader matrices.
+        void ResolveTransformsAndVisibilities(bool transpose);
 
-            // After all node transforms and visibilities have been propagated,
-            // zero the transforms of invisible nodes.
-            for (const auto& node : nodes) {
-                if (!m_resolvedVisibilities[node.GetNodeIndex()]) {
-                    XrMatrix4x4f_CreateScale(&m_resolvedTransforms[node.GetNodeIndex()], 0, 0, 0);
-                }
-            }
+        /// The nodes whose resolved transforms were recomputed since the last MarkResolvedTransformsUpdated(),
+        /// so only this part of a transform buffer needs uploading.
+        /// Unchanged nodes may be included, as only the lowest and highest indices are tracked.
+        NodeIndexRange GetUpdatedTransformRange() const noexcept
+        {
+            return m_updatedTransforms;
         }
 
         const Model& GetModel() const
@@ -253,6 +275,14 @@ namespace Pbr
         }
 
     private:
+        void MarkNodeNeedsResolve(NodeIndex_t nodeIndex)
+        {
+            m_nodeNeedsResolve[nodeIndex] = true;
+            m_firstNodeNeedingResolve = std::min(m_firstNodeNeedingResolve, nodeIndex);
+            m_resolvedTransformsNeedUpdate = true;
+            m_boundsNeedUpdate = true;
+        }
+
         bool m_resolvedTransformsNeedUpdate{true};
 
         // Derived classes may depend on this being immutable.
@@ -263,5 +293,24 @@ namespace Pbr
         // but can be updated for this instance.
         std::vector<XrMatrix4x4f> m_nodeLocalTransforms;
         std::vector<XrMatrix4x4f> m_resolvedTransforms;
+        // Resolved transforms before invisible nodes are zeroed: visible children of invisible nodes still need them.
+        std::vector<XrMatrix4x4f> m_unmaskedTransforms;
+
+        // Nodes whose local transform or visibility changed since they were last resolved.
+        std::vector<bool> m_nodeNeedsResolve;
+        NodeIndex_t m_firstNodeNeedingResolve{0};
+        bool m_transposed{false};
+        NodeIndexRange m_updatedTransforms;
+
+        // Cached by GetBounds until a node transform changes.
+        bool m_boundsNeedUpdate{true};
+        bool m_hasBounds{false};
+        XrVector3f m_boundsMins{};
+        XrVector3f m_boundsMaxs{};
+        // Scratch space for GetBounds: the node-to-model transforms, and the bounds of each bounded node in model space.
+        std::vector<XrMatrix4x4f> m_boundsNodeTransforms;
+        std::vector<XrMatrix4x4f> m_boundsTransforms;
+        std::vector<XrVector3f> m_boundsNodeMins;
+        std::vector<XrVector3f> m_boundsNodeMaxs;
     };
 }  // namespace Pbr
@@ -0,0 +1,93 @@
+// Copyright 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(XR_USE_GRAPHICS_API_VULKAN)
+
+#include "VkDrawList.h"
+
+#include "VkMaterial.h"
+#include "VkPrimitive.h"
+#include "VkResources.h"
+
+#include "../PbrDrawList.h"
+#include "../PbrSharedState.h"
+
+#include "utilities/vulkan_utils.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <stdint.h>
+
+namespace Pbr
+{
+    void VulkanDrawList::Clear()
+    {
+        m_drawList.Clear();
+        m_draws.clear();
+    }
+
+    void VulkanDrawList::Add(const VulkanPrimitive& primitive, VkDescriptorSet descriptorSet, FillMode fillMode, const void* instance)
+    {
+        const VulkanMaterial& material = *primitive.GetMaterial();
+        const BlendState blendState = material.GetAlphaBlended();
+        const DoubleSided doubleSided = material.GetDoubleSided();
+
+        DrawItem item{};
+        // Everything that selects a pipeline in VulkanResources::GetOrCreatePipeline and differs between draws.
+        item.pipelineKey = ((uint32_t)fillMode << 2) | ((uint32_t)blendState << 1) | (uint32_t)doubleSided;
+        item.alphaBlended = blendState == BlendState::AlphaBlended;
+        // The material shares a descriptor set with the instance, one per primitive, which is bound for every draw anyway.
+        // Leaving the material out groups the draws by mesh within each pipeline instead, so more buffer binds are skipped.
+        item.material = nullptr;
+        item.mesh = &primitive;
+        item.instance = instance;
+        item.userIndex = (uint32_t)m_draws.size();
+        m_drawList.Add(item);
+
+        m_draws.push_back(VulkanDraw{&primitive, descriptorSet, fillMode});
+    }
+
+    void VulkanDrawList::Render(Conformance::CmdBuffer& directCommandBuffer, VulkanResources& pbrResources, VkRenderPass renderPass,
+                                VkSampleCountFlagBits sampleCount)
+    {
+        if (m_draws.empty()) {
+            return;
+        }
+
+        pbrResources.UpdateBuffer();
+        m_drawList.Sort();
+
+        // The fill mode is part of the shared state used to pick a pipeline, so set it per pipeline and restore it afterwards.
+        const FillMode originalFillMode = pbrResources.GetFillMode();
+
+        const DrawItem* previous = nullptr;
+        for (const DrawItem& item : m_drawList.GetItems()) {
+            const VulkanDraw& draw = m_draws[item.userIndex];
+            const VulkanPrimitive& primitive = *draw.primitive;
+
+            if (previous == nullptr || previous->pipelineKey != item.pipelineKey) {
+                pbrResources.SetFillMode(draw.fillMode);
+                Conformance::Pipeline& pipeline = pbrResources.GetOrCreatePipeline(
+                    renderPass, sampleCount, primitive.GetMaterial()->GetAlphaBlended(), primitive.GetMaterial()->GetDoubleSided());
+                vkCmdBindPipeline(directCommandBuffer.buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.pipe);
+            }
+
+            // Each primitive of each instance has its own descriptor set, holding both material and instance bindings,
+            // so there is no material bind to skip.
+            vkCmdBindDescriptorSets(directCommandBuffer.buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pbrResources.GetPipelineLayout(), 0, 1,
+                                    &draw.descriptorSet, 0, nullptr);
+
+            if (previous == nullptr || previous->mesh != item.mesh) {
+                primitive.BindBuffers(directCommandBuffer.buf);
+            }
+
+            primitive.Draw(directCommandBuffer.buf);
+            previous = &item;
+        }
+
+        pbrResources.SetFillMode(originalFillMode);
+    }
+}  // namespace Pbr
+
+#endif  // defined(XR_USE_GRAPHICS_API_VULKAN)
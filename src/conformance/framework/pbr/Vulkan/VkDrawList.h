@@ -0,0 +1,50 @@
+// Copyright 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../PbrDrawList.h"
+#include "../PbrSharedState.h"
+
+#include "utilities/vulkan_utils.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace Pbr
+{
+    struct VulkanPrimitive;
+    struct VulkanResources;
+
+    /// Primitives gathered from the model instances drawn in one view, recorded grouped by pipeline and mesh
+    /// so that pipelines and vertex/index buffers are only bound when they change.
+    /// The descriptor set of each draw holds both its material and its instance bindings, so it is bound for every draw.
+    class VulkanDrawList
+    {
+    public:
+        /// Remove all draws, keeping the allocations for reuse.
+        void Clear();
+
+        /// Add a primitive to draw. @p descriptorSet must already be written (see VulkanPrimitive::UpdateDescriptorSet)
+        /// and must not be rewritten until the draws have been executed.
+        void Add(const VulkanPrimitive& primitive, VkDescriptorSet descriptorSet, FillMode fillMode, const void* instance);
+
+        /// Record all draws added since the last Clear(), in sorted order.
+        void Render(Conformance::CmdBuffer& directCommandBuffer, VulkanResources& pbrResources, VkRenderPass renderPass,
+                    VkSampleCountFlagBits sampleCount);
+
+    private:
+        struct VulkanDraw
+        {
+            const VulkanPrimitive* primitive;
+            VkDescriptorSet descriptorSet;
+            FillMode fillMode;
+        };
+
+        DrawList m_drawList;
+        std::vector<VulkanDraw> m_draws;
+    };
+}  // namespace Pbr
@@ -10,6 +10,7 @@
 
 #include "VkModel.h"
 
+#include "VkDrawList.h"
 #include "VkMaterial.h"
 #include "VkPrimitive.h"
 #include "VkResources.h"
@@ -29,7 +30,14 @@ namespace Pbr
     void VulkanModelInstance::Render(Pbr::VulkanResources& pbrResources, Conformance::CmdBuffer& directCommandBuffer,
                                      VkRenderPass renderPass, VkSampleCountFlagBits sampleCount, XrMatrix4x4f modelToWorld)
     {
-        pbrResources.UpdateBuffer();
+        VulkanDrawList drawList;
+        AddToDrawList(pbrResources, modelToWorld, pbrResources.GetFillMode(), drawList);
+        drawList.Render(directCommandBuffer, pbrResources, renderPass, sampleCount);
+    }
+
+    void VulkanModelInstance::AddToDrawList(Pbr::VulkanResources& pbrResources, XrMatrix4x4f modelToWorld, FillMode fillMode,
+                                            VulkanDrawList& drawList)
+    {
         m_modelBuffer.ModelToWorld = modelToWorld;
         m_modelConstantBuffer.Update({&m_modelBuffer, 1});
         UpdateTransforms(pbrResources);
@@ -49,8 +57,9 @@ namespace Pbr
             if (!IsAnyNodeVisible(primitive.GetNodes()))
                 continue;
 
-            primitive.Render(directCommandBuffer, pbrResources, descriptorSet, renderPass, sampleCount,
-                             m_modelConstantBuffer.MakeDescriptor(), m_modelTransformsStructuredBuffer.MakeDescriptor());
+            primitive.UpdateDescriptorSet(pbrResources, descriptorSet, m_modelConstantBuffer.MakeDescriptor(),
+                                          m_modelTransformsStructuredBuffer.MakeDescriptor());
+            drawList.Add(primitive, descriptorSet, fillMode, this);
         }
     }
 
@@ -97,8 +106,12 @@ namespace Pbr
         if (ResolvedTransformsNeedUpdate()) {
             ResolveTransformsAndVisibilities(false);
 
-            // Update node transform structured buffer.
-            m_modelTransformsStructuredBuffer.Update(GetResolvedTransforms());
+            // Update the part of the node transform structured buffer that changed.
+            const NodeIndexRange range = GetUpdatedTransformRange();
+            if (!range.empty()) {
+                nonstd::span<const XrMatrix4x4f> resolvedTransforms = GetResolvedTransforms();
+                m_modelTransformsStructuredBuffer.Update(resolvedTransforms.subspan(range.begin, range.size()), range.begin);
+            }
             MarkResolvedTransformsUpdated();
         }
     }
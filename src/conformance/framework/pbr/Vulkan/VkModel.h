@@ -12,6 +12,7 @@
 #include "../GlslBuffers.h"
 #include "../PbrHandles.h"
 #include "../PbrModel.h"
+#include "../PbrSharedState.h"
 
 #include "common/xr_linear.h"
 #include "utilities/vulkan_scoped_handle.h"
@@ -24,6 +25,7 @@
 
 namespace Pbr
 {
+    class VulkanDrawList;
     struct VulkanPrimitive;
     struct VulkanResources;
 
@@ -36,6 +38,10 @@ namespace Pbr
         void Render(Pbr::VulkanResources& pbrResources, Conformance::CmdBuffer& directCommandBuffer, VkRenderPass renderPass,
                     VkSampleCountFlagBits sampleCount, XrMatrix4x4f modelToWorld);
 
+        /// Update the model's buffers and add its visible primitives to a draw list shared with other model instances.
+        /// The instance must not be added to another draw list, or rendered, until the draws have been executed.
+        void AddToDrawList(Pbr::VulkanResources& pbrResources, XrMatrix4x4f modelToWorld, FillMode fillMode, VulkanDrawList& drawList);
+
     private:
         void AllocateDescriptorSets(Pbr::VulkanResources& pbrResources, uint32_t numSets);
         /// Update the transforms used to render the model. This needs to be called any time a node transform is changed.
@@ -55,9 +55,8 @@ namespace Pbr
     {
     }
 
-    void VulkanPrimitive::Render(Conformance::CmdBuffer& directCommandBuffer, VulkanResources& pbrResources, VkDescriptorSet descriptorSet,
-                                 VkRenderPass renderPass, VkSampleCountFlagBits sampleCount, VkDescriptorBufferInfo modelConstantBuffer,
-                                 VkDescriptorBufferInfo transformBuffer) const
+    void VulkanPrimitive::UpdateDescriptorSet(VulkanResources& pbrResources, VkDescriptorSet descriptorSet,
+                                              VkDescriptorBufferInfo modelConstantBuffer, VkDescriptorBufferInfo transformBuffer) const
     {
         GetMaterial()->UpdateBuffer();
 
@@ -68,29 +67,26 @@ namespace Pbr
 
         vkUpdateDescriptorSets(pbrResources.GetDevice(), static_cast<uint32_t>(wds->writeDescriptorSets.size()),
                                wds->writeDescriptorSets.data(), 0, NULL);
+    }
 
-        BlendState blendState = GetMaterial()->GetAlphaBlended();
-        DoubleSided doubleSided = GetMaterial()->GetDoubleSided();
-
-        Conformance::Pipeline& pipeline = pbrResources.GetOrCreatePipeline(renderPass, sampleCount, blendState, doubleSided);
-
-        vkCmdBindDescriptorSets(directCommandBuffer.buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pbrResources.GetPipelineLayout(), 0, 1,
-                                &descriptorSet, 0, nullptr);
-        vkCmdBindPipeline(directCommandBuffer.buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.pipe);
-
+    void VulkanPrimitive::BindBuffers(VkCommandBuffer commandBuffer) const
+    {
         const VkDeviceSize vertexOffset = 0;
         const VkDeviceSize indexOffset = 0;
 
         // Bind index and vertex buffers
-        vkCmdBindIndexBuffer(directCommandBuffer.buf, m_vertexAndIndexBuffer.idx.buf, indexOffset, VK_INDEX_TYPE_UINT32);
+        vkCmdBindIndexBuffer(commandBuffer, m_vertexAndIndexBuffer.idx.buf, indexOffset, VK_INDEX_TYPE_UINT32);
 
         CHECKPOINT();
 
-        vkCmdBindVertexBuffers(directCommandBuffer.buf, 0, 1, &m_vertexAndIndexBuffer.vtx.buf, &vertexOffset);
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_vertexAndIndexBuffer.vtx.buf, &vertexOffset);
 
         CHECKPOINT();
+    }
 
-        vkCmdDrawIndexed(directCommandBuffer.buf, m_vertexAndIndexBuffer.count.idx, 1, 0, 0, 0);
+    void VulkanPrimitive::Draw(VkCommandBuffer commandBuffer) const
+    {
+        vkCmdDrawIndexed(commandBuffer, m_vertexAndIndexBuffer.count.idx, 1, 0, 0, 0);
 
         CHECKPOINT();
     }
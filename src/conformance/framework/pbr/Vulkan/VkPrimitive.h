@@ -60,9 +60,17 @@ namespace Pbr
 
     protected:
         friend class VulkanModelInstance;
-        void Render(Conformance::CmdBuffer& directCommandBuffer, VulkanResources& pbrResources, VkDescriptorSet descriptorSet,
-                    VkRenderPass renderPass, VkSampleCountFlagBits sampleCount, VkDescriptorBufferInfo modelConstantBuffer,
-                    VkDescriptorBufferInfo transformBuffer) const;
+        friend class VulkanDrawList;
+
+        /// Update the material constant buffer and write all the bindings used to draw this primitive into @p descriptorSet.
+        void UpdateDescriptorSet(VulkanResources& pbrResources, VkDescriptorSet descriptorSet, VkDescriptorBufferInfo modelConstantBuffer,
+                                 VkDescriptorBufferInfo transformBuffer) const;
+
+        /// Bind the vertex and index buffers.
+        void BindBuffers(VkCommandBuffer commandBuffer) const;
+
+        /// Draw using the currently bound pipeline, descriptor set and buffers.
+        void Draw(VkCommandBuffer commandBuffer) const;
 
         /// The clone shares the vertex and index buffers - they are not cloned
         VulkanPrimitive Clone(Pbr::VulkanResources const& pbrResources) const;
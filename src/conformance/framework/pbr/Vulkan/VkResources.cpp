@@ -16,6 +16,7 @@
 #include "VkMaterial.h"
 #include "VkPipelineStates.h"
 #include "VkPrimitive.h"
+#include "VkStagingRing.h"
 #include "VkTexture.h"
 #include "VkTextureCache.h"
 
@@ -34,6 +35,7 @@
 #include <tinygltf/tiny_gltf.h>
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <stdexcept>
@@ -320,6 +322,11 @@ namespace Pbr
             Internal::ThrowIf(!copyCmdBuffer.Init(objnamer, device_, queueFamilyIndex), "Failed to create command buffer");
             copyCmdBuffer.Begin();
 
+            stagingRing.Init(namer, device, allocator);
+            VkPhysicalDeviceProperties properties{};
+            vkGetPhysicalDeviceProperties(physicalDevice_, &properties);
+            optimalBufferCopyOffsetAlignment = std::max<VkDeviceSize>(properties.limits.optimalBufferCopyOffsetAlignment, 1);
+
             PipelineLayout::SetupBindings(VulkanLayout);
 
             Resources.DescriptorSetLayout =
@@ -376,6 +383,21 @@ namespace Pbr
         VkDevice device{VK_NULL_HANDLE};
         Conformance::MemoryAllocator allocator{};
         Conformance::CmdBuffer copyCmdBuffer{};
+        // Whether anything has been recorded into copyCmdBuffer since it was last submitted.
+        bool copyCmdBufferUsed{false};
+        // Whether copyCmdBuffer has been submitted and not yet waited on.
+        bool copyCmdBufferSubmitted{false};
+
+        struct PendingImageUpload
+        {
+            VkImage image;
+            VkImageSubresourceRange range;
+            VkBuffer stagingBuffer;
+            std::vector<VkBufferImageCopy> regions;
+        };
+        VulkanStagingRing stagingRing;
+        VkDeviceSize optimalBufferCopyOffsetAlignment{1};
+        std::vector<PendingImageUpload> pendingUploads;
 
         PrimitiveCollection<VulkanPrimitive> Primitives;
 
@@ -408,6 +430,7 @@ namespace Pbr
             stagingBuffer.Reset(GetDevice());
         }
         m_impl->Resources.StagingBuffers.clear();
+        m_impl->stagingRing.Reset();
     }
 
     /* IGltfBuilder implementations */
@@ -521,6 +544,9 @@ namespace Pbr
     void VulkanResources::DropLoaderCaches()
     {
         m_impl->loaderResources = {};
+
+        // This is the end of loading a model: record its texture uploads together.
+        FlushUploads();
     }
 
     void VulkanResources::SetBrdfLut(std::shared_ptr<VulkanTextureBundle> brdfLut)
@@ -671,6 +697,8 @@ namespace Pbr
 
     const Conformance::CmdBuffer& VulkanResources::GetCopyCommandBuffer() const
     {
+        // The caller may record into it, so it must be submitted.
+        m_impl->copyCmdBufferUsed = true;
         return m_impl->copyCmdBuffer;
     }
 
@@ -681,20 +709,34 @@ namespace Pbr
 
     void VulkanResources::SubmitFrameResources(VkQueue queue) const
     {
+        FlushUploads();
+        if (!m_impl->copyCmdBufferUsed) {
+            // Nothing was uploaded this frame, so there is nothing to submit.
+            return;
+        }
+
         m_impl->copyCmdBuffer.End();
         m_impl->copyCmdBuffer.Exec(queue);
+        m_impl->copyCmdBufferUsed = false;
+        m_impl->copyCmdBufferSubmitted = true;
     }
 
     void VulkanResources::Wait() const
     {
+        if (!m_impl->copyCmdBufferSubmitted) {
+            return;
+        }
+
         m_impl->copyCmdBuffer.Wait();
         m_impl->copyCmdBuffer.Clear();
         m_impl->copyCmdBuffer.Begin();
+        m_impl->copyCmdBufferSubmitted = false;
 
         for (auto stagingBuffer : m_impl->Resources.StagingBuffers) {
             stagingBuffer.Reset(GetDevice());
         }
         m_impl->Resources.StagingBuffers.clear();
+        m_impl->stagingRing.Reclaim();
     }
 
     const VulkanDebugObjectNamer& VulkanResources::GetDebugNamer() const
@@ -717,6 +759,74 @@ namespace Pbr
         m_impl->Resources.StagingBuffers.push_back(buffer);
     }
 
+    static VkDeviceSize LeastCommonMultiple(VkDeviceSize a, VkDeviceSize b)
+    {
+        VkDeviceSize x = a;
+        VkDeviceSize y = b;
+        while (y != 0) {
+            VkDeviceSize t = x % y;
+            x = y;
+            y = t;
+        }
+        return a / x * b;
+    }
+
+    VulkanStagingRing::Allocation VulkanResources::AllocateStaging(VkDeviceSize size, VkDeviceSize texelBlockSize)
+    {
+        // vkCmdCopyBufferToImage requires offsets to be a multiple of the texel block size and of 4.
+        VkDeviceSize alignment = LeastCommonMultiple(std::max<VkDeviceSize>(texelBlockSize, 1), 4);
+        alignment = LeastCommonMultiple(alignment, m_impl->optimalBufferCopyOffsetAlignment);
+        return m_impl->stagingRing.Allocate(size, alignment);
+    }
+
+    void VulkanResources::QueueImageUpload(VkImage image, const VkImageSubresourceRange& range, VkBuffer stagingBuffer,
+                                           std::vector<VkBufferImageCopy> regions)
+    {
+        m_impl->pendingUploads.push_back(Impl::PendingImageUpload{image, range, stagingBuffer, std::move(regions)});
+    }
+
+    void VulkanResources::FlushUploads() const
+    {
+        std::vector<Impl::PendingImageUpload>& uploads = m_impl->pendingUploads;
+        if (uploads.empty()) {
+            return;
+        }
+        VkCommandBuffer cmdBuffer = m_impl->copyCmdBuffer.buf;
+
+        // Switch all the destination images to TRANSFER_DST_OPTIMAL
+        std::vector<VkImageMemoryBarrier> barriers(uploads.size(), VkImageMemoryBarrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER});
+        for (size_t i = 0; i < uploads.size(); ++i) {
+            barriers[i].srcAccessMask = 0;
+            barriers[i].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barriers[i].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barriers[i].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[i].image = uploads[i].image;
+            barriers[i].subresourceRange = uploads[i].range;
+        }
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                             (uint32_t)barriers.size(), barriers.data());
+
+        for (const Impl::PendingImageUpload& upload : uploads) {
+            vkCmdCopyBufferToImage(cmdBuffer, upload.stagingBuffer, upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   (uint32_t)upload.regions.size(), upload.regions.data());
+        }
+
+        // Switch all the destination images to SHADER_READ_ONLY_OPTIMAL
+        for (VkImageMemoryBarrier& barrier : barriers) {
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                             (uint32_t)barriers.size(), barriers.data());
+
+        uploads.clear();
+        m_impl->copyCmdBufferUsed = true;
+    }
+
 }  // namespace Pbr
 
 #endif  // defined(XR_USE_GRAPHICS_API_VULKAN)
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "VkCommon.h"
+#include "VkStagingRing.h"
 
 #include <utilities/image.h>
 #include "../IGltfBuilder.h"
@@ -29,6 +30,7 @@
 #include <memory>
 #include <stddef.h>
 #include <stdint.h>
+#include <vector>
 
 class VulkanDebugObjectNamer;
 
@@ -167,6 +169,19 @@ namespace Pbr
         VkDescriptorPool MakeDescriptorPool(uint32_t maxSets) const;
         void DestroyAfterRender(Conformance::BufferAndMemory buffer) const;
 
+        /// Sub-allocate staging memory for uploading an image with the given texel block (or pixel) size in bytes.
+        /// Valid until the next Wait().
+        VulkanStagingRing::Allocation AllocateStaging(VkDeviceSize size, VkDeviceSize texelBlockSize);
+
+        /// Queue a copy from staging memory to all of @p range of a newly created image, leaving it in
+        /// SHADER_READ_ONLY_OPTIMAL layout. Queued uploads are recorded in one batch by FlushUploads().
+        void QueueImageUpload(VkImage image, const VkImageSubresourceRange& range, VkBuffer stagingBuffer,
+                              std::vector<VkBufferImageCopy> regions);
+
+        /// Record all queued uploads into the copy command buffer. Called at the end of loading a model,
+        /// and by SubmitFrameResources().
+        void FlushUploads() const;
+
     private:
         std::unique_ptr<VulkanWriteDescriptorSets> BuildWriteDescriptorSets(VkDescriptorBufferInfo modelConstantBuffer,
                                                                             VkDescriptorBufferInfo materialConstantBuffer,
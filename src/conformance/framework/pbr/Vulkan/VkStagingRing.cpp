@@ -0,0 +1,134 @@
+// Copyright 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(XR_USE_GRAPHICS_API_VULKAN)
+
+#include "VkStagingRing.h"
+
+#include "common/vulkan_debug_object_namer.hpp"
+#include "utilities/throw_helpers.h"
+#include "utilities/vulkan_utils.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace Pbr
+{
+    constexpr VkDeviceSize VulkanStagingRing::DefaultBlockSize;
+    constexpr VkDeviceSize VulkanStagingRing::MaxRetainedBlockSize;
+
+    static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return ((value + alignment - 1) / alignment) * alignment;
+    }
+
+    VulkanStagingRing::~VulkanStagingRing()
+    {
+        Reset();
+    }
+
+    void VulkanStagingRing::Init(const VulkanDebugObjectNamer& namer, VkDevice device, const Conformance::MemoryAllocator& allocator)
+    {
+        Reset();
+        m_namer = &namer;
+        m_device = device;
+        m_allocator = &allocator;
+    }
+
+    VulkanStagingRing::Allocation VulkanStagingRing::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+    {
+        if (m_device == VK_NULL_HANDLE) {
+            throw std::logic_error("VulkanStagingRing::Allocate called before Init");
+        }
+        if (alignment == 0) {
+            alignment = 1;
+        }
+
+        for (; m_currentBlock < m_blocks.size(); ++m_currentBlock) {
+            Block& block = m_blocks[m_currentBlock];
+            const VkDeviceSize offset = AlignUp(block.head, alignment);
+            if (offset + size <= block.size) {
+                block.head = offset + size;
+                return Allocation{block.buffer.buf, offset, block.mapped + offset};
+            }
+        }
+
+        // Nothing left in the chain: start a new block. Offset 0 satisfies any alignment.
+        AddBlock(std::max(DefaultBlockSize, AlignUp(size, DefaultBlockSize)));
+        m_currentBlock = m_blocks.size() - 1;
+        Block& block = m_blocks.back();
+        block.head = size;
+        return Allocation{block.buffer.buf, 0, block.mapped};
+    }
+
+    void VulkanStagingRing::Reclaim()
+    {
+        VkDeviceSize used = 0;
+        for (const Block& block : m_blocks) {
+            used += block.head;
+        }
+
+        if (m_blocks.size() > 1) {
+            // The last batch overflowed: replace the chain with a single block that would have held all of it.
+            for (Block& block : m_blocks) {
+                DestroyBlock(block);
+            }
+            m_blocks.clear();
+            const VkDeviceSize size = AlignUp(used, DefaultBlockSize);
+            if (size <= MaxRetainedBlockSize) {
+                AddBlock(size);
+            }
+        }
+        else if (m_blocks.size() == 1 && m_blocks[0].size > MaxRetainedBlockSize) {
+            DestroyBlock(m_blocks[0]);
+            m_blocks.clear();
+        }
+
+        for (Block& block : m_blocks) {
+            block.head = 0;
+        }
+        m_currentBlock = 0;
+    }
+
+    void VulkanStagingRing::Reset()
+    {
+        for (Block& block : m_blocks) {
+            DestroyBlock(block);
+        }
+        m_blocks.clear();
+        m_currentBlock = 0;
+    }
+
+    void VulkanStagingRing::AddBlock(VkDeviceSize size)
+    {
+        VkBufferCreateInfo bufferCreateInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferCreateInfo.size = size;
+
+        Block block;
+        block.size = size;
+        // Memory is host-visible and host-coherent, so it stays mapped and never needs flushing.
+        block.buffer.Create(m_device, *m_allocator, bufferCreateInfo);
+        XRC_CHECK_THROW_VKCMD(m_namer->SetName(VK_OBJECT_TYPE_BUFFER, (uint64_t)block.buffer.buf, "CTS PBR staging ring buffer"));
+        void* mapped = nullptr;
+        XRC_CHECK_THROW_VKCMD(vkMapMemory(m_device, block.buffer.mem, 0, VK_WHOLE_SIZE, 0, &mapped));
+        block.mapped = static_cast<uint8_t*>(mapped);
+
+        m_blocks.push_back(block);
+    }
+
+    void VulkanStagingRing::DestroyBlock(Block& block)
+    {
+        if (block.mapped != nullptr) {
+            vkUnmapMemory(m_device, block.buffer.mem);
+            block.mapped = nullptr;
+        }
+        block.buffer.Reset(m_device);
+    }
+}  // namespace Pbr
+
+#endif  // defined(XR_USE_GRAPHICS_API_VULKAN)
@@ -0,0 +1,76 @@
+// Copyright 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "utilities/vulkan_utils.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <stdint.h>
+#include <vector>
+
+class VulkanDebugObjectNamer;
+
+namespace Pbr
+{
+    /// Persistently-mapped, host-visible staging memory for uploads recorded into the PBR copy command buffer.
+    ///
+    /// Uploads are sub-allocated front to back. Once the copy command buffer that reads them has completed, Reclaim()
+    /// rewinds to the start so the same memory is reused by the next batch of uploads. If a batch does not fit, another
+    /// block is chained on, and on the next Reclaim() the blocks are replaced by a single block big enough for the
+    /// whole batch, so steady-state loading needs no staging allocations at all.
+    class VulkanStagingRing
+    {
+    public:
+        /// A sub-allocation: write the data to @ref data, copy from @ref buffer at @ref offset.
+        struct Allocation
+        {
+            VkBuffer buffer;
+            VkDeviceSize offset;
+            uint8_t* data;
+        };
+
+        static constexpr VkDeviceSize DefaultBlockSize = 4 * 1024 * 1024;
+
+        /// Blocks larger than this are released rather than kept for reuse.
+        static constexpr VkDeviceSize MaxRetainedBlockSize = 64 * 1024 * 1024;
+
+        VulkanStagingRing() = default;
+        ~VulkanStagingRing();
+
+        VulkanStagingRing(const VulkanStagingRing&) = delete;
+        VulkanStagingRing& operator=(const VulkanStagingRing&) = delete;
+
+        void Init(const VulkanDebugObjectNamer& namer, VkDevice device, const Conformance::MemoryAllocator& allocator);
+
+        /// Sub-allocate @p size bytes at an offset that is a multiple of @p alignment (which need not be a power of two).
+        Allocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
+
+        /// Make all memory available again. Must only be called once the GPU has finished reading every allocation.
+        void Reclaim();
+
+        /// Destroy all blocks.
+        void Reset();
+
+    private:
+        struct Block
+        {
+            Conformance::BufferAndMemory buffer;
+            VkDeviceSize size{0};
+            VkDeviceSize head{0};
+            uint8_t* mapped{nullptr};
+        };
+
+        void AddBlock(VkDeviceSize size);
+        void DestroyBlock(Block& block);
+
+        const VulkanDebugObjectNamer* m_namer{nullptr};
+        VkDevice m_device{VK_NULL_HANDLE};
+        const Conformance::MemoryAllocator* m_allocator{nullptr};
+
+        std::vector<Block> m_blocks;
+        size_t m_currentBlock{0};
+    };
+}  // namespace Pbr
@@ -14,6 +14,7 @@
 #include "VkCommon.h"
 #include "VkFormats.h"
 #include "VkResources.h"
+#include "VkStagingRing.h"
 #include "stb_image.h"
 
 #include "../PbrCommon.h"
@@ -27,9 +28,12 @@
 #include <assert.h>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <stdlib.h>
+#include <utility>
+#include <vector>
 
 namespace Pbr
 {
@@ -50,7 +54,6 @@ namespace Pbr
         {
             VkDevice device = pbrResources.GetDevice();
             const Conformance::MemoryAllocator& memAllocator = pbrResources.GetMemoryAllocator();
-            const Conformance::CmdBuffer& copyCmdBuffer = pbrResources.GetCopyCommandBuffer();
 
             uint16_t arraySize = imageArray.size();
             assert(arraySize > 0);
@@ -101,20 +104,17 @@ namespace Pbr
                 }
             }
 
-            // Create a staging buffer
-            VkBufferCreateInfo bufferCreateInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-            bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-            bufferCreateInfo.size = static_cast<VkDeviceSize>(bufferOffset);
-
-            Conformance::BufferAndMemory stagingBuffer;
-            stagingBuffer.Create(device, memAllocator, bufferCreateInfo);
-            XRC_CHECK_THROW_VKCMD(namer.SetName(VK_OBJECT_TYPE_BUFFER, (uint64_t)stagingBuffer.buf, "CTS texture array staging buffer"));
+            // Copy the data into shared staging memory
+            const VkDeviceSize stagingSize = static_cast<VkDeviceSize>(bufferOffset);
+            VulkanStagingRing::Allocation staging = pbrResources.AllocateStaging(stagingSize, formatParams.BytesPerBlockOrPixel());
 
             for (int arrayIndex = 0; arrayIndex < arraySize; arrayIndex++) {
                 Image::Image const& arrayLayer = *imageArray[arrayIndex];
                 for (int mipLevel = 0; mipLevel < mipLevels; mipLevel++) {
-                    stagingBuffer.Update<uint8_t>(device, arrayLayer.levels[mipLevel].data,
-                                                  regions[mipLevel + arrayIndex * mipLevels].bufferOffset);
+                    VkBufferImageCopy& region = regions[mipLevel + arrayIndex * mipLevels];
+                    const auto& levelData = arrayLayer.levels[mipLevel].data;
+                    memcpy(staging.data + region.bufferOffset, levelData.data(), levelData.size());
+                    region.bufferOffset += staging.offset;
                 }
             }
 
@@ -148,31 +148,9 @@ namespace Pbr
 
             bundle.deviceMemory = Conformance::ScopedVkDeviceMemory(imageMemory, device);
 
-            // Switch the destination image to TRANSFER_DST_OPTIMAL
-            VkImageMemoryBarrier imgBarrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
-            imgBarrier.srcAccessMask = 0;
-            imgBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            imgBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            imgBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            imgBarrier.image = bundle.image.get();
-            imgBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, arraySize};
-            vkCmdPipelineBarrier(copyCmdBuffer.buf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
-                                 nullptr, 1, &imgBarrier);
-
-            vkCmdCopyBufferToImage(copyCmdBuffer.buf, stagingBuffer.buf, bundle.image.get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                   regions.size(), regions.data());
-
-            // Switch the destination image to SHADER_READ_ONLY_OPTIMAL
-            imgBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            imgBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-            imgBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            imgBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imgBarrier.image = bundle.image.get();
-            imgBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, arraySize};
-            vkCmdPipelineBarrier(copyCmdBuffer.buf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0,
-                                 nullptr, 1, &imgBarrier);
-
-            pbrResources.DestroyAfterRender(stagingBuffer);
+            // The layout transitions and copy are recorded later, batched with the other textures of the model or frame.
+            const VkImageSubresourceRange subresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, arraySize};
+            pbrResources.QueueImageUpload(bundle.image.get(), subresourceRange, staging.buffer, std::move(regions));
 
             return bundle;
         }
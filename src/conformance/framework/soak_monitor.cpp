@@ -0,0 +1,198 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "soak_monitor.h"
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(XR_OS_LINUX) || defined(XR_OS_ANDROID)
+#include <dirent.h>
+#include <unistd.h>
+#elif defined(XR_OS_APPLE)
+#include <dirent.h>
+#include <mach/mach.h>
+#elif defined(XR_OS_WINDOWS)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#include <psapi.h>
+#endif
+
+namespace Conformance
+{
+    namespace
+    {
+#if defined(XR_OS_LINUX) || defined(XR_OS_ANDROID) || defined(XR_OS_APPLE)
+        bool CountDirectoryEntries(const char* path, uint64_t& count)
+        {
+            DIR* dir = opendir(path);
+            if (dir == nullptr) {
+                return false;
+            }
+            count = 0;
+            while (const dirent* entry = readdir(dir)) {
+                if (entry->d_name[0] != '.') {
+                    count++;
+                }
+            }
+            closedir(dir);
+            // Do not count the descriptor of the directory listing itself.
+            if (count > 0) {
+                count--;
+            }
+            return true;
+        }
+#endif
+
+        double AverageOf(const std::vector<SoakSample>& samples, size_t begin, size_t end, double (*value)(const SoakSample&))
+        {
+            double sum = 0;
+            for (size_t i = begin; i < end; ++i) {
+                sum += value(samples[i]);
+            }
+            return sum / (double)(end - begin);
+        }
+    }  // namespace
+
+    bool GetProcessResidentMemory(uint64_t& bytes)
+    {
+#if defined(XR_OS_LINUX) || defined(XR_OS_ANDROID)
+        // The second field of statm is the resident set size in pages.
+        std::ifstream statm("/proc/self/statm");
+        uint64_t sizePages = 0;
+        uint64_t residentPages = 0;
+        if (!(statm >> sizePages >> residentPages)) {
+            return false;
+        }
+        bytes = residentPages * (uint64_t)sysconf(_SC_PAGESIZE);
+        return true;
+#elif defined(XR_OS_APPLE)
+        mach_task_basic_info_data_t info{};
+        mach_msg_type_number_t infoCount = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &infoCount) != KERN_SUCCESS) {
+            return false;
+        }
+        bytes = info.resident_size;
+        return true;
+#elif defined(XR_OS_WINDOWS)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return false;
+        }
+        bytes = counters.WorkingSetSize;
+        return true;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    bool GetProcessHandleCount(uint64_t& count)
+    {
+#if defined(XR_OS_LINUX) || defined(XR_OS_ANDROID)
+        return CountDirectoryEntries("/proc/self/fd", count);
+#elif defined(XR_OS_APPLE)
+        return CountDirectoryEntries("/dev/fd", count);
+#elif defined(XR_OS_WINDOWS)
+        DWORD handleCount = 0;
+        if (!::GetProcessHandleCount(GetCurrentProcess(), &handleCount)) {
+            return false;
+        }
+        count = handleCount;
+        return true;
+#else
+        (void)count;
+        return false;
+#endif
+    }
+
+    XrHandleCounter::XrHandleCounter(XrInstance instance) : m_instance(instance)
+    {
+        PFN_xrVoidFunction function = nullptr;
+        if (XR_SUCCEEDED(xrGetInstanceProcAddr(instance, XRC_GET_CONFORMANCE_LAYER_HANDLE_COUNT_FUNCTION_NAME, &function))) {
+            m_getHandleCount = reinterpret_cast<PFN_xrcGetConformanceLayerHandleCount>(function);
+        }
+    }
+
+    uint32_t XrHandleCounter::Count(XrObjectType objectType) const
+    {
+        uint32_t count = 0;
+        if (m_getHandleCount == nullptr || XR_FAILED(m_getHandleCount(m_instance, objectType, &count))) {
+            return 0;
+        }
+        return count;
+    }
+
+    DurationPercentiles LatencyWindow::TakePercentiles()
+    {
+        const DurationPercentiles percentiles = ComputeDurationPercentiles(m_latencies);
+        m_latencies.clear();
+        return percentiles;
+    }
+
+    SoakTrend ComputeSoakTrend(const std::vector<SoakSample>& samples)
+    {
+        SoakTrend trend;
+        if (samples.size() < 2) {
+            return trend;
+        }
+        const size_t quarter = std::max(samples.size() / 4, (size_t)1);
+        const size_t lastBegin = samples.size() - quarter;
+        auto growth = [&](double (*value)(const SoakSample&)) {
+            return (int64_t)(AverageOf(samples, lastBegin, samples.size(), value) - AverageOf(samples, 0, quarter, value));
+        };
+        auto ratio = [&](double (*value)(const SoakSample&)) {
+            const double start = AverageOf(samples, 0, quarter, value);
+            return start > 0 ? AverageOf(samples, lastBegin, samples.size(), value) / start : 1.0;
+        };
+
+        trend.residentBytesGrowth = growth([](const SoakSample& sample) { return (double)sample.residentBytes; });
+        trend.processHandlesGrowth = growth([](const SoakSample& sample) { return (double)sample.processHandles; });
+        // Handle counts are exact, so compare the first and last samples.
+        for (size_t i = 0; i < SoakHandleTypes.size(); ++i) {
+            trend.xrHandlesGrowth[i] = (int64_t)samples.back().xrHandles[i] - (int64_t)samples.front().xrHandles[i];
+        }
+        trend.frameIntervalP95Ratio = ratio([](const SoakSample& sample) { return (double)sample.frameInterval.p95.count(); });
+        trend.syncActionsP95Ratio = ratio([](const SoakSample& sample) { return (double)sample.syncActions.p95.count(); });
+        trend.locateSpaceP95Ratio = ratio([](const SoakSample& sample) { return (double)sample.locateSpace.p95.count(); });
+        trend.endFrameP95Ratio = ratio([](const SoakSample& sample) { return (double)sample.endFrame.p95.count(); });
+        return trend;
+    }
+
+    bool WriteSoakCsv(const std::string& path, const std::vector<SoakSample>& samples)
+    {
+        std::ofstream file(path);
+        file << "frame,elapsedSeconds,residentBytes,processHandles";
+        for (const char* name : SoakHandleTypeNames) {
+            file << ",xrHandles_" << name;
+        }
+        for (const char* call : {"frameInterval", "syncActions", "locateSpace", "endFrame"}) {
+            for (const char* statistic : {"P50Ms", "P95Ms", "P99Ms", "MaxMs"}) {
+                file << ',' << call << statistic;
+            }
+        }
+        file << '\n';
+
+        auto writePercentiles = [&](const DurationPercentiles& percentiles) {
+            using ms = std::chrono::duration<double, std::milli>;
+            for (std::chrono::nanoseconds value : {percentiles.p50, percentiles.p95, percentiles.p99, percentiles.max}) {
+                file << ',' << std::chrono::duration_cast<ms>(value).count();
+            }
+        };
+        for (const SoakSample& sample : samples) {
+            file << sample.frame << ',' << sample.elapsedSeconds << ',' << sample.residentBytes << ',' << sample.processHandles;
+            for (uint32_t count : sample.xrHandles) {
+                file << ',' << count;
+            }
+            writePercentiles(sample.frameInterval);
+            writePercentiles(sample.syncActions);
+            writePercentiles(sample.locateSpace);
+            writePercentiles(sample.endFrame);
+            file << '\n';
+        }
+        return (bool)file;
+    }
+}  // namespace Conformance
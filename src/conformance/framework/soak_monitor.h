@@ -0,0 +1,127 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "frame_pacing.h"
+#include "conformance_layer/HandleCountQuery.h"
+
+#include <openxr/openxr.h>
+
+#include <array>
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    /// Resident set size of this process. Returns false if the platform does not report it.
+    bool GetProcessResidentMemory(uint64_t& bytes);
+
+    /// Number of open operating system handles (file descriptors on POSIX) of this process, which includes those opened by
+    /// the runtime in this process. Returns false if the platform does not report it.
+    bool GetProcessHandleCount(uint64_t& count);
+
+    /// Counts the handles an instance has open, through the conformance layer's handle registry.
+    class XrHandleCounter
+    {
+    public:
+        explicit XrHandleCounter(XrInstance instance);
+
+        /// False if the conformance layer is not enabled.
+        bool IsAvailable() const
+        {
+            return m_getHandleCount != nullptr;
+        }
+
+        /// Returns 0 if the layer is not available.
+        uint32_t Count(XrObjectType objectType) const;
+
+    private:
+        XrInstance m_instance;
+        PFN_xrcGetConformanceLayerHandleCount m_getHandleCount{nullptr};
+    };
+
+    /// Latencies of one call over the frames between two samples, kept in a buffer allocated up front.
+    class LatencyWindow
+    {
+    public:
+        explicit LatencyWindow(size_t capacity)
+        {
+            m_latencies.reserve(capacity);
+        }
+
+        /// Latencies beyond the capacity are dropped rather than growing the buffer mid-loop.
+        void Add(std::chrono::nanoseconds latency)
+        {
+            if (m_latencies.size() < m_latencies.capacity()) {
+                m_latencies.push_back(latency);
+            }
+        }
+
+        /// Percentiles of the latencies added since the last call, then start a new window.
+        DurationPercentiles TakePercentiles();
+
+    private:
+        std::vector<std::chrono::nanoseconds> m_latencies;
+    };
+
+    /// The object types whose open handles are sampled.
+    constexpr std::array<XrObjectType, 5> SoakHandleTypes{{XR_OBJECT_TYPE_SESSION, XR_OBJECT_TYPE_SPACE, XR_OBJECT_TYPE_SWAPCHAIN,
+                                                           XR_OBJECT_TYPE_ACTION_SET, XR_OBJECT_TYPE_ACTION}};
+    constexpr std::array<const char*, SoakHandleTypes.size()> SoakHandleTypeNames{
+        {"session", "space", "swapchain", "actionSet", "action"}};
+
+    /// Index of @p objectType in SoakHandleTypes, and so in SoakSample::xrHandles, or SoakHandleTypes.size() if it is not
+    /// sampled.
+    constexpr size_t SoakHandleTypeIndex(XrObjectType objectType)
+    {
+        for (size_t i = 0; i < SoakHandleTypes.size(); ++i) {
+            if (SoakHandleTypes[i] == objectType) {
+                return i;
+            }
+        }
+        return SoakHandleTypes.size();
+    }
+
+    /// State of the process and latency of the frame loop calls, sampled every few frames of a soak run.
+    struct SoakSample
+    {
+        uint64_t frame{0};
+        double elapsedSeconds{0};
+        /// 0 if not reported by the platform
+        uint64_t residentBytes{0};
+        /// 0 if not reported by the platform
+        uint64_t processHandles{0};
+        /// Open XR handles of each of SoakHandleTypes, 0 without the conformance layer
+        std::array<uint32_t, SoakHandleTypes.size()> xrHandles{};
+
+        /// From the start of one frame's callback to the start of the next: includes xrWaitFrame and xrBeginFrame.
+        DurationPercentiles frameInterval;
+        DurationPercentiles syncActions;
+        DurationPercentiles locateSpace;
+        DurationPercentiles endFrame;
+    };
+
+    /// Growth between the start and end of a soak run, comparing the average of the first and last quarter of the samples
+    /// so that a single spike does not count as a trend.
+    struct SoakTrend
+    {
+        int64_t residentBytesGrowth{0};
+        int64_t processHandlesGrowth{0};
+        std::array<int64_t, SoakHandleTypes.size()> xrHandlesGrowth{};
+        /// Ratio of the p95 latency at the end to the p95 latency at the start: 1 means no change.
+        double frameIntervalP95Ratio{1};
+        double syncActionsP95Ratio{1};
+        double locateSpaceP95Ratio{1};
+        double endFrameP95Ratio{1};
+    };
+
+    /// Needs at least two samples to find a trend.
+    SoakTrend ComputeSoakTrend(const std::vector<SoakSample>& samples);
+
+    /// Write one line per sample, with durations in milliseconds. Returns false if the file could not be written.
+    bool WriteSoakCsv(const std::string& path, const std::vector<SoakSample>& samples);
+}  // namespace Conformance
@@ -0,0 +1,127 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "space_locator.h"
+
+#include "conformance_framework.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Conformance
+{
+    SpaceLocator::SpaceLocator(XrInstance instance, XrSession session, bool allowBatching) : m_session(session)
+    {
+        if (allowBatching) {
+            // The extension and the core function have the same signature and structures.
+            m_locateSpaces = GetInstanceExtensionFunctionNoexcept<PFN_xrLocateSpacesKHR>(instance, "xrLocateSpacesKHR");
+            if (m_locateSpaces == nullptr) {
+                m_locateSpaces = GetInstanceExtensionFunctionNoexcept<PFN_xrLocateSpacesKHR>(instance, "xrLocateSpaces");
+            }
+        }
+    }
+
+    SpaceLocator::Ticket SpaceLocator::Request(XrSpace space, XrSpace baseSpace, XrTime time)
+    {
+        m_requests.push_back({space, baseSpace, time});
+        m_locations.push_back({0, XrPosef{{0, 0, 0, 1}, {0, 0, 0}}});
+        return m_requests.size() - 1;
+    }
+
+    XrResult SpaceLocator::Resolve()
+    {
+        m_order.clear();
+        for (Ticket ticket = m_resolvedCount; ticket < m_requests.size(); ++ticket) {
+            m_order.push_back(ticket);
+        }
+        m_resolvedCount = m_requests.size();
+
+        // Group the requests by base space and time, keeping the order of the requests within each group.
+        const auto groupLess = [this](Ticket a, Ticket b) {
+            const PendingRequest& requestA = m_requests[a];
+            const PendingRequest& requestB = m_requests[b];
+            if (requestA.baseSpace != requestB.baseSpace) {
+                return std::less<XrSpace>()(requestA.baseSpace, requestB.baseSpace);
+            }
+            return requestA.time < requestB.time;
+        };
+        std::stable_sort(m_order.begin(), m_order.end(), groupLess);
+
+        XrResult firstFailure = XR_SUCCESS;
+        for (size_t begin = 0; begin < m_order.size();) {
+            size_t end = begin + 1;
+            while (end < m_order.size() && !groupLess(m_order[begin], m_order[end])) {
+                ++end;
+            }
+            const XrResult result = LocateGroup(begin, end);
+            if (XR_FAILED(result) && XR_SUCCEEDED(firstFailure)) {
+                firstFailure = result;
+            }
+            begin = end;
+        }
+        return firstFailure;
+    }
+
+    XrSpaceLocation SpaceLocator::GetLocation(Ticket ticket) const
+    {
+        XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+        location.locationFlags = m_locations[ticket].locationFlags;
+        location.pose = m_locations[ticket].pose;
+        return location;
+    }
+
+    void SpaceLocator::Clear()
+    {
+        m_requests.clear();
+        m_locations.clear();
+        m_resolvedCount = 0;
+    }
+
+    XrResult SpaceLocator::LocateGroup(size_t begin, size_t end)
+    {
+        const PendingRequest& first = m_requests[m_order[begin]];
+
+        if (m_locateSpaces == nullptr) {
+            XrResult firstFailure = XR_SUCCESS;
+            for (size_t i = begin; i < end; ++i) {
+                const PendingRequest& request = m_requests[m_order[i]];
+                XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+                const XrResult result = xrLocateSpace(request.space, request.baseSpace, request.time, &location);
+                m_runtimeCallCount++;
+                if (XR_FAILED(result)) {
+                    if (XR_SUCCEEDED(firstFailure)) {
+                        firstFailure = result;
+                    }
+                    continue;
+                }
+                m_locations[m_order[i]] = {location.locationFlags, location.pose};
+            }
+            return firstFailure;
+        }
+
+        m_groupSpaces.clear();
+        for (size_t i = begin; i < end; ++i) {
+            m_groupSpaces.push_back(m_requests[m_order[i]].space);
+        }
+        m_groupLocations.resize(m_groupSpaces.size());
+
+        XrSpacesLocateInfoKHR locateInfo{XR_TYPE_SPACES_LOCATE_INFO_KHR};
+        locateInfo.baseSpace = first.baseSpace;
+        locateInfo.time = first.time;
+        locateInfo.spaceCount = (uint32_t)m_groupSpaces.size();
+        locateInfo.spaces = m_groupSpaces.data();
+        XrSpaceLocationsKHR locations{XR_TYPE_SPACE_LOCATIONS_KHR};
+        locations.locationCount = (uint32_t)m_groupLocations.size();
+        locations.locations = m_groupLocations.data();
+        const XrResult result = m_locateSpaces(m_session, &locateInfo, &locations);
+        m_runtimeCallCount++;
+        if (XR_FAILED(result)) {
+            return result;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            m_locations[m_order[i]] = m_groupLocations[i - begin];
+        }
+        return result;
+    }
+}  // namespace Conformance
@@ -0,0 +1,82 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Conformance
+{
+    /// Locates many spaces per frame with as few runtime calls as possible.
+    ///
+    /// Code that needs several space locations queues them with Request, then calls Resolve once, for instance each frame.
+    /// Requests with the same base space and time are located together in one xrLocateSpacesKHR call, or xrLocateSpaces
+    /// on an OpenXR 1.1 instance, if either is available. Otherwise each request falls back to its own xrLocateSpace call,
+    /// so callers need not care which is used.
+    ///
+    /// Only poses and location flags are located; use xrLocateSpace directly for velocities.
+    class SpaceLocator
+    {
+    public:
+        /// Identifies a request within the batch being built, until the next Clear.
+        using Ticket = size_t;
+
+        /// Looks up xrLocateSpacesKHR, then xrLocateSpaces, on @p instance, falling back to xrLocateSpace if neither is
+        /// available. Set @p allowBatching to false to always use xrLocateSpace, for comparison.
+        SpaceLocator(XrInstance instance, XrSession session, bool allowBatching = true);
+
+        /// Whether requests are located in batches, rather than one xrLocateSpace call each.
+        bool IsBatched() const
+        {
+            return m_locateSpaces != nullptr;
+        }
+
+        /// Queues locating @p space relative to @p baseSpace at @p time.
+        Ticket Request(XrSpace space, XrSpace baseSpace, XrTime time);
+
+        /// Locates every request queued since the last Clear that has not been located yet.
+        /// Returns the first failure, if any; the requests of a failed call keep empty location flags.
+        XrResult Resolve();
+
+        /// The location found for @p ticket by the last Resolve.
+        XrSpaceLocation GetLocation(Ticket ticket) const;
+
+        /// Forgets all requests, to start the next frame. Keeps the allocated memory.
+        void Clear();
+
+        /// Number of runtime calls made by Resolve since construction.
+        uint64_t GetRuntimeCallCount() const
+        {
+            return m_runtimeCallCount;
+        }
+
+    private:
+        struct PendingRequest
+        {
+            XrSpace space;
+            XrSpace baseSpace;
+            XrTime time;
+        };
+
+        XrResult LocateGroup(size_t begin, size_t end);
+
+        XrSession m_session;
+        PFN_xrLocateSpacesKHR m_locateSpaces{nullptr};
+        uint64_t m_runtimeCallCount{0};
+
+        std::vector<PendingRequest> m_requests;
+        std::vector<XrSpaceLocationDataKHR> m_locations;
+        /// Number of requests, from the start, located by an earlier Resolve.
+        size_t m_resolvedCount{0};
+
+        // Scratch space for Resolve, reused to avoid reallocating.
+        std::vector<Ticket> m_order;
+        std::vector<XrSpace> m_groupSpaces;
+        std::vector<XrSpaceLocationDataKHR> m_groupLocations;
+    };
+}  // namespace Conformance
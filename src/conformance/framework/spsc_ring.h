@@ -0,0 +1,64 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <stddef.h>
+
+namespace Conformance
+{
+    /// Fixed-capacity lock-free queue between exactly one producer thread and one consumer thread.
+    /// Neither side ever blocks or allocates: TryPush fails when the ring is full and TryPop when it is empty.
+    template <typename T, size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        /// Producer thread only.
+        bool TryPush(const T& value)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_producerTail == Capacity) {
+                // Only look at the consumer's index when the last one seen says the ring is full, so that the producer
+                // does not pull in the consumer's cache line on every push.
+                m_producerTail = m_tail.load(std::memory_order_acquire);
+                if (head - m_producerTail == Capacity) {
+                    return false;
+                }
+            }
+            m_items[head & (Capacity - 1)] = value;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Consumer thread only.
+        bool TryPop(T& value)
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_consumerHead) {
+                m_consumerHead = m_head.load(std::memory_order_acquire);
+                if (tail == m_consumerHead) {
+                    return false;
+                }
+            }
+            value = m_items[tail & (Capacity - 1)];
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        // Each side's index and its cached copy of the other side's index are padded onto a cache line of their own.
+        // Padding rather than alignas keeps the ring allocatable with new before C++17.
+        std::atomic<size_t> m_head{0};
+        size_t m_producerTail{0};
+        char m_producerPadding[64]{};
+        std::atomic<size_t> m_tail{0};
+        size_t m_consumerHead{0};
+        char m_consumerPadding[64]{};
+        std::array<T, Capacity> m_items{};
+    };
+}  // namespace Conformance
@@ -0,0 +1,60 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "swapchain_probe.h"
+
+#include "conformance_framework.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace Conformance
+{
+    namespace
+    {
+        SwapchainProbeResult ProbeSwapchain(XrSession session, const XrSwapchainCreateInfo& createInfo)
+        {
+            SwapchainProbeResult result;
+            XrSwapchain swapchain{XR_NULL_HANDLE};
+            result.createResult = xrCreateSwapchain(session, &createInfo, &swapchain);
+            if (XR_FAILED(result.createResult)) {
+                return result;
+            }
+
+            result.enumerateResult = xrEnumerateSwapchainImages(swapchain, 0, &result.imageCount, nullptr);
+            result.destroyResult = xrDestroySwapchain(swapchain);
+            return result;
+        }
+    }  // namespace
+
+    std::vector<SwapchainProbeResult> RunSwapchainProbes(XrSession session, const std::vector<XrSwapchainCreateInfo>& createInfos,
+                                                         uint32_t threadCount)
+    {
+        std::vector<SwapchainProbeResult> results(createInfos.size());
+
+        // Each worker claims the next unprobed index, so the load balances however long each probe takes,
+        // and writes only its own elements of the preallocated results.
+        std::atomic<size_t> nextIndex{0};
+        auto worker = [&] {
+            ATTACH_THREAD;
+            for (size_t i = nextIndex++; i < createInfos.size(); i = nextIndex++) {
+                results[i] = ProbeSwapchain(session, createInfos[i]);
+            }
+            DETACH_THREAD;
+        };
+
+        const size_t workerCount = std::min<size_t>(std::max<uint32_t>(threadCount, 1), createInfos.size());
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers.emplace_back(worker);
+        }
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+
+        return results;
+    }
+}  // namespace Conformance
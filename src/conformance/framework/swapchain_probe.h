@@ -0,0 +1,38 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace Conformance
+{
+    /// What happened to one XrSwapchainCreateInfo passed to RunSwapchainProbes.
+    struct SwapchainProbeResult
+    {
+        XrResult createResult{XR_RESULT_MAX_ENUM};
+        /// Result of the count query of xrEnumerateSwapchainImages. Only set if the swapchain was created.
+        XrResult enumerateResult{XR_RESULT_MAX_ENUM};
+        /// Image count reported by xrEnumerateSwapchainImages.
+        uint32_t imageCount{0};
+        /// Only set if the swapchain was created.
+        XrResult destroyResult{XR_RESULT_MAX_ENUM};
+    };
+
+    /// Creates a swapchain from each of @p createInfos on @p session, queries its image count and destroys it again,
+    /// spreading the probes over @p threadCount worker threads (at least one).
+    ///
+    /// The probes are independent, so they exercise xrCreateSwapchain, xrEnumerateSwapchainImages and xrDestroySwapchain
+    /// being called concurrently on one session. Element i of the returned vector always belongs to @p createInfos[i],
+    /// whatever order the probes ran in, so the caller can check them deterministically.
+    ///
+    /// The workers only make OpenXR calls: no Catch2 assertions and no graphics plugin calls. With OpenGL, the caller must
+    /// release the context from its thread for the duration (see IGraphicsPlugin::MakeCurrent), since the context must not
+    /// be bound on another thread while the runtime uses it.
+    std::vector<SwapchainProbeResult> RunSwapchainProbes(XrSession session, const std::vector<XrSwapchainCreateInfo>& createInfos,
+                                                         uint32_t threadCount);
+}  // namespace Conformance
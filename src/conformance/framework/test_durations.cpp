@@ -0,0 +1,154 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "test_durations.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+
+namespace Conformance
+{
+    namespace
+    {
+        constexpr char Separator = '\t';
+        constexpr const char* FileHeader = "# OpenXR CTS test durations: key, path, seconds";
+
+        std::string MakeEntryName(const std::string& key, const std::string& path)
+        {
+            return key + Separator + path;
+        }
+    }  // namespace
+
+    std::string TestDurationDatabase::MakeKey(const char* runtimeName, XrVersion runtimeVersion, const std::string& graphicsPlugin)
+    {
+        std::string key = std::string(runtimeName) + " " + std::to_string(XR_VERSION_MAJOR(runtimeVersion)) + "." +
+                          std::to_string(XR_VERSION_MINOR(runtimeVersion)) + "." + std::to_string(XR_VERSION_PATCH(runtimeVersion)) +
+                          " " + graphicsPlugin;
+        // The key is the first field of a line.
+        std::replace(key.begin(), key.end(), Separator, ' ');
+        return key;
+    }
+
+    bool TestDurationDatabase::Load(const std::string& path)
+    {
+        m_durations.clear();
+        std::ifstream file(path);
+        if (!file) {
+            return true;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            const size_t keyEnd = line.find(Separator);
+            const size_t pathEnd = line.rfind(Separator);
+            if (keyEnd == std::string::npos || pathEnd == keyEnd) {
+                m_durations.clear();
+                return false;
+            }
+            char* end = nullptr;
+            const double seconds = std::strtod(line.c_str() + pathEnd + 1, &end);
+            if (end == line.c_str() + pathEnd + 1 || seconds < 0) {
+                m_durations.clear();
+                return false;
+            }
+            m_durations[line.substr(0, pathEnd)] = seconds;
+        }
+        return true;
+    }
+
+    bool TestDurationDatabase::MergeInto(const std::string& path) const
+    {
+        TestDurationDatabase merged;
+        if (!merged.Load(path)) {
+            return false;
+        }
+        for (const auto& entry : m_durations) {
+            merged.m_durations[entry.first] = entry.second;
+        }
+
+        // Write a temporary file and replace the database with it, so that readers never see a partial file.
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath);
+            file << FileHeader << "\n";
+            char seconds[32];
+            for (const auto& entry : merged.m_durations) {
+                snprintf(seconds, sizeof(seconds), "%.6f", entry.second);
+                file << entry.first << Separator << seconds << "\n";
+            }
+            if (!file) {
+                return false;
+            }
+        }
+        std::remove(path.c_str());
+        return std::rename(tempPath.c_str(), path.c_str()) == 0;
+    }
+
+    void TestDurationDatabase::Add(const std::string& key, const std::string& path, double seconds)
+    {
+        m_durations[MakeEntryName(key, path)] += seconds;
+    }
+
+    bool TestDurationDatabase::TryGetDuration(const std::string& key, const std::string& path, double& seconds) const
+    {
+        auto it = m_durations.find(MakeEntryName(key, path));
+        if (it == m_durations.end()) {
+            return false;
+        }
+        seconds = it->second;
+        return true;
+    }
+
+    std::vector<TestDurationRegression> TestDurationDatabase::FindRegressions(const TestDurationDatabase& previous, const std::string& key,
+                                                                              double thresholdFraction, double minimumSeconds) const
+    {
+        const std::string prefix = key + Separator;
+        std::vector<TestDurationRegression> regressions;
+        for (auto it = m_durations.lower_bound(prefix); it != m_durations.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+             ++it) {
+            auto previousIt = previous.m_durations.find(it->first);
+            if (previousIt == previous.m_durations.end()) {
+                continue;
+            }
+            const double previousSeconds = previousIt->second;
+            const double currentSeconds = it->second;
+            if (currentSeconds - previousSeconds >= minimumSeconds && currentSeconds > previousSeconds * (1.0 + thresholdFraction)) {
+                regressions.push_back({it->first.substr(prefix.size()), previousSeconds, currentSeconds});
+            }
+        }
+        return regressions;
+    }
+
+    std::vector<size_t> AssignShardsLongestFirst(const std::vector<double>& durations, size_t shardCount)
+    {
+        double knownTotal = 0;
+        size_t knownCount = 0;
+        for (double duration : durations) {
+            if (duration >= 0) {
+                knownTotal += duration;
+                knownCount++;
+            }
+        }
+        const double unknownDuration = knownCount > 0 ? knownTotal / (double)knownCount : 1.0;
+
+        std::vector<size_t> order(durations.size());
+        std::iota(order.begin(), order.end(), (size_t)0);
+        auto predicted = [&](size_t i) { return durations[i] >= 0 ? durations[i] : unknownDuration; };
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return predicted(a) > predicted(b); });
+
+        std::vector<size_t> shards(durations.size(), 0);
+        std::vector<double> shardTotals(std::max(shardCount, (size_t)1), 0.0);
+        for (size_t i : order) {
+            const size_t shard = (size_t)(std::min_element(shardTotals.begin(), shardTotals.end()) - shardTotals.begin());
+            shards[i] = shard;
+            shardTotals[shard] += predicted(i);
+        }
+        return shards;
+    }
+}  // namespace Conformance
@@ -0,0 +1,76 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <map>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Conformance
+{
+    /// A test case or section whose duration grew by more than the allowed fraction since it was last recorded.
+    struct TestDurationRegression
+    {
+        std::string path;
+        double previousSeconds;
+        double currentSeconds;
+    };
+
+    /// Durations of test cases and their sections, stored in a local text file between runs.
+    ///
+    /// Durations are keyed by runtime and graphics plugin, since the same test can take very different times on each.
+    /// Each line of the file holds a key, a path and a duration in seconds, separated by tabs.
+    /// A path is the test case name for the whole test case, or the test case name followed by each section name,
+    /// separated by '/', for a section.
+    class TestDurationDatabase
+    {
+    public:
+        /// Identify the runtime configuration that durations were measured with.
+        static std::string MakeKey(const char* runtimeName, XrVersion runtimeVersion, const std::string& graphicsPlugin);
+
+        /// Replace the contents with the file at @p path. A missing file is an empty database.
+        /// Returns false if the file exists but cannot be parsed.
+        bool Load(const std::string& path);
+
+        /// Merge the durations of this database into the file at @p path, keeping the entries of the file that are not
+        /// in this database. Re-reads the file first so that other runs writing to it in the meantime are not lost.
+        bool MergeInto(const std::string& path) const;
+
+        /// Add to the duration recorded for @p path. Sections run once per leaf section and generator value,
+        /// so their durations accumulate over the run.
+        void Add(const std::string& key, const std::string& path, double seconds);
+
+        /// Returns false if nothing is recorded for @p path.
+        bool TryGetDuration(const std::string& key, const std::string& path, double& seconds) const;
+
+        /// Find the entries of this database that took more than (1 + @p thresholdFraction) times their duration
+        /// in @p previous, ignoring changes smaller than @p minimumSeconds.
+        std::vector<TestDurationRegression> FindRegressions(const TestDurationDatabase& previous, const std::string& key,
+                                                            double thresholdFraction, double minimumSeconds) const;
+
+        bool empty() const
+        {
+            return m_durations.empty();
+        }
+
+        void clear()
+        {
+            m_durations.clear();
+        }
+
+    private:
+        /// Keyed by key and path, joined with a tab.
+        std::map<std::string, double> m_durations;
+    };
+
+    /// Assign test cases to @p shardCount shards so that their predicted durations are balanced:
+    /// longest first, each to the shard with the least predicted duration so far.
+    /// A negative duration is unknown and predicted as the average of the known ones.
+    /// Returns the shard of each test case. Ties are broken by test case order, so every process computes the same assignment.
+    std::vector<size_t> AssignShardsLongestFirst(const std::vector<double>& durations, size_t shardCount);
+}  // namespace Conformance
@@ -0,0 +1,165 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "view_culling.h"
+
+#include "common/xr_linear.h"
+#include "utilities/xr_linear_batch.h"
+#include "utilities/xr_math_operators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Conformance
+{
+    using namespace openxr::math_operators;
+
+    namespace
+    {
+        static_assert(sizeof(DrawableParams) == sizeof(XrPosef) + sizeof(XrVector3f),
+                      "DrawableParams are compared bitwise, so must have no padding");
+
+        template <typename T>
+        bool BitwiseEqual(const std::vector<T>& a, const std::vector<T>& b)
+        {
+            return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+        }
+    }  // namespace
+
+    DrawableBounds ComputeBounds(span<const Geometry::Vertex> vertices)
+    {
+        DrawableBounds bounds;
+        if (vertices.empty()) {
+            return bounds;
+        }
+        bounds.mins = vertices[0].Position;
+        bounds.maxs = vertices[0].Position;
+        for (const Geometry::Vertex& vertex : vertices) {
+            XrVector3f_Min(&bounds.mins, &bounds.mins, &vertex.Position);
+            XrVector3f_Max(&bounds.maxs, &bounds.maxs, &vertex.Position);
+        }
+        return bounds;
+    }
+
+    bool MakeCombinedViewProjection(XrMatrix4x4f* result, span<const XrView> views, float nearZ, float farZ)
+    {
+        if (views.empty()) {
+            return false;
+        }
+
+        // Orientations that differ by less than this are treated as the same, a small fraction of a pixel at any resolution.
+        constexpr float orientationTolerance = 1e-6f;
+        const XrQuaternionf orientation = views[0].pose.orientation;
+        float tanLeft = 0, tanRight = 0, tanUp = 0, tanDown = 0;
+        XrVector3f center{0, 0, 0};
+        for (const XrView& view : views) {
+            const XrQuaternionf& q = view.pose.orientation;
+            const float dot = q.x * orientation.x + q.y * orientation.y + q.z * orientation.z + q.w * orientation.w;
+            if (std::fabs(dot) < 1.0f - orientationTolerance) {
+                return false;
+            }
+            tanLeft = std::min(tanLeft, std::tan(view.fov.angleLeft));
+            tanRight = std::max(tanRight, std::tan(view.fov.angleRight));
+            tanUp = std::max(tanUp, std::tan(view.fov.angleUp));
+            tanDown = std::min(tanDown, std::tan(view.fov.angleDown));
+            center = center + view.pose.position;
+        }
+        if (!(tanLeft < 0 && tanRight > 0 && tanUp > 0 && tanDown < 0)) {
+            return false;
+        }
+        center = center * (1.0f / (float)views.size());
+
+        // In the shared view space, looking down -Z, move the apex back along +Z by `back` so that each view frustum is
+        // inside the combined one: a view at offset o needs o.x <= tanRight * (back - o.z), and so on for each side.
+        XrQuaternionf inverseOrientation;
+        XrQuaternionf_Invert(&inverseOrientation, &orientation);
+        float back = 0;
+        float minZ = 0;
+        for (const XrView& view : views) {
+            const XrVector3f offsetWorld = view.pose.position - center;
+            XrVector3f offset;
+            XrQuaternionf_RotateVector3f(&offset, &inverseOrientation, &offsetWorld);
+            back = std::max({back, offset.z, offset.z + offset.x / tanRight, offset.z + offset.x / tanLeft,
+                             offset.z + offset.y / tanUp, offset.z + offset.y / tanDown});
+            minZ = std::min(minZ, offset.z);
+        }
+
+        // Each view's near plane is at least back - offset.z >= 0 further from the apex than its own near distance,
+        // and its far plane at most back - minZ further.
+        XrMatrix4x4f projection;
+        XrMatrix4x4f_CreateProjection(&projection, GRAPHICS_OPENGL, tanLeft, tanRight, tanUp, tanDown, nearZ, farZ + back - minZ);
+
+        const XrVector3f apexOffset{0, 0, back};
+        XrVector3f apex;
+        XrQuaternionf_RotateVector3f(&apex, &orientation, &apexOffset);
+        const XrPosef apexPose{orientation, center + apex};
+        *result = projection * Matrix::InvertRigidBody(Matrix::FromPose(apexPose));
+        return true;
+    }
+
+    ViewCuller::ViewCuller() : m_cubeBounds(ComputeBounds(Geometry::c_cubeVertices))
+    {
+    }
+
+    void ViewCuller::Cull(const XrMatrix4x4f& viewProjection, const RenderParams& params, const MeshBoundsGetter& getMeshBounds,
+                          const GLTFBoundsGetter& getGLTFBounds)
+    {
+        const XrMatrix4x4f& cullingViewProjection = params.cullingViewProjection ? *params.cullingViewProjection : viewProjection;
+
+        m_cubeCount = params.cubes.size();
+        m_meshCount = params.meshes.size();
+        m_drawables.clear();
+        m_localMins.clear();
+        m_localMaxs.clear();
+        const auto add = [this](const DrawableParams& drawable, const DrawableBounds& bounds) {
+            m_drawables.push_back(drawable);
+            m_localMins.push_back(bounds.mins);
+            m_localMaxs.push_back(bounds.maxs);
+        };
+        for (const Cube& cube : params.cubes) {
+            add(cube.params, m_cubeBounds);
+        }
+        for (const MeshDrawable& mesh : params.meshes) {
+            add(mesh.params, getMeshBounds(mesh.handle));
+        }
+        for (const GLTFDrawable& gltf : params.glTFs) {
+            add(gltf.params, getGLTFBounds(gltf.handle));
+        }
+        const size_t count = m_drawables.size();
+
+        const bool sameAsPrevious =
+            m_hasPrevious && std::memcmp(&cullingViewProjection, &m_previousViewProjection, sizeof(XrMatrix4x4f)) == 0 &&
+            BitwiseEqual(m_drawables, m_previousDrawables) && BitwiseEqual(m_localMins, m_previousLocalMins) &&
+            BitwiseEqual(m_localMaxs, m_previousLocalMaxs);
+        if (sameAsPrevious) {
+            m_statistics.sharedPasses++;
+        }
+        else {
+            m_modelMatrices.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                const DrawableParams& drawable = m_drawables[i];
+                m_modelMatrices[i] =
+                    Matrix::FromTranslationRotationScale(drawable.pose.position, drawable.pose.orientation, drawable.scale);
+            }
+            m_worldMins.resize(count);
+            m_worldMaxs.resize(count);
+            LinearBatch::TransformBounds(m_worldMins.data(), m_worldMaxs.data(), m_modelMatrices.data(), m_localMins.data(),
+                                         m_localMaxs.data(), count);
+            m_culled.resize(count);
+            m_culledCount =
+                LinearBatch::CullBounds(m_culled.data(), cullingViewProjection, m_worldMins.data(), m_worldMaxs.data(), count);
+
+            m_previousViewProjection = cullingViewProjection;
+            m_hasPrevious = true;
+        }
+        // Keep this call's inputs for comparison with the next one, and reuse the older buffers next time.
+        std::swap(m_drawables, m_previousDrawables);
+        std::swap(m_localMins, m_previousLocalMins);
+        std::swap(m_localMaxs, m_previousLocalMaxs);
+
+        m_statistics.culled += m_culledCount;
+        m_statistics.drawn += count - m_culledCount;
+    }
+}  // namespace Conformance
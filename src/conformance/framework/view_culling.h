@@ -0,0 +1,110 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "graphics_plugin.h"
+#include "utilities/Geometry.h"
+
+#include <openxr/openxr.h>
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Conformance
+{
+    /// Axis-aligned bounds of a drawable in its own space, before its DrawableParams are applied.
+    /// Bounds with `maxs <= mins` are empty, and are never culled.
+    struct DrawableBounds
+    {
+        XrVector3f mins{0, 0, 0};
+        XrVector3f maxs{0, 0, 0};
+    };
+
+    /// Near and far plane distances of the projection the OpenGL and Vulkan IGraphicsPlugin::RenderView draw with.
+    constexpr float RenderViewNearZ = 0.05f;
+    constexpr float RenderViewFarZ = 100.0f;
+
+    /// Bounds of the positions of @p vertices, or empty bounds if there are none.
+    DrawableBounds ComputeBounds(span<const Geometry::Vertex> vertices);
+
+    /// Makes a view-projection matrix whose frustum contains the frusta of all of @p views, to cull once for all of them
+    /// with RenderParams::CullWith. The frusta match those IGraphicsPlugin::RenderView draws with when @p nearZ and
+    /// @p farZ are RenderViewNearZ and RenderViewFarZ.
+    ///
+    /// The combined frustum has the orientation shared by the views and the union of their fields of view, with its apex
+    /// moved back from the middle of the view positions until it contains each of them. Returns false if the views are
+    /// not all oriented the same way or a field of view does not include the view direction, in which case the views
+    /// should be culled separately.
+    bool MakeCombinedViewProjection(XrMatrix4x4f* result, span<const XrView> views, float nearZ, float farZ);
+
+    /// Culls the drawables of RenderParams against a view frustum on the CPU, for IGraphicsPlugin::RenderView
+    /// implementations to skip those entirely outside it.
+    ///
+    /// The drawables are culled as a batch with LinearBatch::TransformBounds and LinearBatch::CullBounds.
+    /// If the drawables, their bounds and the frustum are all the same as for the previous call (for instance each view
+    /// of a frame with RenderParams::CullWith), the previous result is reused instead.
+    class ViewCuller
+    {
+    public:
+        using MeshBoundsGetter = std::function<DrawableBounds(MeshHandle)>;
+        using GLTFBoundsGetter = std::function<DrawableBounds(GLTFModelInstanceHandle)>;
+
+        ViewCuller();
+
+        /// Culls every drawable in @p params against @p viewProjection, or against RenderParams::cullingViewProjection
+        /// if it is set. Cubes are bounded by the standard cube, and meshes and glTF model instances by the bounds
+        /// returned for their handles.
+        void Cull(const XrMatrix4x4f& viewProjection, const RenderParams& params, const MeshBoundsGetter& getMeshBounds,
+                  const GLTFBoundsGetter& getGLTFBounds);
+
+        /// Whether element @p index of RenderParams::cubes, meshes or glTFs passed to the last Cull() should be drawn.
+        ///@{
+        bool IsCubeVisible(size_t index) const
+        {
+            return m_culled[index] == 0;
+        }
+        bool IsMeshVisible(size_t index) const
+        {
+            return m_culled[m_cubeCount + index] == 0;
+        }
+        bool IsGLTFVisible(size_t index) const
+        {
+            return m_culled[m_cubeCount + m_meshCount + index] == 0;
+        }
+        ///@}
+
+        const ViewCullingStatistics& GetStatistics() const
+        {
+            return m_statistics;
+        }
+
+    private:
+        DrawableBounds m_cubeBounds;
+        ViewCullingStatistics m_statistics;
+
+        size_t m_cubeCount{0};
+        size_t m_meshCount{0};
+        std::vector<uint8_t> m_culled;
+        size_t m_culledCount{0};
+
+        // The drawables and frustum of this call and of the previous one, to tell whether the previous result still applies.
+        std::vector<DrawableParams> m_drawables;
+        std::vector<XrVector3f> m_localMins;
+        std::vector<XrVector3f> m_localMaxs;
+        std::vector<DrawableParams> m_previousDrawables;
+        std::vector<XrVector3f> m_previousLocalMins;
+        std::vector<XrVector3f> m_previousLocalMaxs;
+        XrMatrix4x4f m_previousViewProjection{};
+        bool m_hasPrevious{false};
+
+        // Scratch space, reused to avoid reallocating.
+        std::vector<XrMatrix4x4f> m_modelMatrices;
+        std::vector<XrVector3f> m_worldMins;
+        std::vector<XrVector3f> m_worldMaxs;
+    };
+}  // namespace Conformance
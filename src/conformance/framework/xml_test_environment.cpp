@@ -13,8 +13,6 @@
 
 #include <chrono>
 
-#define CTS_XML_NS_PREFIX "cts"
-#define CTS_XML_NS_PREFIX_QUALIFIER CTS_XML_NS_PREFIX ":"
 namespace Conformance
 {
     void WriteXmlnsAttribute(Catch::XmlWriter& xml)
@@ -46,6 +44,48 @@ namespace Conformance
             xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "averageBeginWaitTime")
                 .writeAttribute("ms", std::chrono::duration_cast<ms>(timing.GetAverageBeginWaitTime()).count());
             xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "overhead").writeAttribute("percent", timing.GetOverheadFactor() * 100.f);
+
+            const FramePacingStatistics& pacing = timing.GetFramePacing();
+            auto toMs = [](std::chrono::nanoseconds duration) { return std::chrono::duration_cast<ms>(duration).count(); };
+            auto writePercentiles = [&](const char* name, const DurationPercentiles& percentiles) {
+                xml.scopedElement(name)
+                    .writeAttribute("p50ms", toMs(percentiles.p50))
+                    .writeAttribute("p95ms", toMs(percentiles.p95))
+                    .writeAttribute("p99ms", toMs(percentiles.p99))
+                    .writeAttribute("maxms", toMs(percentiles.max));
+            };
+            auto e3 = xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "framePacing");
+            xml.writeAttribute("frameCount", pacing.frameCount);
+            writePercentiles(CTS_XML_NS_PREFIX_QUALIFIER "waitTime", pacing.waitTime);
+            writePercentiles(CTS_XML_NS_PREFIX_QUALIFIER "beginWaitTime", pacing.beginTime);
+            writePercentiles(CTS_XML_NS_PREFIX_QUALIFIER "frameInterval", pacing.frameInterval);
+            writePercentiles(CTS_XML_NS_PREFIX_QUALIFIER "frameLatency", pacing.frameLatency);
+            xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "missedDeadlines").writeAttribute("count", pacing.missedDeadlines);
+            xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "jitter").writeAttribute("ms", toMs(pacing.jitter));
+            xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "displayTimeDrift").writeAttribute("ms", toMs(pacing.displayTimeDrift));
+        }
+        if (!cr.actionStateScaling.empty()) {
+            using us = std::chrono::duration<float, std::micro>;
+            auto toUs = [](std::chrono::nanoseconds duration) { return std::chrono::duration_cast<us>(duration).count(); };
+            auto writePercentiles = [&](const char* name, const DurationPercentiles& percentiles) {
+                xml.scopedElement(name)
+                    .writeAttribute("p50us", toUs(percentiles.p50))
+                    .writeAttribute("p95us", toUs(percentiles.p95))
+                    .writeAttribute("p99us", toUs(percentiles.p99))
+                    .writeAttribute("maxus", toUs(percentiles.max));
+            };
+            auto e2 = xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "actionStateScaling");
+            for (const ActionStateScalingResult& result : cr.actionStateScaling) {
+                auto e3 = xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "actionCount");
+                xml.writeAttribute("actionSets", result.actionSetCount)
+                    .writeAttribute("actions", result.actionCount)
+                    .writeAttribute("subactionPaths", result.subactionPathCount)
+                    .writeAttribute("queriesPerFrame", result.queriesPerFrame)
+                    .writeAttribute("frameCount", result.frameCount)
+                    .writeAttribute("meanQueryUs", toUs(result.meanQueryTime));
+                writePercentiles(CTS_XML_NS_PREFIX_QUALIFIER "syncActions", result.syncTime);
+                writePercentiles(CTS_XML_NS_PREFIX_QUALIFIER "stateQueries", result.queryTime);
+            }
         }
         if (!cr.swapchainFormats.empty()) {
             auto e2 = xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "swapchainFormats");
@@ -153,6 +193,11 @@ namespace Conformance
 
         xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "fileLineLoggingEnabled").writeAttribute("value", options.fileLineLoggingEnabled);
         xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "pollGetSystem").writeAttribute("value", options.pollGetSystem);
+        xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "exclusiveSessionTests")
+            .writeAttribute("value", options.exclusiveSessionTests);
+        if (options.exclusiveSessionTests != "include") {
+            xml.writeComment("Partial run: combine with the results of the other exclusiveSessionTests mode");
+        }
         xml.scopedElement(CTS_XML_NS_PREFIX_QUALIFIER "debugMode").writeAttribute("value", options.debugMode);
     }
 
@@ -7,6 +7,11 @@
 #include <openxr/openxr.h>
 #include <nonstd/span.hpp>
 
+/// Prefix of the elements and attributes the CTS adds to its XML reports, declared by WriteXmlnsAttribute.
+#define CTS_XML_NS_PREFIX "cts"
+/// Prepend to an element name to put it in the CTS namespace, e.g. `CTS_XML_NS_PREFIX_QUALIFIER "totals"`.
+#define CTS_XML_NS_PREFIX_QUALIFIER CTS_XML_NS_PREFIX ":"
+
 namespace Catch
 {
     class XmlWriter;
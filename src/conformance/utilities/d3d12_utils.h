@@ -24,16 +24,18 @@ namespace Conformance
     Microsoft::WRL::ComPtr<ID3D12Resource> D3D12CreateImage(ID3D12Device* d3d12Device, uint32_t width, uint32_t height, uint16_t arraySize,
                                                             uint16_t mipLevels, DXGI_FORMAT format, D3D12_HEAP_TYPE heapType);
 
+    /// Write @p count elements to a mappable buffer, starting at element @p offset.
     template <typename T>
-    void D3D12BasicUpload(_In_ ID3D12Resource* buffer, _In_reads_(count) const T* data, size_t count)
+    void D3D12BasicUpload(_In_ ID3D12Resource* buffer, _In_reads_(count) const T* data, size_t count, size_t offset = 0)
     {
         void* pData;
         XRC_CHECK_THROW_HRCMD(buffer->Map(0, nullptr, &pData));
 
+        size_t offsetBytes = offset * sizeof(T);
         size_t writeBytes = count * sizeof(T);
-        memcpy(pData, data, writeBytes);
+        memcpy(static_cast<uint8_t*>(pData) + offsetBytes, data, writeBytes);
 
-        D3D12_RANGE writtenRange{0, writeBytes};
+        D3D12_RANGE writtenRange{offsetBytes, offsetBytes + writeBytes};
         buffer->Unmap(0, &writtenRange);
     }
 
@@ -87,6 +89,22 @@ namespace Conformance
             copyCommandList->CopyBufferRegion(resource.Get(), 0, uploadBuffer.Get(), 0, RequiredBytesFor(count));
         }
 
+        /// Like AsyncUpload, but only replaces the @p count elements starting at element @p offset,
+        /// leaving the rest of the buffer as it was.
+        void AsyncUploadRange(ID3D12GraphicsCommandList* copyCommandList, _In_reads_(count) const T* data, size_t offset,
+                              size_t count) const
+        {
+            if (!resource) {
+                throw std::logic_error("Resources not allocated before calling AsyncUploadRange()");
+            }
+            assert(Fits(offset + count));
+
+            D3D12BasicUpload<T>(uploadBuffer.Get(), data, count, offset);
+            const size_t offsetBytes = RequiredBytesFor(offset);
+            copyCommandList->CopyBufferRegion(resource.Get(), offsetBytes, uploadBuffer.Get(), offsetBytes,
+                                              RequiredBytesFor(count));
+        }
+
         /// Get the resource on the GPU, without affecting the reference count.
         ID3D12Resource* GetResource() const noexcept
         {
@@ -19,30 +19,178 @@
 #include "throw_helpers.h"
 
 #include <openxr/openxr.h>
+#include <openxr/openxr_reflection_parent_structs.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
 
 namespace Conformance
 {
+    constexpr std::chrono::milliseconds EventQueue::WaitPollInterval;
 
-    EventQueue::EventQueue(XrInstance instance) : m_instance(instance)
+    EventQueue::EventQueue(XrInstance instance, size_t capacityBytes)
+        : EventQueue([instance](XrEventDataBuffer* eventData) { return xrPollEvent(instance, eventData); }, capacityBytes)
     {
     }
 
+    EventQueue::EventQueue(PollFunction pollEvent, size_t capacityBytes)
+        : m_pollEvent(std::move(pollEvent)), m_ring(std::max(capacityBytes, sizeof(XrEventDataBuffer)))
+    {
+    }
+
+    size_t EventQueue::GetStoredEventCount() const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_storedEvents.size();
+    }
+
+    size_t EventQueue::GetStoredBytes() const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_storedBytes;
+    }
+
+    size_t EventQueue::GetEventSize(XrStructureType type)
+    {
+#define XRC_EVENT_SIZE_CASE(STRUCT_TYPE, TYPE_ENUM) \
+    case TYPE_ENUM:                                 \
+        return sizeof(STRUCT_TYPE);
+#define XRC_EVENT_SIZE_UNAVAILABLE(STRUCT_TYPE, TYPE_ENUM)
+
+        switch ((int)type) {  // int cast so compiler doesn't warn about other enumerants.
+            XR_LIST_ALL_CHILD_STRUCTURE_TYPES_XrEventDataBaseHeader(XRC_EVENT_SIZE_CASE, XRC_EVENT_SIZE_UNAVAILABLE);
+        default:
+            return sizeof(XrEventDataBuffer);
+        }
+
+#undef XRC_EVENT_SIZE_CASE
+#undef XRC_EVENT_SIZE_UNAVAILABLE
+    }
+
     void EventQueue::ReadEvents() const
     {
+        // Poll without holding the lock, then add everything polled at once.
+        std::vector<XrEventDataBuffer> events;
         XrResult pollRes;
         XrEventDataBuffer eventDataBuffer{XR_TYPE_EVENT_DATA_BUFFER};
-        while ((pollRes = xrPollEvent(m_instance, &eventDataBuffer)) == XR_SUCCESS) {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_events.push_back(eventDataBuffer);
+        while ((pollRes = m_pollEvent(&eventDataBuffer)) == XR_SUCCESS) {
+            events.push_back(eventDataBuffer);
             eventDataBuffer.type = XR_TYPE_EVENT_DATA_BUFFER;
             eventDataBuffer.next = nullptr;
         }
 
+        if (!events.empty()) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                for (const XrEventDataBuffer& event : events) {
+                    AddEvent(event);
+                }
+            }
+            m_eventsAdded.notify_all();
+        }
+
         XRC_CHECK_THROW_XRRESULT(pollRes, "xrPollEvent");
     }
 
-    EventReader::EventReader(const EventQueue& eventQueue) : m_eventQueue(eventQueue), m_nextEventIndex(eventQueue.m_events.size())
+    bool EventQueue::WaitForNewEvents(std::chrono::nanoseconds timeout) const
+    {
+        uint64_t endSequence;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            endSequence = m_firstSequence + m_storedEvents.size();
+        }
+        ReadEvents();
+        return WaitForEventsAfter(endSequence, timeout);
+    }
+
+    bool EventQueue::WaitForEventsAfter(uint64_t sequence, std::chrono::nanoseconds timeout) const
     {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_eventsAdded.wait_for(lock, timeout, [&] { return m_firstSequence + m_storedEvents.size() > sequence; });
+    }
+
+    void EventQueue::AddEvent(const XrEventDataBuffer& event) const
+    {
+        if (m_readers.empty()) {
+            // Readers only see events added after they were created, so nobody can read this one.
+            m_firstSequence++;
+            return;
+        }
+
+        const size_t size = std::min(GetEventSize(event.type), sizeof(XrEventDataBuffer));
+
+        // Each event is stored contiguously, so skip the end of the ring if the event does not fit there.
+        auto findSpace = [&](size_t* offset) {
+            if (m_storedEvents.empty()) {
+                *offset = 0;
+                return true;
+            }
+            const size_t readOffset = m_storedEvents.front().offset;
+            if (m_writeOffset > readOffset) {
+                if (m_ring.size() - m_writeOffset >= size) {
+                    *offset = m_writeOffset;
+                    return true;
+                }
+                if (readOffset >= size) {
+                    *offset = 0;
+                    return true;
+                }
+                return false;
+            }
+            // Wrapped around: the free space is between the newest and oldest events.
+            if (readOffset - m_writeOffset >= size) {
+                *offset = m_writeOffset;
+                return true;
+            }
+            return false;
+        };
+
+        size_t offset;
+        while (!findSpace(&offset)) {
+            DropOldestEvent();
+        }
+
+        memcpy(&m_ring[offset], &event, size);
+        m_storedEvents.push_back({offset, size});
+        m_writeOffset = offset + size;
+        m_storedBytes += size;
+    }
+
+    void EventQueue::DropOldestEvent() const
+    {
+        m_storedBytes -= m_storedEvents.front().size;
+        m_storedEvents.pop_front();
+        m_firstSequence++;
+        if (m_storedEvents.empty()) {
+            m_writeOffset = 0;
+        }
+    }
+
+    void EventQueue::ReclaimReadEvents() const
+    {
+        uint64_t firstUnread = m_firstSequence + m_storedEvents.size();
+        for (const EventReader* reader : m_readers) {
+            firstUnread = std::min(firstUnread, reader->m_nextSequence);
+        }
+        while (m_firstSequence < firstUnread) {
+            DropOldestEvent();
+        }
+    }
+
+    EventReader::EventReader(const EventQueue& eventQueue) : m_eventQueue(eventQueue)
+    {
+        std::unique_lock<std::mutex> lock(m_eventQueue.m_mutex);
+        m_nextSequence = m_eventQueue.m_firstSequence + m_eventQueue.m_storedEvents.size();
+        m_eventQueue.m_readers.push_back(this);
+    }
+
+    EventReader::~EventReader()
+    {
+        std::unique_lock<std::mutex> lock(m_eventQueue.m_mutex);
+        auto& readers = m_eventQueue.m_readers;
+        readers.erase(std::remove(readers.begin(), readers.end(), this), readers.end());
+        m_eventQueue.ReclaimReadEvents();
     }
 
     bool EventReader::TryReadNext(XrEventDataBuffer& dataBuffer)
@@ -50,11 +198,23 @@ namespace Conformance
         m_eventQueue.ReadEvents();
 
         std::unique_lock<std::mutex> lock(m_eventQueue.m_mutex);
-        if (m_nextEventIndex >= m_eventQueue.m_events.size()) {
+        const uint64_t firstSequence = m_eventQueue.m_firstSequence;
+        if (m_nextSequence < firstSequence) {
+            // The queue filled up and dropped events before this reader got to them.
+            XrEventDataEventsLost eventsLost{XR_TYPE_EVENT_DATA_EVENTS_LOST};
+            eventsLost.lostEventCount = (uint32_t)(firstSequence - m_nextSequence);
+            memcpy(&dataBuffer, &eventsLost, sizeof(eventsLost));
+            m_nextSequence = firstSequence;
+            return true;
+        }
+        if (m_nextSequence >= firstSequence + m_eventQueue.m_storedEvents.size()) {
             return false;
         }
 
-        dataBuffer = m_eventQueue.m_events[m_nextEventIndex++];
+        const EventQueue::StoredEvent& event = m_eventQueue.m_storedEvents[(size_t)(m_nextSequence - firstSequence)];
+        memcpy(&dataBuffer, &m_eventQueue.m_ring[event.offset], event.size);
+        m_nextSequence++;
+        m_eventQueue.ReclaimReadEvents();
         return true;
     }
 
@@ -69,11 +229,28 @@ namespace Conformance
         return false;
     }
 
+    bool EventReader::WaitForEvent(XrEventDataBuffer& dataBuffer, XrStructureType eventType, std::chrono::nanoseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!TryReadUntilEvent(dataBuffer, eventType)) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            const std::chrono::nanoseconds remaining = deadline - now;
+            m_eventQueue.WaitForEventsAfter(m_nextSequence,
+                                            std::min<std::chrono::nanoseconds>(remaining, EventQueue::WaitPollInterval));
+        }
+
+        return true;
+    }
+
     void EventReader::ReadUntilEmpty()
     {
         m_eventQueue.ReadEvents();
 
         std::unique_lock<std::mutex> lock(m_eventQueue.m_mutex);
-        m_nextEventIndex = m_eventQueue.m_events.size();
+        m_nextSequence = m_eventQueue.m_firstSequence + m_eventQueue.m_storedEvents.size();
+        m_eventQueue.ReclaimReadEvents();
     }
 }  // namespace Conformance
@@ -18,6 +18,11 @@
 
 #include <openxr/openxr.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <vector>
 #include <mutex>
 
@@ -29,20 +34,86 @@ namespace Conformance
      */
     /// @{
 
-    /// Buffered collection of all events read. Only accessible through an @ref EventReader.
+    class EventReader;
+
+    /// Buffered collection of the events read, until every @ref EventReader has read them. Only accessible through an @ref EventReader.
+    ///
+    /// Events are kept in a fixed-size ring buffer, each taking only the size of its own structure rather than a whole XrEventDataBuffer.
+    /// If a reader falls so far behind that the buffer fills up, the oldest events are dropped and that reader is told how many
+    /// it missed with an XrEventDataEventsLost, just as a runtime would.
+    ///
+    /// The queue must outlive all readers created from it.
     class EventQueue
     {
     public:
-        explicit EventQueue(XrInstance instance);
+        /// Enough for thousands of typical events.
+        static constexpr size_t DefaultCapacityBytes = 256 * 1024;
+
+        /// How often blocking waits poll the runtime.
+        /// OpenXR has no call that blocks until the runtime has an event: events only arrive when somebody calls xrPollEvent.
+        /// A wait that slept on the condition variable for its whole timeout would therefore only wake if another thread
+        /// happened to poll, so waits poll this often themselves, and still wake at once when another reader's poll adds
+        /// events. xrPollEvent does not block, so polling this often costs little and bounds how late an event is seen.
+        static constexpr std::chrono::milliseconds WaitPollInterval{1};
+
+        /// Function used to read the next event, with the semantics of xrPollEvent.
+        using PollFunction = std::function<XrResult(XrEventDataBuffer*)>;
+
+        explicit EventQueue(XrInstance instance, size_t capacityBytes = DefaultCapacityBytes);
+
+        /// Read events from @p pollEvent instead of xrPollEvent, e.g. to test the queue itself.
+        explicit EventQueue(PollFunction pollEvent, size_t capacityBytes = DefaultCapacityBytes);
+
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        /// Number of events kept because some reader has not read them yet.
+        size_t GetStoredEventCount() const;
+
+        /// Bytes of the ring buffer in use by the stored events.
+        size_t GetStoredBytes() const;
+
+        /// Size in bytes of the event structure with type @p type, or of XrEventDataBuffer if the type is unknown.
+        static size_t GetEventSize(XrStructureType type);
+
+        /// Poll for events, then block until new events are added, by this or any other thread, or @p timeout elapses.
+        /// Returns true if new events were added.
+        bool WaitForNewEvents(std::chrono::nanoseconds timeout) const;
 
     private:
         friend class EventReader;  // ;-)
 
+        struct StoredEvent
+        {
+            size_t offset;
+            size_t size;
+        };
+
+        /// Poll all available events and add them to the queue.
         void ReadEvents() const;
 
-        const XrInstance m_instance;
+        /// Wait until events after @p sequence are added by any reader, or @p timeout elapses.
+        /// Returns false on timeout.
+        bool WaitForEventsAfter(uint64_t sequence, std::chrono::nanoseconds timeout) const;
+
+        // All of the below require m_mutex to be held.
+        void AddEvent(const XrEventDataBuffer& event) const;
+        void DropOldestEvent() const;
+        void ReclaimReadEvents() const;
+
+        PollFunction m_pollEvent;
         mutable std::mutex m_mutex;
-        mutable std::vector<XrEventDataBuffer> m_events;
+        mutable std::condition_variable m_eventsAdded;
+
+        // Ring buffer of event structures: m_storedEvents holds the location of each, oldest first.
+        // The event at the front has sequence number m_firstSequence.
+        mutable std::vector<uint8_t> m_ring;
+        mutable std::deque<StoredEvent> m_storedEvents;
+        mutable size_t m_writeOffset{0};
+        mutable size_t m_storedBytes{0};
+        mutable uint64_t m_firstSequence{0};
+
+        mutable std::vector<const EventReader*> m_readers;
     };
 
     /// Reads all events added to the @ref EventQueue after this object was created.
@@ -52,16 +123,27 @@ namespace Conformance
     {
     public:
         explicit EventReader(const EventQueue& eventQueue);
+        ~EventReader();
+
+        EventReader(const EventReader&) = delete;
+        EventReader& operator=(const EventReader&) = delete;
 
         bool TryReadNext(XrEventDataBuffer& dataBuffer);
 
         bool TryReadUntilEvent(XrEventDataBuffer& dataBuffer, XrStructureType eventType);
 
+        /// Like @ref TryReadUntilEvent, but if no matching event is available yet, block until one arrives or @p timeout elapses.
+        /// The runtime is polled periodically while waiting, and any events another reader polls wake this one up immediately.
+        bool WaitForEvent(XrEventDataBuffer& dataBuffer, XrStructureType eventType, std::chrono::nanoseconds timeout);
+
         void ReadUntilEmpty();
 
     private:
+        friend class EventQueue;
+
         const EventQueue& m_eventQueue;
-        size_t m_nextEventIndex;
+        // Sequence number of the next event to read, guarded by the queue mutex.
+        uint64_t m_nextSequence;
     };
     /// @}
 
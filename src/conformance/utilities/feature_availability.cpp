@@ -3,8 +3,9 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "feature_availability.h"
+#include <algorithm>
 #include <cstdint>
-#include <sstream>
+#include <cstring>
 #include "utilities/utils.h"
 #include <openxr/openxr.h>
 #include <openxr/openxr_reflection.h>
@@ -32,29 +33,49 @@ namespace Conformance
             void AddTerm(const char* term)
             {
                 if (m_termCount != 0) {
-                    m_stream << m_joinChar;
+                    m_string += m_joinChar;
                 }
-                m_stream << term;
+                m_string += term;
                 ++m_termCount;
             }
 
-            std::string ToString() const
+            const std::string& ToString() const
             {
-                return m_stream.str();
+                return m_string;
             }
 
             void Reset()
             {
                 m_termCount = 0;
-                m_stream = std::ostringstream();
+                m_string.clear();
             }
 
         private:
             const char m_joinChar;
             size_t m_termCount{0};
-            std::ostringstream m_stream;
+            std::string m_string;
         };
 
+        struct FeatureName
+        {
+            const char* name;
+            FeatureBitIndex bit;
+        };
+
+        /// All feature names with their bits, sorted by name for binary search.
+        const std::vector<FeatureName>& GetSortedFeatureNames()
+        {
+            static const std::vector<FeatureName> names = [] {
+#define MAKE_FEATURE_NAME(EXT_NAME, NUM) FeatureName{#EXT_NAME, FeatureBitIndex::BIT_##EXT_NAME},
+                std::vector<FeatureName> ret{XRC_ENUM_FEATURES(MAKE_FEATURE_NAME) XR_LIST_EXTENSIONS(MAKE_FEATURE_NAME)};
+#undef MAKE_FEATURE_NAME
+                std::sort(ret.begin(), ret.end(),
+                          [](const FeatureName& a, const FeatureName& b) { return strcmp(a.name, b.name) < 0; });
+                return ret;
+            }();
+            return names;
+        }
+
     }  // namespace
 
     const char* FeatureBitToString(FeatureBitIndex bit)
@@ -62,7 +83,7 @@ namespace Conformance
 
 #define RETURN_BIT(EXT_NAME, NUM)         \
     case FeatureBitIndex::BIT_##EXT_NAME: \
-        return "XR_" #EXT_NAME;
+        return #EXT_NAME;
 
         switch (bit) {
             XRC_ENUM_FEATURES(RETURN_BIT)
@@ -75,16 +96,14 @@ namespace Conformance
     }
     FeatureBitIndex FeatureNameToBitIndex(const std::string& extNameString)
     {
-
-#define CHECK_BIT_NAME(EXT_NAME, NUM)           \
-    if (#EXT_NAME == extNameString) {           \
-        return FeatureBitIndex::BIT_##EXT_NAME; \
-    }
-        XRC_ENUM_FEATURES(CHECK_BIT_NAME)
-        XR_LIST_EXTENSIONS(CHECK_BIT_NAME)
-
-        // No matching name found
-        return FeatureBitIndex::FEATURE_COUNT;
+        const std::vector<FeatureName>& names = GetSortedFeatureNames();
+        auto it = std::lower_bound(names.begin(), names.end(), extNameString.c_str(),
+                                   [](const FeatureName& feature, const char* name) { return strcmp(feature.name, name) < 0; });
+        if (it == names.end() || extNameString != it->name) {
+            // No matching name found
+            return FeatureBitIndex::FEATURE_COUNT;
+        }
+        return it->bit;
     }
 
     static void FeatureSetToString(const FeatureSet& featureSet, TermJoiner& joiner)
@@ -133,12 +152,7 @@ namespace Conformance
 
     FeatureSet FeatureSet::operator+(const FeatureSet& other) const
     {
-        FeatureSet ret;
-        for (uint32_t i = 0; i < (uint32_t)FeatureBitIndex::FEATURE_COUNT; ++i) {
-            FeatureBitIndex bit(static_cast<FeatureBitIndex>(i));
-            ret.Get(bit) = Get(bit) || other.Get(bit);
-        }
-        return ret;
+        return FeatureSet(m_bits | other.m_bits);
     }
 
     FeatureSet& FeatureSet::operator+=(const FeatureSet& other)
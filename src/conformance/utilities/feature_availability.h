@@ -46,7 +46,7 @@ namespace Conformance
     /// Return a feature bit for the given extension name, if known,
     /// otherwise returns @ref FeatureBitIndex::FEATURE_COUNT
     ///
-    /// Fairly slow because it is doing a lot of naive string comparisons.
+    /// Binary searches a table of names sorted on first use.
     ///
     /// @relates FeatureBitIndex
     FeatureBitIndex FeatureNameToBitIndex(const std::string& extNameString);
@@ -112,7 +112,7 @@ namespace Conformance
         }
 
         /// Set the bit for an extension name using its string.
-        /// Slow - avoid if possible!
+        /// Slower than setting it by FeatureBitIndex.
         /// Returns true if we recognized it.
         bool SetByExtensionNameString(const std::string& extNameString);
 
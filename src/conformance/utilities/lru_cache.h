@@ -0,0 +1,92 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace Conformance
+{
+    /// Map of shared immutable values, bounded by the total size in bytes of the values it holds.
+    /// Adding a value past the budget evicts the least recently used values until it fits.
+    /// Not thread-safe: callers sharing a cache between threads must lock around it.
+    template <typename Key, typename Value>
+    class LruCache
+    {
+    public:
+        explicit LruCache(size_t budgetBytes) : m_budgetBytes(budgetBytes)
+        {
+        }
+
+        /// Returns nullptr if nothing is cached for @p key. Otherwise marks the value as the most recently used.
+        std::shared_ptr<const Value> Find(const Key& key)
+        {
+            auto it = m_entries.find(key);
+            if (it == m_entries.end()) {
+                return nullptr;
+            }
+            m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+            return it->second.value;
+        }
+
+        /// Cache @p value, which takes @p bytes of the budget, for @p key, and return it.
+        /// If a value is already cached for @p key, that one is returned instead.
+        /// A value larger than the whole budget is returned without being cached.
+        std::shared_ptr<const Value> Insert(const Key& key, std::shared_ptr<const Value> value, size_t bytes)
+        {
+            if (std::shared_ptr<const Value> existing = Find(key)) {
+                return existing;
+            }
+            if (bytes > m_budgetBytes) {
+                return value;
+            }
+            while (m_storedBytes + bytes > m_budgetBytes) {
+                auto oldest = m_entries.find(m_recency.back());
+                m_storedBytes -= oldest->second.bytes;
+                m_entries.erase(oldest);
+                m_recency.pop_back();
+            }
+
+            m_recency.push_front(key);
+            m_entries.emplace(key, Entry{value, bytes, m_recency.begin()});
+            m_storedBytes += bytes;
+            return value;
+        }
+
+        void Clear()
+        {
+            m_entries.clear();
+            m_recency.clear();
+            m_storedBytes = 0;
+        }
+
+        size_t GetStoredBytes() const
+        {
+            return m_storedBytes;
+        }
+
+        size_t size() const
+        {
+            return m_entries.size();
+        }
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<const Value> value;
+            size_t bytes;
+            typename std::list<Key>::iterator recency;
+        };
+
+        size_t m_budgetBytes;
+        size_t m_storedBytes{0};
+        /// Keys of the cached values, most recently used first.
+        std::list<Key> m_recency;
+        std::map<Key, Entry> m_entries;
+    };
+}  // namespace Conformance
@@ -7,6 +7,8 @@
 
 #include "common/gfxwrapper_opengl.h"
 
+#include <cstring>
+#include <stdint.h>
 #include <string>
 
 namespace Conformance
@@ -57,6 +59,56 @@ namespace Conformance
             XRC_CHECK_THROW_MSG(r, msg);
         }
     }
+
+    void GLImageUploader::UploadRGBA8(GLenum target, GLuint texture, GLint arraySlice, GLsizei width, GLsizei height,
+                                      const void* pixels)
+    {
+        const size_t rowBytes = (size_t)width * 4;
+        const GLsizeiptr size = (GLsizeiptr)(rowBytes * height);
+
+        if (m_buffer == 0) {
+            XRC_CHECK_THROW_GLCMD(glGenBuffers(1, &m_buffer));
+        }
+        XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffer));
+        // Respecify the storage every time, so the driver can hand out fresh memory
+        // instead of waiting for the previous upload to finish reading from it.
+        XRC_CHECK_THROW_GLCMD(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped == nullptr) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            XRC_THROW_GL(glGetError(), glMapBufferRange);
+        }
+        const uint8_t* source = static_cast<const uint8_t*>(pixels);
+        uint8_t* dest = static_cast<uint8_t*>(mapped);
+        for (GLsizei y = 0; y < height; ++y) {
+            memcpy(dest + y * rowBytes, source + (height - 1 - y) * rowBytes, rowBytes);
+        }
+        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE) {
+            // The buffer contents were lost while mapped (e.g. a display mode change): nothing sensible was uploaded.
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            XRC_THROW("glUnmapBuffer reported the pixel unpack buffer was corrupted");
+        }
+
+        // With a pixel unpack buffer bound, the pixels argument is an offset into the buffer.
+        XRC_CHECK_THROW_GLCMD(glBindTexture(target, texture));
+        if (target == GL_TEXTURE_2D_ARRAY) {
+            XRC_CHECK_THROW_GLCMD(
+                glTexSubImage3D(target, 0, 0, 0, arraySlice, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)0));
+        }
+        else {
+            XRC_CHECK_THROW_GLCMD(glTexSubImage2D(target, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)0));
+        }
+        XRC_CHECK_THROW_GLCMD(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+    }
+
+    void GLImageUploader::Reset()
+    {
+        if (m_buffer != 0) {
+            glDeleteBuffers(1, &m_buffer);
+            m_buffer = 0;
+        }
+    }
 }  // namespace Conformance
 
 #endif  // defined(XR_USE_GRAPHICS_API_OPENGL) || defined(XR_USE_GRAPHICS_API_OPENGL_ES)
@@ -11,6 +11,7 @@
 #include "utilities/stringification.h"
 #include "utilities/throw_helpers.h"
 
+#include <stdint.h>
 #include <string>
 
 namespace Conformance
@@ -54,6 +55,30 @@ namespace Conformance
     void CheckGLShader(GLuint shader);
     void CheckGLProgram(GLuint prog);
 
+    /// Uploads RGBA8 images to textures through a pixel unpack buffer (PBO).
+    ///
+    /// Images are stored top row first, while GL textures start at the bottom row, so rows are flipped while copying
+    /// into the buffer. That leaves a single glTexSubImage call per image, instead of one per row.
+    ///
+    /// Owns a GL buffer object: call Reset() while the GL context is still current.
+    class GLImageUploader
+    {
+    public:
+        GLImageUploader() = default;
+        GLImageUploader(const GLImageUploader&) = delete;
+        GLImageUploader& operator=(const GLImageUploader&) = delete;
+
+        /// Replace mip 0 of @p texture (of type GL_TEXTURE_2D, or slice @p arraySlice of a GL_TEXTURE_2D_ARRAY)
+        /// with @p pixels: @p width x @p height tightly packed RGBA8 pixels, top row first.
+        void UploadRGBA8(GLenum target, GLuint texture, GLint arraySlice, GLsizei width, GLsizei height, const void* pixels);
+
+        /// Delete the buffer object.
+        void Reset();
+
+    private:
+        GLuint m_buffer{0};
+    };
+
 }  // namespace Conformance
 
 #endif  // defined(XR_USE_GRAPHICS_API_OPENGL) || defined(XR_USE_GRAPHICS_API_OPENGL_ES)
@@ -0,0 +1,288 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "pixel_kernels.h"
+
+#include "colors.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define XRC_PIXEL_KERNELS_AVX2
+#define XRC_PIXEL_KERNELS_SSSE3
+#define XRC_PIXEL_KERNELS_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XRC_PIXEL_KERNELS_SSE2
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#define XRC_PIXEL_KERNELS_SSSE3
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define XRC_PIXEL_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Conformance
+{
+    namespace PixelKernels
+    {
+        namespace
+        {
+            /// Table matching the previous per-pixel `ColorUtils::ToSRGB` conversion exactly.
+            const std::array<uint8_t, 256>& GetLinearToSRGBTable()
+            {
+                static const std::array<uint8_t, 256> table = [] {
+                    std::array<uint8_t, 256> result{};
+                    for (size_t i = 0; i < result.size(); ++i) {
+                        result[i] = (uint8_t)(ColorUtils::ToSRGB((double)i / 255.0) * 255.0);
+                    }
+                    return result;
+                }();
+                return table;
+            }
+
+            /// Exact rounded division by 255 for any 16-bit value.
+            inline uint32_t Div255(uint32_t x)
+            {
+                x += 128;
+                return (x + (x >> 8)) >> 8;
+            }
+
+#if defined(XRC_PIXEL_KERNELS_SSE2)
+            /// Rounded division by 255 of eight 16-bit lanes, matching Div255.
+            inline __m128i Div255_SSE2(__m128i x)
+            {
+                x = _mm_add_epi16(x, _mm_set1_epi16(128));
+                return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+            }
+
+            /// Blend two pixels held as 16-bit lanes.
+            inline __m128i Blend16_SSE2(__m128i dest16, __m128i coverage16, __m128i color16)
+            {
+                const __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), coverage16);
+                const __m128i sum = _mm_add_epi16(_mm_mullo_epi16(coverage16, color16), _mm_mullo_epi16(dest16, inverse));
+                return Div255_SSE2(sum);
+            }
+
+            /// Replicate each of the four low coverage bytes of @p coverage across the four channels of its pixel.
+            inline __m128i SplatCoverage4_SSE2(__m128i coverage)
+            {
+                const __m128i doubled = _mm_unpacklo_epi8(coverage, coverage);
+                return _mm_unpacklo_epi16(doubled, doubled);
+            }
+#endif  // defined(XRC_PIXEL_KERNELS_SSE2)
+
+#if defined(XRC_PIXEL_KERNELS_AVX2)
+            inline __m256i Div255_AVX2(__m256i x)
+            {
+                x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+                return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+            }
+
+            /// Blend four pixels held as 16-bit lanes.
+            inline __m256i Blend16_AVX2(__m256i dest16, __m256i coverage16, __m256i color16)
+            {
+                const __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), coverage16);
+                const __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(coverage16, color16), _mm256_mullo_epi16(dest16, inverse));
+                return Div255_AVX2(sum);
+            }
+#endif  // defined(XRC_PIXEL_KERNELS_AVX2)
+
+#if defined(XRC_PIXEL_KERNELS_NEON)
+            /// Rounded division by 255 of eight 16-bit lanes, narrowed to bytes, matching Div255.
+            inline uint8x8_t Div255_NEON(uint16x8_t x)
+            {
+                return vrshrn_n_u16(vaddq_u16(x, vrshrq_n_u16(x, 8)), 8);
+            }
+
+            inline uint8x8_t BlendChannel_NEON(uint8x8_t dest, uint8x8_t coverage, uint8x8_t inverse, uint8x8_t color)
+            {
+                return Div255_NEON(vmlal_u8(vmull_u8(coverage, color), dest, inverse));
+            }
+#endif  // defined(XRC_PIXEL_KERNELS_NEON)
+        }  // namespace
+
+        namespace Reference
+        {
+            void ConvertLinearToSRGB(uint8_t* rgba, size_t pixelCount)
+            {
+                const std::array<uint8_t, 256>& table = GetLinearToSRGBTable();
+                for (size_t i = 0; i < pixelCount; ++i, rgba += 4) {
+                    rgba[0] = table[rgba[0]];
+                    rgba[1] = table[rgba[1]];
+                    rgba[2] = table[rgba[2]];
+                }
+            }
+
+            void Fill(uint32_t* dest, size_t count, uint32_t value)
+            {
+                for (size_t i = 0; i < count; ++i) {
+                    dest[i] = value;
+                }
+            }
+
+            void BlendCoverage(uint8_t* destRGBA, const uint8_t* coverage, size_t count, const RGBA8& premultipliedColor)
+            {
+                for (size_t i = 0; i < count; ++i, destRGBA += 4) {
+                    const uint32_t c = coverage[i];
+                    for (size_t channel = 0; channel < 4; ++channel) {
+                        destRGBA[channel] = (uint8_t)Div255(c * premultipliedColor[channel] + (255 - c) * destRGBA[channel]);
+                    }
+                }
+            }
+
+            void ExpandRGBToRGBA(const uint8_t* src, uint8_t* destRGBA, size_t pixelCount)
+            {
+                for (size_t i = 0; i < pixelCount; ++i, src += 3, destRGBA += 4) {
+                    destRGBA[0] = src[0];
+                    destRGBA[1] = src[1];
+                    destRGBA[2] = src[2];
+                    destRGBA[3] = 255;
+                }
+            }
+        }  // namespace Reference
+
+        const char* GetInstructionSetName()
+        {
+#if defined(XRC_PIXEL_KERNELS_AVX2)
+            return "AVX2";
+#elif defined(XRC_PIXEL_KERNELS_SSSE3)
+            return "SSSE3";
+#elif defined(XRC_PIXEL_KERNELS_SSE2)
+            return "SSE2";
+#elif defined(XRC_PIXEL_KERNELS_NEON)
+            return "NEON";
+#else
+            return "scalar";
+#endif
+        }
+
+        void ConvertLinearToSRGB(uint8_t* rgba, size_t pixelCount)
+        {
+            // Byte-indexed table lookups do not map onto SSE2 or NEON usefully, and AVX2 gathers are no faster
+            // than scalar loads for a 256-entry table, so the table replaces the pow() calls on every path.
+            Reference::ConvertLinearToSRGB(rgba, pixelCount);
+        }
+
+        void Fill(uint32_t* dest, size_t count, uint32_t value)
+        {
+            size_t i = 0;
+#if defined(XRC_PIXEL_KERNELS_AVX2)
+            const __m256i value8 = _mm256_set1_epi32((int)value);
+            for (; i + 8 <= count; i += 8) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), value8);
+            }
+#endif
+#if defined(XRC_PIXEL_KERNELS_SSE2)
+            const __m128i value4 = _mm_set1_epi32((int)value);
+            for (; i + 4 <= count; i += 4) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), value4);
+            }
+#elif defined(XRC_PIXEL_KERNELS_NEON)
+            const uint32x4_t value4 = vdupq_n_u32(value);
+            for (; i + 4 <= count; i += 4) {
+                vst1q_u32(dest + i, value4);
+            }
+#endif
+            Reference::Fill(dest + i, count - i, value);
+        }
+
+        void BlendCoverage(uint8_t* destRGBA, const uint8_t* coverage, size_t count, const RGBA8& premultipliedColor)
+        {
+            size_t i = 0;
+#if defined(XRC_PIXEL_KERNELS_AVX2)
+            {
+                const __m256i color16 = _mm256_setr_epi16(premultipliedColor[0], premultipliedColor[1], premultipliedColor[2],
+                                                          premultipliedColor[3], premultipliedColor[0], premultipliedColor[1],
+                                                          premultipliedColor[2], premultipliedColor[3], premultipliedColor[0],
+                                                          premultipliedColor[1], premultipliedColor[2], premultipliedColor[3],
+                                                          premultipliedColor[0], premultipliedColor[1], premultipliedColor[2],
+                                                          premultipliedColor[3]);
+                for (; i + 8 <= count; i += 8) {
+                    const __m128i coverage8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(coverage + i));
+                    const __m128i doubled = _mm_unpacklo_epi8(coverage8, coverage8);
+                    const __m256i coverageLo = _mm256_cvtepu8_epi16(_mm_unpacklo_epi16(doubled, doubled));
+                    const __m256i coverageHi = _mm256_cvtepu8_epi16(_mm_unpackhi_epi16(doubled, doubled));
+
+                    __m256i* const destPtr = reinterpret_cast<__m256i*>(destRGBA + i * 4);
+                    const __m256i dest = _mm256_loadu_si256(destPtr);
+                    const __m256i destLo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(dest));
+                    const __m256i destHi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(dest, 1));
+
+                    const __m256i packed =
+                        _mm256_packus_epi16(Blend16_AVX2(destLo, coverageLo, color16), Blend16_AVX2(destHi, coverageHi, color16));
+                    // packus works within 128-bit lanes, so restore pixel order.
+                    _mm256_storeu_si256(destPtr, _mm256_permute4x64_epi64(packed, 0xD8));
+                }
+            }
+#endif
+#if defined(XRC_PIXEL_KERNELS_SSE2)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i color16 = _mm_setr_epi16(premultipliedColor[0], premultipliedColor[1], premultipliedColor[2],
+                                                       premultipliedColor[3], premultipliedColor[0], premultipliedColor[1],
+                                                       premultipliedColor[2], premultipliedColor[3]);
+                for (; i + 4 <= count; i += 4) {
+                    int32_t coverage4;
+                    memcpy(&coverage4, coverage + i, sizeof(coverage4));
+                    const __m128i coverageSplat = SplatCoverage4_SSE2(_mm_cvtsi32_si128(coverage4));
+
+                    __m128i* const destPtr = reinterpret_cast<__m128i*>(destRGBA + i * 4);
+                    const __m128i dest = _mm_loadu_si128(destPtr);
+                    const __m128i lo = Blend16_SSE2(_mm_unpacklo_epi8(dest, zero), _mm_unpacklo_epi8(coverageSplat, zero), color16);
+                    const __m128i hi = Blend16_SSE2(_mm_unpackhi_epi8(dest, zero), _mm_unpackhi_epi8(coverageSplat, zero), color16);
+                    _mm_storeu_si128(destPtr, _mm_packus_epi16(lo, hi));
+                }
+            }
+#elif defined(XRC_PIXEL_KERNELS_NEON)
+            {
+                const uint8x8_t colorR = vdup_n_u8(premultipliedColor[0]);
+                const uint8x8_t colorG = vdup_n_u8(premultipliedColor[1]);
+                const uint8x8_t colorB = vdup_n_u8(premultipliedColor[2]);
+                const uint8x8_t colorA = vdup_n_u8(premultipliedColor[3]);
+                for (; i + 8 <= count; i += 8) {
+                    const uint8x8_t coverage8 = vld1_u8(coverage + i);
+                    const uint8x8_t inverse8 = vsub_u8(vdup_n_u8(255), coverage8);
+                    uint8x8x4_t dest = vld4_u8(destRGBA + i * 4);
+                    dest.val[0] = BlendChannel_NEON(dest.val[0], coverage8, inverse8, colorR);
+                    dest.val[1] = BlendChannel_NEON(dest.val[1], coverage8, inverse8, colorG);
+                    dest.val[2] = BlendChannel_NEON(dest.val[2], coverage8, inverse8, colorB);
+                    dest.val[3] = BlendChannel_NEON(dest.val[3], coverage8, inverse8, colorA);
+                    vst4_u8(destRGBA + i * 4, dest);
+                }
+            }
+#endif
+            Reference::BlendCoverage(destRGBA + i * 4, coverage + i, count - i, premultipliedColor);
+        }
+
+        void ExpandRGBToRGBA(const uint8_t* src, uint8_t* destRGBA, size_t pixelCount)
+        {
+            size_t i = 0;
+#if defined(XRC_PIXEL_KERNELS_SSSE3)
+            {
+                const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+                const __m128i alpha = _mm_set1_epi32((int)0xFF000000u);
+                // Each iteration reads 16 source bytes but only consumes 12, so stop while a full load is still in bounds.
+                for (; i + 6 <= pixelCount; i += 4) {
+                    const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destRGBA + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+                }
+            }
+#elif defined(XRC_PIXEL_KERNELS_NEON)
+            {
+                const uint8x8_t alpha = vdup_n_u8(255);
+                for (; i + 8 <= pixelCount; i += 8) {
+                    const uint8x8x3_t rgb = vld3_u8(src + i * 3);
+                    const uint8x8x4_t rgba = {{rgb.val[0], rgb.val[1], rgb.val[2], alpha}};
+                    vst4_u8(destRGBA + i * 4, rgba);
+                }
+            }
+#endif
+            Reference::ExpandRGBToRGBA(src + i * 3, destRGBA + i * 4, pixelCount - i);
+        }
+    }  // namespace PixelKernels
+}  // namespace Conformance
@@ -0,0 +1,58 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Conformance
+{
+    /**
+     * @defgroup cts_pixel_kernels Pixel kernels
+     * @ingroup cts_framework
+     *
+     * Bulk operations on 8-bit-per-channel RGBA pixel data, used when generating and converting images on the CPU.
+     *
+     * The instruction set is chosen at compile time (AVX2, SSE2/SSSE3 or NEON, as enabled by the compiler flags),
+     * falling back to the scalar implementations in PixelKernels::Reference. All paths produce identical results.
+     */
+    namespace PixelKernels
+    {
+        ///@{
+
+        /// Color channels in memory order: R, G, B, A.
+        using RGBA8 = std::array<uint8_t, 4>;
+
+        /// Name of the instruction set the kernels were compiled for, for reporting in benchmarks.
+        const char* GetInstructionSetName();
+
+        /// Convert the color channels of @p pixelCount tightly-packed RGBA pixels from linear to sRGB in place.
+        /// Alpha is not modified.
+        void ConvertLinearToSRGB(uint8_t* rgba, size_t pixelCount);
+
+        /// Set @p count 32-bit pixels to @p value.
+        void Fill(uint32_t* dest, size_t count, uint32_t value);
+
+        /// Blend a premultiplied color into @p count RGBA pixels, using an 8-bit coverage value per pixel
+        /// (e.g. a row of a glyph bitmap): `dest = color * coverage + dest * (1 - coverage)`, rounded to nearest.
+        void BlendCoverage(uint8_t* destRGBA, const uint8_t* coverage, size_t count, const RGBA8& premultipliedColor);
+
+        /// Expand @p pixelCount tightly-packed RGB pixels into RGBA pixels with an opaque alpha channel.
+        /// @p src and @p destRGBA must not overlap.
+        void ExpandRGBToRGBA(const uint8_t* src, uint8_t* destRGBA, size_t pixelCount);
+
+        /// Scalar implementations of the kernels, used for the tail of each span and as a baseline for comparison.
+        namespace Reference
+        {
+            void ConvertLinearToSRGB(uint8_t* rgba, size_t pixelCount);
+            void Fill(uint32_t* dest, size_t count, uint32_t value);
+            void BlendCoverage(uint8_t* destRGBA, const uint8_t* coverage, size_t count, const RGBA8& premultipliedColor);
+            void ExpandRGBToRGBA(const uint8_t* src, uint8_t* destRGBA, size_t pixelCount);
+        }  // namespace Reference
+
+        ///@}
+    }  // namespace PixelKernels
+}  // namespace Conformance
@@ -0,0 +1,603 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "xr_linear_batch.h"
+
+#include <cstring>
+
+#if defined(__AVX__)
+#define XRC_LINEAR_BATCH_AVX
+#define XRC_LINEAR_BATCH_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XRC_LINEAR_BATCH_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+// 32-bit NEON has no vector divide, so only AArch64 is vectorized.
+#define XRC_LINEAR_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(XRC_LINEAR_BATCH_AVX) || defined(XRC_LINEAR_BATCH_SSE2) || defined(XRC_LINEAR_BATCH_NEON)
+#define XRC_LINEAR_BATCH_WIDE
+#endif
+
+namespace Conformance
+{
+    namespace LinearBatch
+    {
+        namespace
+        {
+            /// XrQuaternionf_Multiply, for a single quaternion or for one lane of a Wide each.
+            template <typename T>
+            inline void QuaternionMultiply(T& rx, T& ry, T& rz, T& rw, const T& ax, const T& ay, const T& az, const T& aw,
+                                           const T& bx, const T& by, const T& bz, const T& bw)
+            {
+                rx = (bw * ax) + (bx * aw) + (by * az) - (bz * ay);
+                ry = (bw * ay) - (bx * az) + (by * aw) + (bz * ax);
+                rz = (bw * az) + (bx * ay) - (by * ax) + (bz * aw);
+                rw = (bw * aw) - (bx * ax) - (by * ay) - (bz * az);
+            }
+
+#if defined(XRC_LINEAR_BATCH_WIDE)
+            /// One float per element being processed. The kernels below gather one component of Width consecutive
+            /// elements into each Wide, evaluate the xr_linear.h expressions on all lanes, and scatter the results.
+#if defined(XRC_LINEAR_BATCH_AVX)
+            struct Wide
+            {
+                static constexpr size_t Width = 8;
+                __m256 v;
+
+                static Wide Set1(float f)
+                {
+                    return {_mm256_set1_ps(f)};
+                }
+                void Store(float* p) const
+                {
+                    _mm256_storeu_ps(p, v);
+                }
+                static Wide Gather(const float* p, size_t stride)
+                {
+                    return {_mm256_setr_ps(p[0], p[stride], p[2 * stride], p[3 * stride], p[4 * stride], p[5 * stride],
+                                           p[6 * stride], p[7 * stride])};
+                }
+            };
+
+            inline Wide operator+(Wide a, Wide b)
+            {
+                return {_mm256_add_ps(a.v, b.v)};
+            }
+            inline Wide operator-(Wide a, Wide b)
+            {
+                return {_mm256_sub_ps(a.v, b.v)};
+            }
+            inline Wide operator*(Wide a, Wide b)
+            {
+                return {_mm256_mul_ps(a.v, b.v)};
+            }
+            inline Wide operator/(Wide a, Wide b)
+            {
+                return {_mm256_div_ps(a.v, b.v)};
+            }
+            inline Wide operator&(Wide a, Wide b)
+            {
+                return {_mm256_and_ps(a.v, b.v)};
+            }
+            inline Wide operator|(Wide a, Wide b)
+            {
+                return {_mm256_or_ps(a.v, b.v)};
+            }
+            inline Wide Abs(Wide a)
+            {
+                return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)};
+            }
+            inline Wide Greater(Wide a, Wide b)
+            {
+                return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)};
+            }
+            inline Wide Less(Wide a, Wide b)
+            {
+                return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)};
+            }
+#elif defined(XRC_LINEAR_BATCH_SSE2)
+            struct Wide
+            {
+                static constexpr size_t Width = 4;
+                __m128 v;
+
+                static Wide Set1(float f)
+                {
+                    return {_mm_set1_ps(f)};
+                }
+                void Store(float* p) const
+                {
+                    _mm_storeu_ps(p, v);
+                }
+                static Wide Gather(const float* p, size_t stride)
+                {
+                    return {_mm_setr_ps(p[0], p[stride], p[2 * stride], p[3 * stride])};
+                }
+            };
+
+            inline Wide operator+(Wide a, Wide b)
+            {
+                return {_mm_add_ps(a.v, b.v)};
+            }
+            inline Wide operator-(Wide a, Wide b)
+            {
+                return {_mm_sub_ps(a.v, b.v)};
+            }
+            inline Wide operator*(Wide a, Wide b)
+            {
+                return {_mm_mul_ps(a.v, b.v)};
+            }
+            inline Wide operator/(Wide a, Wide b)
+            {
+                return {_mm_div_ps(a.v, b.v)};
+            }
+            inline Wide operator&(Wide a, Wide b)
+            {
+                return {_mm_and_ps(a.v, b.v)};
+            }
+            inline Wide operator|(Wide a, Wide b)
+            {
+                return {_mm_or_ps(a.v, b.v)};
+            }
+            inline Wide Abs(Wide a)
+            {
+                return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)};
+            }
+            inline Wide Greater(Wide a, Wide b)
+            {
+                return {_mm_cmpgt_ps(a.v, b.v)};
+            }
+            inline Wide Less(Wide a, Wide b)
+            {
+                return {_mm_cmplt_ps(a.v, b.v)};
+            }
+#elif defined(XRC_LINEAR_BATCH_NEON)
+            struct Wide
+            {
+                static constexpr size_t Width = 4;
+                float32x4_t v;
+
+                static Wide Set1(float f)
+                {
+                    return {vdupq_n_f32(f)};
+                }
+                void Store(float* p) const
+                {
+                    vst1q_f32(p, v);
+                }
+                static Wide Gather(const float* p, size_t stride)
+                {
+                    const float lanes[4] = {p[0], p[stride], p[2 * stride], p[3 * stride]};
+                    return {vld1q_f32(lanes)};
+                }
+            };
+
+            inline Wide operator+(Wide a, Wide b)
+            {
+                return {vaddq_f32(a.v, b.v)};
+            }
+            inline Wide operator-(Wide a, Wide b)
+            {
+                return {vsubq_f32(a.v, b.v)};
+            }
+            inline Wide operator*(Wide a, Wide b)
+            {
+                return {vmulq_f32(a.v, b.v)};
+            }
+            inline Wide operator/(Wide a, Wide b)
+            {
+                return {vdivq_f32(a.v, b.v)};
+            }
+            inline Wide operator&(Wide a, Wide b)
+            {
+                return {vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)))};
+            }
+            inline Wide operator|(Wide a, Wide b)
+            {
+                return {vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)))};
+            }
+            inline Wide Abs(Wide a)
+            {
+                return {vabsq_f32(a.v)};
+            }
+            inline Wide Greater(Wide a, Wide b)
+            {
+                return {vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v))};
+            }
+            inline Wide Less(Wide a, Wide b)
+            {
+                return {vreinterpretq_f32_u32(vcltq_f32(a.v, b.v))};
+            }
+#endif
+
+            constexpr size_t Width = Wide::Width;
+
+            /// Writes lane l of @p value to `p[l * stride]`.
+            inline void Scatter(const Wide& value, float* p, size_t stride)
+            {
+                float lanes[Width];
+                value.Store(lanes);
+                for (size_t lane = 0; lane < Width; ++lane) {
+                    p[lane * stride] = lanes[lane];
+                }
+            }
+
+            // The kernels address the components of the OpenXR structures as strided float arrays.
+            constexpr size_t Vector3fStride = sizeof(XrVector3f) / sizeof(float);
+            constexpr size_t PosefStride = sizeof(XrPosef) / sizeof(float);
+            constexpr size_t Matrix4x4fStride = sizeof(XrMatrix4x4f) / sizeof(float);
+            static_assert(sizeof(XrVector3f) == 3 * sizeof(float), "XrVector3f must be tightly packed");
+            static_assert(sizeof(XrPosef) == 7 * sizeof(float), "XrPosef must be tightly packed");
+            static_assert(sizeof(XrMatrix4x4f) == 16 * sizeof(float), "XrMatrix4x4f must be tightly packed");
+
+            inline bool IsMaskSet(float lane)
+            {
+                uint32_t bits;
+                memcpy(&bits, &lane, sizeof(bits));
+                return bits != 0;
+            }
+#endif  // defined(XRC_LINEAR_BATCH_WIDE)
+
+#if defined(XRC_LINEAR_BATCH_AVX)
+            /// XrMatrix4x4f_Multiply with the columns of @p a duplicated into both halves of @p a2, two columns at a time.
+            inline void MultiplyMatrix_AVX(XrMatrix4x4f* result, const __m256 a2[4], const XrMatrix4x4f& b)
+            {
+                for (int col = 0; col < 4; col += 2) {
+                    const __m256 b2 = _mm256_loadu_ps(b.m + col * 4);
+                    __m256 r = _mm256_mul_ps(a2[0], _mm256_permute_ps(b2, 0x00));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(a2[1], _mm256_permute_ps(b2, 0x55)));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(a2[2], _mm256_permute_ps(b2, 0xAA)));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(a2[3], _mm256_permute_ps(b2, 0xFF)));
+                    _mm256_storeu_ps(result->m + col * 4, r);
+                }
+            }
+
+            inline void LoadColumns_AVX(__m256 a2[4], const XrMatrix4x4f& a)
+            {
+                for (int col = 0; col < 4; ++col) {
+                    const __m128 column = _mm_loadu_ps(a.m + col * 4);
+                    a2[col] = _mm256_insertf128_ps(_mm256_castps128_ps256(column), column, 1);
+                }
+            }
+#elif defined(XRC_LINEAR_BATCH_SSE2)
+            inline void MultiplyMatrix_SSE2(XrMatrix4x4f* result, const __m128 a[4], const XrMatrix4x4f& b)
+            {
+                for (int col = 0; col < 4; ++col) {
+                    const float* bColumn = b.m + col * 4;
+                    __m128 r = _mm_mul_ps(a[0], _mm_set1_ps(bColumn[0]));
+                    r = _mm_add_ps(r, _mm_mul_ps(a[1], _mm_set1_ps(bColumn[1])));
+                    r = _mm_add_ps(r, _mm_mul_ps(a[2], _mm_set1_ps(bColumn[2])));
+                    r = _mm_add_ps(r, _mm_mul_ps(a[3], _mm_set1_ps(bColumn[3])));
+                    _mm_storeu_ps(result->m + col * 4, r);
+                }
+            }
+
+            inline void LoadColumns_SSE2(__m128 a[4], const XrMatrix4x4f& m)
+            {
+                for (int col = 0; col < 4; ++col) {
+                    a[col] = _mm_loadu_ps(m.m + col * 4);
+                }
+            }
+#elif defined(XRC_LINEAR_BATCH_NEON)
+            inline void MultiplyMatrix_NEON(XrMatrix4x4f* result, const float32x4_t a[4], const XrMatrix4x4f& b)
+            {
+                // Separate multiplies and adds rather than vmlaq/vfmaq, to round like the scalar expression.
+                for (int col = 0; col < 4; ++col) {
+                    const float* bColumn = b.m + col * 4;
+                    float32x4_t r = vmulq_n_f32(a[0], bColumn[0]);
+                    r = vaddq_f32(r, vmulq_n_f32(a[1], bColumn[1]));
+                    r = vaddq_f32(r, vmulq_n_f32(a[2], bColumn[2]));
+                    r = vaddq_f32(r, vmulq_n_f32(a[3], bColumn[3]));
+                    vst1q_f32(result->m + col * 4, r);
+                }
+            }
+
+            inline void LoadColumns_NEON(float32x4_t a[4], const XrMatrix4x4f& m)
+            {
+                for (int col = 0; col < 4; ++col) {
+                    a[col] = vld1q_f32(m.m + col * 4);
+                }
+            }
+#endif
+        }  // namespace
+
+        namespace Reference
+        {
+            void MultiplyMatrices(XrMatrix4x4f* results, const XrMatrix4x4f& a, const XrMatrix4x4f* b, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i) {
+                    XrMatrix4x4f_Multiply(&results[i], &a, &b[i]);
+                }
+            }
+
+            void MultiplyMatrixPairs(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i) {
+                    XrMatrix4x4f_Multiply(&results[i], &a[i], &b[i]);
+                }
+            }
+
+            void MultiplyPoses(XrPosef* results, const XrPosef& a, const XrPosef* b, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i) {
+                    XrPosef_Multiply(&results[i], &a, &b[i]);
+                }
+            }
+
+            void TransformPoints(XrVector3f* results, const XrMatrix4x4f& matrix, const XrVector3f* points, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i) {
+                    XrMatrix4x4f_TransformVector3f(&results[i], &matrix, &points[i]);
+                }
+            }
+
+            void TransformBounds(XrVector3f* resultMins, XrVector3f* resultMaxs, const XrMatrix4x4f* matrices,
+                                 const XrVector3f* mins, const XrVector3f* maxs, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i) {
+                    XrMatrix4x4f_TransformBounds(&resultMins[i], &resultMaxs[i], &matrices[i], &mins[i], &maxs[i]);
+                }
+            }
+
+            size_t CullBounds(uint8_t* culled, const XrMatrix4x4f& viewProjection, const XrVector3f* mins, const XrVector3f* maxs,
+                              size_t count)
+            {
+                size_t culledCount = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    culled[i] = XrMatrix4x4f_CullBounds(&viewProjection, &mins[i], &maxs[i]) ? 1 : 0;
+                    culledCount += culled[i];
+                }
+                return culledCount;
+            }
+        }  // namespace Reference
+
+        const char* GetInstructionSetName()
+        {
+#if defined(XRC_LINEAR_BATCH_AVX)
+            return "AVX";
+#elif defined(XRC_LINEAR_BATCH_SSE2)
+            return "SSE2";
+#elif defined(XRC_LINEAR_BATCH_NEON)
+            return "NEON";
+#else
+            return "scalar";
+#endif
+        }
+
+        void MultiplyMatrices(XrMatrix4x4f* results, const XrMatrix4x4f& a, const XrMatrix4x4f* b, size_t count)
+        {
+            size_t i = 0;
+#if defined(XRC_LINEAR_BATCH_AVX)
+            __m256 a2[4];
+            LoadColumns_AVX(a2, a);
+            for (; i < count; ++i) {
+                MultiplyMatrix_AVX(&results[i], a2, b[i]);
+            }
+#elif defined(XRC_LINEAR_BATCH_SSE2)
+            __m128 aColumns[4];
+            LoadColumns_SSE2(aColumns, a);
+            for (; i < count; ++i) {
+                MultiplyMatrix_SSE2(&results[i], aColumns, b[i]);
+            }
+#elif defined(XRC_LINEAR_BATCH_NEON)
+            float32x4_t aColumns[4];
+            LoadColumns_NEON(aColumns, a);
+            for (; i < count; ++i) {
+                MultiplyMatrix_NEON(&results[i], aColumns, b[i]);
+            }
+#endif
+            Reference::MultiplyMatrices(results + i, a, b + i, count - i);
+        }
+
+        void MultiplyMatrixPairs(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, size_t count)
+        {
+            size_t i = 0;
+#if defined(XRC_LINEAR_BATCH_AVX)
+            for (; i < count; ++i) {
+                __m256 a2[4];
+                LoadColumns_AVX(a2, a[i]);
+                MultiplyMatrix_AVX(&results[i], a2, b[i]);
+            }
+#elif defined(XRC_LINEAR_BATCH_SSE2)
+            for (; i < count; ++i) {
+                __m128 aColumns[4];
+                LoadColumns_SSE2(aColumns, a[i]);
+                MultiplyMatrix_SSE2(&results[i], aColumns, b[i]);
+            }
+#elif defined(XRC_LINEAR_BATCH_NEON)
+            for (; i < count; ++i) {
+                float32x4_t aColumns[4];
+                LoadColumns_NEON(aColumns, a[i]);
+                MultiplyMatrix_NEON(&results[i], aColumns, b[i]);
+            }
+#endif
+            Reference::MultiplyMatrixPairs(results + i, a + i, b + i, count - i);
+        }
+
+        void MultiplyPoses(XrPosef* results, const XrPosef& a, const XrPosef* b, size_t count)
+        {
+            size_t i = 0;
+#if defined(XRC_LINEAR_BATCH_WIDE)
+            const Wide aqx = Wide::Set1(a.orientation.x);
+            const Wide aqy = Wide::Set1(a.orientation.y);
+            const Wide aqz = Wide::Set1(a.orientation.z);
+            const Wide aqw = Wide::Set1(a.orientation.w);
+            // XrQuaternionf_Invert
+            const Wide invx = Wide::Set1(-a.orientation.x);
+            const Wide invy = Wide::Set1(-a.orientation.y);
+            const Wide invz = Wide::Set1(-a.orientation.z);
+            const Wide zero = Wide::Set1(0.0f);
+            const Wide apx = Wide::Set1(a.position.x);
+            const Wide apy = Wide::Set1(a.position.y);
+            const Wide apz = Wide::Set1(a.position.z);
+
+            for (; i + Width <= count; i += Width) {
+                const float* pose = reinterpret_cast<const float*>(b + i);
+                // XrPosef_Multiply: the orientation is b's orientation followed by a's.
+                Wide qx, qy, qz, qw;
+                QuaternionMultiply(qx, qy, qz, qw, Wide::Gather(pose + 0, PosefStride), Wide::Gather(pose + 1, PosefStride),
+                                   Wide::Gather(pose + 2, PosefStride), Wide::Gather(pose + 3, PosefStride), aqx, aqy, aqz, aqw);
+
+                // XrQuaternionf_RotateVector3f of b's position by a's orientation, then a's translation.
+                Wide tx, ty, tz, tw;
+                QuaternionMultiply(tx, ty, tz, tw, Wide::Gather(pose + 4, PosefStride), Wide::Gather(pose + 5, PosefStride),
+                                   Wide::Gather(pose + 6, PosefStride), zero, aqx, aqy, aqz, aqw);
+                Wide px, py, pz, pw;
+                QuaternionMultiply(px, py, pz, pw, invx, invy, invz, aqw, tx, ty, tz, tw);
+
+                float* result = reinterpret_cast<float*>(results + i);
+                Scatter(qx, result + 0, PosefStride);
+                Scatter(qy, result + 1, PosefStride);
+                Scatter(qz, result + 2, PosefStride);
+                Scatter(qw, result + 3, PosefStride);
+                Scatter(px + apx, result + 4, PosefStride);
+                Scatter(py + apy, result + 5, PosefStride);
+                Scatter(pz + apz, result + 6, PosefStride);
+            }
+#endif
+            Reference::MultiplyPoses(results + i, a, b + i, count - i);
+        }
+
+        void TransformPoints(XrVector3f* results, const XrMatrix4x4f& matrix, const XrVector3f* points, size_t count)
+        {
+            size_t i = 0;
+#if defined(XRC_LINEAR_BATCH_WIDE)
+            Wide m[16];
+            for (int element = 0; element < 16; ++element) {
+                m[element] = Wide::Set1(matrix.m[element]);
+            }
+            const Wide one = Wide::Set1(1.0f);
+
+            for (; i + Width <= count; i += Width) {
+                const float* point = reinterpret_cast<const float*>(points + i);
+                const Wide x = Wide::Gather(point + 0, Vector3fStride);
+                const Wide y = Wide::Gather(point + 1, Vector3fStride);
+                const Wide z = Wide::Gather(point + 2, Vector3fStride);
+
+                // XrMatrix4x4f_TransformVector3f
+                const Wide w = m[3] * x + m[7] * y + m[11] * z + m[15];
+                const Wide rcpW = one / w;
+                float* result = reinterpret_cast<float*>(results + i);
+                Scatter((m[0] * x + m[4] * y + m[8] * z + m[12]) * rcpW, result + 0, Vector3fStride);
+                Scatter((m[1] * x + m[5] * y + m[9] * z + m[13]) * rcpW, result + 1, Vector3fStride);
+                Scatter((m[2] * x + m[6] * y + m[10] * z + m[14]) * rcpW, result + 2, Vector3fStride);
+            }
+#endif
+            Reference::TransformPoints(results + i, matrix, points + i, count - i);
+        }
+
+        void TransformBounds(XrVector3f* resultMins, XrVector3f* resultMaxs, const XrMatrix4x4f* matrices, const XrVector3f* mins,
+                             const XrVector3f* maxs, size_t count)
+        {
+            size_t i = 0;
+#if defined(XRC_LINEAR_BATCH_WIDE)
+            // Gathering twelve matrix elements per lane costs more than it saves, so transform one bounds at a time,
+            // with the columns of its matrix as vectors.
+            for (; i < count; ++i) {
+                const XrMatrix4x4f& matrix = matrices[i];
+                const float center[3] = {(mins[i].x + maxs[i].x) * 0.5f, (mins[i].y + maxs[i].y) * 0.5f,
+                                         (mins[i].z + maxs[i].z) * 0.5f};
+                const float extents[3] = {maxs[i].x - center[0], maxs[i].y - center[1], maxs[i].z - center[2]};
+                float newMins[4];
+                float newMaxs[4];
+#if defined(XRC_LINEAR_BATCH_SSE2)
+                const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+                const __m128 col0 = _mm_loadu_ps(matrix.m + 0);
+                const __m128 col1 = _mm_loadu_ps(matrix.m + 4);
+                const __m128 col2 = _mm_loadu_ps(matrix.m + 8);
+                const __m128 col3 = _mm_loadu_ps(matrix.m + 12);
+                __m128 newCenter = _mm_mul_ps(col0, _mm_set1_ps(center[0]));
+                newCenter = _mm_add_ps(newCenter, _mm_mul_ps(col1, _mm_set1_ps(center[1])));
+                newCenter = _mm_add_ps(newCenter, _mm_mul_ps(col2, _mm_set1_ps(center[2])));
+                newCenter = _mm_add_ps(newCenter, col3);
+                __m128 newExtents = _mm_and_ps(_mm_mul_ps(_mm_set1_ps(extents[0]), col0), absMask);
+                newExtents = _mm_add_ps(newExtents, _mm_and_ps(_mm_mul_ps(_mm_set1_ps(extents[1]), col1), absMask));
+                newExtents = _mm_add_ps(newExtents, _mm_and_ps(_mm_mul_ps(_mm_set1_ps(extents[2]), col2), absMask));
+                _mm_storeu_ps(newMins, _mm_sub_ps(newCenter, newExtents));
+                _mm_storeu_ps(newMaxs, _mm_add_ps(newCenter, newExtents));
+#elif defined(XRC_LINEAR_BATCH_NEON)
+                const float32x4_t col0 = vld1q_f32(matrix.m + 0);
+                const float32x4_t col1 = vld1q_f32(matrix.m + 4);
+                const float32x4_t col2 = vld1q_f32(matrix.m + 8);
+                const float32x4_t col3 = vld1q_f32(matrix.m + 12);
+                float32x4_t newCenter = vmulq_n_f32(col0, center[0]);
+                newCenter = vaddq_f32(newCenter, vmulq_n_f32(col1, center[1]));
+                newCenter = vaddq_f32(newCenter, vmulq_n_f32(col2, center[2]));
+                newCenter = vaddq_f32(newCenter, col3);
+                float32x4_t newExtents = vabsq_f32(vmulq_n_f32(col0, extents[0]));
+                newExtents = vaddq_f32(newExtents, vabsq_f32(vmulq_n_f32(col1, extents[1])));
+                newExtents = vaddq_f32(newExtents, vabsq_f32(vmulq_n_f32(col2, extents[2])));
+                vst1q_f32(newMins, vsubq_f32(newCenter, newExtents));
+                vst1q_f32(newMaxs, vaddq_f32(newCenter, newExtents));
+#endif
+                resultMins[i] = {newMins[0], newMins[1], newMins[2]};
+                resultMaxs[i] = {newMaxs[0], newMaxs[1], newMaxs[2]};
+            }
+#endif
+            Reference::TransformBounds(resultMins + i, resultMaxs + i, matrices + i, mins + i, maxs + i, count - i);
+        }
+
+        size_t CullBounds(uint8_t* culled, const XrMatrix4x4f& viewProjection, const XrVector3f* mins, const XrVector3f* maxs,
+                          size_t count)
+        {
+            size_t i = 0;
+            size_t culledCount = 0;
+#if defined(XRC_LINEAR_BATCH_WIDE)
+            Wide m[16];
+            for (int element = 0; element < 16; ++element) {
+                m[element] = Wide::Set1(viewProjection.m[element]);
+            }
+            const Wide one = Wide::Set1(1.0f);
+
+            for (; i + Width <= count; i += Width) {
+                const float* min = reinterpret_cast<const float*>(mins + i);
+                const float* max = reinterpret_cast<const float*>(maxs + i);
+                const Wide x[2] = {Wide::Gather(min + 0, Vector3fStride), Wide::Gather(max + 0, Vector3fStride)};
+                const Wide y[2] = {Wide::Gather(min + 1, Vector3fStride), Wide::Gather(max + 1, Vector3fStride)};
+                const Wide z[2] = {Wide::Gather(min + 2, Vector3fStride), Wide::Gather(max + 2, Vector3fStride)};
+
+                // XrMatrix4x4f_CullBounds culls if all eight corners are outside the same clip plane,
+                // so track for each plane whether any corner is inside it.
+                const Wide none = Wide::Set1(0.0f);
+                Wide insideLeft = none, insideRight = none, insideBottom = none;
+                Wide insideTop = none, insideNear = none, insideFar = none;
+                for (int corner = 0; corner < 8; ++corner) {
+                    const Wide& cornerX = x[(corner & 1) != 0];
+                    const Wide& cornerY = y[(corner & 2) != 0];
+                    const Wide& cornerZ = z[(corner & 4) != 0];
+                    // XrMatrix4x4f_TransformVector4f with w = 1
+                    const Wide cx = m[0] * cornerX + m[4] * cornerY + m[8] * cornerZ + m[12] * one;
+                    const Wide cy = m[1] * cornerX + m[5] * cornerY + m[9] * cornerZ + m[13] * one;
+                    const Wide cz = m[2] * cornerX + m[6] * cornerY + m[10] * cornerZ + m[14] * one;
+                    const Wide cw = m[3] * cornerX + m[7] * cornerY + m[11] * cornerZ + m[15] * one;
+                    const Wide negativeW = none - cw;
+
+                    insideLeft = insideLeft | Greater(cx, negativeW);
+                    insideRight = insideRight | Less(cx, cw);
+                    insideBottom = insideBottom | Greater(cy, negativeW);
+                    insideTop = insideTop | Less(cy, cw);
+                    insideNear = insideNear | Greater(cz, negativeW);
+                    insideFar = insideFar | Less(cz, cw);
+                }
+
+                float visible[Width];
+                (insideLeft & insideRight & insideBottom & insideTop & insideNear & insideFar).Store(visible);
+                for (size_t lane = 0; lane < Width; ++lane) {
+                    const XrVector3f& laneMins = mins[i + lane];
+                    const XrVector3f& laneMaxs = maxs[i + lane];
+                    // Empty bounds are never culled.
+                    const bool empty = laneMaxs.x <= laneMins.x && laneMaxs.y <= laneMins.y && laneMaxs.z <= laneMins.z;
+                    culled[i + lane] = (!empty && !IsMaskSet(visible[lane])) ? 1 : 0;
+                    culledCount += culled[i + lane];
+                }
+            }
+#endif
+            return culledCount + Reference::CullBounds(culled + i, viewProjection, mins + i, maxs + i, count - i);
+        }
+    }  // namespace LinearBatch
+}  // namespace Conformance
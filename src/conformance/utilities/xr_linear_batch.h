@@ -0,0 +1,76 @@
+// Copyright (c) 2024, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openxr/openxr.h>
+#include "common/xr_linear.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Conformance
+{
+    /**
+     * @defgroup cts_linear_batch Batched linear algebra
+     * @ingroup cts_framework
+     *
+     * The xr_linear.h operations most used per frame, applied to whole arrays at once: combining the transforms of
+     * every joint of a hand or every node of a model, and culling their bounds.
+     *
+     * The instruction set is chosen at compile time (AVX, SSE2 or NEON, as enabled by the compiler flags), falling back
+     * to the scalar implementations in LinearBatch::Reference, which call the xr_linear.h functions one element at a time.
+     * The vector paths evaluate the same expressions in the same order, so they match the reference exactly unless
+     * the compiler contracts multiplies and adds differently on each path; compare results with a small tolerance.
+     *
+     * Arrays are passed as separate pointers per quantity (for example mins and maxs), so the caller can keep them as
+     * structures of arrays. Inputs and results must not overlap unless stated otherwise.
+     */
+    namespace LinearBatch
+    {
+        ///@{
+
+        /// Name of the instruction set the kernels were compiled for, for reporting in benchmarks.
+        const char* GetInstructionSetName();
+
+        /// `results[i] = a * b[i]`, as XrMatrix4x4f_Multiply. For example, model-view-projection matrices from one
+        /// view-projection matrix and many model matrices.
+        void MultiplyMatrices(XrMatrix4x4f* results, const XrMatrix4x4f& a, const XrMatrix4x4f* b, size_t count);
+
+        /// `results[i] = a[i] * b[i]`, as XrMatrix4x4f_Multiply.
+        void MultiplyMatrixPairs(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, size_t count);
+
+        /// `results[i] = a * b[i]`, as XrPosef_Multiply. For example, the poses of many joints relative to a space,
+        /// transformed by the pose of that space.
+        void MultiplyPoses(XrPosef* results, const XrPosef& a, const XrPosef* b, size_t count);
+
+        /// Transforms @p count points by @p matrix, including the divide by w, as XrMatrix4x4f_TransformVector3f.
+        void TransformPoints(XrVector3f* results, const XrMatrix4x4f& matrix, const XrVector3f* points, size_t count);
+
+        /// Transforms the bounds `mins[i]`, `maxs[i]` by the affine `matrices[i]` into axis-aligned bounds,
+        /// as XrMatrix4x4f_TransformBounds.
+        void TransformBounds(XrVector3f* resultMins, XrVector3f* resultMaxs, const XrMatrix4x4f* matrices, const XrVector3f* mins,
+                             const XrVector3f* maxs, size_t count);
+
+        /// Sets `culled[i]` to 1 if the bounds `mins[i]`, `maxs[i]` are entirely outside one of the clip planes of
+        /// @p viewProjection and to 0 otherwise, as XrMatrix4x4f_CullBounds. Returns the number of bounds culled.
+        size_t CullBounds(uint8_t* culled, const XrMatrix4x4f& viewProjection, const XrVector3f* mins, const XrVector3f* maxs,
+                          size_t count);
+
+        /// Scalar implementations of the kernels, used for the tail of each array and as a baseline for comparison.
+        namespace Reference
+        {
+            void MultiplyMatrices(XrMatrix4x4f* results, const XrMatrix4x4f& a, const XrMatrix4x4f* b, size_t count);
+            void MultiplyMatrixPairs(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, size_t count);
+            void MultiplyPoses(XrPosef* results, const XrPosef& a, const XrPosef* b, size_t count);
+            void TransformPoints(XrVector3f* results, const XrMatrix4x4f& matrix, const XrVector3f* points, size_t count);
+            void TransformBounds(XrVector3f* resultMins, XrVector3f* resultMaxs, const XrMatrix4x4f* matrices,
+                                 const XrVector3f* mins, const XrVector3f* maxs, size_t count);
+            size_t CullBounds(uint8_t* culled, const XrMatrix4x4f& viewProjection, const XrVector3f* mins, const XrVector3f* maxs,
+                              size_t count);
+        }  // namespace Reference
+
+        ///@}
+    }  // namespace LinearBatch
+}  // namespace Conformance
@@ -20,7 +20,8 @@
 
 from typing import List, Tuple
 from automatic_source_generator import AutomaticSourceOutputGenerator, write
-from interaction_profile_processor import AvailabilitySymbols, InteractionProfileProcessor, FrozenAvailability
+from interaction_profile_processor import (AvailabilitySymbols, InteractionProfileProcessor, InteractionProfileTables,
+                                           FrozenAvailability, PERFECT_HASH_EMPTY_SLOT)
 from jinja_helpers import JinjaTemplate, make_jinja_environment
 
 VALID_FOR_NULL_INSTANCE = set((
@@ -96,6 +97,8 @@ class ConformanceGenerator(AutomaticSourceOutputGenerator):
             null_instance_ok=VALID_FOR_NULL_INSTANCE,
             sorted_cmds=sorted_cmds,
             interaction_profiles=self.interaction_profiles.interaction_profiles,
+            interaction_profile_tables=InteractionProfileTables.create(self.interaction_profiles.interaction_profiles, avail_syms),
+            perfect_hash_empty_slot=PERFECT_HASH_EMPTY_SLOT,
             availabilities=avail_syms)
         write(file_data, file=self.outFile)
 
@@ -387,3 +387,174 @@ class InteractionProfileProcessor:
                                   action_type=component.get("type"),
                                   limit_to_user_path=component.get("user_path"),
                                   system=system, integral=integral, avail=avail)
+
+
+_FNV_OFFSET_BASIS = 2166136261
+_FNV_PRIME = 16777619
+_SEED_MULTIPLIER = 0x9E3779B9
+_UINT32_MASK = 0xFFFFFFFF
+
+PERFECT_HASH_EMPTY_SLOT = 0xFFFF
+"""Marks an unused slot in a perfect hash table. Keep in sync with template_interaction_info_generated.cpp."""
+
+
+def path_hash_state(path: str, state: int = _FNV_OFFSET_BASIS) -> int:
+    """
+    FNV-1a hash of a path string, continuing from @p state.
+
+    Must match HashPathState in template_interaction_info_generated.cpp.
+    """
+    for byte in path.encode("utf-8"):
+        state = ((state ^ byte) * _FNV_PRIME) & _UINT32_MASK
+    return state
+
+
+def path_hash_separator(state: int) -> int:
+    """Hash the separator between a profile path and a binding path, as if it were a zero byte."""
+    return (state * _FNV_PRIME) & _UINT32_MASK
+
+
+def path_hash_seeded(state: int, seed: int) -> int:
+    """
+    Mix a path hash state with a seed, to give independent hashes for each seed.
+
+    Must match HashPathSeeded in template_interaction_info_generated.cpp.
+    """
+    h = (state ^ (seed * _SEED_MULTIPLIER)) & _UINT32_MASK
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & _UINT32_MASK
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & _UINT32_MASK
+    h ^= h >> 16
+    return h
+
+
+@dataclass
+class PerfectHash:
+    """
+    A perfect hash of a set of keys, built with "hash and displace".
+
+    Each key goes to bucket `path_hash_seeded(state, 0) % len(seeds)`, then to slot
+    `path_hash_seeded(state, seeds[bucket]) % len(slots)`, which holds its index.
+    Keys never collide; a lookup of an unknown key must still compare against the key found.
+    """
+
+    seeds: List[int]
+    slots: List[int]
+
+    @classmethod
+    def build(cls, states: List[int]) -> "PerfectHash":
+        """Build from the hash states of the keys, which must be distinct."""
+        if len(set(states)) != len(states):
+            raise RuntimeError("Duplicate keys or a hash collision: cannot build a perfect hash")
+        if len(states) >= PERFECT_HASH_EMPTY_SLOT:
+            raise RuntimeError("Too many keys for 16-bit perfect hash slots")
+
+        # Four keys per bucket on average, and a load factor of 0.8.
+        bucket_count = max(1, (len(states) + 3) // 4)
+        slot_count = max(1, len(states) + len(states) // 4)
+        buckets: List[List[int]] = [[] for _ in range(bucket_count)]
+        for index, state in enumerate(states):
+            buckets[path_hash_seeded(state, 0) % bucket_count].append(index)
+
+        seeds = [0] * bucket_count
+        slots = [PERFECT_HASH_EMPTY_SLOT] * slot_count
+        # Place the largest buckets first, while most slots are free.
+        for bucket in sorted(range(bucket_count), key=lambda b: (-len(buckets[b]), b)):
+            keys = buckets[bucket]
+            if not keys:
+                continue
+            for seed in range(1, 1 << 20):
+                candidates = [path_hash_seeded(states[k], seed) % slot_count for k in keys]
+                if len(set(candidates)) == len(candidates) and all(slots[s] == PERFECT_HASH_EMPTY_SLOT for s in candidates):
+                    break
+            else:
+                raise RuntimeError("Could not find a seed for a perfect hash bucket")
+            seeds[bucket] = seed
+            for key, slot in zip(keys, candidates):
+                slots[slot] = key
+        return cls(seeds=seeds, slots=slots)
+
+
+@dataclass
+class InteractionProfileTableEntry:
+    """Where the paths of one interaction profile are in InteractionProfileTables."""
+
+    profile: InteractionProfile
+    top_level_path_offset: int
+    top_level_path_count: int
+    input_source_offset: int
+    input_source_count: int
+
+    binding_prefix_state: int
+    """Hash state of the profile path and separator, to continue with a binding path."""
+
+
+@dataclass
+class InteractionProfileTables:
+    """
+    The interaction profiles flattened into arrays, in the order of InteractionProfileIndex,
+    with perfect hashes to look up profiles by path and input sources by profile and binding path.
+    """
+
+    top_level_paths: List[str]
+    """The top level user paths of every profile, one profile after another."""
+
+    input_sources: List[Tuple[str, InteractionProfileComponent]]
+    """The binding paths and components of every profile, one profile after another."""
+
+    profiles: List[InteractionProfileTableEntry]
+
+    profile_hash: PerfectHash
+    """Keyed by interaction profile path, giving the profile index."""
+
+    input_source_hash: PerfectHash
+    """Keyed by interaction profile path and binding path, giving the index into input_sources."""
+
+    features: List[str]
+    """Every feature named in an availability expression, in the order of their bits in availability_terms."""
+
+    availability_terms: List[Tuple[str, int]]
+    """The symbol of each availability expression with the mask of features of each of its conjunctions, one per term."""
+
+    @classmethod
+    def create(cls, interaction_profiles: Dict[str, InteractionProfile],
+               availabilities: List[Tuple[str, FrozenAvailability]]) -> "InteractionProfileTables":
+        top_level_paths: List[str] = []
+        input_sources: List[Tuple[str, InteractionProfileComponent]] = []
+        profiles: List[InteractionProfileTableEntry] = []
+        profile_states: List[int] = []
+        input_source_states: List[int] = []
+        for path, profile in interaction_profiles.items():
+            user_paths = sorted(profile.valid_user_paths)
+            prefix_state = path_hash_separator(path_hash_state(path))
+            sources = [(user_path + component.subpath, component)
+                       for component in profile.components.values()
+                       for user_path in sorted(component.valid_user_paths)]
+            profiles.append(InteractionProfileTableEntry(
+                profile=profile,
+                top_level_path_offset=len(top_level_paths),
+                top_level_path_count=len(user_paths),
+                input_source_offset=len(input_sources),
+                input_source_count=len(sources),
+                binding_prefix_state=prefix_state))
+            profile_states.append(path_hash_state(path))
+            top_level_paths.extend(user_paths)
+            input_sources.extend(sources)
+            input_source_states.extend(path_hash_state(binding_path, prefix_state) for binding_path, _ in sources)
+
+        features = sorted({feature for _, conjunctions in availabilities for conj in conjunctions for feature in conj})
+        if len(features) > 64:
+            raise RuntimeError("Too many features in interaction profile availability for 64-bit masks")
+        feature_bits = {feature: 1 << bit for bit, feature in enumerate(features)}
+        availability_terms = [(sym, sum(feature_bits[feature] for feature in conj))
+                              for sym, conjunctions in availabilities
+                              for conj in conjunctions]
+
+        return cls(top_level_paths=top_level_paths,
+                   input_sources=input_sources,
+                   profiles=profiles,
+                   profile_hash=PerfectHash.build(profile_states),
+                   input_source_hash=PerfectHash.build(input_source_states),
+                   features=features,
+                   availability_terms=availability_terms)
@@ -7,11 +7,14 @@
 #include "utilities/feature_availability.h"
 #include "interaction_info.h"
 
+#include <cstdint>
+#include <cstring>
+
 namespace Conformance {
 
-//# macro make_qualified_path_entry(user_path, component)
+//# macro make_qualified_path_entry(binding_path, component)
     InputSourcePathAvailData{
-        /*{ (user_path + component.subpath) | quote_string }*/,
+        /*{ binding_path | quote_string }*/,
         /*{ component.action_type }*/,
         InteractionProfileAvailability::Avail_/*{- component.availability.as_normalized_symbol() }*/
         //# if component.system
@@ -20,43 +23,178 @@ namespace Conformance {
     }
 //# endmacro
 
-const std::vector<InteractionProfileAvailMetadata>& GetAllInteractionProfiles() {
-    //
-    // Generated lists of component paths for interaction profiles, with metadata and availability expressions.
-    //
-//# for path, profile in interaction_profiles.items()
+//# macro make_uint_list(values)
+//# for value in values
+/*{ value }*/,
+//# endfor
+//# endmacro
+
+//# set tables = interaction_profile_tables
+namespace {
+
+//
+// Generated list of the component paths of all interaction profiles, with metadata and availability expressions.
+// Each profile refers to a range of these.
+//
 
-    static const InputSourcePathAvailCollection /*{'c' + (path | replace("/", "_")) }*/{
-//# for component in profile.components.values()
-//# for user_path in component.valid_user_paths
-        /*{ make_qualified_path_entry(user_path, component) | collapse_whitespace }*/,
+constexpr InputSourcePathAvailData kInputSourcePaths[] = {
+//# for binding_path, component in tables.input_sources
+    /*{ make_qualified_path_entry(binding_path, component) | collapse_whitespace }*/,
 //# endfor
+};
+
+//
+// Generated list of the top level user paths of all interaction profiles. Each profile refers to a range of these.
+//
+
+constexpr const char* kTopLevelPaths[] = {
+//# for user_path in tables.top_level_paths
+    /*{ user_path | quote_string }*/,
 //# endfor
-    };
+};
+
+//
+// Generated list of all known interaction profiles and metadata, referring to paths defined in the preceding sections.
+//
+
+constexpr InteractionProfileAvailMetadata kAllProfiles[] = {
+//# for entry in tables.profiles
+    {
+        /*{ entry.profile.name | quote_string }*/,
+        /*{ entry.profile.name | replace("/interaction_profiles/", "") | quote_string }*/,
+        {kTopLevelPaths + /*{ entry.top_level_path_offset }*/, /*{ entry.top_level_path_count }*/},
+        InteractionProfileAvailability::Avail_/*{- entry.profile.availability.as_normalized_symbol() -}*/,
+        {kInputSourcePaths + /*{ entry.input_source_offset }*/, /*{ entry.input_source_count }*/},
+    },
+//# endfor
+};
+
+//
+// Perfect hashes to look up profiles and input sources without searching. See PerfectHash in interaction_profile_processor.py.
+//
+
+constexpr uint16_t kEmptySlot = /*{ perfect_hash_empty_slot }*/;
+
+/// Hash state of each profile path followed by the separator, indexed by InteractionProfileIndex.
+constexpr uint32_t kBindingPrefixStates[] = {
+//# for entry in tables.profiles
+    /*{ "0x%08Xu" | format(entry.binding_prefix_state) }*/,
+//# endfor
+};
+
+constexpr uint32_t kProfileSeeds[] = {
+    /*{ make_uint_list(tables.profile_hash.seeds) | collapse_whitespace }*/
+};
+constexpr uint16_t kProfileSlots[] = {
+    /*{ make_uint_list(tables.profile_hash.slots) | collapse_whitespace }*/
+};
+
+constexpr uint32_t kInputSourceSeeds[] = {
+    /*{ make_uint_list(tables.input_source_hash.seeds) | collapse_whitespace }*/
+};
+constexpr uint16_t kInputSourceSlots[] = {
+    /*{ make_uint_list(tables.input_source_hash.slots) | collapse_whitespace }*/
+};
+
+//
+// Availability expressions as masks over the features they use, for InteractionAvailabilityMask.
+//
 
+/// The features named in availability expressions. Bit i of a mask stands for element i.
+constexpr FeatureBitIndex kAvailabilityFeatures[] = {
+//# for feature in tables.features
+    FeatureBitIndex::BIT_/*{ feature }*/,
 //# endfor
+};
 
-    //
-    // Generated list of all known interaction profiles and metadata, referring to paths defined in the preceding section.
-    //
-
-    static const std::vector<InteractionProfileAvailMetadata> cAllProfiles{
-//# for path, profile in interaction_profiles.items()
-        {
-            /*{ profile.name | quote_string }*/,
-            /*{ profile.name | replace("/interaction_profiles/", "") | quote_string }*/,
-            {
-                //# for user_path in profile.valid_user_paths
-                /*{ user_path | quote_string }*/,
-                //# endfor
-            },
-            InteractionProfileAvailability::Avail_/*{- profile.availability.as_normalized_symbol() -}*/,
-            /*{'c' + (path |replace("/", "_")) }*/
-        },
+struct AvailabilityTerm
+{
+    InteractionProfileAvailability availability;
+    /// The features of one conjunction of the availability expression, all of which must be present.
+    uint64_t requiredFeatures;
+};
+
+constexpr AvailabilityTerm kAvailabilityTerms[] = {
+//# for sym, mask in tables.availability_terms
+    {InteractionProfileAvailability::Avail_/*{ sym }*/, /*{ "0x%016Xull" | format(mask) }*/},
 //# endfor
-    };
+};
+
+/// FNV-1a hash of @p path, continuing from @p state. Must match path_hash_state in interaction_profile_processor.py.
+inline uint32_t HashPathState(const char* path, uint32_t state = 2166136261u) {
+    for (; *path != '\0'; ++path) {
+        state = (state ^ (uint8_t)*path) * 16777619u;
+    }
+    return state;
+}
+
+/// Must match path_hash_seeded in interaction_profile_processor.py.
+inline uint32_t HashPathSeeded(uint32_t state, uint32_t seed) {
+    uint32_t h = state ^ (seed * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/// The index stored for a key with hash @p state, which is only the index of that key if the key is in the table.
+template <size_t SeedCount, size_t SlotCount>
+inline uint16_t LookUpSlot(const uint32_t (&seeds)[SeedCount], const uint16_t (&slots)[SlotCount], uint32_t state) {
+    const uint32_t seed = seeds[HashPathSeeded(state, 0) % SeedCount];
+    return slots[HashPathSeeded(state, seed) % SlotCount];
+}
+
+}  // namespace
+
+span<const InteractionProfileAvailMetadata> GetAllInteractionProfiles() {
+    return kAllProfiles;
+}
+
+const InteractionProfileAvailMetadata* FindInteractionProfile(const char* interactionProfilePath) {
+    const uint16_t index = LookUpSlot(kProfileSeeds, kProfileSlots, HashPathState(interactionProfilePath));
+    if (index == kEmptySlot || strcmp(kAllProfiles[index].InteractionProfilePathString, interactionProfilePath) != 0) {
+        return nullptr;
+    }
+    return &kAllProfiles[index];
+}
+
+const InputSourcePathAvailData* FindInputSourcePath(InteractionProfileIndex profile, const char* bindingPath) {
+    const uint32_t state = HashPathState(bindingPath, kBindingPrefixStates[(size_t)profile]);
+    const uint16_t index = LookUpSlot(kInputSourceSeeds, kInputSourceSlots, state);
+    if (index == kEmptySlot) {
+        return nullptr;
+    }
+    // The slot may belong to a binding path of another profile.
+    const InputSourcePathAvailCollection& sources = kAllProfiles[(size_t)profile].InputSourcePaths;
+    const InputSourcePathAvailData* source = &kInputSourcePaths[index];
+    if (source < sources.data() || source >= sources.data() + sources.size() || strcmp(source->Path, bindingPath) != 0) {
+        return nullptr;
+    }
+    return source;
+}
+
+InteractionAvailabilityMask::InteractionAvailabilityMask(const FeatureSet& features) {
+    uint64_t present = 0;
+    for (size_t bit = 0; bit < sizeof(kAvailabilityFeatures) / sizeof(kAvailabilityFeatures[0]); ++bit) {
+        if (features.Get(kAvailabilityFeatures[bit])) {
+            present |= uint64_t(1) << bit;
+        }
+    }
+    for (const AvailabilityTerm& term : kAvailabilityTerms) {
+        if ((term.requiredFeatures & ~present) == 0) {
+            m_satisfied.set((size_t)term.availability);
+        }
+    }
+    for (size_t i = 0; i < kInputSourcePathCount; ++i) {
+        m_inputSources[i] = m_satisfied[(size_t)kInputSourcePaths[i].Availability];
+    }
+}
 
-    return cAllProfiles;
+span<const uint8_t> InteractionAvailabilityMask::GetInputSourceAvailability(const InteractionProfileAvailMetadata& profile) const {
+    const size_t offset = profile.InputSourcePaths.data() - kInputSourcePaths;
+    return {m_inputSources.data() + offset, profile.InputSourcePaths.size()};
 }
 
 } // namespace Conformance
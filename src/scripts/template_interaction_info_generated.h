@@ -58,6 +58,9 @@ static const std::array<Availability, /*{ availabilities | length }*/> kInteract
 //# endfor
 };
 
+/// The number of input sources of all interaction profiles together.
+constexpr size_t kInputSourcePathCount = /*{ interaction_profile_tables.input_sources | length }*/;
+
 /// This is a generated list of all interaction profiles in the order returned by GetAllInteractionProfiles.
 enum class InteractionProfileIndex {
 //# for path, profile in interaction_profiles.items()